@@ -4,6 +4,8 @@ set -euo pipefail
 ROOT_DIR=$(cd "$(dirname "$0")" && pwd)
 THIRD_PARTY="$ROOT_DIR/third_party"
 WHISPER_CPP_DIR="$THIRD_PARTY/whisper.cpp"
+# Public headers only (the header-only decode guards); the commons library is not linked
+COMMONS_INCLUDE_DIR="$ROOT_DIR/../third_party/runanywhere-sdks/sdk/runanywhere-commons/include"
 BUILD_DIR="$ROOT_DIR/build"
 BIN_DIR="$ROOT_DIR/bin"
 
@@ -32,7 +34,8 @@ if [ ! -d "$WHISPER_CPP_DIR" ]; then
   git clone https://github.com/ggml-org/whisper.cpp "$WHISPER_CPP_DIR"
 fi
 
-cmake -S "$ROOT_DIR/native" -B "$BUILD_DIR" -DWHISPER_CPP_DIR="$WHISPER_CPP_DIR" -DCMAKE_BUILD_TYPE=Release
+cmake -S "$ROOT_DIR/native" -B "$BUILD_DIR" -DWHISPER_CPP_DIR="$WHISPER_CPP_DIR" -DCMAKE_BUILD_TYPE=Release \
+  -DCMAKE_CXX_FLAGS="-I$COMMONS_INCLUDE_DIR"
 cmake --build "$BUILD_DIR" -j
 
 mkdir -p "$BIN_DIR"
@@ -19,6 +19,7 @@
 
 #include "whisper.h"
 #include "model_data.h"
+#include "rac/backends/rac_whispercpp_decode_guard.h"
 
 static constexpr int kSampleRate = 16000;
 static constexpr int kChannels = 1;
@@ -30,6 +31,11 @@ static std::atomic<bool> g_stop(false);
 static constexpr const char *kColorRed = "\033[31m";
 static constexpr const char *kColorReset = "\033[0m";
 
+// Decode guards against loops and repeated re-decodes on silence/music,
+// shared with the runanywhere-commons whisper.cpp backend
+static const runanywhere::DecodeGuardConfig kGuardConfig;
+static runanywhere::DecodeGuardStats g_guard_stats;
+
 struct SourceInfo {
     std::string index;
     std::string name;
@@ -268,6 +274,8 @@ static std::string write_model_temp() {
     return std::string(tpl.data());
 }
 
+// Same scaling as rac_audio_int16_to_float32. The CLI only includes header-only
+// commons headers and does not link rac_commons, where that kernel is compiled.
 static std::vector<float> pcm16_to_float(const std::vector<int16_t> &pcm) {
     std::vector<float> out(pcm.size());
     for (size_t i = 0; i < pcm.size(); ++i) {
@@ -364,13 +372,22 @@ static std::string transcribe_audio(whisper_context *ctx, const std::vector<floa
     params.n_threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
     params.language = language.c_str();
 
+    runanywhere::DecodeGuard guard;
+    guard.attach(ctx, kGuardConfig, params);
+
     if (whisper_full(ctx, params, audio.data(), audio.size()) != 0) {
         throw std::runtime_error("whisper_full failed");
     }
+    guard.end_window();
+    g_guard_stats.add(guard.snapshot());
 
     int n_segments = whisper_full_n_segments(ctx);
     std::ostringstream oss;
     for (int i = 0; i < n_segments; ++i) {
+        if (runanywhere::is_no_speech_segment(kGuardConfig, ctx, nullptr, i)) {
+            g_guard_stats.no_speech_skips++;
+            continue;
+        }
         oss << whisper_full_get_segment_text(ctx, i);
     }
     return trim(oss.str());
@@ -550,6 +567,11 @@ int main() {
     } else {
         std::cout << "RTF: 0" << std::endl;
     }
+    std::cout << "Windows: " << g_guard_stats.windows_decoded << std::endl;
+    std::cout << "Decoder steps: " << g_guard_stats.decoder_steps << std::endl;
+    std::cout << "Repetition stops: " << g_guard_stats.repetition_stops << std::endl;
+    std::cout << "Fallback re-decodes: " << g_guard_stats.fallback_decodes << std::endl;
+    std::cout << "No-speech segments skipped: " << g_guard_stats.no_speech_skips << std::endl;
     if (!saved_path.empty()) {
         std::cout << "Saved: " << saved_path << std::endl;
     }
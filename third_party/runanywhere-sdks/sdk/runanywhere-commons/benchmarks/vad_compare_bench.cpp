@@ -0,0 +1,373 @@
+/**
+ * @file vad_compare_bench.cpp
+ * @brief Accuracy and CPU comparison of the energy and spectral VAD engines
+ *
+ * Reports, per engine, the share of frames spent in the speech state on
+ * noise alone, the recall on speech frames of clips mixed with that noise at
+ * 10 dB SNR, and the cost per 100 ms frame. The hiss, fan, keyboard and music
+ * noise is synthesized from a fixed seed, so runs are repeatable. Build with
+ * -DRAC_BUILD_BENCHMARKS=ON and run rac_vad_compare_bench clip.wav... with
+ * 16-bit PCM WAV clips of any rate and channel count, e.g. the ones in
+ * WhisperAndroid/app/src/main/assets/benchmark-clips.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac/features/vad/rac_vad_spectral.h"
+
+namespace {
+
+constexpr int32_t kSampleRate = 16000;
+constexpr size_t kFrameSamples = 1600;     // 100 ms, the default frame of both engines
+constexpr float kNoiseOnlyRms = 0.03f;     // Louder than the default energy threshold
+constexpr size_t kNoiseOnlySeconds = 60;
+constexpr float kSnrDb = 10.0f;
+constexpr float kSpeechFrameRms = 0.02f;   // Clean frames above this count as speech
+constexpr double kPi = 3.14159265358979323846;
+
+// =============================================================================
+// CLIPS
+// =============================================================================
+
+uint32_t read_le(const uint8_t* p, int bytes) {
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/**
+ * Read a 16-bit PCM WAV file as mono Float32 at kSampleRate (channels are
+ * averaged, other rates resampled linearly)
+ */
+bool read_wav(const char* path, std::vector<float>* out) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[65536];
+    size_t n = 0;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+        std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint32_t channels = 0, rate = 0, bits = 0, format = 0;
+    const uint8_t* data = nullptr;
+    size_t data_size = 0;
+    for (size_t pos = 12; pos + 8 <= bytes.size();) {
+        const uint8_t* chunk = bytes.data() + pos;
+        const size_t size = std::min<size_t>(read_le(chunk + 4, 4), bytes.size() - pos - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && size >= 16) {
+            format = read_le(chunk + 8, 2);
+            channels = read_le(chunk + 10, 2);
+            rate = read_le(chunk + 12, 4);
+            bits = read_le(chunk + 22, 2);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            data_size = size;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    if (format != 1 || bits != 16 || channels == 0 || rate == 0 || !data) {
+        return false;
+    }
+
+    const size_t frames = data_size / (2 * channels);
+    std::vector<float> mono(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (uint32_t c = 0; c < channels; ++c) {
+            sum += static_cast<int16_t>(read_le(data + 2 * (i * channels + c), 2)) / 32768.0f;
+        }
+        mono[i] = sum / static_cast<float>(channels);
+    }
+
+    const double step = static_cast<double>(rate) / kSampleRate;
+    const size_t resampled = static_cast<size_t>(frames / step);
+    out->resize(resampled);
+    for (size_t i = 0; i < resampled; ++i) {
+        const double src = i * step;
+        const size_t i0 = static_cast<size_t>(src);
+        const size_t i1 = std::min(i0 + 1, frames - 1);
+        const float t = static_cast<float>(src - i0);
+        (*out)[i] = mono[i0] * (1.0f - t) + mono[i1] * t;
+    }
+    return true;
+}
+
+// =============================================================================
+// NOISE
+// =============================================================================
+
+float rms(const float* samples, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return count > 0 ? static_cast<float>(std::sqrt(sum / count)) : 0.0f;
+}
+
+void scale_to_rms(std::vector<float>* samples, float target) {
+    const float current = rms(samples->data(), samples->size());
+    if (current > 0.0f) {
+        for (float& s : *samples) {
+            s *= target / current;
+        }
+    }
+}
+
+std::vector<float> hiss(size_t count, std::mt19937* rng) {
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::vector<float> out(count);
+    for (float& s : out) {
+        s = gauss(*rng);
+    }
+    return out;
+}
+
+// Low-passed broadband airflow over a 60 Hz motor hum
+std::vector<float> fan(size_t count, std::mt19937* rng) {
+    std::vector<float> out = hiss(count, rng);
+    float state = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        state = 0.5f * state + 0.5f * out[i];
+        const double t = static_cast<double>(i) / kSampleRate;
+        out[i] = state + 0.2f * static_cast<float>(std::sin(2 * kPi * 60 * t));
+    }
+    return out;
+}
+
+// Decaying 5 ms broadband clicks, 80-250 ms apart
+std::vector<float> keyboard(size_t count, std::mt19937* rng) {
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::uniform_int_distribution<size_t> gap(kSampleRate * 80 / 1000, kSampleRate * 250 / 1000);
+    const size_t click = kSampleRate * 5 / 1000;
+    std::vector<float> out(count, 0.0f);
+    for (size_t start = gap(*rng); start < count; start += gap(*rng)) {
+        for (size_t i = 0; i < click && start + i < count; ++i) {
+            out[start + i] = gauss(*rng) * std::exp(-6.0f * i / click);
+        }
+    }
+    return out;
+}
+
+// Three-note chords with a few harmonics, changing every 400 ms
+std::vector<float> music(size_t count, std::mt19937* rng) {
+    static const double kNotes[] = {196.0, 220.0, 246.9, 261.6, 293.7, 329.6, 349.2, 392.0};
+    std::uniform_int_distribution<int> pick(0, 7);
+    const size_t chord_samples = kSampleRate * 400 / 1000;
+    std::vector<float> out(count);
+    double chord[3] = {};
+    for (size_t i = 0; i < count; ++i) {
+        if (i % chord_samples == 0) {
+            for (double& note : chord) {
+                note = kNotes[pick(*rng)];
+            }
+        }
+        const double t = static_cast<double>(i) / kSampleRate;
+        double sample = 0.0;
+        for (double note : chord) {
+            for (int h = 1; h <= 3; ++h) {
+                sample += std::sin(2 * kPi * note * h * t) / h;
+            }
+        }
+        out[i] = static_cast<float>(sample);
+    }
+    return out;
+}
+
+struct noise_type {
+    const char* name;
+    std::vector<float> (*generate)(size_t count, std::mt19937* rng);
+};
+
+const noise_type kNoises[] = {
+    {"hiss", hiss}, {"fan", fan}, {"keyboard", keyboard}, {"music", music}};
+
+// Same seed per noise type, so every engine and run sees identical audio
+std::vector<float> make_noise(const noise_type& noise, size_t count, float target_rms) {
+    std::mt19937 rng(42);
+    std::vector<float> out = noise.generate(count, &rng);
+    scale_to_rms(&out, target_rms);
+    return out;
+}
+
+// =============================================================================
+// ENGINES
+// =============================================================================
+
+struct engine {
+    const char* name;
+    bool spectral;
+    bool calibrate;  // Energy VAD only: measure the ambient level first
+};
+
+const engine kEngines[] = {{"energy", false, false},
+                           {"energy (calibrated)", false, true},
+                           {"spectral", true, false}};
+
+// Speech state after each whole frame
+std::vector<bool> run_engine(const engine& e, const std::vector<float>& audio) {
+    const size_t frames = audio.size() / kFrameSamples;
+    std::vector<bool> active(frames, false);
+    rac_bool_t has_voice = RAC_FALSE;
+    rac_bool_t is_active = RAC_FALSE;
+
+    if (e.spectral) {
+        rac_spectral_vad_handle_t vad = nullptr;
+        rac_spectral_vad_create(nullptr, &vad);
+        rac_spectral_vad_start(vad);
+        for (size_t f = 0; f < frames; ++f) {
+            rac_spectral_vad_process_audio(vad, audio.data() + f * kFrameSamples, kFrameSamples,
+                                           &has_voice);
+            rac_spectral_vad_is_speech_active(vad, &is_active);
+            active[f] = is_active == RAC_TRUE;
+        }
+        rac_spectral_vad_destroy(vad);
+        return active;
+    }
+
+    rac_energy_vad_handle_t vad = nullptr;
+    rac_energy_vad_create(nullptr, &vad);
+    if (e.calibrate) {
+        rac_energy_vad_initialize(vad);  // Starts and calibrates on the first frames
+    } else {
+        rac_energy_vad_start(vad);
+    }
+    for (size_t f = 0; f < frames; ++f) {
+        rac_energy_vad_process_audio(vad, audio.data() + f * kFrameSamples, kFrameSamples,
+                                     &has_voice);
+        rac_energy_vad_is_speech_active(vad, &is_active);
+        active[f] = is_active == RAC_TRUE;
+    }
+    rac_energy_vad_destroy(vad);
+    return active;
+}
+
+double percent_active(const std::vector<bool>& active) {
+    if (active.empty()) {
+        return 0.0;
+    }
+    return 100.0 * std::count(active.begin(), active.end(), true) / active.size();
+}
+
+// Share of the clean clip's speech frames during which the engine is active
+double recall(const std::vector<float>& clean, const std::vector<bool>& active) {
+    size_t speech = 0, hits = 0;
+    for (size_t f = 0; f < active.size(); ++f) {
+        if (rms(clean.data() + f * kFrameSamples, kFrameSamples) > kSpeechFrameRms) {
+            speech++;
+            hits += active[f] ? 1 : 0;
+        }
+    }
+    return speech > 0 ? 100.0 * hits / speech : 0.0;
+}
+
+double best_us_per_frame(const std::function<void()>& fn, size_t frames) {
+    using clock = std::chrono::steady_clock;
+    double best = 1e30;
+    for (int round = 0; round < 3; ++round) {
+        auto start = clock::now();
+        fn();
+        double us = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+        best = std::min(best, us / static_cast<double>(frames));
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    // Speech edges and calibration in loud noise are logged on every run
+    rac_logger_set_min_level(RAC_LOG_ERROR);
+
+    std::vector<std::vector<float>> clips;
+    for (int i = 1; i < argc; ++i) {
+        std::vector<float> clip;
+        if (!read_wav(argv[i], &clip)) {
+            std::fprintf(stderr, "skipping %s: not a 16-bit PCM WAV file\n", argv[i]);
+            continue;
+        }
+        clips.push_back(std::move(clip));
+    }
+
+    const size_t noise_samples = kNoiseOnlySeconds * kSampleRate;
+    std::printf("noise only (RMS %.2f, %zu s): %% of frames in the speech state\n", kNoiseOnlyRms,
+                kNoiseOnlySeconds);
+    std::printf("%-22s", "");
+    for (const noise_type& noise : kNoises) {
+        std::printf(" %9s", noise.name);
+    }
+    std::printf("\n");
+    for (const engine& e : kEngines) {
+        std::printf("%-22s", e.name);
+        for (const noise_type& noise : kNoises) {
+            std::printf(" %8.1f%%",
+                        percent_active(run_engine(e, make_noise(noise, noise_samples,
+                                                                kNoiseOnlyRms))));
+        }
+        std::printf("\n");
+    }
+
+    if (clips.empty()) {
+        std::printf("\nno clips given: speech recall skipped\n");
+    } else {
+        std::printf("\nspeech recall at %.0f dB SNR on frames with clean RMS > %.2f, "
+                    "mean over %zu clip(s)\n",
+                    kSnrDb, kSpeechFrameRms, clips.size());
+        std::printf("%-22s %9s", "", "clean");
+        for (const noise_type& noise : kNoises) {
+            std::printf(" %9s", noise.name);
+        }
+        std::printf("\n");
+        for (const engine& e : kEngines) {
+            double clean_sum = 0.0;
+            std::vector<double> noisy_sum(sizeof(kNoises) / sizeof(kNoises[0]), 0.0);
+            for (const std::vector<float>& clip : clips) {
+                clean_sum += recall(clip, run_engine(e, clip));
+                const float noise_rms =
+                    rms(clip.data(), clip.size()) / std::pow(10.0f, kSnrDb / 20.0f);
+                for (size_t n = 0; n < noisy_sum.size(); ++n) {
+                    std::vector<float> mixed = make_noise(kNoises[n], clip.size(), noise_rms);
+                    for (size_t i = 0; i < mixed.size(); ++i) {
+                        mixed[i] += clip[i];
+                    }
+                    noisy_sum[n] += recall(clip, run_engine(e, mixed));
+                }
+            }
+            std::printf("%-22s %8.1f%%", e.name, clean_sum / clips.size());
+            for (double sum : noisy_sum) {
+                std::printf(" %8.1f%%", sum / clips.size());
+            }
+            std::printf("\n");
+        }
+    }
+
+    const std::vector<float> cost_audio = make_noise(kNoises[0], noise_samples, kNoiseOnlyRms);
+    const size_t cost_frames = cost_audio.size() / kFrameSamples;
+    std::printf("\ncost per %zu ms frame\n", kFrameSamples * 1000 / kSampleRate);
+    for (const engine& e : kEngines) {
+        std::printf("%-22s %8.2f us\n", e.name,
+                    best_us_per_frame([&] { run_engine(e, cost_audio); }, cost_frames));
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+# FetchAudioDecoders.cmake
+# Fetches the compressed audio decoders used by rac_audio_reader
+#
+# FLAC and MP3: dr_flac.h / dr_mp3.h from dr_libs (single-header, public domain)
+# Ogg Opus:     libogg + libopus + opusfile (BSD), only with RAC_AUDIO_DECODER_OPUS
+#
+# Defines the interface target rac_audio_decoders. Any dependency can be
+# vendored instead of downloaded by pointing FETCHCONTENT_SOURCE_DIR_<NAME>
+# (DR_LIBS, OGG, OPUS, OPUSFILE) at a local checkout.
+#
+# dr_libs and opusfile are only fetched, never configured: their SOURCE_SUBDIR
+# names a directory without a CMakeLists.txt, so FetchContent_MakeAvailable
+# populates them without an add_subdirectory.
+
+include(FetchContent)
+include(LoadVersions)
+
+if(NOT DEFINED DR_LIBS_VERSION OR "${DR_LIBS_VERSION}" STREQUAL "")
+    message(FATAL_ERROR "DR_LIBS_VERSION not defined in VERSIONS file")
+endif()
+
+add_library(rac_audio_decoders INTERFACE)
+
+# -----------------------------------------------------------------------------
+# dr_libs (header-only; the implementations are compiled in audio_decoder.cpp)
+# -----------------------------------------------------------------------------
+FetchContent_Declare(
+    dr_libs
+    GIT_REPOSITORY https://github.com/mackron/dr_libs.git
+    GIT_TAG        ${DR_LIBS_VERSION}
+    SOURCE_SUBDIR  populate-only
+)
+FetchContent_MakeAvailable(dr_libs)
+target_include_directories(rac_audio_decoders INTERFACE ${dr_libs_SOURCE_DIR})
+
+# dr_libs has no release tags, so anything but a full commit SHA builds whatever
+# the branch holds that day. Report the commit that was fetched so it can be pinned.
+if(NOT DR_LIBS_VERSION MATCHES "^[0-9a-f]{40}$")
+    find_package(Git QUIET)
+    set(_dr_libs_commit "unknown")
+    if(GIT_FOUND)
+        execute_process(
+            COMMAND ${GIT_EXECUTABLE} rev-parse HEAD
+            WORKING_DIRECTORY ${dr_libs_SOURCE_DIR}
+            OUTPUT_VARIABLE _dr_libs_commit
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+        )
+    endif()
+    message(WARNING "DR_LIBS_VERSION '${DR_LIBS_VERSION}' is not a commit SHA, so the audio "
+                    "decoder build is not reproducible. Fetched dr_libs commit: "
+                    "${_dr_libs_commit}; set DR_LIBS_VERSION in VERSIONS to it.")
+endif()
+
+# -----------------------------------------------------------------------------
+# Ogg Opus
+# -----------------------------------------------------------------------------
+if(RAC_AUDIO_DECODER_OPUS)
+    FetchContent_Declare(
+        ogg
+        GIT_REPOSITORY https://github.com/xiph/ogg.git
+        GIT_TAG        v${OGG_VERSION}
+        GIT_SHALLOW    TRUE
+    )
+    FetchContent_Declare(
+        opus
+        GIT_REPOSITORY https://github.com/xiph/opus.git
+        GIT_TAG        v${OPUS_VERSION}
+        GIT_SHALLOW    TRUE
+    )
+    FetchContent_Declare(
+        opusfile
+        GIT_REPOSITORY https://github.com/xiph/opusfile.git
+        GIT_TAG        v${OPUSFILE_VERSION}
+        GIT_SHALLOW    TRUE
+        SOURCE_SUBDIR  populate-only
+    )
+
+    set(INSTALL_DOCS OFF CACHE BOOL "" FORCE)
+    set(BUILD_TESTING OFF CACHE BOOL "" FORCE)
+    set(OPUS_BUILD_PROGRAMS OFF CACHE BOOL "" FORCE)
+    set(OPUS_BUILD_TESTING OFF CACHE BOOL "" FORCE)
+    set(OPUS_INSTALL_PKG_CONFIG_MODULE OFF CACHE BOOL "" FORCE)
+    set(OPUS_INSTALL_CMAKE_CONFIG_MODULE OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(ogg opus)
+
+    # opusfile's own build looks for installed Ogg/Opus packages, so its
+    # sources are compiled directly against the targets above. Only local
+    # files are read, so the HTTP stream support is left out.
+    FetchContent_MakeAvailable(opusfile)
+    add_library(rac_opusfile STATIC
+        ${opusfile_SOURCE_DIR}/src/info.c
+        ${opusfile_SOURCE_DIR}/src/internal.c
+        ${opusfile_SOURCE_DIR}/src/opusfile.c
+        ${opusfile_SOURCE_DIR}/src/stream.c
+    )
+    target_include_directories(rac_opusfile PUBLIC ${opusfile_SOURCE_DIR}/include)
+    target_compile_definitions(rac_opusfile PRIVATE OP_DISABLE_HTTP)
+    target_link_libraries(rac_opusfile PUBLIC ogg opus)
+    set_target_properties(rac_opusfile PROPERTIES POSITION_INDEPENDENT_CODE ON)
+
+    target_link_libraries(rac_audio_decoders INTERFACE rac_opusfile)
+endif()
+
+message(STATUS "Audio decoders: dr_libs=${DR_LIBS_VERSION}, Opus=${RAC_AUDIO_DECODER_OPUS}")
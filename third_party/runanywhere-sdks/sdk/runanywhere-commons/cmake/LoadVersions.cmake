@@ -60,6 +60,11 @@ message(STATUS "  Sherpa-ONNX:")
 message(STATUS "    SHERPA_ONNX_VERSION_IOS: ${RAC_SHERPA_ONNX_VERSION_IOS}")
 message(STATUS "    SHERPA_ONNX_VERSION_ANDROID: ${RAC_SHERPA_ONNX_VERSION_ANDROID}")
 message(STATUS "    SHERPA_ONNX_VERSION_MACOS: ${RAC_SHERPA_ONNX_VERSION_MACOS}")
+message(STATUS "  Audio decoders:")
+message(STATUS "    DR_LIBS_VERSION: ${RAC_DR_LIBS_VERSION}")
+message(STATUS "    OGG_VERSION: ${RAC_OGG_VERSION}")
+message(STATUS "    OPUS_VERSION: ${RAC_OPUS_VERSION}")
+message(STATUS "    OPUSFILE_VERSION: ${RAC_OPUSFILE_VERSION}")
 message(STATUS "  Other:")
 message(STATUS "    LLAMACPP_VERSION: ${RAC_LLAMACPP_VERSION}")
 message(STATUS "    NLOHMANN_JSON_VERSION: ${RAC_NLOHMANN_JSON_VERSION}")
@@ -52,12 +52,46 @@ typedef enum rac_stt_onnx_model_type {
  */
 typedef struct rac_stt_onnx_config {
     rac_stt_onnx_model_type_t model_type;
+    /** Intra-op threads per session (0 = default of 2) */
     int32_t num_threads;
     rac_bool_t use_coreml;
+    /** Per-language recognizers kept loaded for language switches (0 = default of 2) */
+    int32_t recognizer_cache_size;
+    /** Execution provider for the sherpa/ORT sessions (NULL = "cpu") */
+    const char* provider;
+    /** Verbose model loading logs from sherpa-onnx */
+    rac_bool_t debug;
+    /**
+     * Create the process OrtEnv with global thread pools sized by num_threads. The
+     * sherpa-onnx sessions behind this model cannot share them and keep their own
+     * pools, each capped at num_threads.
+     */
+    rac_bool_t use_global_thread_pool;
+    /** Skip the optimized-graph cache saved next to each model file */
+    rac_bool_t disable_model_cache;
 } rac_stt_onnx_config_t;
 
 static const rac_stt_onnx_config_t RAC_STT_ONNX_CONFIG_DEFAULT = {
-    .model_type = RAC_STT_ONNX_MODEL_AUTO, .num_threads = 0, .use_coreml = RAC_TRUE};
+    .model_type = RAC_STT_ONNX_MODEL_AUTO,
+    .num_threads = 0,
+    .use_coreml = RAC_TRUE,
+    .recognizer_cache_size = 0,
+    .provider = NULL,
+    .debug = RAC_FALSE,
+    .use_global_thread_pool = RAC_FALSE,
+    .disable_model_cache = RAC_FALSE};
+
+/**
+ * Recognizer cache statistics since the model was loaded.
+ */
+typedef struct rac_stt_onnx_recognizer_stats {
+    int64_t language_switches;
+    /** Recognizers built from disk, including the initial one */
+    int64_t recognizer_loads;
+    /** Language switches served by an already loaded recognizer */
+    int64_t reloads_avoided;
+    int64_t evictions;
+} rac_stt_onnx_recognizer_stats_t;
 
 // =============================================================================
 // ONNX STT API
@@ -90,6 +124,9 @@ RAC_ONNX_API rac_bool_t rac_stt_onnx_is_endpoint(rac_handle_t handle, rac_handle
 
 RAC_ONNX_API void rac_stt_onnx_destroy_stream(rac_handle_t handle, rac_handle_t stream);
 
+RAC_ONNX_API rac_result_t rac_stt_onnx_get_recognizer_stats(
+    rac_handle_t handle, rac_stt_onnx_recognizer_stats_t* out_stats);
+
 RAC_ONNX_API void rac_stt_onnx_destroy(rac_handle_t handle);
 
 #ifdef __cplusplus
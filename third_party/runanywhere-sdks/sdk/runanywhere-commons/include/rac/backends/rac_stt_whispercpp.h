@@ -59,8 +59,81 @@ typedef struct rac_stt_whispercpp_config {
 
     /** Translate to English (when source is non-English) */
     rac_bool_t translate;
+
+    /** Latency budget per transcription in ms, including queueing (0 = no deadline) */
+    int32_t deadline_ms;
+
+    /** Stop decoding once output loops on an n-gram up to this length (0 = default, <0 = off) */
+    int32_t repetition_ngram;
+
+    /** Back-to-back repeats of such an n-gram that end the decode (0 = default, <0 = off) */
+    int32_t max_ngram_repeats;
+
+    /** Temperature-fallback re-decodes allowed per window (0 = default, <0 = off) */
+    int32_t max_fallback_steps;
+
+    /** Skip segments whose no-speech probability exceeds this (0 = default, >=1 = off) */
+    float no_speech_threshold;
+
+    /**
+     * Refine word timestamps with DTW on the model's alignment heads. The aligner is
+     * created on the first request with enable_word_timestamps and only serves those.
+     *
+     * whisper.cpp fixes DTW when a context is created, so the aligner is a second
+     * context with its own copy of the model weights: expect model memory to double
+     * once it exists. It lives until the model is unloaded.
+     */
+    rac_bool_t dtw_word_timestamps;
+
+    /** Streams decoded at once by the stream scheduler (0 = based on hardware threads) */
+    int32_t max_concurrent_streams;
 } rac_stt_whispercpp_config_t;
 
+/**
+ * Counters for the decode guards, accumulated since the model was loaded.
+ */
+typedef struct rac_stt_whispercpp_guard_stats {
+    /** 30-second windows encoded */
+    int64_t windows_decoded;
+
+    /** Decoder steps across all passes (a proxy for decode CPU) */
+    int64_t decoder_steps;
+
+    /** Decode passes stopped early by the repetition guard */
+    int64_t repetition_stops;
+
+    /** Temperature-fallback re-decodes performed */
+    int64_t fallback_decodes;
+
+    /** Windows that used up the capped fallback budget */
+    int64_t fallback_cap_hits;
+
+    /** Segments dropped as no-speech */
+    int64_t no_speech_skips;
+} rac_stt_whispercpp_guard_stats_t;
+
+/**
+ * Stream scheduler counters, accumulated since the handle's first stream.
+ */
+typedef struct rac_stt_whispercpp_stream_stats {
+    /** Scheduler rounds run */
+    int64_t scheduler_ticks;
+
+    /** Stream decodes dispatched, and ready streams left for a later round */
+    int64_t stream_decodes;
+    int64_t streams_deferred;
+
+    /** Dispatches forced because a stream had been passed over too often */
+    int64_t fairness_promotions;
+
+    /** Stream decodes whose inference failed */
+    int64_t failed_decodes;
+
+    /** Delay from a chunk's oldest sample to its delivered result, in ms */
+    double avg_stream_lag_ms;
+    double max_stream_lag_ms;
+} rac_stt_whispercpp_stream_stats_t;
+
 /**
  * Default WhisperCPP configuration.
  */
@@ -69,7 +142,70 @@ static const rac_stt_whispercpp_config_t RAC_STT_WHISPERCPP_CONFIG_DEFAULT = {
     .use_gpu = RAC_TRUE,
     .use_coreml = RAC_TRUE,
     .language = NULL,
-    .translate = RAC_FALSE};
+    .translate = RAC_FALSE,
+    .deadline_ms = 0,
+    .repetition_ngram = 0,
+    .max_ngram_repeats = 0,
+    .max_fallback_steps = 0,
+    .no_speech_threshold = 0.0f,
+    .dtw_word_timestamps = RAC_FALSE,
+    .max_concurrent_streams = 0};
+
+/**
+ * Escalation router configuration.
+ *
+ * A routed handle transcribes with a small primary model and re-transcribes
+ * only the segments below these thresholds with a larger escalation model.
+ */
+typedef struct rac_stt_whispercpp_router_config {
+    /** Escalate segments whose confidence (1 - no-speech probability) is below this */
+    float min_segment_confidence;
+
+    /** Escalate segments whose mean text-token probability is below this */
+    float min_avg_token_prob;
+
+    /** Audio context added before and after each escalated span, in ms */
+    int32_t padding_ms;
+} rac_stt_whispercpp_router_config_t;
+
+/**
+ * Default escalation router configuration.
+ */
+static const rac_stt_whispercpp_router_config_t RAC_STT_WHISPERCPP_ROUTER_CONFIG_DEFAULT = {
+    .min_segment_confidence = 0.5f, .min_avg_token_prob = 0.6f, .padding_ms = 200};
+
+/**
+ * Escalation router statistics, accumulated since the handle was created.
+ */
+typedef struct rac_stt_whispercpp_router_stats {
+    /** Transcriptions routed */
+    int64_t requests;
+
+    /** Segments produced by the primary model */
+    int64_t segments;
+
+    /** Segments re-transcribed with the escalation model */
+    int64_t escalated_segments;
+
+    /** escalated_segments / segments */
+    float escalation_rate;
+
+    /** Audio transcribed, and the part of it that was escalated, in ms */
+    double audio_ms;
+    double escalated_audio_ms;
+
+    /** Time spent in the primary and escalation models, in ms */
+    double primary_time_ms;
+    double escalation_time_ms;
+
+    /**
+     * Mean token probability (avg_token_prob) of escalated segments before and
+     * after escalation. Not the confidence reported in rac_stt_result_t, which
+     * is 1 - no_speech_prob; do not compare the two.
+     */
+    float mean_token_prob_before;
+    float mean_token_prob_after;
+} rac_stt_whispercpp_router_stats_t;
 
 // =============================================================================
 // WHISPERCPP STT API
@@ -87,9 +223,40 @@ RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_create(const char* model_path
                                                           const rac_stt_whispercpp_config_t* config,
                                                           rac_handle_t* out_handle);
 
+/**
+ * Creates a WhisperCPP STT service that escalates uncertain segments.
+ *
+ * The returned handle is used with the regular rac_stt_whispercpp_* functions.
+ *
+ * @param primary_model_path Path to the small GGML model used for every request
+ * @param escalation_model_path Path to the larger GGML model used for escalations
+ * @param config WhisperCPP configuration for both models (can be NULL for defaults)
+ * @param router_config Escalation thresholds (can be NULL for defaults)
+ * @param out_handle Output: Handle to the created service
+ * @return RAC_SUCCESS or error code
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_create_router(
+    const char* primary_model_path, const char* escalation_model_path,
+    const rac_stt_whispercpp_config_t* config,
+    const rac_stt_whispercpp_router_config_t* router_config, rac_handle_t* out_handle);
+
+/**
+ * Gets escalation statistics for a handle created with rac_stt_whispercpp_create_router.
+ *
+ * @param handle Service handle
+ * @param out_stats Output: Router statistics
+ * @return RAC_SUCCESS, or RAC_ERROR_NOT_SUPPORTED for a non-routed handle
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_get_router_stats(
+    rac_handle_t handle, rac_stt_whispercpp_router_stats_t* out_stats);
+
 /**
  * Transcribes audio data.
  *
+ * A transcription that is cancelled or misses its configured deadline is dropped:
+ * out_result is left empty and RAC_ERROR_CANCELLED or RAC_ERROR_GENERATION_TIMEOUT
+ * is returned.
+ *
  * @param handle Service handle
  * @param audio_samples Float32 PCM samples (16kHz mono)
  * @param num_samples Number of samples
@@ -103,6 +270,100 @@ RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handl
                                                               const rac_stt_options_t* options,
                                                               rac_stt_result_t* out_result);
 
+/**
+ * Opens a transcription stream.
+ *
+ * Streams on one handle share its model. A scheduler decodes up to
+ * max_concurrent_streams of them at a time, each on its own whisper state,
+ * picking the stream with the least deadline slack or the oldest audio and
+ * promoting streams it has passed over too often.
+ *
+ * Each decoded chunk is passed to callback on a scheduler thread. The final
+ * result, after input is finished, always arrives with is_final set; its text
+ * is NULL if nothing was decoded, the stream was cancelled or the decode
+ * failed. rac_stt_whispercpp_get_stream_error() tells the last two apart.
+ *
+ * Streams decode with the handle's primary model only: escalation and word
+ * timestamps are not available, since the callback carries text alone. Use
+ * rac_stt_whispercpp_transcribe() for those.
+ *
+ * @param handle Service handle
+ * @param options Language (or detect_language) and sample rate of the fed audio
+ *                (can be NULL for defaults)
+ * @param callback Receives decoded text
+ * @param user_data Passed to callback
+ * @param out_stream Output: Stream handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_create_stream(rac_handle_t handle,
+                                                                 const rac_stt_options_t* options,
+                                                                 rac_stt_stream_callback_t callback,
+                                                                 void* user_data,
+                                                                 rac_handle_t* out_stream);
+
+/**
+ * Feeds audio to a stream.
+ *
+ * @param handle Service handle
+ * @param stream Stream handle
+ * @param audio_samples Float32 PCM samples at the stream's sample rate
+ * @param num_samples Number of samples
+ * @param last_chunk RAC_TRUE to finish input with these samples
+ * @return RAC_SUCCESS or error code
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_feed_audio(rac_handle_t handle,
+                                                              rac_handle_t stream,
+                                                              const float* audio_samples,
+                                                              size_t num_samples,
+                                                              rac_bool_t last_chunk);
+
+/**
+ * Finishes a stream's input; its remaining audio is decoded as the final result.
+ *
+ * @param handle Service handle
+ * @param stream Stream handle
+ */
+RAC_WHISPERCPP_API void rac_stt_whispercpp_input_finished(rac_handle_t handle,
+                                                          rac_handle_t stream);
+
+/**
+ * Aborts a stream's in-flight decode and drops its pending audio.
+ *
+ * @param handle Service handle
+ * @param stream Stream handle
+ */
+RAC_WHISPERCPP_API void rac_stt_whispercpp_cancel_stream(rac_handle_t handle, rac_handle_t stream);
+
+/**
+ * Gets why a stream's last chunk produced no text.
+ *
+ * @param handle Service handle
+ * @param stream Stream handle
+ * @return RAC_SUCCESS, RAC_ERROR_CANCELLED or RAC_ERROR_GENERATION_TIMEOUT for a
+ *         decode cut short, or RAC_ERROR_INFERENCE_FAILED for a failed decode
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_get_stream_error(rac_handle_t handle,
+                                                                    rac_handle_t stream);
+
+/**
+ * Closes a stream. Waits for a callback in progress, so it must not be called
+ * from the stream's own callback.
+ *
+ * @param handle Service handle
+ * @param stream Stream handle to destroy
+ */
+RAC_WHISPERCPP_API void rac_stt_whispercpp_destroy_stream(rac_handle_t handle,
+                                                          rac_handle_t stream);
+
+/**
+ * Cancels all transcriptions in flight or waiting on this handle.
+ *
+ * Transcriptions started after this call are not affected.
+ *
+ * @param handle Service handle
+ */
+RAC_WHISPERCPP_API void rac_stt_whispercpp_cancel(rac_handle_t handle);
+
 /**
  * Gets detected language after transcription.
  *
@@ -113,6 +374,26 @@ RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handl
 RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_get_language(rac_handle_t handle,
                                                                 char** out_language);
 
+/**
+ * Gets decode guard counters. For a routed handle they cover both models.
+ *
+ * @param handle Service handle
+ * @param out_stats Output: Guard counters
+ * @return RAC_SUCCESS or error code
+ */
+RAC_WHISPERCPP_API rac_result_t
+rac_stt_whispercpp_get_guard_stats(rac_handle_t handle, rac_stt_whispercpp_guard_stats_t* out_stats);
+
+/**
+ * Gets stream scheduler counters; all zero before the first stream.
+ *
+ * @param handle Service handle
+ * @param out_stats Output: Scheduler counters
+ * @return RAC_SUCCESS or error code
+ */
+RAC_WHISPERCPP_API rac_result_t rac_stt_whispercpp_get_stream_stats(
+    rac_handle_t handle, rac_stt_whispercpp_stream_stats_t* out_stats);
+
 /**
  * Checks if model is loaded and ready.
  *
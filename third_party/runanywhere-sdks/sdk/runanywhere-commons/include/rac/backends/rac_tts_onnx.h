@@ -37,13 +37,33 @@ extern "C" {
 // =============================================================================
 
 typedef struct rac_tts_onnx_config {
+    /** Intra-op threads per session (0 = default of 2) */
     int32_t num_threads;
     rac_bool_t use_coreml;
     int32_t sample_rate;
+    /** Execution provider for the sherpa/ORT sessions (NULL = "cpu") */
+    const char* provider;
+    /** Verbose model loading logs from sherpa-onnx */
+    rac_bool_t debug;
+    /**
+     * Create the process OrtEnv with global thread pools sized by num_threads. The
+     * sherpa-onnx sessions behind this model cannot share them and keep their own
+     * pools, each capped at num_threads.
+     */
+    rac_bool_t use_global_thread_pool;
+    /** Skip the optimized-graph cache saved next to each model file */
+    rac_bool_t disable_model_cache;
 } rac_tts_onnx_config_t;
 
-static const rac_tts_onnx_config_t RAC_TTS_ONNX_CONFIG_DEFAULT = {
-    .num_threads = 0, .use_coreml = RAC_TRUE, .sample_rate = 22050};
+static const rac_tts_onnx_config_t RAC_TTS_ONNX_CONFIG_DEFAULT = {.num_threads = 0,
+                                                                  .use_coreml = RAC_TRUE,
+                                                                  .sample_rate = 22050,
+                                                                  .provider = NULL,
+                                                                  .debug = RAC_FALSE,
+                                                                  .use_global_thread_pool =
+                                                                      RAC_FALSE,
+                                                                  .disable_model_cache =
+                                                                      RAC_FALSE};
 
 // =============================================================================
 // ONNX TTS API
@@ -57,6 +77,15 @@ RAC_ONNX_API rac_result_t rac_tts_onnx_synthesize(rac_handle_t handle, const cha
                                                   const rac_tts_options_t* options,
                                                   rac_tts_result_t* out_result);
 
+/**
+ * Synthesizes sentence by sentence, passing each chunk of float32 PCM to the
+ * callback as soon as it is generated.
+ */
+RAC_ONNX_API rac_result_t rac_tts_onnx_synthesize_stream(rac_handle_t handle, const char* text,
+                                                         const rac_tts_options_t* options,
+                                                         rac_tts_stream_callback_t callback,
+                                                         void* user_data);
+
 RAC_ONNX_API rac_result_t rac_tts_onnx_get_voices(rac_handle_t handle, char*** out_voices,
                                                   size_t* out_count);
 
@@ -40,11 +40,28 @@ typedef struct rac_vad_onnx_config {
     int32_t sample_rate;
     float energy_threshold;
     float frame_length;
+    /** Intra-op threads per session (0 = default of 2) */
     int32_t num_threads;
+    /** Execution provider for the sherpa/ORT sessions (NULL = "cpu") */
+    const char* provider;
+    /** Verbose model loading logs from sherpa-onnx */
+    rac_bool_t debug;
+    /** Create the process OrtEnv with global thread pools sized by num_threads */
+    rac_bool_t use_global_thread_pool;
+    /** Skip the optimized-graph cache saved next to each model file */
+    rac_bool_t disable_model_cache;
 } rac_vad_onnx_config_t;
 
-static const rac_vad_onnx_config_t RAC_VAD_ONNX_CONFIG_DEFAULT = {
-    .sample_rate = 16000, .energy_threshold = 0.5f, .frame_length = 0.032f, .num_threads = 0};
+static const rac_vad_onnx_config_t RAC_VAD_ONNX_CONFIG_DEFAULT = {.sample_rate = 16000,
+                                                                  .energy_threshold = 0.5f,
+                                                                  .frame_length = 0.032f,
+                                                                  .num_threads = 0,
+                                                                  .provider = NULL,
+                                                                  .debug = RAC_FALSE,
+                                                                  .use_global_thread_pool =
+                                                                      RAC_FALSE,
+                                                                  .disable_model_cache =
+                                                                      RAC_FALSE};
 
 // =============================================================================
 // ONNX VAD API
@@ -0,0 +1,233 @@
+/**
+ * @file rac_whispercpp_decode_guard.h
+ * @brief RunAnywhere Core - WhisperCPP decode guards (C++, header-only)
+ *
+ * Limits on wasted decoding, mostly on silence and music where whisper tends to
+ * loop until the token limit or re-decode a window at every fallback temperature.
+ *
+ * Header-only and dependent on whisper.h alone, so tools that link whisper.cpp
+ * directly (the WhisperLinux CLI) run the same guards as the backend without
+ * linking commons.
+ */
+
+#ifndef RAC_WHISPERCPP_DECODE_GUARD_H
+#define RAC_WHISPERCPP_DECODE_GUARD_H
+
+#include <whisper.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace runanywhere {
+
+struct DecodeGuardConfig {
+    int repetition_ngram = 8;          // Longest looping n-gram detected (<= 0 disables)
+    int max_ngram_repeats = 4;         // Back-to-back repeats that end the decode (< 2 disables)
+    int max_fallback_steps = 2;        // Temperature fallbacks per window (< 0 = whisper's own)
+    float no_speech_threshold = 0.6f;  // Skip low-logprob segments above this (>= 1 disables)
+};
+
+struct DecodeGuardStats {
+    uint64_t windows_decoded = 0;
+    uint64_t decoder_steps = 0;
+    uint64_t repetition_stops = 0;
+    uint64_t fallback_decodes = 0;
+    uint64_t fallback_cap_hits = 0;
+    uint64_t no_speech_skips = 0;
+
+    void add(const DecodeGuardStats& other) {
+        windows_decoded += other.windows_decoded;
+        decoder_steps += other.decoder_steps;
+        repetition_stops += other.repetition_stops;
+        fallback_decodes += other.fallback_decodes;
+        fallback_cap_hits += other.fallback_cap_hits;
+        no_speech_skips += other.no_speech_skips;
+    }
+};
+
+/**
+ * Per-decode guard state, driven from whisper's encoder_begin and logits_filter
+ * callbacks. whisper may run the logits filter for several decoders in parallel,
+ * hence the atomics.
+ */
+struct DecodeGuard {
+    const DecodeGuardConfig* config = nullptr;
+    whisper_token token_eot = 0;
+    int n_vocab = 0;
+
+    std::atomic<uint64_t> windows{0};
+    std::atomic<uint64_t> decoder_steps{0};
+    std::atomic<uint64_t> repetition_stops{0};
+    std::atomic<uint64_t> fallback_decodes{0};
+    std::atomic<uint64_t> fallback_cap_hits{0};
+    std::atomic<int> window_passes{0};
+
+    /**
+     * Points wparams' callbacks at this guard and applies the fallback and
+     * no-speech limits to it. The guard must outlive the decode.
+     */
+    void attach(whisper_context* ctx, const DecodeGuardConfig& guard_config,
+                whisper_full_params& wparams) {
+        config = &guard_config;
+        token_eot = whisper_token_eot(ctx);
+        n_vocab = whisper_n_vocab(ctx);
+
+        // Fewer, larger temperature steps between the base temperature and 1.0
+        if (config->max_fallback_steps == 0) {
+            wparams.temperature_inc = 0.0f;
+        } else if (config->max_fallback_steps > 0) {
+            const float inc = (1.0f - wparams.temperature) / config->max_fallback_steps;
+            wparams.temperature_inc = std::max(wparams.temperature_inc, inc);
+        }
+
+        // Lets whisper skip fallback re-decodes on windows it already considers silent
+        if (config->no_speech_threshold < 1.0f) {
+            wparams.no_speech_thold = config->no_speech_threshold;
+        }
+
+        wparams.encoder_begin_callback = encoder_begin_callback;
+        wparams.encoder_begin_callback_user_data = this;
+        wparams.logits_filter_callback = logits_filter_callback;
+        wparams.logits_filter_callback_user_data = this;
+    }
+
+    void begin_window() {
+        if (windows.fetch_add(1) > 0) {
+            end_window();
+        }
+    }
+
+    /**
+     * Closes the current window's pass count; call once more after whisper_full returns
+     */
+    void end_window() {
+        const int passes = window_passes.exchange(0);
+        if (passes <= 1) {
+            return;
+        }
+
+        const int fallbacks = passes - 1;
+        fallback_decodes.fetch_add(static_cast<uint64_t>(fallbacks));
+        if (config->max_fallback_steps > 0 && fallbacks >= config->max_fallback_steps) {
+            fallback_cap_hits.fetch_add(1);
+        }
+    }
+
+    void filter_logits(const whisper_token_data* tokens, int n_tokens, float* logits) {
+        decoder_steps.fetch_add(1);
+
+        // whisper filters the first step of a pass once, on decoder 0, and copies
+        // the result to the other decoders, so empty sequences count passes
+        if (n_tokens == 0) {
+            window_passes.fetch_add(1);
+            return;
+        }
+
+        const int max_period = config->repetition_ngram;
+        const int repeats = config->max_ngram_repeats;
+        if (max_period <= 0 || repeats < 2) {
+            return;
+        }
+
+        // Text tokens only (timestamps and specials sort after EOT), oldest first
+        thread_local std::vector<whisper_token> text;
+        text.clear();
+        const size_t max_span = static_cast<size_t>(max_period) * static_cast<size_t>(repeats);
+        for (int i = n_tokens - 1; i >= 0 && text.size() < max_span; --i) {
+            if (tokens[i].id < token_eot) {
+                text.push_back(tokens[i].id);
+            }
+        }
+        std::reverse(text.begin(), text.end());
+
+        const int n = static_cast<int>(text.size());
+        for (int period = 1; period <= max_period && period * repeats <= n; ++period) {
+            bool looping = true;
+            for (int i = n - period * repeats; i < n - period; ++i) {
+                if (text[i] != text[i + period]) {
+                    looping = false;
+                    break;
+                }
+            }
+
+            if (looping) {
+                // Force end-of-text so this pass stops instead of running to the token limit
+                for (int t = 0; t < n_vocab; ++t) {
+                    if (t != token_eot) {
+                        logits[t] = -INFINITY;
+                    }
+                }
+                repetition_stops.fetch_add(1);
+                return;
+            }
+        }
+    }
+
+    DecodeGuardStats snapshot() const {
+        DecodeGuardStats stats;
+        stats.windows_decoded = windows.load();
+        stats.decoder_steps = decoder_steps.load();
+        stats.repetition_stops = repetition_stops.load();
+        stats.fallback_decodes = fallback_decodes.load();
+        stats.fallback_cap_hits = fallback_cap_hits.load();
+        return stats;
+    }
+
+   private:
+    static bool encoder_begin_callback(whisper_context* ctx, whisper_state* state,
+                                       void* user_data) {
+        (void)ctx;
+        (void)state;
+        static_cast<DecodeGuard*>(user_data)->begin_window();
+        return true;
+    }
+
+    static void logits_filter_callback(whisper_context* ctx, whisper_state* state,
+                                       const whisper_token_data* tokens, int n_tokens,
+                                       float* logits, void* user_data) {
+        (void)ctx;
+        (void)state;
+        static_cast<DecodeGuard*>(user_data)->filter_logits(tokens, n_tokens, logits);
+    }
+};
+
+/**
+ * Whether a decoded segment is silence, by the same rule as OpenAI's reference
+ * decoder: a high no-speech probability and unlikely text. Reads the context's
+ * default state when state is null.
+ */
+inline bool is_no_speech_segment(const DecodeGuardConfig& config, whisper_context* ctx,
+                                 whisper_state* state, int segment) {
+    if (config.no_speech_threshold >= 1.0f) {
+        return false;
+    }
+
+    const float no_speech_prob =
+        state ? whisper_full_get_segment_no_speech_prob_from_state(state, segment)
+              : whisper_full_get_segment_no_speech_prob(ctx, segment);
+    if (no_speech_prob <= config.no_speech_threshold) {
+        return false;
+    }
+
+    const int n_tokens = state ? whisper_full_n_tokens_from_state(state, segment)
+                               : whisper_full_n_tokens(ctx, segment);
+    if (n_tokens == 0) {
+        return true;
+    }
+
+    double sum_logprob = 0.0;
+    for (int j = 0; j < n_tokens; ++j) {
+        const whisper_token_data data =
+            state ? whisper_full_get_token_data_from_state(state, segment, j)
+                  : whisper_full_get_token_data(ctx, segment, j);
+        sum_logprob += data.plog;
+    }
+    return sum_logprob / n_tokens < -1.0;
+}
+
+}  // namespace runanywhere
+
+#endif  // RAC_WHISPERCPP_DECODE_GUARD_H
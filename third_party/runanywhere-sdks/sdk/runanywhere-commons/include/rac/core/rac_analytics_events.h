@@ -263,6 +263,10 @@ typedef struct rac_analytics_tts_synthesis {
     double processing_duration_ms;
     /** Characters processed per second */
     double characters_per_second;
+    /** Time until the first audio chunk was delivered (streaming synthesis, 0 otherwise) */
+    double time_to_first_audio_ms;
+    /** Whether the audio was served from the synthesized-audio cache */
+    rac_bool_t is_cache_hit;
     /** Sample rate */
     int32_t sample_rate;
     /** Inference framework */
@@ -561,6 +565,8 @@ static const rac_analytics_tts_synthesis_t RAC_ANALYTICS_TTS_SYNTHESIS_DEFAULT =
     .audio_size_bytes = 0,
     .processing_duration_ms = 0.0,
     .characters_per_second = 0.0,
+    .time_to_first_audio_ms = 0.0,
+    .is_cache_hit = RAC_FALSE,
     .sample_rate = 0,
     .framework = RAC_FRAMEWORK_UNKNOWN,
     .error_code = RAC_SUCCESS,
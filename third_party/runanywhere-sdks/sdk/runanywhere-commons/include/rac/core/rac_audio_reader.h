@@ -0,0 +1,146 @@
+/**
+ * @file rac_audio_reader.h
+ * @brief RunAnywhere Commons - Streaming Audio File Reader
+ *
+ * Reads an audio file as fixed-size blocks of mono Float32 samples,
+ * optionally resampled, so a recording of any length can be processed with
+ * a few hundred kilobytes of buffers. The container is detected from the
+ * file contents.
+ *
+ * WAV files are memory-mapped, and pages behind the read position are
+ * released as the reader advances; files that cannot be mapped are read
+ * with buffered I/O instead. Supported WAV encodings: PCM 8/16/24/32-bit
+ * and IEEE float 32/64-bit, in WAVE_FORMAT_PCM, WAVE_FORMAT_IEEE_FLOAT or
+ * WAVE_FORMAT_EXTENSIBLE files. A data chunk size of zero (a header that was
+ * never finalized) is read to the end of the file.
+ *
+ * FLAC, MP3 and Ogg Opus are decoded incrementally, one block at a time,
+ * when commons is built with RAC_BUILD_AUDIO_DECODERS (Opus additionally
+ * needs RAC_AUDIO_DECODER_OPUS). Check rac_audio_reader_supports_format.
+ *
+ * Any channel count is accepted; channels are averaged to mono.
+ */
+
+#ifndef RAC_AUDIO_READER_H
+#define RAC_AUDIO_READER_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+#include "rac/features/stt/rac_stt_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Reader configuration
+ */
+typedef struct rac_audio_reader_config {
+    /** Output sample rate; the file is resampled if it differs (0 = file's rate) */
+    int32_t target_sample_rate;
+
+    /** Samples per block returned by rac_audio_reader_read (0 = 4096) */
+    size_t block_size;
+
+    /** Read WAV files with buffered I/O even when they can be memory-mapped */
+    rac_bool_t disable_mmap;
+} rac_audio_reader_config_t;
+
+/**
+ * @brief Default reader configuration
+ */
+static const rac_audio_reader_config_t RAC_AUDIO_READER_CONFIG_DEFAULT = {
+    .target_sample_rate = 0, .block_size = 4096, .disable_mmap = RAC_FALSE};
+
+/**
+ * @brief Format of an opened file, as stored
+ */
+typedef struct rac_audio_file_info {
+    /** Container: RAC_AUDIO_FORMAT_WAV, _FLAC, _MP3 or _OPUS */
+    rac_audio_format_enum_t format;
+
+    /** Sample rate of the file in Hz (decoder output rate for MP3 and Opus) */
+    int32_t sample_rate;
+
+    /** Interleaved channels in the file */
+    int32_t channels;
+
+    /** Stored bits per sample (0 for MP3 and Opus) */
+    int32_t bits_per_sample;
+
+    /** RAC_TRUE for IEEE float WAV samples */
+    rac_bool_t is_float;
+
+    /** Frames (samples per channel) in the file (0 = unknown until decoded) */
+    uint64_t frame_count;
+
+    /** RAC_TRUE if the file is memory-mapped */
+    rac_bool_t is_mapped;
+} rac_audio_file_info_t;
+
+// =============================================================================
+// READER API
+// =============================================================================
+
+/**
+ * @brief Check whether this build can read a container
+ *
+ * @param format RAC_AUDIO_FORMAT_WAV, _FLAC, _MP3 or _OPUS
+ * @return RAC_TRUE if rac_audio_reader_open accepts files of this format
+ */
+RAC_API rac_bool_t rac_audio_reader_supports_format(rac_audio_format_enum_t format);
+
+/**
+ * @brief Open an audio file for streaming reads
+ *
+ * @param path File path
+ * @param config Configuration (can be NULL for defaults)
+ * @param out_reader Output: Reader handle
+ * @return RAC_SUCCESS, RAC_ERROR_FILE_NOT_FOUND, RAC_ERROR_INVALID_FORMAT for
+ *         an unrecognized or malformed file, or RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED
+ *         for an encoding this build cannot decode
+ */
+RAC_API rac_result_t rac_audio_reader_open(const char* path,
+                                           const rac_audio_reader_config_t* config,
+                                           rac_handle_t* out_reader);
+
+/**
+ * @brief Get the stored format of the file
+ *
+ * @param reader Reader handle
+ * @param out_info Output: File format
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_audio_reader_get_info(rac_handle_t reader,
+                                               rac_audio_file_info_t* out_info);
+
+/**
+ * @brief Read the next block of mono Float32 samples
+ *
+ * Every block holds block_size samples except the last one, which may be
+ * shorter. At the end of the file *out_count is 0.
+ *
+ * @param reader Reader handle
+ * @param out_samples Output: Samples, owned by the reader and valid until the next call
+ * @param out_count Output: Number of samples
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_READ_FAILED
+ */
+RAC_API rac_result_t rac_audio_reader_read(rac_handle_t reader, const float** out_samples,
+                                           size_t* out_count);
+
+/**
+ * @brief Close the reader and release the file
+ *
+ * @param reader Reader handle
+ */
+RAC_API void rac_audio_reader_close(rac_handle_t reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_AUDIO_READER_H */
@@ -74,6 +74,98 @@ RAC_API rac_result_t rac_audio_int16_to_wav(const void* pcm_data, size_t pcm_siz
                                             int32_t sample_rate, void** out_wav_data,
                                             size_t* out_wav_size);
 
+/**
+ * @brief Convert Float32 PCM samples to Int16 PCM samples
+ *
+ * Samples are clamped to [-1.0, 1.0] and scaled by 32767, matching the
+ * conversion used for WAV output.
+ *
+ * @param samples Input Float32 samples
+ * @param sample_count Number of samples
+ * @param out_samples Output Int16 samples (may alias samples for in-place conversion)
+ */
+RAC_API void rac_audio_float32_to_int16(const float* samples, size_t sample_count,
+                                        int16_t* out_samples);
+
+// =============================================================================
+// SAMPLE KERNELS
+// =============================================================================
+//
+// Vectorized (SSE2/AVX2/NEON) with a scalar fallback; the implementation is
+// chosen once, at first use, from what the CPU supports.
+
+/**
+ * @brief Convert Int16 PCM samples to Float32 in [-1.0, 1.0)
+ *
+ * Samples are scaled by 1/32768.
+ *
+ * @param samples Input Int16 samples
+ * @param sample_count Number of samples
+ * @param out_samples Output Float32 samples (must not alias samples)
+ */
+RAC_API void rac_audio_int16_to_float32(const int16_t* samples, size_t sample_count,
+                                        float* out_samples);
+
+/**
+ * @brief Convert Float32 PCM samples to Int16 with TPDF dither
+ *
+ * Like rac_audio_float32_to_int16, but adds triangular dither of +/-1 LSB
+ * and rounds to nearest, which turns the truncation distortion of quiet
+ * signals into a low, signal-independent noise floor. Use it for audio a
+ * person will listen to; STT input does not need it.
+ *
+ * The noise is a function of dither_state and the sample position, so
+ * passing the same state variable across calls continues one sequence and
+ * results are reproducible.
+ *
+ * @param samples Input Float32 samples
+ * @param sample_count Number of samples
+ * @param out_samples Output Int16 samples (may alias samples for in-place conversion)
+ * @param dither_state In/out: dither sequence position, any initial value (NULL = 0)
+ */
+RAC_API void rac_audio_float32_to_int16_dithered(const float* samples, size_t sample_count,
+                                                 int16_t* out_samples, uint32_t* dither_state);
+
+/**
+ * @brief Downmix interleaved stereo Float32 to mono by averaging channels
+ *
+ * @param samples Interleaved L/R samples (2 * frame_count values)
+ * @param frame_count Number of stereo frames
+ * @param out_samples Output mono samples (may alias samples)
+ */
+RAC_API void rac_audio_stereo_to_mono_float32(const float* samples, size_t frame_count,
+                                              float* out_samples);
+
+/**
+ * @brief Downmix interleaved stereo Int16 to mono by averaging channels
+ *
+ * The average rounds toward negative infinity.
+ *
+ * @param samples Interleaved L/R samples (2 * frame_count values)
+ * @param frame_count Number of stereo frames
+ * @param out_samples Output mono samples (may alias samples)
+ */
+RAC_API void rac_audio_stereo_to_mono_int16(const int16_t* samples, size_t frame_count,
+                                            int16_t* out_samples);
+
+/**
+ * @brief Multiply Float32 samples by a gain, in place
+ *
+ * No clipping is applied; the Int16 conversions clamp.
+ *
+ * @param samples Samples to scale
+ * @param sample_count Number of samples
+ * @param gain Linear gain factor
+ */
+RAC_API void rac_audio_apply_gain(float* samples, size_t sample_count, float gain);
+
+/**
+ * @brief Name of the sample kernel implementation in use
+ *
+ * @return "avx2", "sse2", "neon" or "scalar"
+ */
+RAC_API const char* rac_audio_simd_backend(void);
+
 /**
  * @brief Get WAV header size in bytes
  *
@@ -81,6 +173,165 @@ RAC_API rac_result_t rac_audio_int16_to_wav(const void* pcm_data, size_t pcm_siz
  */
 RAC_API size_t rac_audio_wav_header_size(void);
 
+// =============================================================================
+// AUDIO RING BUFFER API
+// =============================================================================
+//
+// A single-writer, multi-reader ring of Float32 samples, so that VAD,
+// streaming STT, recorders and level meters can share one copy of a capture
+// stream. Each reader keeps its own cursor. The writer never blocks and
+// never waits for readers: a reader that falls more than `capacity` samples
+// behind loses the oldest audio and is told how much it lost. No locks are
+// taken on the write or read paths.
+//
+// Reads are zero-copy: a view points straight into the ring and is always
+// contiguous, even across the wrap point. Because the writer does not wait,
+// it may overwrite a view while the reader is still using it; consuming the
+// view reports that as RAC_ERROR_AUDIO_BUFFER_OVERRUN.
+//
+// The writer must be a single thread, and each reader must be used from one
+// thread at a time.
+
+/**
+ * @brief Ring buffer configuration
+ */
+typedef struct rac_audio_ring_buffer_config {
+    /** Samples retained for readers (rounded up to a power of two) */
+    size_t capacity;
+
+    /** Longest view a reader can take in one peek (clamped to capacity) */
+    size_t max_read_size;
+
+    /** Maximum number of readers attached at the same time */
+    int32_t max_readers;
+} rac_audio_ring_buffer_config_t;
+
+/**
+ * @brief Default ring buffer configuration: ~32s at 16kHz, 1s views, 8 readers
+ */
+static const rac_audio_ring_buffer_config_t RAC_AUDIO_RING_BUFFER_CONFIG_DEFAULT = {
+    .capacity = 524288, .max_read_size = 16000, .max_readers = 8};
+
+/**
+ * @brief Contiguous run of samples available to a reader
+ */
+typedef struct rac_audio_ring_view {
+    /** Samples, pointing into the ring; valid until the writer laps them */
+    const float* samples;
+
+    /** Number of samples in the view */
+    size_t count;
+
+    /** Stream position of samples[0] (samples written before it) */
+    uint64_t position;
+
+    /** Samples the reader lost since its previous peek because it fell behind */
+    uint64_t dropped;
+} rac_audio_ring_view_t;
+
+/**
+ * @brief Create a ring buffer
+ *
+ * @param config Configuration (can be NULL for defaults)
+ * @param out_handle Output: Ring buffer handle
+ * @return RAC_SUCCESS, RAC_ERROR_INVALID_ARGUMENT or RAC_ERROR_OUT_OF_MEMORY
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_create(const rac_audio_ring_buffer_config_t* config,
+                                                  rac_handle_t* out_handle);
+
+/**
+ * @brief Destroy a ring buffer
+ *
+ * The writer and all readers must have stopped using it.
+ *
+ * @param handle Ring buffer handle
+ */
+RAC_API void rac_audio_ring_buffer_destroy(rac_handle_t handle);
+
+/**
+ * @brief Append samples (writer thread only)
+ *
+ * Never blocks. If more than capacity samples are written at once, only the
+ * last capacity samples are kept.
+ *
+ * @param handle Ring buffer handle
+ * @param samples Samples to append
+ * @param sample_count Number of samples
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_write(rac_handle_t handle, const float* samples,
+                                                 size_t sample_count);
+
+/**
+ * @brief Total number of samples written since the buffer was created
+ *
+ * @param handle Ring buffer handle
+ * @return Stream position of the next sample to be written
+ */
+RAC_API uint64_t rac_audio_ring_buffer_write_position(rac_handle_t handle);
+
+/**
+ * @brief Attach a reader, starting at the current write position
+ *
+ * @param handle Ring buffer handle
+ * @param out_reader Output: Reader index
+ * @return RAC_SUCCESS or RAC_ERROR_SERVICE_BUSY if max_readers are attached
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_add_reader(rac_handle_t handle, int32_t* out_reader);
+
+/**
+ * @brief Detach a reader; its index may be handed out again
+ *
+ * @param handle Ring buffer handle
+ * @param reader Reader index
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_remove_reader(rac_handle_t handle, int32_t reader);
+
+/**
+ * @brief Number of samples a reader has not consumed yet
+ *
+ * May exceed capacity when the reader has fallen behind; the excess is
+ * reported as dropped by the next peek.
+ *
+ * @param handle Ring buffer handle
+ * @param reader Reader index
+ * @return Unread samples (0 for an invalid reader)
+ */
+RAC_API uint64_t rac_audio_ring_buffer_available(rac_handle_t handle, int32_t reader);
+
+/**
+ * @brief Get a view of a reader's unread samples without consuming them
+ *
+ * The view holds at most min(max_count, max_read_size) samples and may be
+ * empty. If the reader fell behind, it is first moved to the oldest sample
+ * still in the ring and the skipped amount is returned in dropped.
+ *
+ * @param handle Ring buffer handle
+ * @param reader Reader index
+ * @param max_count Maximum samples to return
+ * @param out_view Output: View of the samples
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_peek(rac_handle_t handle, int32_t reader,
+                                                size_t max_count, rac_audio_ring_view_t* out_view);
+
+/**
+ * @brief Advance a reader past samples it has finished with
+ *
+ * Call once the samples of the last view are no longer needed. The cursor
+ * advances either way, but RAC_ERROR_AUDIO_BUFFER_OVERRUN means the writer
+ * overwrote some of them while they were in use, and whatever was computed
+ * from the view should be discarded.
+ *
+ * @param handle Ring buffer handle
+ * @param reader Reader index
+ * @param sample_count Samples to consume (clamped to what has been written)
+ * @return RAC_SUCCESS, RAC_ERROR_AUDIO_BUFFER_OVERRUN or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_audio_ring_buffer_consume(rac_handle_t handle, int32_t reader,
+                                                   size_t sample_count);
+
 #ifdef __cplusplus
 }
 #endif
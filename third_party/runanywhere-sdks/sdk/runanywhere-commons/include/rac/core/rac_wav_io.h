@@ -0,0 +1,77 @@
+/**
+ * @file rac_wav_io.h
+ * @brief RunAnywhere Commons - Streaming WAV Writer
+ *
+ * Streams Int16 PCM to disk and fills in the RIFF and data chunk sizes when
+ * the writer is closed. Until then both sizes are zero, which
+ * rac_audio_reader treats as "data runs to the end of the file", so a
+ * recording cut short by a crash is still readable.
+ *
+ * For reading WAV files see rac_audio_reader.h.
+ */
+
+#ifndef RAC_WAV_IO_H
+#define RAC_WAV_IO_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// WRITER API
+// =============================================================================
+
+/**
+ * @brief Create a WAV file for streaming Int16 PCM writes
+ *
+ * An existing file at path is replaced.
+ *
+ * @param path File path
+ * @param sample_rate Sample rate in Hz
+ * @param channels Interleaved channels per frame
+ * @param out_writer Output: Writer handle
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_wav_writer_open(const char* path, int32_t sample_rate, int32_t channels,
+                                         rac_handle_t* out_writer);
+
+/**
+ * @brief Append Int16 samples
+ *
+ * @param writer Writer handle
+ * @param samples Interleaved samples
+ * @param sample_count Number of samples (a multiple of the channel count)
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_WRITE_FAILED (also once the 4 GB WAV limit is hit)
+ */
+RAC_API rac_result_t rac_wav_writer_write_int16(rac_handle_t writer, const int16_t* samples,
+                                                size_t sample_count);
+
+/**
+ * @brief Append Float32 samples, converted with rac_audio_float32_to_int16
+ *
+ * @param writer Writer handle
+ * @param samples Interleaved samples in [-1.0, 1.0]
+ * @param sample_count Number of samples (a multiple of the channel count)
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_wav_writer_write_float32(rac_handle_t writer, const float* samples,
+                                                  size_t sample_count);
+
+/**
+ * @brief Write the final chunk sizes into the header and close the file
+ *
+ * The handle is released even if finalizing fails.
+ *
+ * @param writer Writer handle
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_wav_writer_close(rac_handle_t writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_WAV_IO_H */
@@ -105,6 +105,28 @@ RAC_API rac_result_t rac_stt_component_transcribe(rac_handle_t handle, const voi
                                                   const rac_stt_options_t* options,
                                                   rac_stt_result_t* out_result);
 
+/**
+ * @brief Transcribe an audio file (batch mode)
+ *
+ * The file is streamed through rac_audio_reader (decoded block by block,
+ * mixed to mono and resampled to options->sample_rate, or 16kHz without
+ * options) and transcribed in windows of up to 30 seconds, each cut at the
+ * quietest point of its last 3 seconds, so memory use does not grow with the
+ * length of the recording. Decoding runs on a separate thread, overlapped
+ * with inference. Each window is a separate rac_stt_component_transcribe
+ * call. Window texts are joined with spaces and word timestamps are offset
+ * to file time.
+ *
+ * @param handle Component handle
+ * @param file_path Path to an audio file (see rac_audio_reader.h for supported formats)
+ * @param options Transcription options (can be NULL for defaults)
+ * @param out_result Output: Transcription result
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_stt_component_transcribe_file(rac_handle_t handle, const char* file_path,
+                                                       const rac_stt_options_t* options,
+                                                       rac_stt_result_t* out_result);
+
 /**
  * @brief Check if streaming is supported
  *
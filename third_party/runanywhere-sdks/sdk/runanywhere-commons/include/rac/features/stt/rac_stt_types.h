@@ -143,7 +143,7 @@ typedef struct rac_stt_options {
     /** Maximum number of speakers (0 = auto) */
     int32_t max_speakers;
 
-    /** Enable word-level timestamps */
+    /** Enable segment-level timestamps */
     rac_bool_t enable_timestamps;
 
     /** Audio format of input data */
@@ -151,6 +151,9 @@ typedef struct rac_stt_options {
 
     /** Sample rate of input audio (default: 16000 Hz) */
     int32_t sample_rate;
+
+    /** Enable word-level timestamps, which cost extra decode work on some backends */
+    rac_bool_t enable_word_timestamps;
 } rac_stt_options_t;
 
 /**
@@ -163,7 +166,8 @@ static const rac_stt_options_t RAC_STT_OPTIONS_DEFAULT = {.language = "en",
                                                           .max_speakers = 0,
                                                           .enable_timestamps = RAC_TRUE,
                                                           .audio_format = RAC_AUDIO_FORMAT_PCM,
-                                                          .sample_rate = 16000};
+                                                          .sample_rate = 16000,
+                                                          .enable_word_timestamps = RAC_FALSE};
 
 // =============================================================================
 // RESULT - Mirrors Swift's STTTranscriptionResult
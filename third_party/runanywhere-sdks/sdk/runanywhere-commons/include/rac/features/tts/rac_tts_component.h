@@ -22,6 +22,66 @@ extern "C" {
 
 // NOTE: rac_tts_config_t is defined in rac_tts_types.h (included above)
 
+// =============================================================================
+// AUDIO CACHE TYPES
+// =============================================================================
+
+/**
+ * @brief Synthesized-audio cache configuration
+ *
+ * Repeated prompts are served from an LRU cache keyed by voice, every option
+ * that changes the audio and whitespace-normalized text. Persisted entries are
+ * held to the same byte budget, least recently used files deleted first.
+ */
+typedef struct rac_tts_cache_config {
+    /** Audio byte budget of the in-memory cache (0 = caching disabled) */
+    int64_t max_bytes;
+
+    /** Largest single phrase to cache in bytes (0 = max_bytes / 8) */
+    int64_t max_entry_bytes;
+
+    /** Directory to persist entries in through the platform adapter (NULL = memory only) */
+    const char* persist_directory;
+} rac_tts_cache_config_t;
+
+/**
+ * @brief Default cache configuration (disabled)
+ */
+static const rac_tts_cache_config_t RAC_TTS_CACHE_CONFIG_DEFAULT = {
+    .max_bytes = 0, .max_entry_bytes = 0, .persist_directory = RAC_NULL};
+
+/**
+ * @brief Synthesized-audio cache counters
+ */
+typedef struct rac_tts_cache_stats {
+    /** Syntheses served from the cache (memory or disk) */
+    int64_t hits;
+
+    /** Syntheses that went to the TTS service */
+    int64_t misses;
+
+    /** Hits that had to be loaded from the persist directory */
+    int64_t disk_hits;
+
+    /** Entries dropped to stay within the byte budget */
+    int64_t evictions;
+
+    /** Entries currently held in memory */
+    int32_t entry_count;
+
+    /** Audio bytes currently held in memory */
+    int64_t bytes;
+
+    /** Persisted files deleted to stay within the byte budget */
+    int64_t disk_evictions;
+
+    /** Entries currently persisted */
+    int32_t disk_entry_count;
+
+    /** Bytes currently persisted */
+    int64_t disk_bytes;
+} rac_tts_cache_stats_t;
+
 // =============================================================================
 // TTS COMPONENT API - Mirrors Swift's TTSCapability
 // =============================================================================
@@ -60,6 +120,19 @@ RAC_API rac_bool_t rac_tts_component_is_loaded(rac_handle_t handle);
  */
 RAC_API const char* rac_tts_component_get_voice_id(rac_handle_t handle);
 
+/**
+ * @brief Get the options synthesis uses when none are passed
+ *
+ * Lets callers override a few fields (e.g. sample_format) while keeping the
+ * configured voice, rate, pitch and volume.
+ *
+ * @param handle Component handle
+ * @param out_options Output: Configured default options
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_tts_component_get_default_options(rac_handle_t handle,
+                                                           rac_tts_options_t* out_options);
+
 /**
  * @brief Load a voice
  *
@@ -144,6 +217,43 @@ RAC_API rac_lifecycle_state_t rac_tts_component_get_state(rac_handle_t handle);
 RAC_API rac_result_t rac_tts_component_get_metrics(rac_handle_t handle,
                                                    rac_lifecycle_metrics_t* out_metrics);
 
+/**
+ * @brief Configure the synthesized-audio cache
+ *
+ * Shrinking the budget evicts least recently used entries; a zero budget
+ * disables the cache and drops everything in memory. Only non-streaming
+ * synthesis is cached.
+ *
+ * @param handle Component handle
+ * @param config Cache configuration
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_tts_component_configure_cache(rac_handle_t handle,
+                                                       const rac_tts_cache_config_t* config);
+
+/**
+ * @brief Get synthesized-audio cache counters
+ *
+ * Cache counters are kept apart from rac_tts_component_get_metrics, whose
+ * lifecycle metrics struct is shared by every component.
+ *
+ * @param handle Component handle
+ * @param out_stats Output: Cache counters
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_tts_component_get_cache_stats(rac_handle_t handle,
+                                                       rac_tts_cache_stats_t* out_stats);
+
+/**
+ * @brief Drop all in-memory cache entries
+ *
+ * Persisted files are kept and will be reloaded on demand.
+ *
+ * @param handle Component handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_tts_component_clear_cache(rac_handle_t handle);
+
 /**
  * @brief Destroy the TTS component
  *
@@ -43,6 +43,30 @@ extern "C" {
 // Streaming Constants
 #define RAC_TTS_DEFAULT_STREAMING_CHUNK_BYTES 4096
 
+// =============================================================================
+// RAW PCM OUTPUT
+// =============================================================================
+
+/**
+ * @brief Sample encoding of raw PCM audio returned by TTS
+ *
+ * Applies when audio is delivered as RAC_AUDIO_FORMAT_PCM. Consumers feeding a
+ * sound device directly can ask for the device's native encoding instead of
+ * converting or wrapping the audio in a WAV container.
+ */
+typedef enum rac_tts_sample_format {
+    RAC_TTS_SAMPLE_FORMAT_FLOAT32 = 0, /**< 32-bit float, range [-1.0, 1.0] (default) */
+    RAC_TTS_SAMPLE_FORMAT_INT16 = 1    /**< 16-bit signed integer */
+} rac_tts_sample_format_t;
+
+/**
+ * @brief Releases a borrowed TTS audio buffer
+ *
+ * @param audio_data The result's audio_data
+ * @param context The result's release_context
+ */
+typedef void (*rac_tts_audio_release_fn)(void* audio_data, void* context);
+
 // =============================================================================
 // CONFIGURATION - Mirrors Swift's TTSConfiguration
 // =============================================================================
@@ -133,6 +157,16 @@ typedef struct rac_tts_options {
 
     /** Whether to use SSML markup */
     rac_bool_t use_ssml;
+
+    /** Sample encoding of raw PCM output */
+    rac_tts_sample_format_t sample_format;
+
+    /**
+     * Let the result borrow the backend's buffer instead of a malloc'd copy.
+     * A borrowed result carries a release callback and must be freed with
+     * rac_tts_result_free, never with rac_free.
+     */
+    rac_bool_t borrow_audio;
 } rac_tts_options_t;
 
 /**
@@ -146,7 +180,10 @@ static const rac_tts_options_t RAC_TTS_OPTIONS_DEFAULT = {.voice = RAC_NULL,
                                                           .audio_format = RAC_AUDIO_FORMAT_PCM,
                                                           .sample_rate =
                                                               RAC_TTS_DEFAULT_SAMPLE_RATE,
-                                                          .use_ssml = RAC_FALSE};
+                                                          .use_ssml = RAC_FALSE,
+                                                          .sample_format =
+                                                              RAC_TTS_SAMPLE_FORMAT_FLOAT32,
+                                                          .borrow_audio = RAC_FALSE};
 
 // =============================================================================
 // INPUT - Mirrors Swift's TTSInput
@@ -192,7 +229,7 @@ static const rac_tts_input_t RAC_TTS_INPUT_DEFAULT = {.text = RAC_NULL,
  * @brief TTS synthesis result
  */
 typedef struct rac_tts_result {
-    /** Audio data (owned, must be freed with rac_free) */
+    /** Audio data (free with rac_tts_result_free; rac_free only if release_audio is NULL) */
     void* audio_data;
 
     /** Size of audio data in bytes */
@@ -209,6 +246,15 @@ typedef struct rac_tts_result {
 
     /** Processing time in milliseconds */
     int64_t processing_time_ms;
+
+    /** Sample encoding when audio_format is RAC_AUDIO_FORMAT_PCM */
+    rac_tts_sample_format_t sample_format;
+
+    /** Set when audio_data is borrowed from the backend; called by rac_tts_result_free */
+    rac_tts_audio_release_fn release_audio;
+
+    /** Context passed to release_audio */
+    void* release_context;
 } rac_tts_result_t;
 
 // =============================================================================
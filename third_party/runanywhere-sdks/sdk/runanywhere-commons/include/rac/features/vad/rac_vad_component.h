@@ -71,6 +71,9 @@ RAC_API rac_result_t rac_vad_component_cleanup(rac_handle_t handle);
 /**
  * @brief Set speech activity callback
  *
+ * Invoked on the VAD engine's dispatcher thread, not the thread calling
+ * rac_vad_component_process.
+ *
  * @param handle Component handle
  * @param callback Activity callback
  * @param user_data User context passed to callback
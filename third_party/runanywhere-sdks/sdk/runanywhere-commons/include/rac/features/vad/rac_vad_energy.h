@@ -88,6 +88,12 @@ typedef struct rac_energy_vad_config {
 
     /** Energy threshold for voice detection (default: 0.005) */
     float energy_threshold;
+
+    /**
+     * Keep the threshold fixed after calibration instead of following the
+     * room's noise floor (default: RAC_FALSE)
+     */
+    rac_bool_t disable_noise_tracking;
 } rac_energy_vad_config_t;
 
 /**
@@ -96,7 +102,8 @@ typedef struct rac_energy_vad_config {
 static const rac_energy_vad_config_t RAC_ENERGY_VAD_CONFIG_DEFAULT = {
     .sample_rate = RAC_VAD_DEFAULT_SAMPLE_RATE,
     .frame_length = RAC_VAD_DEFAULT_FRAME_LENGTH,
-    .energy_threshold = RAC_VAD_DEFAULT_ENERGY_THRESHOLD};
+    .energy_threshold = RAC_VAD_DEFAULT_ENERGY_THRESHOLD,
+    .disable_noise_tracking = RAC_FALSE};
 
 /**
  * @brief Energy VAD statistics for debugging.
@@ -120,6 +127,46 @@ typedef struct rac_energy_vad_stats {
     float recent_max;
 } rac_energy_vad_stats_t;
 
+/**
+ * @brief Speech start or end found by rac_energy_vad_process_frames().
+ */
+typedef struct rac_energy_vad_boundary {
+    /** Whether speech started or ended */
+    rac_speech_activity_event_t event;
+
+    /**
+     * Offset, in samples from the start of the buffer passed in, of the frame
+     * that completed the hysteresis (the start/end thresholds are counted in
+     * frames, so the transition is decided on the last of those frames)
+     */
+    size_t sample_offset;
+} rac_energy_vad_boundary_t;
+
+/**
+ * @brief Output arrays for rac_energy_vad_process_frames().
+ *
+ * The arrays are owned by the caller. Either may be NULL with a capacity of
+ * 0 when the caller does not need it.
+ */
+typedef struct rac_energy_vad_frame_output {
+    /** Per-frame voice decisions, one per processed frame */
+    rac_bool_t* frame_decisions;
+    size_t frame_capacity;
+
+    /** Speech start/end transitions in the processed frames */
+    rac_energy_vad_boundary_t* boundaries;
+    size_t boundary_capacity;
+
+    /** Output: Number of frames processed */
+    size_t frame_count;
+
+    /** Output: Number of entries written to boundaries */
+    size_t boundary_count;
+
+    /** Output: Samples consumed (frame_count * frame length) */
+    size_t samples_consumed;
+} rac_energy_vad_frame_output_t;
+
 /**
  * @brief Callback for speech activity events.
  * Mirrors Swift's onSpeechActivity callback.
@@ -234,6 +281,32 @@ RAC_API rac_result_t rac_energy_vad_process_audio(rac_energy_vad_handle_t handle
  */
 RAC_API float rac_energy_vad_calculate_rms(const float* audio_data, size_t sample_count);
 
+/**
+ * @brief Process a buffer of any length as a sequence of configured frames.
+ *
+ * Splits the buffer into frames of rac_energy_vad_get_frame_length_samples()
+ * samples and runs each through the same calibration and hysteresis as
+ * rac_energy_vad_process_audio(), taking the handle lock once for the whole
+ * buffer. Frame energies are computed with a vectorized kernel.
+ *
+ * Processing stops early once a non-NULL frame_decisions or boundaries array
+ * is full, so no decision or transition is lost. A trailing partial
+ * frame is not consumed; resubmit the remaining samples
+ * (sample_count - samples_consumed) with the next buffer.
+ *
+ * The speech callback fires for each transition, and the audio buffer
+ * callback fires once with the consumed samples.
+ *
+ * @param handle Service handle
+ * @param audio_data Array of audio samples (float32)
+ * @param sample_count Number of samples
+ * @param output Caller-provided output arrays; counts are filled on return
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_process_frames(rac_energy_vad_handle_t handle,
+                                                   const float* audio_data, size_t sample_count,
+                                                   rac_energy_vad_frame_output_t* output);
+
 // =============================================================================
 // PAUSE/RESUME API
 // =============================================================================
@@ -411,7 +484,10 @@ RAC_API rac_result_t rac_energy_vad_get_frame_length_samples(rac_energy_vad_hand
 /**
  * @brief Set speech activity callback.
  *
- * Mirrors Swift's onSpeechActivity property.
+ * Mirrors Swift's onSpeechActivity property. Events are queued by the
+ * processing call and delivered in order on a dispatcher thread owned by the
+ * service, so the callback never runs on (or holds up) the capture thread.
+ * Events still queued when the callback is replaced are discarded.
  *
  * @param handle Service handle
  * @param callback Callback function (can be NULL to clear)
@@ -425,7 +501,9 @@ RAC_API rac_result_t rac_energy_vad_set_speech_callback(rac_energy_vad_handle_t
 /**
  * @brief Set audio buffer callback.
  *
- * Mirrors Swift's onAudioBuffer property.
+ * Mirrors Swift's onAudioBuffer property. Called on the processing thread
+ * after the service lock is released; the buffer is only valid during the
+ * call.
  *
  * @param handle Service handle
  * @param callback Callback function (can be NULL to clear)
@@ -0,0 +1,198 @@
+/**
+ * @file rac_vad_segmenter.h
+ * @brief RunAnywhere Commons - VAD-driven utterance segmenter
+ *
+ * Turns a stream of capture buffers into transcribed utterances. Audio is
+ * run through a VAD component; while no speech is active the most recent
+ * pre_roll_ms of audio is kept in a ring buffer so the onset is not clipped
+ * when speech starts. Speech audio is accumulated as 16-bit PCM in a buffer
+ * allocated once at max_utterance_ms, and when the VAD reports the end of
+ * speech the utterance is handed to an STT component on the segmenter's
+ * worker thread. The capture thread never waits for transcription.
+ *
+ * With partial_window_ms set (and a streaming-capable STT model), every
+ * partial_window_ms of new speech the utterance so far is also sent to
+ * rac_stt_component_transcribe_stream and reported as a partial result, so
+ * each partial replaces the previous one. Partials of an utterance are always
+ * delivered before its final result; queued partials that a newer partial or
+ * the final supersedes are dropped instead of transcribed.
+ *
+ * PCM buffers come from a small pool allocated at create. If transcription
+ * falls so far behind that the pool runs dry, queued partials are dropped
+ * first and then the oldest queued utterance (see the dropped_* metrics).
+ */
+
+#ifndef RAC_VAD_SEGMENTER_H
+#define RAC_VAD_SEGMENTER_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Segmenter configuration
+ */
+typedef struct rac_vad_segmenter_config {
+    /** Sample rate of the audio passed in; must match the STT model (default: 16000) */
+    int32_t sample_rate;
+
+    /** Audio kept from before the speech start (default: 300) */
+    int32_t pre_roll_ms;
+
+    /** Longest utterance; longer speech is split at this length (default: 30000) */
+    int32_t max_utterance_ms;
+
+    /** New speech between partial results (0 = final results only) */
+    int32_t partial_window_ms;
+} rac_vad_segmenter_config_t;
+
+/**
+ * @brief Default segmenter configuration
+ */
+static const rac_vad_segmenter_config_t RAC_VAD_SEGMENTER_CONFIG_DEFAULT = {
+    .sample_rate = 16000, .pre_roll_ms = 300, .max_utterance_ms = 30000, .partial_window_ms = 0};
+
+/**
+ * @brief A transcription produced by the segmenter
+ */
+typedef struct rac_vad_segment_result {
+    /** Transcribed text (valid for the duration of the callback) */
+    const char* text;
+
+    /** RAC_TRUE for the utterance's final text, RAC_FALSE for a partial result */
+    rac_bool_t is_final;
+
+    /** Sequence number of the utterance, starting at 1 */
+    int64_t utterance_id;
+
+    /** Audio transcribed, including pre-roll */
+    int64_t audio_duration_ms;
+
+    /** Final results only: time from the end of speech to this result */
+    double endpoint_latency_ms;
+
+    /**
+     * RAC_SUCCESS, or the error of a final transcription that failed (text is
+     * then empty). Failed partial transcriptions are only counted.
+     */
+    rac_result_t error_code;
+} rac_vad_segment_result_t;
+
+/**
+ * @brief Result callback, invoked on the segmenter's worker thread
+ */
+typedef void (*rac_vad_segmenter_callback_fn)(const rac_vad_segment_result_t* result,
+                                              void* user_data);
+
+/**
+ * @brief Endpoint-to-text latency and counters
+ */
+typedef struct rac_vad_segmenter_metrics {
+    /** Final results delivered */
+    int64_t utterances;
+
+    /** Partial results delivered */
+    int64_t partial_results;
+
+    /** Utterances split because they reached max_utterance_ms */
+    int64_t split_utterances;
+
+    /** Transcriptions that returned an error */
+    int64_t failed_transcriptions;
+
+    /** Speech end to final text, most recent utterance */
+    double last_endpoint_latency_ms;
+
+    /** Speech end to final text, mean over all utterances */
+    double avg_endpoint_latency_ms;
+
+    /** Speech end to final text, worst utterance */
+    double max_endpoint_latency_ms;
+
+    /** Partials superseded before transcription or skipped for lack of a buffer */
+    int64_t dropped_partials;
+
+    /** Utterances dropped untranscribed because the buffer pool ran dry */
+    int64_t dropped_utterances;
+} rac_vad_segmenter_metrics_t;
+
+// =============================================================================
+// SEGMENTER API
+// =============================================================================
+
+/**
+ * @brief Create a segmenter
+ *
+ * Neither component is owned; both must outlive the segmenter. The VAD
+ * component must be initialized and started, and the STT component must
+ * have a model loaded.
+ *
+ * @param vad_component VAD component handle
+ * @param stt_component STT component handle
+ * @param config Configuration (can be NULL for defaults)
+ * @param callback Result callback
+ * @param user_data User context passed to callback
+ * @param out_handle Output: Segmenter handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_vad_segmenter_create(rac_handle_t vad_component,
+                                              rac_handle_t stt_component,
+                                              const rac_vad_segmenter_config_t* config,
+                                              rac_vad_segmenter_callback_fn callback,
+                                              void* user_data, rac_handle_t* out_handle);
+
+/**
+ * @brief Feed captured audio
+ *
+ * Runs the samples through the VAD component and accumulates speech.
+ * Never blocks on transcription.
+ *
+ * @param handle Segmenter handle
+ * @param samples Float audio samples (PCM)
+ * @param num_samples Number of samples
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_vad_segmenter_process(rac_handle_t handle, const float* samples,
+                                               size_t num_samples);
+
+/**
+ * @brief End the current utterance now and queue it for transcription
+ *
+ * @param handle Segmenter handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_vad_segmenter_flush(rac_handle_t handle);
+
+/**
+ * @brief Get latency metrics
+ *
+ * @param handle Segmenter handle
+ * @param out_metrics Output: Metrics
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_vad_segmenter_get_metrics(rac_handle_t handle,
+                                                   rac_vad_segmenter_metrics_t* out_metrics);
+
+/**
+ * @brief Destroy the segmenter
+ *
+ * Transcribes and delivers the utterances already queued before returning,
+ * so no final result is lost; queued partial results are dropped. Call
+ * rac_vad_segmenter_flush() first to also end an utterance still in progress.
+ *
+ * @param handle Segmenter handle
+ */
+RAC_API void rac_vad_segmenter_destroy(rac_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_VAD_SEGMENTER_H */
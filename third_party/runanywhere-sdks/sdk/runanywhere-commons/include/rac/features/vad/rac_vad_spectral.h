@@ -0,0 +1,245 @@
+/**
+ * @file rac_vad_spectral.h
+ * @brief Spectral Voice Activity Detection
+ *
+ * Frame classifier that looks at the shape of the spectrum as well as its
+ * level. Each frame is analyzed with a short FFT and must pass all of:
+ *
+ *   - RMS energy above the energy threshold
+ *   - speech-band (200-4000 Hz) share of the spectrum at or above min_band_ratio
+ *   - spectral flatness in the speech band at or below max_flatness
+ *     (fans and hiss are flat, voiced speech is harmonic)
+ *   - zero-crossing rate at or below max_zero_crossing_rate
+ *     (clicks and broadband noise cross zero far more often than voice)
+ *
+ * Frame decisions go through the same start/end hysteresis as the energy
+ * VAD, so a click shorter than the start window never becomes speech.
+ * Selected for rac_vad_component with RAC_VAD_ENGINE_SPECTRAL.
+ */
+
+#ifndef RAC_VAD_SPECTRAL_H
+#define RAC_VAD_SPECTRAL_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac/features/vad/rac_vad_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Opaque handle for spectral VAD service.
+ */
+typedef struct rac_spectral_vad* rac_spectral_vad_handle_t;
+
+/**
+ * @brief Configuration for spectral VAD.
+ */
+typedef struct rac_spectral_vad_config {
+    /** Audio sample rate (default: 16000) */
+    int32_t sample_rate;
+
+    /** Frame length in seconds (default: 0.1 = 100ms) */
+    float frame_length;
+
+    /** Minimum RMS energy of a speech frame (default: 0.005) */
+    float energy_threshold;
+
+    /** Minimum share of spectral energy in 200-4000 Hz (default: 0.5) */
+    float min_band_ratio;
+
+    /** Maximum speech-band spectral flatness, 0 = tonal, 1 = white (default: 0.35) */
+    float max_flatness;
+
+    /** Maximum zero crossings per sample (default: 0.3) */
+    float max_zero_crossing_rate;
+
+    /** Speech frames needed to start speech, in ms (default: 200) */
+    int32_t speech_start_ms;
+
+    /** Non-speech frames needed to end speech, in ms (default: 1200) */
+    int32_t speech_end_ms;
+} rac_spectral_vad_config_t;
+
+/**
+ * @brief Default spectral VAD configuration.
+ */
+static const rac_spectral_vad_config_t RAC_SPECTRAL_VAD_CONFIG_DEFAULT = {
+    .sample_rate = RAC_VAD_DEFAULT_SAMPLE_RATE,
+    .frame_length = RAC_VAD_DEFAULT_FRAME_LENGTH,
+    .energy_threshold = 0.005f,
+    .min_band_ratio = 0.5f,
+    .max_flatness = 0.35f,
+    .max_zero_crossing_rate = 0.3f,
+    .speech_start_ms = 200,
+    .speech_end_ms = 1200};
+
+/**
+ * @brief Features of the most recent frame, for debugging and tuning.
+ */
+typedef struct rac_spectral_vad_features {
+    /** RMS energy */
+    float energy;
+
+    /** Share of spectral energy in the speech band */
+    float band_ratio;
+
+    /** Spectral flatness in the speech band */
+    float flatness;
+
+    /** Zero crossings per sample */
+    float zero_crossing_rate;
+
+    /** Whether the frame passed every check */
+    rac_bool_t is_speech_frame;
+} rac_spectral_vad_features_t;
+
+// =============================================================================
+// LIFECYCLE API
+// =============================================================================
+
+/**
+ * @brief Create a spectral VAD service.
+ *
+ * @param config Configuration (can be NULL for defaults)
+ * @param out_handle Output: Handle to the created service
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_create(const rac_spectral_vad_config_t* config,
+                                             rac_spectral_vad_handle_t* out_handle);
+
+/**
+ * @brief Destroy a spectral VAD service.
+ *
+ * @param handle Service handle to destroy
+ */
+RAC_API void rac_spectral_vad_destroy(rac_spectral_vad_handle_t handle);
+
+/**
+ * @brief Start voice activity detection.
+ *
+ * @param handle Service handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_start(rac_spectral_vad_handle_t handle);
+
+/**
+ * @brief Stop voice activity detection, ending any active speech.
+ *
+ * @param handle Service handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_stop(rac_spectral_vad_handle_t handle);
+
+/**
+ * @brief Reset the VAD state and drop any buffered partial frame.
+ *
+ * @param handle Service handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_reset(rac_spectral_vad_handle_t handle);
+
+// =============================================================================
+// PROCESSING API
+// =============================================================================
+
+/**
+ * @brief Process audio for voice activity detection.
+ *
+ * Buffers of any length are split into frames; a trailing partial frame is
+ * kept and completed by the next call.
+ *
+ * @param handle Service handle
+ * @param audio_data Array of audio samples (float32)
+ * @param sample_count Number of samples
+ * @param out_has_voice Output: Decision for the last frame completed by this
+ *                      call (RAC_FALSE if none was completed)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_process_audio(rac_spectral_vad_handle_t handle,
+                                                    const float* audio_data, size_t sample_count,
+                                                    rac_bool_t* out_has_voice);
+
+// =============================================================================
+// STATE QUERY API
+// =============================================================================
+
+/**
+ * @brief Check if speech is currently active.
+ *
+ * @param handle Service handle
+ * @param out_is_active Output: RAC_TRUE if speech is active
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_is_speech_active(rac_spectral_vad_handle_t handle,
+                                                       rac_bool_t* out_is_active);
+
+/**
+ * @brief Get the energy threshold.
+ *
+ * @param handle Service handle
+ * @param out_threshold Output: Current threshold value
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_get_threshold(rac_spectral_vad_handle_t handle,
+                                                    float* out_threshold);
+
+/**
+ * @brief Set the energy threshold.
+ *
+ * @param handle Service handle
+ * @param threshold New threshold value
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_set_threshold(rac_spectral_vad_handle_t handle,
+                                                    float threshold);
+
+/**
+ * @brief Get the features of the most recent frame.
+ *
+ * @param handle Service handle
+ * @param out_features Output: Frame features
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_get_features(rac_spectral_vad_handle_t handle,
+                                                   rac_spectral_vad_features_t* out_features);
+
+/**
+ * @brief Get frame length in samples.
+ *
+ * @param handle Service handle
+ * @param out_frame_length Output: Frame length in samples
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_get_frame_length_samples(rac_spectral_vad_handle_t handle,
+                                                               int32_t* out_frame_length);
+
+// =============================================================================
+// CALLBACK API
+// =============================================================================
+
+/**
+ * @brief Set speech activity callback.
+ *
+ * Delivered on the service's dispatcher thread, as for the energy VAD.
+ *
+ * @param handle Service handle
+ * @param callback Callback function (can be NULL to clear)
+ * @param user_data User-provided context
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_spectral_vad_set_speech_callback(rac_spectral_vad_handle_t handle,
+                                                          rac_speech_activity_callback_fn callback,
+                                                          void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_VAD_SPECTRAL_H */
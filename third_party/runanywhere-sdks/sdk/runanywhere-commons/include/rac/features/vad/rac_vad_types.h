@@ -54,6 +54,16 @@ extern "C" {
 // CONFIGURATION - Mirrors Swift's VADConfiguration
 // =============================================================================
 
+/**
+ * @brief Frame classifier used by the VAD component
+ */
+typedef enum rac_vad_engine {
+    /** RMS energy against a calibrated threshold (rac_vad_energy.h) */
+    RAC_VAD_ENGINE_ENERGY = 0,
+    /** Energy plus band ratio, flatness and zero-crossing checks (rac_vad_spectral.h) */
+    RAC_VAD_ENGINE_SPECTRAL = 1
+} rac_vad_engine_t;
+
 /**
  * @brief VAD component configuration
  *
@@ -81,6 +91,9 @@ typedef struct rac_vad_config {
 
     /** Calibration multiplier (threshold = ambient noise * multiplier) */
     float calibration_multiplier;
+
+    /** Frame classifier (default: RAC_VAD_ENGINE_ENERGY) */
+    rac_vad_engine_t engine;
 } rac_vad_config_t;
 
 /**
@@ -93,7 +106,8 @@ static const rac_vad_config_t RAC_VAD_CONFIG_DEFAULT = {
     .sample_rate = RAC_VAD_DEFAULT_SAMPLE_RATE,
     .frame_length = RAC_VAD_DEFAULT_FRAME_LENGTH,
     .enable_auto_calibration = RAC_FALSE,
-    .calibration_multiplier = RAC_VAD_DEFAULT_CALIBRATION_MULTIPLIER};
+    .calibration_multiplier = RAC_VAD_DEFAULT_CALIBRATION_MULTIPLIER,
+    .engine = RAC_VAD_ENGINE_ENERGY};
 
 // =============================================================================
 // SPEECH ACTIVITY - Mirrors Swift's SpeechActivityEvent
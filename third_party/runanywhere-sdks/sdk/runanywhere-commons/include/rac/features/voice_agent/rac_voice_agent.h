@@ -82,7 +82,9 @@ typedef enum rac_voice_agent_event_type {
     RAC_VOICE_AGENT_EVENT_TRANSCRIPTION = 2,     /**< Transcription available from STT */
     RAC_VOICE_AGENT_EVENT_RESPONSE = 3,          /**< Response generated from LLM */
     RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED = 4, /**< Audio synthesized from TTS */
-    RAC_VOICE_AGENT_EVENT_ERROR = 5              /**< Error occurred during processing */
+    RAC_VOICE_AGENT_EVENT_ERROR = 5,             /**< Error occurred during processing */
+    RAC_VOICE_AGENT_EVENT_PARTIAL_TRANSCRIPTION = 6, /**< Session only: text of speech so far */
+    RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK = 7 /**< Session only: next piece of the reply audio */
 } rac_voice_agent_event_type_t;
 
 /**
@@ -143,6 +145,10 @@ typedef struct rac_voice_agent_tts_config {
     const char* voice_id;
     /** Voice name - human-readable name (e.g., "Piper TTS (British English)") */
     const char* voice_name;
+    /** Deliver synthesized audio as raw PCM instead of a WAV file (e.g., for a sound device) */
+    rac_bool_t raw_pcm_output;
+    /** Sample encoding of raw PCM output */
+    rac_tts_sample_format_t pcm_sample_format;
 } rac_voice_agent_tts_config_t;
 
 /**
@@ -170,7 +176,11 @@ static const rac_voice_agent_config_t RAC_VOICE_AGENT_CONFIG_DEFAULT = {
     .vad_config = {.sample_rate = 16000, .frame_length = 0.1f, .energy_threshold = 0.005f},
     .stt_config = {.model_path = RAC_NULL, .model_id = RAC_NULL, .model_name = RAC_NULL},
     .llm_config = {.model_path = RAC_NULL, .model_id = RAC_NULL, .model_name = RAC_NULL},
-    .tts_config = {.voice_path = RAC_NULL, .voice_id = RAC_NULL, .voice_name = RAC_NULL}};
+    .tts_config = {.voice_path = RAC_NULL,
+                   .voice_id = RAC_NULL,
+                   .voice_name = RAC_NULL,
+                   .raw_pcm_output = RAC_FALSE,
+                   .pcm_sample_format = RAC_TTS_SAMPLE_FORMAT_FLOAT32}};
 
 // =============================================================================
 // AUDIO PIPELINE STATE MANAGER CONFIG - Mirrors Swift's AudioPipelineStateManager.Configuration
@@ -249,7 +259,7 @@ typedef struct rac_voice_agent_result {
     /** Generated response text from LLM (owned, must be freed with rac_free) */
     char* response;
 
-    /** Synthesized audio data from TTS (owned, must be freed with rac_free) */
+    /** Synthesized audio from TTS: WAV, or raw PCM if configured (owned, free with rac_free) */
     void* synthesized_audio;
 
     /** Size of synthesized audio data in bytes */
@@ -271,7 +281,7 @@ typedef struct rac_voice_agent_event {
         /** For VAD_TRIGGERED event: true if speech started, false if ended */
         rac_bool_t vad_speech_active;
 
-        /** For TRANSCRIPTION event */
+        /** For TRANSCRIPTION and PARTIAL_TRANSCRIPTION events */
         const char* transcription;
 
         /** For RESPONSE event */
@@ -594,6 +604,203 @@ RAC_API rac_result_t rac_voice_agent_detect_speech(rac_voice_agent_handle_t hand
                                                    const float* samples, size_t sample_count,
                                                    rac_bool_t* out_speech_detected);
 
+// =============================================================================
+// VOICE SESSION API
+// =============================================================================
+//
+// A session turns a continuous microphone stream into conversation turns.
+// Captured frames are pushed as they arrive. The agent's VAD finds the end
+// of each utterance, STT transcribes windows of speech while the user is
+// still talking, and each finished utterance is answered with LLM and TTS
+// on a session thread. Events arrive on the session's threads while the
+// capture keeps running. Echo of the agent's own playback has to be removed
+// by the platform (acoustic echo cancellation) before frames are pushed.
+
+/**
+ * @brief Voice session configuration
+ */
+typedef struct rac_voice_agent_session_config {
+    /** Sample rate of pushed audio; must match the VAD and STT models (default: 16000) */
+    int32_t sample_rate;
+
+    /** Audio kept from before each speech start (default: 300) */
+    int32_t pre_roll_ms;
+
+    /** Longest utterance; longer speech is split into several turns (default: 30000) */
+    int32_t max_utterance_ms;
+
+    /**
+     * New speech between PARTIAL_TRANSCRIPTION events (default: 0 = final text
+     * only). Each partial transcribes the whole utterance so far.
+     */
+    int32_t partial_window_ms;
+
+    /** Captured audio buffered ahead of VAD processing (default: 10000) */
+    int32_t capture_buffer_ms;
+
+    /**
+     * Cancel the turn in progress when the user starts speaking, as
+     * rac_voice_agent_session_cancel_turn does. Only useful when echo of the
+     * agent's playback is removed, or it interrupts itself (default: RAC_FALSE).
+     */
+    rac_bool_t barge_in;
+} rac_voice_agent_session_config_t;
+
+/**
+ * @brief Default voice session configuration
+ */
+static const rac_voice_agent_session_config_t RAC_VOICE_AGENT_SESSION_CONFIG_DEFAULT = {
+    .sample_rate = 16000,
+    .pre_roll_ms = 300,
+    .max_utterance_ms = 30000,
+    .partial_window_ms = 0,
+    .capture_buffer_ms = 10000,
+    .barge_in = RAC_FALSE};
+
+/**
+ * @brief Voice session latency and counters
+ *
+ * Latencies are measured from the moment the VAD reports the end of speech.
+ * "First audio" is the first AUDIO_CHUNK of the reply.
+ */
+typedef struct rac_voice_agent_session_metrics {
+    /** Turns that produced synthesized audio */
+    int64_t turns;
+
+    /** Turns that failed in STT, LLM or TTS */
+    int64_t failed_turns;
+
+    /** PARTIAL_TRANSCRIPTION events delivered */
+    int64_t partial_transcriptions;
+
+    /** Captured samples lost because processing fell behind the capture */
+    uint64_t dropped_samples;
+
+    /** Most recent turn: end of speech to final transcription */
+    double last_stt_latency_ms;
+
+    /** Most recent turn: LLM response time */
+    double last_llm_duration_ms;
+
+    /** Most recent turn: TTS synthesis time */
+    double last_tts_duration_ms;
+
+    /** Most recent turn: end of speech to first audio */
+    double last_first_audio_latency_ms;
+
+    /** End of speech to first audio, mean over all turns */
+    double avg_first_audio_latency_ms;
+
+    /** End of speech to first audio, worst turn */
+    double max_first_audio_latency_ms;
+
+    /** Turns cancelled in progress or while queued */
+    int64_t cancelled_turns;
+} rac_voice_agent_session_metrics_t;
+
+/**
+ * @brief Opaque handle for a voice session.
+ */
+typedef struct rac_voice_agent_session* rac_voice_agent_session_handle_t;
+
+/**
+ * @brief Start a voice session on an initialized voice agent.
+ *
+ * Starts the agent's VAD. Only one session can run per agent, and while it
+ * runs the agent's VAD must not be used through rac_voice_agent_detect_speech.
+ *
+ * Events: VAD_TRIGGERED when speech starts and ends; PARTIAL_TRANSCRIPTION
+ * while speaking (with partial_window_ms and a streaming-capable STT model);
+ * then for each utterance TRANSCRIPTION, RESPONSE, AUDIO_SYNTHESIZED and
+ * PROCESSED, or ERROR if transcription, generation or synthesis fails.
+ * AUDIO_CHUNK events carry the reply sentence by sentence before
+ * AUDIO_SYNTHESIZED delivers all of it: as raw PCM in the configured sample
+ * format, or with WAV output as Int16 PCM, while AUDIO_SYNTHESIZED is the WAV
+ * file. A streaming TTS model splits sentences into smaller chunks when it
+ * outputs raw PCM. Utterances that transcribe to nothing
+ * produce no turn. Callbacks come from session threads but never run
+ * concurrently; event data is only valid during the callback and is freed by
+ * the session (including the PROCESSED result, unlike
+ * rac_voice_agent_process_stream). The callback must not stop the session.
+ *
+ * @param handle Voice agent handle (initialized, with STT, LLM and TTS loaded)
+ * @param config Session configuration (can be NULL for defaults)
+ * @param callback Event callback function
+ * @param user_data User context passed to callback
+ * @param out_session Output: Session handle
+ * @return RAC_SUCCESS, RAC_ERROR_NOT_INITIALIZED, RAC_ERROR_SERVICE_BUSY if a
+ *         session is already running, or another error code
+ */
+RAC_API rac_result_t rac_voice_agent_session_start(
+    rac_voice_agent_handle_t handle, const rac_voice_agent_session_config_t* config,
+    rac_voice_agent_event_callback_fn callback, void* user_data,
+    rac_voice_agent_session_handle_t* out_session);
+
+/**
+ * @brief Push captured microphone audio.
+ *
+ * Safe to call from a real-time audio thread: the samples are copied into a
+ * lock-free buffer and processed on the session's capture thread. If that
+ * thread falls more than capture_buffer_ms behind, the oldest audio is
+ * dropped and counted in the metrics.
+ *
+ * @param session Session handle
+ * @param samples Mono Float32 samples at the session's sample rate
+ * @param sample_count Number of samples
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_voice_agent_session_push_audio(rac_voice_agent_session_handle_t session,
+                                                        const float* samples,
+                                                        size_t sample_count);
+
+/**
+ * @brief End the current utterance now (e.g., push-to-talk released).
+ *
+ * Audio pushed before this call is processed first.
+ *
+ * @param session Session handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_voice_agent_session_flush(rac_voice_agent_session_handle_t session);
+
+/**
+ * @brief Cancel the turn in progress and the utterances waiting for a reply.
+ *
+ * For barge-in: call when the user interrupts the agent, and stop playback
+ * of the reply. LLM generation stops at its next token and synthesis at the
+ * end of the sentence being synthesized, whose audio is discarded. No
+ * RESPONSE, AUDIO_CHUNK, AUDIO_SYNTHESIZED or PROCESSED event of a cancelled
+ * turn starts after this returns. Capture and transcription keep running, so
+ * the interruption itself becomes the next turn. Can be called from the
+ * event callback.
+ *
+ * @param session Session handle
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_voice_agent_session_cancel_turn(rac_voice_agent_session_handle_t session);
+
+/**
+ * @brief Get latency metrics.
+ *
+ * @param session Session handle
+ * @param out_metrics Output: Metrics
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_voice_agent_session_get_metrics(
+    rac_voice_agent_session_handle_t session, rac_voice_agent_session_metrics_t* out_metrics);
+
+/**
+ * @brief Stop a voice session and release it.
+ *
+ * Cancels the turn in progress as rac_voice_agent_session_cancel_turn does
+ * and waits for it to stop; transcriptions already queued are delivered, but
+ * get no reply. Stops and resets the agent's VAD. Must be called before the agent
+ * is cleaned up or destroyed.
+ *
+ * @param session Session handle
+ */
+RAC_API void rac_voice_agent_session_stop(rac_voice_agent_session_handle_t session);
+
 // =============================================================================
 // MEMORY MANAGEMENT
 // =============================================================================
@@ -96,6 +96,9 @@ typedef struct rac_telemetry_payload {
     int32_t sample_rate;
     const char* voice;
     double output_duration_ms;
+    double time_to_first_audio_ms;
+    rac_bool_t is_cache_hit;
+    rac_bool_t has_is_cache_hit;
 
     // Model lifecycle fields
     int64_t model_size_bytes;
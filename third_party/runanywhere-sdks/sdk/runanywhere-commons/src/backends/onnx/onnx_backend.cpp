@@ -58,6 +58,150 @@ const char* printable_language(const std::string& language) {
     return language.empty() ? "<auto>" : language.c_str();
 }
 
+struct SynthesisGuard {
+    std::atomic<int>& count_;
+    SynthesisGuard(std::atomic<int>& count) : count_(count) { count_++; }
+    ~SynthesisGuard() { count_--; }
+};
+
+// Progress callback context for one sentence generated by sherpa-onnx
+struct CancelCheck {
+    const std::atomic<uint64_t>& generation;
+    uint64_t started_at;
+};
+
+// Sherpa reports progress after each sentence it generates (the model is
+// loaded with max_num_sentences = 1); returning 0 makes it stop there
+int32_t continue_unless_cancelled(const float* /*samples*/, int32_t /*n*/, float /*progress*/,
+                                  void* arg) {
+    const auto* check = static_cast<const CancelCheck*>(arg);
+    return check->generation.load() == check->started_at ? 1 : 0;
+}
+
+int parse_speaker_id(const std::string& voice_id) {
+    int speaker_id = 0;
+    if (!voice_id.empty()) {
+        try {
+            speaker_id = std::stoi(voice_id);
+        } catch (...) {}
+    }
+    return speaker_id;
+}
+
+bool is_sentence_end(const std::string& text, size_t i, size_t* end) {
+    const char ch = text[i];
+    if (ch == '\n') {
+        *end = i + 1;
+        return true;
+    }
+    if (ch == '.' || ch == '!' || ch == '?' || ch == ';' || ch == ':') {
+        // The dot in "3.5" or "v1.2" is not followed by whitespace
+        size_t next = i + 1;
+        while (next < text.size() && std::strchr(".!?\"')", text[next]) != nullptr) {
+            ++next;
+        }
+        if (next == text.size() || std::isspace(static_cast<unsigned char>(text[next])) != 0) {
+            *end = next;
+            return true;
+        }
+        return false;
+    }
+    // Full-width CJK terminators: 。！？ (3-byte UTF-8)
+    static const char* const kWideTerminators[] = {"\xE3\x80\x82", "\xEF\xBC\x81",
+                                                   "\xEF\xBC\x9F"};
+    for (const char* terminator : kWideTerminators) {
+        if (text.compare(i, 3, terminator) == 0) {
+            *end = i + 3;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Splits text into sentences for chunked synthesis. Fragments shorter than
+// kMinChunkChars are merged into the next one so prosody is not chopped up.
+std::vector<std::string> split_sentences(const std::string& text) {
+    constexpr size_t kMinChunkChars = 20;
+
+    std::vector<std::string> sentences;
+    std::string current;
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        size_t end = 0;
+        if (!is_sentence_end(text, i, &end)) {
+            continue;
+        }
+        current += text.substr(start, end - start);
+        start = end;
+        i = end - 1;
+
+        std::string trimmed = trim_copy(current);
+        if (trimmed.size() >= kMinChunkChars) {
+            sentences.push_back(std::move(trimmed));
+            current.clear();
+        }
+    }
+    current += text.substr(start);
+
+    std::string trimmed = trim_copy(current);
+    if (!trimmed.empty()) {
+        if (trimmed.size() < kMinChunkChars && !sentences.empty()) {
+            sentences.back() += " " + trimmed;
+        } else {
+            sentences.push_back(std::move(trimmed));
+        }
+    }
+    return sentences;
+}
+
+std::vector<float> resample_linear(const std::vector<float>& input, int from_rate, int to_rate) {
+    if (input.empty() || from_rate == to_rate) {
+        return input;
+    }
+    const double step = static_cast<double>(from_rate) / to_rate;
+    const auto out_size = static_cast<size_t>(input.size() / step);
+    std::vector<float> output(out_size);
+    for (size_t i = 0; i < out_size; ++i) {
+        const double pos = i * step;
+        const auto index = static_cast<size_t>(pos);
+        const auto frac = static_cast<float>(pos - index);
+        const float next = index + 1 < input.size() ? input[index + 1] : input[index];
+        output[i] = input[index] + (next - input[index]) * frac;
+    }
+    return output;
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+// How a load used the optimized-model cache, for the time-to-ready logs
+const char* describe_model_cache(bool created, bool from_cache) {
+    if (created) {
+        return "cold, optimized graph cached";
+    }
+    return from_cache ? "warm, cached optimized graph" : "optimized-model cache unused";
+}
+
+// Sherpa-onnx builds its own sessions, so it is handed the cached optimized
+// graphs instead; its optimizer then has little left to fuse
+const char* use_optimized_models(const ONNXBackendNew* backend,
+                                 std::initializer_list<std::string*> paths) {
+    bool created = false;
+    bool from_cache = false;
+    for (std::string* path : paths) {
+        if (path->empty()) {
+            continue;
+        }
+        OptimizedModel model = backend->resolve_model(*path, ORT_ENABLE_EXTENDED);
+        *path = model.path;
+        created = created || model.created;
+        from_cache = from_cache || model.from_cache;
+    }
+    return describe_model_cache(created, from_cache);
+}
+
 }  // namespace
 
 // =============================================================================
@@ -79,6 +223,22 @@ bool ONNXBackendNew::initialize(const nlohmann::json& config) {
 
     config_ = config;
 
+    if (config.contains("num_threads") && config["num_threads"].get<int>() > 0) {
+        num_threads_ = config["num_threads"].get<int>();
+    }
+    if (config.contains("provider")) {
+        provider_ = config["provider"].get<std::string>();
+    }
+    if (config.contains("debug")) {
+        debug_ = config["debug"].get<bool>();
+    }
+    if (config.contains("global_thread_pool")) {
+        global_thread_pools_ = config["global_thread_pool"].get<bool>();
+    }
+    if (config.contains("model_cache")) {
+        model_cache_ = config["model_cache"].get<bool>();
+    }
+
     if (!initialize_ort()) {
         return false;
     }
@@ -89,6 +249,28 @@ bool ONNXBackendNew::initialize(const nlohmann::json& config) {
     return true;
 }
 
+OptimizedModel ONNXBackendNew::resolve_model(const std::string& model_path,
+                                            GraphOptimizationLevel level) const {
+    if (!model_cache_ || provider_ != "cpu") {
+        OptimizedModel model;
+        model.path = model_path;
+        return model;
+    }
+    return resolve_optimized_model(ort_api_, ort_env_, model_path, level, provider_);
+}
+
+int ONNXBackendNew::sherpa_num_threads(int requested) const {
+    if (requested <= 0) {
+        return num_threads_;
+    }
+    if (global_thread_pools_ && requested > num_threads_) {
+        RAC_LOG_INFO("ONNX", "num_threads %d capped to the %d-thread budget of the global pools",
+                     requested, num_threads_);
+        return num_threads_;
+    }
+    return requested;
+}
+
 bool ONNXBackendNew::is_initialized() const {
     return initialized_;
 }
@@ -127,6 +309,11 @@ bool ONNXBackendNew::initialize_ort() {
         return false;
     }
 
+    if (global_thread_pools_ && create_env_with_global_thread_pools()) {
+        return true;
+    }
+    global_thread_pools_ = false;
+
     OrtStatus* status = ort_api_->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "runanywhere", &ort_env_);
     if (status) {
         RAC_LOG_ERROR("ONNX", "Failed to create ONNX Runtime environment: %s",
@@ -138,12 +325,50 @@ bool ONNXBackendNew::initialize_ort() {
     return true;
 }
 
+bool ONNXBackendNew::create_env_with_global_thread_pools() {
+    // ONNX Runtime keeps a single environment per process, so the pools created
+    // here are the ones every session that disables per-session threads will use
+    OrtThreadingOptions* threading_options = nullptr;
+    OrtStatus* status = ort_api_->CreateThreadingOptions(&threading_options);
+    if (!status) {
+        status = ort_api_->SetGlobalIntraOpNumThreads(threading_options, num_threads_);
+    }
+    if (!status) {
+        status = ort_api_->SetGlobalInterOpNumThreads(threading_options, 1);
+    }
+    if (!status) {
+        // Idle pool threads yield instead of spinning while other models run
+        status = ort_api_->SetGlobalSpinControl(threading_options, 0);
+    }
+    if (!status) {
+        status = ort_api_->CreateEnvWithGlobalThreadPools(ORT_LOGGING_LEVEL_WARNING, "runanywhere",
+                                                          threading_options, &ort_env_);
+    }
+    if (threading_options) {
+        ort_api_->ReleaseThreadingOptions(threading_options);
+    }
+
+    if (status) {
+        RAC_LOG_WARNING("ONNX", "Global thread pools unavailable, using per-session pools: %s",
+                        ort_api_->GetErrorMessage(status));
+        ort_api_->ReleaseStatus(status);
+        ort_env_ = nullptr;
+        return false;
+    }
+
+    RAC_LOG_INFO("ONNX", "ONNX Runtime environment uses global thread pools (%d intra-op threads)",
+                 num_threads_);
+    return true;
+}
+
 void ONNXBackendNew::create_capabilities() {
     stt_ = std::make_unique<ONNXSTT>(this);
 
+    // Silero VAD runs on ONNX Runtime directly
+    vad_ = std::make_unique<ONNXVAD>(this);
+
 #if SHERPA_ONNX_AVAILABLE
     tts_ = std::make_unique<ONNXTTS>(this);
-    vad_ = std::make_unique<ONNXVAD>(this);
 #endif
 }
 
@@ -159,7 +384,7 @@ ONNXSTT::~ONNXSTT() {
 
 bool ONNXSTT::is_ready() const {
 #if SHERPA_ONNX_AVAILABLE
-    return model_loaded_ && sherpa_recognizer_ != nullptr;
+    return model_loaded_ && (sherpa_recognizer_ != nullptr || online_recognizer_ != nullptr);
 #else
     return model_loaded_;
 #endif
@@ -170,15 +395,14 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
     std::lock_guard<std::mutex> lock(mutex_);
 
 #if SHERPA_ONNX_AVAILABLE
-    if (sherpa_recognizer_) {
-        SherpaOnnxDestroyOfflineRecognizer(sherpa_recognizer_);
-        sherpa_recognizer_ = nullptr;
-    }
+    destroy_recognizers();
+    destroy_online_recognizer();
 
     model_type_ = model_type;
     model_dir_ = model_path;
 
     RAC_LOG_INFO("ONNX.STT", "Loading model from: %s", model_path.c_str());
+    const auto load_start = std::chrono::steady_clock::now();
 
     struct stat path_stat;
     if (stat(model_path.c_str(), &path_stat) != 0) {
@@ -189,6 +413,7 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
     std::string encoder_path;
     std::string decoder_path;
     std::string tokens_path;
+    std::string joiner_path;
 
     if (S_ISDIR(path_stat.st_mode)) {
         DIR* dir = opendir(model_path.c_str());
@@ -210,6 +435,10 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
                      filename.substr(filename.size() - 5) == ".onnx") {
                 decoder_path = full_path;
                 RAC_LOG_DEBUG("ONNX.STT", "Found decoder: %s", decoder_path.c_str());
+            } else if (filename.find("joiner") != std::string::npos && filename.size() > 5 &&
+                       filename.substr(filename.size() - 5) == ".onnx") {
+                joiner_path = full_path;
+                RAC_LOG_DEBUG("ONNX.STT", "Found joiner: %s", joiner_path.c_str());
             } else if (filename == "tokens.txt" || (filename.find("tokens") != std::string::npos &&
                                                   filename.find(".txt") != std::string::npos)) {
                 tokens_path = full_path;
@@ -244,6 +473,11 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
             model_dir_ = dir;
             decoder_path = dir + "/decoder.onnx";
             tokens_path = dir + "/tokens.txt";
+
+            std::string test_path = dir + "/joiner.onnx";
+            if (stat(test_path.c_str(), &path_stat) == 0) {
+                joiner_path = test_path;
+            }
         }
     }
 
@@ -252,6 +486,15 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
         language_ = config["language"].get<std::string>();
     }
 
+    num_threads_ = backend_->sherpa_num_threads(
+        config.contains("num_threads") ? config["num_threads"].get<int>() : 0);
+
+    recognizer_cache_size_ = 2;
+    if (config.contains("recognizer_cache_size")) {
+        recognizer_cache_size_ =
+            static_cast<size_t>(std::max(1, config["recognizer_cache_size"].get<int>()));
+    }
+
     RAC_LOG_INFO("ONNX.STT", "Encoder: %s", encoder_path.c_str());
     RAC_LOG_INFO("ONNX.STT", "Decoder: %s", decoder_path.c_str());
     RAC_LOG_INFO("ONNX.STT", "Tokens: %s", tokens_path.c_str());
@@ -270,6 +513,77 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
         return false;
     }
 
+    encoder_path_ = encoder_path;
+    decoder_path_ = decoder_path;
+    tokens_path_ = tokens_path;
+    joiner_path_ = joiner_path;
+    const char* load_mode =
+        use_optimized_models(backend_, {&encoder_path_, &decoder_path_, &joiner_path_});
+
+    // Whisper never ships a joiner, so its presence also marks a transducer
+    // model loaded without an explicit type
+    if (model_type == STTModelType::ZIPFORMER || model_type == STTModelType::TRANSDUCER ||
+        !joiner_path.empty()) {
+        if (stat(joiner_path.c_str(), &path_stat) != 0) {
+            RAC_LOG_ERROR("ONNX.STT", "Joiner file not found for transducer model in: %s",
+                          model_path.c_str());
+            return false;
+        }
+        if (model_type == STTModelType::WHISPER) {
+            model_type_ = STTModelType::TRANSDUCER;
+        }
+
+        if (config.contains("rule1_min_trailing_silence")) {
+            rule1_min_trailing_silence_ = config["rule1_min_trailing_silence"].get<float>();
+        }
+        if (config.contains("rule2_min_trailing_silence")) {
+            rule2_min_trailing_silence_ = config["rule2_min_trailing_silence"].get<float>();
+        }
+        if (config.contains("rule3_min_utterance_length")) {
+            rule3_min_utterance_length_ = config["rule3_min_utterance_length"].get<float>();
+        }
+
+        RAC_LOG_INFO("ONNX.STT", "Joiner: %s", joiner_path.c_str());
+        RAC_LOG_INFO("ONNX.STT", "Creating SherpaOnnxOnlineRecognizer...");
+
+        online_recognizer_ = create_online_recognizer();
+        if (!online_recognizer_) {
+            RAC_LOG_ERROR("ONNX.STT", "Failed to create SherpaOnnxOnlineRecognizer");
+            return false;
+        }
+
+        RAC_LOG_INFO("ONNX.STT", "Streaming STT model ready in %.0fms (%s)",
+                     elapsed_ms(load_start), load_mode);
+        model_loaded_ = true;
+        return true;
+    }
+
+    RAC_LOG_INFO("ONNX.STT", "Creating SherpaOnnxOfflineRecognizer...");
+
+    sherpa_recognizer_ = create_recognizer(language_);
+
+    if (!sherpa_recognizer_) {
+        RAC_LOG_ERROR("ONNX.STT", "Failed to create SherpaOnnxOfflineRecognizer");
+        return false;
+    }
+
+    recognizer_cache_.push_back({language_, sherpa_recognizer_});
+    cache_stats_ = RecognizerCacheStats();
+    cache_stats_.recognizer_loads++;
+
+    RAC_LOG_INFO("ONNX.STT", "STT model ready in %.0fms (%s)", elapsed_ms(load_start),
+                 load_mode);
+    model_loaded_ = true;
+    return true;
+
+#else
+    RAC_LOG_ERROR("ONNX.STT", "Sherpa-ONNX not available - streaming STT disabled");
+    return false;
+#endif
+}
+
+#if SHERPA_ONNX_AVAILABLE
+const SherpaOnnxOfflineRecognizer* ONNXSTT::create_recognizer(const std::string& language) const {
     SherpaOnnxOfflineRecognizerConfig recognizer_config;
     memset(&recognizer_config, 0, sizeof(recognizer_config));
 
@@ -283,16 +597,16 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
     recognizer_config.model_config.nemo_ctc.model = "";
     recognizer_config.model_config.tdnn.model = "";
 
-    recognizer_config.model_config.whisper.encoder = encoder_path.c_str();
-    recognizer_config.model_config.whisper.decoder = decoder_path.c_str();
-    recognizer_config.model_config.whisper.language = language_.c_str();
+    recognizer_config.model_config.whisper.encoder = encoder_path_.c_str();
+    recognizer_config.model_config.whisper.decoder = decoder_path_.c_str();
+    recognizer_config.model_config.whisper.language = language.c_str();
     recognizer_config.model_config.whisper.task = "transcribe";
     recognizer_config.model_config.whisper.tail_paddings = -1;
 
-    recognizer_config.model_config.tokens = tokens_path.c_str();
-    recognizer_config.model_config.num_threads = 2;
-    recognizer_config.model_config.debug = 1;
-    recognizer_config.model_config.provider = "cpu";
+    recognizer_config.model_config.tokens = tokens_path_.c_str();
+    recognizer_config.model_config.num_threads = num_threads_;
+    recognizer_config.model_config.debug = backend_->is_debug() ? 1 : 0;
+    recognizer_config.model_config.provider = backend_->get_provider().c_str();
     recognizer_config.model_config.model_type = "whisper";
 
     recognizer_config.model_config.modeling_unit = "cjkchar";
@@ -336,25 +650,208 @@ bool ONNXSTT::load_model(const std::string& model_path, STTModelType model_type,
     recognizer_config.hr.lexicon = "";
     recognizer_config.hr.rule_fsts = "";
 
-    RAC_LOG_INFO("ONNX.STT", "Creating SherpaOnnxOfflineRecognizer...");
+    return SherpaOnnxCreateOfflineRecognizer(&recognizer_config);
+}
 
-    sherpa_recognizer_ = SherpaOnnxCreateOfflineRecognizer(&recognizer_config);
+bool ONNXSTT::activate_language(const std::string& language) {
+    cache_stats_.language_switches++;
+
+    auto it = std::find_if(recognizer_cache_.begin(), recognizer_cache_.end(),
+                           [&](const CachedRecognizer& entry) {
+                               return entry.language == language;
+                           });
+    if (it != recognizer_cache_.end()) {
+        std::rotate(recognizer_cache_.begin(), it, it + 1);
+        cache_stats_.reloads_avoided++;
+        RAC_LOG_INFO("ONNX.STT", "Reusing cached recognizer for language %s",
+                     printable_language(language));
+    } else {
+        RAC_LOG_INFO("ONNX.STT", "Creating recognizer for language %s",
+                     printable_language(language));
+        const SherpaOnnxOfflineRecognizer* recognizer = create_recognizer(language);
+        if (!recognizer) {
+            return false;
+        }
+        cache_stats_.recognizer_loads++;
+        recognizer_cache_.insert(recognizer_cache_.begin(), {language, recognizer});
 
-    if (!sherpa_recognizer_) {
-        RAC_LOG_ERROR("ONNX.STT", "Failed to create SherpaOnnxOfflineRecognizer");
-        return false;
+        while (recognizer_cache_.size() > recognizer_cache_size_) {
+            SherpaOnnxDestroyOfflineRecognizer(recognizer_cache_.back().recognizer);
+            recognizer_cache_.pop_back();
+            cache_stats_.evictions++;
+        }
     }
 
-    RAC_LOG_INFO("ONNX.STT", "STT model loaded successfully");
-    model_loaded_ = true;
+    sherpa_recognizer_ = recognizer_cache_.front().recognizer;
+    language_ = language;
     return true;
+}
 
-#else
-    RAC_LOG_ERROR("ONNX.STT", "Sherpa-ONNX not available - streaming STT disabled");
-    return false;
-#endif
+void ONNXSTT::destroy_recognizers() {
+    for (auto& entry : recognizer_cache_) {
+        SherpaOnnxDestroyOfflineRecognizer(entry.recognizer);
+    }
+    recognizer_cache_.clear();
+    sherpa_recognizer_ = nullptr;
+}
+
+const SherpaOnnxOnlineRecognizer* ONNXSTT::create_online_recognizer() const {
+    SherpaOnnxOnlineRecognizerConfig recognizer_config;
+    memset(&recognizer_config, 0, sizeof(recognizer_config));
+
+    recognizer_config.feat_config.sample_rate = 16000;
+    recognizer_config.feat_config.feature_dim = 80;
+
+    recognizer_config.model_config.transducer.encoder = encoder_path_.c_str();
+    recognizer_config.model_config.transducer.decoder = decoder_path_.c_str();
+    recognizer_config.model_config.transducer.joiner = joiner_path_.c_str();
+    recognizer_config.model_config.paraformer.encoder = "";
+    recognizer_config.model_config.paraformer.decoder = "";
+    recognizer_config.model_config.zipformer2_ctc.model = "";
+    recognizer_config.model_config.nemo_ctc.model = "";
+
+    recognizer_config.model_config.tokens = tokens_path_.c_str();
+    recognizer_config.model_config.num_threads = num_threads_;
+    recognizer_config.model_config.debug = backend_->is_debug() ? 1 : 0;
+    recognizer_config.model_config.provider = backend_->get_provider().c_str();
+    recognizer_config.model_config.model_type = "";
+    recognizer_config.model_config.modeling_unit = "cjkchar";
+    recognizer_config.model_config.bpe_vocab = "";
+
+    recognizer_config.decoding_method = "greedy_search";
+    recognizer_config.max_active_paths = 4;
+
+    recognizer_config.enable_endpoint = 1;
+    recognizer_config.rule1_min_trailing_silence = rule1_min_trailing_silence_;
+    recognizer_config.rule2_min_trailing_silence = rule2_min_trailing_silence_;
+    recognizer_config.rule3_min_utterance_length = rule3_min_utterance_length_;
+
+    recognizer_config.hotwords_file = "";
+    recognizer_config.hotwords_score = 1.5f;
+    recognizer_config.ctc_fst_decoder_config.graph = "";
+    recognizer_config.rule_fsts = "";
+    recognizer_config.rule_fars = "";
+    recognizer_config.blank_penalty = 0.0f;
+
+    recognizer_config.hr.dict_dir = "";
+    recognizer_config.hr.lexicon = "";
+    recognizer_config.hr.rule_fsts = "";
+
+    return SherpaOnnxCreateOnlineRecognizer(&recognizer_config);
+}
+
+void ONNXSTT::destroy_online_recognizer() {
+    for (auto& pair : online_streams_) {
+        if (pair.second.stream) {
+            SherpaOnnxDestroyOnlineStream(pair.second.stream);
+        }
+    }
+    online_streams_.clear();
+
+    if (online_recognizer_) {
+        SherpaOnnxDestroyOnlineRecognizer(online_recognizer_);
+        online_recognizer_ = nullptr;
+    }
 }
 
+void ONNXSTT::finish_online_input(const SherpaOnnxOnlineStream* stream, int sample_rate) {
+    // The encoder holds back its right context; trailing silence flushes the
+    // last words out before the stream is closed
+    std::vector<float> tail_padding(static_cast<size_t>(sample_rate * 0.66), 0.0f);
+    SherpaOnnxOnlineStreamAcceptWaveform(stream, sample_rate, tail_padding.data(),
+                                         static_cast<int32_t>(tail_padding.size()));
+    SherpaOnnxOnlineStreamInputFinished(stream);
+}
+
+STTResult ONNXSTT::transcribe_online(const STTRequest& request) {
+    STTResult result;
+    auto start_time = std::chrono::steady_clock::now();
+
+    RAC_LOG_INFO("ONNX.STT", "Transcribing %zu samples at %d Hz (streaming model)",
+                 request.audio_samples.size(), request.sample_rate);
+
+    const SherpaOnnxOnlineStream* stream = SherpaOnnxCreateOnlineStream(online_recognizer_);
+    if (!stream) {
+        RAC_LOG_ERROR("ONNX.STT", "Failed to create online stream");
+        result.text = "[Error: Failed to create stream]";
+        return result;
+    }
+
+    SherpaOnnxOnlineStreamAcceptWaveform(stream, request.sample_rate,
+                                         request.audio_samples.data(),
+                                         static_cast<int32_t>(request.audio_samples.size()));
+    finish_online_input(stream, request.sample_rate);
+
+    // Every endpoint closes a segment and restarts the hypothesis
+    auto take_segment = [&]() {
+        const SherpaOnnxOnlineRecognizerResult* recognizer_result =
+            SherpaOnnxGetOnlineStreamResult(online_recognizer_, stream);
+        if (recognizer_result && recognizer_result->text && recognizer_result->text[0] != '\0') {
+            AudioSegment segment;
+            segment.text = recognizer_result->text;
+            if (!result.text.empty()) {
+                result.text += " ";
+            }
+            result.text += segment.text;
+            result.segments.push_back(std::move(segment));
+        }
+        if (recognizer_result) {
+            SherpaOnnxDestroyOnlineRecognizerResult(recognizer_result);
+        }
+    };
+
+    while (SherpaOnnxIsOnlineStreamReady(online_recognizer_, stream)) {
+        SherpaOnnxDecodeOnlineStream(online_recognizer_, stream);
+        if (SherpaOnnxOnlineStreamIsEndpoint(online_recognizer_, stream)) {
+            take_segment();
+            SherpaOnnxOnlineStreamReset(online_recognizer_, stream);
+        }
+    }
+    take_segment();
+
+    SherpaOnnxDestroyOnlineStream(stream);
+
+    if (request.sample_rate > 0) {
+        result.audio_duration_ms =
+            request.audio_samples.size() * 1000.0 / static_cast<double>(request.sample_rate);
+    }
+    result.inference_time_ms = std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - start_time)
+                                   .count();
+
+    RAC_LOG_INFO("ONNX.STT", "Transcription result: \"%s\"", result.text.c_str());
+    return result;
+}
+
+STTResult ONNXSTT::decode_online(OnlineStream& stream) {
+    STTResult result;
+
+    while (SherpaOnnxIsOnlineStreamReady(online_recognizer_, stream.stream)) {
+        SherpaOnnxDecodeOnlineStream(online_recognizer_, stream.stream);
+    }
+
+    const SherpaOnnxOnlineRecognizerResult* recognizer_result =
+        SherpaOnnxGetOnlineStreamResult(online_recognizer_, stream.stream);
+    if (recognizer_result && recognizer_result->text) {
+        result.text = recognizer_result->text;
+    }
+    if (recognizer_result) {
+        SherpaOnnxDestroyOnlineRecognizerResult(recognizer_result);
+    }
+
+    stream.endpoint = SherpaOnnxOnlineStreamIsEndpoint(online_recognizer_, stream.stream) != 0;
+    if (stream.endpoint) {
+        SherpaOnnxOnlineStreamReset(online_recognizer_, stream.stream);
+    }
+    result.is_final = stream.endpoint || stream.input_finished;
+
+    RAC_LOG_DEBUG("ONNX.STT", "%s result: \"%s\"", result.is_final ? "Final" : "Partial",
+                  result.text.c_str());
+    return result;
+}
+
+#endif
+
 bool ONNXSTT::is_model_loaded() const {
     return model_loaded_;
 }
@@ -370,10 +867,8 @@ bool ONNXSTT::unload_model() {
     }
     sherpa_streams_.clear();
 
-    if (sherpa_recognizer_) {
-        SherpaOnnxDestroyOfflineRecognizer(sherpa_recognizer_);
-        sherpa_recognizer_ = nullptr;
-    }
+    destroy_recognizers();
+    destroy_online_recognizer();
 #endif
 
     model_loaded_ = false;
@@ -390,43 +885,26 @@ STTResult ONNXSTT::transcribe(const STTRequest& request) {
 #if SHERPA_ONNX_AVAILABLE
     const std::string effective_language = normalize_language_for_request(request);
 
-    bool needs_reload = false;
-    std::string current_language;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (!sherpa_recognizer_ || !model_loaded_) {
-            RAC_LOG_ERROR("ONNX.STT", "STT not ready for transcription");
-            result.text = "[Error: STT model not loaded]";
-            return result;
-        }
-        current_language = language_;
-        needs_reload = (effective_language != language_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (online_recognizer_ && model_loaded_) {
+        return transcribe_online(request);
+    }
+    if (!sherpa_recognizer_ || !model_loaded_) {
+        RAC_LOG_ERROR("ONNX.STT", "STT not ready for transcription");
+        result.text = "[Error: STT model not loaded]";
+        return result;
     }
 
-    if (needs_reload) {
-        if (model_dir_.empty()) {
-            RAC_LOG_ERROR("ONNX.STT", "Cannot switch language: model directory missing");
-            result.text = "[Error: STT model path missing]";
-            return result;
-        }
-
-        nlohmann::json reload_config = {{"language", effective_language}};
+    if (effective_language != language_) {
         RAC_LOG_INFO("ONNX.STT", "Switching recognizer language from %s to %s",
-                     printable_language(current_language), printable_language(effective_language));
-        if (!load_model(model_dir_, model_type_, reload_config)) {
-            RAC_LOG_ERROR("ONNX.STT", "Failed to reload model for requested language");
+                     printable_language(language_), printable_language(effective_language));
+        if (!activate_language(effective_language)) {
+            RAC_LOG_ERROR("ONNX.STT", "Failed to create recognizer for requested language");
             result.text = "[Error: Failed to switch STT language]";
             return result;
         }
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!sherpa_recognizer_ || !model_loaded_) {
-        RAC_LOG_ERROR("ONNX.STT", "STT not ready for transcription");
-        result.text = "[Error: STT model not loaded]";
-        return result;
-    }
-
     RAC_LOG_INFO("ONNX.STT", "Transcribing %zu samples at %d Hz (language=%s)",
                  request.audio_samples.size(), request.sample_rate, printable_language(language_));
 
@@ -473,7 +951,7 @@ STTResult ONNXSTT::transcribe(const STTRequest& request) {
 
 bool ONNXSTT::supports_streaming() const {
 #if SHERPA_ONNX_AVAILABLE
-    return false;
+    return online_recognizer_ != nullptr;
 #else
     return false;
 #endif
@@ -483,6 +961,24 @@ std::string ONNXSTT::create_stream(const nlohmann::json& config) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
 
+    if (online_recognizer_) {
+        const SherpaOnnxOnlineStream* stream = SherpaOnnxCreateOnlineStream(online_recognizer_);
+        if (!stream) {
+            RAC_LOG_ERROR("ONNX.STT", "Failed to create online stream");
+            return "";
+        }
+
+        std::string stream_id = "stt_stream_" + std::to_string(++stream_counter_);
+        OnlineStream& online = online_streams_[stream_id];
+        online.stream = stream;
+        if (config.contains("sample_rate")) {
+            online.sample_rate = config["sample_rate"].get<int>();
+        }
+
+        RAC_LOG_DEBUG("ONNX.STT", "Created online stream: %s", stream_id.c_str());
+        return stream_id;
+    }
+
     if (!sherpa_recognizer_) {
         RAC_LOG_ERROR("ONNX.STT", "Cannot create stream: recognizer not initialized");
         return "";
@@ -509,6 +1005,15 @@ bool ONNXSTT::feed_audio(const std::string& stream_id, const std::vector<float>&
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
 
+    auto online = online_streams_.find(stream_id);
+    if (online != online_streams_.end()) {
+        online->second.endpoint = false;
+        online->second.sample_rate = sample_rate;
+        SherpaOnnxOnlineStreamAcceptWaveform(online->second.stream, sample_rate, samples.data(),
+                                             static_cast<int32_t>(samples.size()));
+        return true;
+    }
+
     auto it = sherpa_streams_.find(stream_id);
     if (it == sherpa_streams_.end() || !it->second) {
         RAC_LOG_ERROR("ONNX.STT", "Stream not found: %s", stream_id.c_str());
@@ -527,6 +1032,9 @@ bool ONNXSTT::feed_audio(const std::string& stream_id, const std::vector<float>&
 bool ONNXSTT::is_stream_ready(const std::string& stream_id) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
+    if (online_streams_.count(stream_id) != 0) {
+        return true;
+    }
     auto it = sherpa_streams_.find(stream_id);
     return it != sherpa_streams_.end() && it->second != nullptr;
 #else
@@ -540,6 +1048,11 @@ STTResult ONNXSTT::decode(const std::string& stream_id) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
 
+    auto online = online_streams_.find(stream_id);
+    if (online != online_streams_.end()) {
+        return decode_online(online->second);
+    }
+
     auto it = sherpa_streams_.find(stream_id);
     if (it == sherpa_streams_.end() || !it->second) {
         RAC_LOG_ERROR("ONNX.STT", "Stream not found for decode: %s", stream_id.c_str());
@@ -572,15 +1085,52 @@ STTResult ONNXSTT::decode(const std::string& stream_id) {
 }
 
 bool ONNXSTT::is_endpoint(const std::string& stream_id) {
+#if SHERPA_ONNX_AVAILABLE
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // decode() resets the stream at an endpoint, so report what it saw; before
+    // the first decode, ask the recognizer directly
+    auto it = online_streams_.find(stream_id);
+    if (it == online_streams_.end()) {
+        return false;
+    }
+    return it->second.endpoint ||
+           SherpaOnnxOnlineStreamIsEndpoint(online_recognizer_, it->second.stream) != 0;
+#else
     return false;
+#endif
 }
 
-void ONNXSTT::input_finished(const std::string& stream_id) {}
+void ONNXSTT::input_finished(const std::string& stream_id) {
+#if SHERPA_ONNX_AVAILABLE
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = online_streams_.find(stream_id);
+    if (it != online_streams_.end() && !it->second.input_finished) {
+        finish_online_input(it->second.stream, it->second.sample_rate);
+        it->second.input_finished = true;
+    }
+#endif
+}
 
 void ONNXSTT::reset_stream(const std::string& stream_id) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
 
+    auto online = online_streams_.find(stream_id);
+    if (online != online_streams_.end()) {
+        // A finished stream cannot take more input, so start a fresh one
+        const int sample_rate = online->second.sample_rate;
+        SherpaOnnxDestroyOnlineStream(online->second.stream);
+        online->second = OnlineStream();
+        online->second.sample_rate = sample_rate;
+        online->second.stream = SherpaOnnxCreateOnlineStream(online_recognizer_);
+        if (!online->second.stream) {
+            online_streams_.erase(online);
+        }
+        return;
+    }
+
     auto it = sherpa_streams_.find(stream_id);
     if (it != sherpa_streams_.end() && it->second) {
         SherpaOnnxDestroyOfflineStream(it->second);
@@ -598,6 +1148,14 @@ void ONNXSTT::destroy_stream(const std::string& stream_id) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
 
+    auto online = online_streams_.find(stream_id);
+    if (online != online_streams_.end()) {
+        SherpaOnnxDestroyOnlineStream(online->second.stream);
+        online_streams_.erase(online);
+        RAC_LOG_DEBUG("ONNX.STT", "Destroyed online stream: %s", stream_id.c_str());
+        return;
+    }
+
     auto it = sherpa_streams_.find(stream_id);
     if (it != sherpa_streams_.end()) {
         if (it->second) {
@@ -613,6 +1171,11 @@ void ONNXSTT::cancel() {
     cancel_requested_ = true;
 }
 
+RecognizerCacheStats ONNXSTT::get_recognizer_cache_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_stats_;
+}
+
 std::vector<std::string> ONNXSTT::get_supported_languages() const {
     return {"en", "zh", "de",  "es", "ru", "ko", "fr", "ja", "pt", "tr", "pl", "ca", "nl",
             "ar", "sv", "it",  "id", "hi", "fi", "vi", "he", "uk", "el", "ms", "cs", "ro",
@@ -655,6 +1218,7 @@ bool ONNXTTS::load_model(const std::string& model_path, TTSModelType model_type,
     model_dir_ = model_path;
 
     RAC_LOG_INFO("ONNX.TTS", "Loading model from: %s", model_path.c_str());
+    const auto load_start = std::chrono::steady_clock::now();
 
     std::string model_onnx_path;
     std::string tokens_path;
@@ -728,6 +1292,8 @@ bool ONNXTTS::load_model(const std::string& model_path, TTSModelType model_type,
         return false;
     }
 
+    const char* load_mode = use_optimized_models(backend_, {&model_onnx_path});
+
     SherpaOnnxOfflineTtsConfig tts_config;
     memset(&tts_config, 0, sizeof(tts_config));
 
@@ -748,9 +1314,13 @@ bool ONNXTTS::load_model(const std::string& model_path, TTSModelType model_type,
     tts_config.model.vits.noise_scale_w = 0.8f;
     tts_config.model.vits.length_scale = 1.0f;
 
-    tts_config.model.provider = "cpu";
-    tts_config.model.num_threads = 2;
-    tts_config.model.debug = 1;
+    tts_config.model.provider = backend_->get_provider().c_str();
+    tts_config.model.num_threads = backend_->sherpa_num_threads(
+        config.contains("num_threads") ? config["num_threads"].get<int>() : 0);
+    tts_config.model.debug = backend_->is_debug() ? 1 : 0;
+
+    // One sentence per progress callback keeps cancellation latency to a sentence
+    tts_config.max_num_sentences = 1;
 
     RAC_LOG_INFO("ONNX.TTS", "Creating SherpaOnnxOfflineTts...");
 
@@ -775,7 +1345,8 @@ bool ONNXTTS::load_model(const std::string& model_path, TTSModelType model_type,
     sample_rate_ = SherpaOnnxOfflineTtsSampleRate(sherpa_tts_);
     int num_speakers = SherpaOnnxOfflineTtsNumSpeakers(sherpa_tts_);
 
-    RAC_LOG_INFO("ONNX.TTS", "TTS model loaded successfully");
+    RAC_LOG_INFO("ONNX.TTS", "TTS model ready in %.0fms (%s)", elapsed_ms(load_start),
+                 load_mode);
     RAC_LOG_INFO("ONNX.TTS", "Sample rate: %d, speakers: %d", sample_rate_, num_speakers);
 
     voices_.clear();
@@ -830,58 +1401,74 @@ TTSModelType ONNXTTS::get_model_type() const {
     return model_type_;
 }
 
-TTSResult ONNXTTS::synthesize(const TTSRequest& request) {
-    TTSResult result;
-
 #if SHERPA_ONNX_AVAILABLE
-    struct SynthesisGuard {
-        std::atomic<int>& count_;
-        SynthesisGuard(std::atomic<int>& count) : count_(count) { count_++; }
-        ~SynthesisGuard() { count_--; }
-    };
-    SynthesisGuard guard(active_synthesis_count_);
+const SherpaOnnxOfflineTts* ONNXTTS::acquire_tts() const {
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    const SherpaOnnxOfflineTts* tts_ptr = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
+    if (!sherpa_tts_ || !model_loaded_) {
+        RAC_LOG_ERROR("ONNX.TTS", "TTS not ready for synthesis");
+        return nullptr;
+    }
+    return sherpa_tts_;
+}
 
-        if (!sherpa_tts_ || !model_loaded_) {
-            RAC_LOG_ERROR("ONNX.TTS", "TTS not ready for synthesis");
-            return result;
+bool ONNXTTS::generate(const SherpaOnnxOfflineTts* tts, const std::string& text, int speaker_id,
+                       float speed, uint64_t generation, TTSResult& out) {
+    CancelCheck check{cancel_generation_, generation};
+    const SherpaOnnxGeneratedAudio* audio = SherpaOnnxOfflineTtsGenerateWithProgressCallbackWithArg(
+        tts, text.c_str(), speaker_id, speed, continue_unless_cancelled, &check);
+
+    if (cancel_generation_.load() != generation) {
+        RAC_LOG_INFO("ONNX.TTS", "Synthesis cancelled");
+        if (audio) {
+            SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
         }
+        out.cancelled = true;
+        return false;
+    }
 
-        tts_ptr = sherpa_tts_;
+    if (!audio || audio->n <= 0) {
+        RAC_LOG_ERROR("ONNX.TTS", "Failed to generate audio");
+        if (audio) {
+            SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+        }
+        return false;
     }
 
-    RAC_LOG_INFO("ONNX.TTS", "Synthesizing: \"%s...\"", request.text.substr(0, 50).c_str());
+    RAC_LOG_INFO("ONNX.TTS", "Generated %d samples at %d Hz", audio->n, audio->sample_rate);
 
-    int speaker_id = 0;
-    if (!request.voice_id.empty()) {
-        try {
-            speaker_id = std::stoi(request.voice_id);
-        } catch (...) {}
-    }
+    out.audio_samples.assign(audio->samples, audio->samples + audio->n);
+    out.sample_rate = audio->sample_rate;
+    out.duration_ms =
+        (static_cast<double>(audio->n) / static_cast<double>(audio->sample_rate)) * 1000.0;
 
-    float speed = request.speed_rate > 0 ? request.speed_rate : 1.0f;
+    SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+    return true;
+}
+#endif
 
-    RAC_LOG_DEBUG("ONNX.TTS", "Speaker ID: %d, Speed: %.2f", speaker_id, speed);
+TTSResult ONNXTTS::synthesize(const TTSRequest& request) {
+    TTSResult result;
 
-    const SherpaOnnxGeneratedAudio* audio =
-        SherpaOnnxOfflineTtsGenerate(tts_ptr, request.text.c_str(), speaker_id, speed);
+#if SHERPA_ONNX_AVAILABLE
+    SynthesisGuard guard(active_synthesis_count_);
+    const uint64_t generation = cancel_generation_.load();
 
-    if (!audio || audio->n <= 0) {
-        RAC_LOG_ERROR("ONNX.TTS", "Failed to generate audio");
+    const SherpaOnnxOfflineTts* tts_ptr = acquire_tts();
+    if (!tts_ptr) {
         return result;
     }
 
-    RAC_LOG_INFO("ONNX.TTS", "Generated %d samples at %d Hz", audio->n, audio->sample_rate);
+    RAC_LOG_INFO("ONNX.TTS", "Synthesizing: \"%s...\"", request.text.substr(0, 50).c_str());
 
-    result.audio_samples.assign(audio->samples, audio->samples + audio->n);
-    result.sample_rate = audio->sample_rate;
-    result.duration_ms =
-        (static_cast<double>(audio->n) / static_cast<double>(audio->sample_rate)) * 1000.0;
+    const int speaker_id = parse_speaker_id(request.voice_id);
+    const float speed = request.speed_rate > 0 ? request.speed_rate : 1.0f;
 
-    SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+    RAC_LOG_DEBUG("ONNX.TTS", "Speaker ID: %d, Speed: %.2f", speaker_id, speed);
+
+    if (!generate(tts_ptr, request.text, speaker_id, speed, generation, result)) {
+        return result;
+    }
 
     RAC_LOG_INFO("ONNX.TTS", "Synthesis complete. Duration: %.2fs", (result.duration_ms / 1000.0));
 
@@ -892,12 +1479,70 @@ TTSResult ONNXTTS::synthesize(const TTSRequest& request) {
     return result;
 }
 
-bool ONNXTTS::supports_streaming() const {
+bool ONNXTTS::synthesize_stream(const TTSRequest& request, const ChunkCallback& on_chunk,
+                                bool* cancelled) {
+    if (cancelled) {
+        *cancelled = false;
+    }
+
+#if SHERPA_ONNX_AVAILABLE
+    SynthesisGuard guard(active_synthesis_count_);
+    const uint64_t generation = cancel_generation_.load();
+
+    const SherpaOnnxOfflineTts* tts_ptr = acquire_tts();
+    if (!tts_ptr) {
+        return false;
+    }
+
+    const int speaker_id = parse_speaker_id(request.voice_id);
+    const float speed = request.speed_rate > 0 ? request.speed_rate : 1.0f;
+
+    const std::vector<std::string> sentences = split_sentences(request.text);
+    RAC_LOG_INFO("ONNX.TTS", "Streaming synthesis of %zu sentence(s)", sentences.size());
+
+    bool produced = false;
+    for (const auto& sentence : sentences) {
+        auto start_time = std::chrono::steady_clock::now();
+
+        TTSResult chunk;
+        if (!generate(tts_ptr, sentence, speaker_id, speed, generation, chunk)) {
+            if (chunk.cancelled) {
+                if (cancelled) {
+                    *cancelled = true;
+                }
+                break;
+            }
+            // A sentence of only punctuation or symbols can yield no audio
+            continue;
+        }
+        chunk.inference_time_ms = std::chrono::duration<double, std::milli>(
+                                      std::chrono::steady_clock::now() - start_time)
+                                      .count();
+        produced = true;
+
+        if (on_chunk && !on_chunk(chunk)) {
+            RAC_LOG_INFO("ONNX.TTS", "Streaming synthesis stopped by consumer");
+            break;
+        }
+    }
+    return produced;
+
+#else
+    RAC_LOG_ERROR("ONNX.TTS", "Sherpa-ONNX not available");
     return false;
+#endif
+}
+
+bool ONNXTTS::supports_streaming() const {
+    return is_ready();
 }
 
 void ONNXTTS::cancel() {
-    cancel_requested_ = true;
+    if (active_synthesis_count_ > 0) {
+        RAC_LOG_INFO("ONNX.TTS", "Cancelling %d synthesis operation(s)",
+                     active_synthesis_count_.load());
+    }
+    cancel_generation_++;
 }
 
 std::vector<VoiceInfo> ONNXTTS::get_voices() const {
@@ -913,7 +1558,9 @@ std::string ONNXTTS::get_default_voice(const std::string& language) const {
 // ONNXVAD Implementation
 // =============================================================================
 
-ONNXVAD::ONNXVAD(ONNXBackendNew* backend) : backend_(backend) {}
+ONNXVAD::ONNXVAD(ONNXBackendNew* backend) : backend_(backend) {
+    default_stream_ = make_stream(config_);
+}
 
 ONNXVAD::~ONNXVAD() {
     unload_model();
@@ -926,7 +1573,67 @@ bool ONNXVAD::is_ready() const {
 bool ONNXVAD::load_model(const std::string& model_path, VADModelType model_type,
                          const nlohmann::json& config) {
     std::lock_guard<std::mutex> lock(mutex_);
-    model_loaded_ = true;
+
+    if (model_type != VADModelType::SILERO) {
+        RAC_LOG_ERROR("ONNX.VAD", "Only Silero VAD models are supported");
+        return false;
+    }
+
+    if (config.contains("threshold")) {
+        config_.threshold = config["threshold"].get<float>();
+    } else if (config.contains("energy_threshold")) {
+        config_.threshold = config["energy_threshold"].get<float>();
+    }
+    if (config.contains("min_speech_duration_ms")) {
+        config_.min_speech_duration_ms = config["min_speech_duration_ms"].get<int>();
+    }
+    if (config.contains("min_silence_duration_ms")) {
+        config_.min_silence_duration_ms = config["min_silence_duration_ms"].get<int>();
+    }
+    if (config.contains("padding_ms")) {
+        config_.padding_ms = config["padding_ms"].get<int>();
+    }
+    if (config.contains("max_batch_size") && config["max_batch_size"].get<int>() > 0) {
+        max_batch_size_ = config["max_batch_size"].get<int>();
+    }
+
+    // Model directories ship the graph as silero_vad.onnx
+    std::string path = model_path;
+    struct stat path_stat;
+    if (stat(path.c_str(), &path_stat) == 0 && S_ISDIR(path_stat.st_mode)) {
+        path += "/silero_vad.onnx";
+    }
+
+    if (!model_) {
+        model_ = std::make_unique<SileroVadModel>(backend_->get_ort_api(),
+                                                  backend_->get_ort_env());
+    }
+    const auto load_start = std::chrono::steady_clock::now();
+    const OptimizedModel optimized = backend_->resolve_model(path, ORT_ENABLE_EXTENDED);
+    const bool pre_optimized = optimized.from_cache || optimized.created;
+    model_loaded_ = model_->load(optimized.path, backend_->get_num_threads(),
+                                 backend_->uses_global_thread_pools(), pre_optimized);
+    if (!model_loaded_ && pre_optimized) {
+        // A damaged cache entry must not take VAD down with it
+        model_loaded_ = model_->load(path, backend_->get_num_threads(),
+                                     backend_->uses_global_thread_pools(), false);
+    }
+    if (!model_loaded_) {
+        RAC_LOG_ERROR("ONNX.VAD", "Failed to load Silero VAD model: %s", path.c_str());
+        return false;
+    }
+
+    default_stream_->config = config_;
+    reset_stream(*default_stream_);
+    for (auto& [id, stream] : streams_) {
+        reset_stream(*stream);
+    }
+
+    RAC_LOG_INFO("ONNX.VAD", "Silero VAD ready in %.0fms (%s)", elapsed_ms(load_start),
+                 describe_model_cache(optimized.created, optimized.from_cache));
+    RAC_LOG_INFO("ONNX.VAD", "Threshold %.2f, min speech %dms, min silence %dms",
+                 config_.threshold, config_.min_speech_duration_ms,
+                 config_.min_silence_duration_ms);
     return true;
 }
 
@@ -936,39 +1643,289 @@ bool ONNXVAD::is_model_loaded() const {
 
 bool ONNXVAD::unload_model() {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (model_) {
+        model_->unload();
+    }
     model_loaded_ = false;
     return true;
 }
 
 bool ONNXVAD::configure_vad(const VADConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
     config_ = config;
+    default_stream_->config = config;
     return true;
 }
 
+std::unique_ptr<ONNXVAD::VADStream> ONNXVAD::make_stream(const VADConfig& config) const {
+    auto stream = std::make_unique<VADStream>();
+    stream->config = config;
+    stream->sample_rate = config.sample_rate;
+    reset_stream(*stream);
+    return stream;
+}
+
+void ONNXVAD::reset_stream(VADStream& stream) const {
+    const bool loaded = model_ && model_->is_loaded();
+    stream.pending.clear();
+    stream.context.assign(loaded ? model_->context_samples(stream.sample_rate) : 0, 0.0f);
+    stream.model_state.assign(loaded ? model_->state_size() : 0, 0.0f);
+    stream.processed_samples = 0;
+    stream.triggered = false;
+    stream.speech_start = 0;
+    stream.silence_start = -1;
+    stream.speech_prob_sum = 0.0f;
+    stream.speech_frames = 0;
+}
+
+void ONNXVAD::close_segment(VADStream& stream, int64_t end_sample, int sample_rate,
+                            std::vector<SpeechSegment>& segments) const {
+    const int64_t min_speech =
+        static_cast<int64_t>(stream.config.min_speech_duration_ms) * sample_rate / 1000;
+    const int64_t padding = static_cast<int64_t>(stream.config.padding_ms) * sample_rate / 1000;
+
+    if (end_sample - stream.speech_start >= min_speech) {
+        SpeechSegment segment;
+        const int64_t start = std::max<int64_t>(0, stream.speech_start - padding);
+        const int64_t end = std::min(stream.processed_samples, end_sample + padding);
+        segment.start_time_ms = start * 1000.0 / sample_rate;
+        segment.end_time_ms = end * 1000.0 / sample_rate;
+        segment.confidence = stream.speech_frames > 0
+                                 ? stream.speech_prob_sum / static_cast<float>(stream.speech_frames)
+                                 : 0.0f;
+        segments.push_back(segment);
+    }
+
+    stream.triggered = false;
+    stream.silence_start = -1;
+    stream.speech_prob_sum = 0.0f;
+    stream.speech_frames = 0;
+}
+
+void ONNXVAD::advance(VADStream& stream, float probability, int sample_rate,
+                      std::vector<SpeechSegment>& segments) const {
+    const int64_t frame_start = stream.processed_samples;
+    stream.processed_samples += static_cast<int64_t>(model_->frame_samples(sample_rate));
+
+    // Speech starts above the threshold but only ends below a lower one, so
+    // probabilities hovering around the threshold do not split segments
+    const float threshold = stream.config.threshold;
+    const float neg_threshold = std::max(threshold - 0.15f, 0.01f);
+
+    if (probability >= threshold) {
+        stream.silence_start = -1;
+        if (!stream.triggered) {
+            stream.triggered = true;
+            stream.speech_start = frame_start;
+        }
+    }
+    if (stream.triggered) {
+        stream.speech_prob_sum += probability;
+        ++stream.speech_frames;
+    }
+
+    if (stream.triggered && probability < neg_threshold) {
+        if (stream.silence_start < 0) {
+            stream.silence_start = frame_start;
+        }
+        const int64_t min_silence =
+            static_cast<int64_t>(stream.config.min_silence_duration_ms) * sample_rate / 1000;
+        if (stream.processed_samples - stream.silence_start >= min_silence) {
+            close_segment(stream, stream.silence_start, sample_rate, segments);
+        }
+    }
+}
+
+std::vector<VADResult> ONNXVAD::run_streams(const std::vector<VADStream*>& streams,
+                                            const std::vector<const std::vector<float>*>& samples,
+                                            int sample_rate) {
+    std::vector<VADResult> results(streams.size());
+    if (!model_loaded_ || streams.empty() || sample_rate <= 0) {
+        return results;
+    }
+
+    // Rates the graph does not support are resampled to 16kHz
+    const int rate = SileroVadModel::supports_sample_rate(sample_rate) ? sample_rate : 16000;
+    const size_t frame = model_->frame_samples(rate);
+    const size_t context = model_->context_samples(rate);
+    const size_t row = context + frame;
+    const size_t state = model_->state_size();
+
+    for (size_t i = 0; i < streams.size(); ++i) {
+        VADStream& stream = *streams[i];
+        if (stream.sample_rate != rate || stream.model_state.size() != state) {
+            stream.sample_rate = rate;
+            reset_stream(stream);
+        }
+        if (rate == sample_rate) {
+            stream.pending.insert(stream.pending.end(), samples[i]->begin(), samples[i]->end());
+        } else {
+            std::vector<float> resampled = resample_linear(*samples[i], sample_rate, rate);
+            stream.pending.insert(stream.pending.end(), resampled.begin(), resampled.end());
+        }
+    }
+
+    std::vector<size_t> consumed(streams.size(), 0);
+    std::vector<size_t> ready;
+    std::vector<float> inputs;
+    std::vector<float> states;
+    std::vector<float> probs;
+    const size_t max_batch = static_cast<size_t>(std::max(1, max_batch_size_));
+
+    bool failed = false;
+    while (!failed) {
+        ready.clear();
+        for (size_t i = 0; i < streams.size(); ++i) {
+            if (streams[i]->pending.size() - consumed[i] >= frame) {
+                ready.push_back(i);
+            }
+        }
+        if (ready.empty()) {
+            break;
+        }
+
+        for (size_t begin = 0; begin < ready.size() && !failed; begin += max_batch) {
+            const size_t count = std::min(max_batch, ready.size() - begin);
+            inputs.resize(count * row);
+            states.resize(count * state);
+            probs.resize(count);
+
+            for (size_t j = 0; j < count; ++j) {
+                const size_t i = ready[begin + j];
+                const VADStream& stream = *streams[i];
+                float* input = inputs.data() + j * row;
+                std::copy(stream.context.begin(), stream.context.end(), input);
+                std::copy_n(stream.pending.begin() + consumed[i], frame, input + context);
+                std::copy(stream.model_state.begin(), stream.model_state.end(),
+                          states.begin() + j * state);
+            }
+
+            if (!model_->run(rate, count, inputs.data(), states.data(), probs.data())) {
+                failed = true;
+                break;
+            }
+
+            for (size_t j = 0; j < count; ++j) {
+                const size_t i = ready[begin + j];
+                VADStream& stream = *streams[i];
+                const float* input = inputs.data() + j * row;
+                std::copy(input + row - context, input + row, stream.context.begin());
+                std::copy_n(states.begin() + j * state, state, stream.model_state.begin());
+                consumed[i] += frame;
+
+                advance(stream, probs[j], rate, results[i].segments);
+                results[i].probability = probs[j];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < streams.size(); ++i) {
+        VADStream& stream = *streams[i];
+        stream.pending.erase(stream.pending.begin(), stream.pending.begin() + consumed[i]);
+        results[i].is_speech = stream.triggered;
+        results[i].timestamp_ms = stream.processed_samples * 1000.0 / rate;
+    }
+
+    if (failed) {
+        RAC_LOG_ERROR("ONNX.VAD", "Silero VAD inference failed");
+    }
+    return results;
+}
+
 VADResult ONNXVAD::process(const std::vector<float>& audio_samples, int sample_rate) {
-    VADResult result;
-    return result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return run_streams({default_stream_.get()}, {&audio_samples}, sample_rate).front();
 }
 
 std::vector<SpeechSegment> ONNXVAD::detect_segments(const std::vector<float>& audio_samples,
                                                     int sample_rate) {
-    return {};
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto stream = make_stream(config_);
+    VADResult result = run_streams({stream.get()}, {&audio_samples}, sample_rate).front();
+
+    // Speech still open at the end of the clip ends with the clip
+    if (stream->triggered) {
+        close_segment(*stream, stream->processed_samples, stream->sample_rate, result.segments);
+    }
+    return result.segments;
 }
 
 std::string ONNXVAD::create_stream(const VADConfig& config) {
-    return "";
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string stream_id = "vad_stream_" + std::to_string(++next_stream_id_);
+    streams_[stream_id] = make_stream(config);
+    return stream_id;
 }
 
 VADResult ONNXVAD::feed_audio(const std::string& stream_id, const std::vector<float>& samples,
                               int sample_rate) {
-    return {};
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+        RAC_LOG_ERROR("ONNX.VAD", "Unknown VAD stream: %s", stream_id.c_str());
+        return {};
+    }
+    return run_streams({it->second.get()}, {&samples}, sample_rate).front();
+}
+
+std::vector<VADResult> ONNXVAD::feed_audio_batch(const std::vector<std::string>& stream_ids,
+                                                 const std::vector<std::vector<float>>& samples,
+                                                 int sample_rate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stream_ids.size() != samples.size()) {
+        RAC_LOG_ERROR("ONNX.VAD", "feed_audio_batch: %zu streams but %zu buffers",
+                      stream_ids.size(), samples.size());
+        return std::vector<VADResult>(stream_ids.size());
+    }
+
+    std::vector<VADStream*> streams;
+    std::vector<const std::vector<float>*> buffers;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < stream_ids.size(); ++i) {
+        auto it = streams_.find(stream_ids[i]);
+        if (it == streams_.end()) {
+            RAC_LOG_ERROR("ONNX.VAD", "Unknown VAD stream: %s", stream_ids[i].c_str());
+            continue;
+        }
+        if (std::find(streams.begin(), streams.end(), it->second.get()) != streams.end()) {
+            RAC_LOG_ERROR("ONNX.VAD", "VAD stream fed twice in one batch: %s",
+                          stream_ids[i].c_str());
+            continue;
+        }
+        streams.push_back(it->second.get());
+        buffers.push_back(&samples[i]);
+        positions.push_back(i);
+    }
+
+    std::vector<VADResult> batch = run_streams(streams, buffers, sample_rate);
+    std::vector<VADResult> results(stream_ids.size());
+    for (size_t j = 0; j < positions.size(); ++j) {
+        results[positions[j]] = std::move(batch[j]);
+    }
+    return results;
 }
 
-void ONNXVAD::destroy_stream(const std::string& stream_id) {}
+void ONNXVAD::destroy_stream(const std::string& stream_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.erase(stream_id);
+}
 
-void ONNXVAD::reset() {}
+bool ONNXVAD::is_speech_active() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return default_stream_->triggered;
+}
+
+void ONNXVAD::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reset_stream(*default_stream_);
+    for (auto& [id, stream] : streams_) {
+        reset_stream(*stream);
+    }
+}
 
 VADConfig ONNXVAD::get_vad_config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return config_;
 }
 
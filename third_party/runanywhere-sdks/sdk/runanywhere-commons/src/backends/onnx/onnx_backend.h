@@ -14,6 +14,7 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -21,6 +22,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include "ort_model_cache.h"
+#include "silero_vad.h"
+
 // Sherpa-ONNX C API for TTS/STT
 #if SHERPA_ONNX_AVAILABLE
 #include <sherpa-onnx/c-api/c-api.h>
@@ -85,6 +89,13 @@ struct STTResult {
     bool is_final = true;
 };
 
+struct RecognizerCacheStats {
+    uint64_t language_switches = 0;
+    uint64_t recognizer_loads = 0;  // Recognizers built from disk, including the first
+    uint64_t reloads_avoided = 0;   // Language switches served from the cache
+    uint64_t evictions = 0;
+};
+
 // =============================================================================
 // TTS TYPES
 // =============================================================================
@@ -120,6 +131,7 @@ struct TTSResult {
     int channels = 1;
     double duration_ms = 0.0;
     double inference_time_ms = 0.0;
+    bool cancelled = false;
 };
 
 // =============================================================================
@@ -207,6 +219,27 @@ class ONNXBackendNew {
     const OrtApi* get_ort_api() const { return ort_api_; }
     OrtEnv* get_ort_env() const { return ort_env_; }
 
+    // Session settings shared by the STT/TTS/VAD models this backend loads
+    int get_num_threads() const { return num_threads_; }
+    const std::string& get_provider() const { return provider_; }
+    bool is_debug() const { return debug_; }
+
+    // True when the OrtEnv owns process-wide intra/inter-op pools. Sessions created
+    // here opt in with DisablePerSessionThreads; sherpa-onnx builds its own session
+    // options, so its models keep per-session pools sized by sherpa_num_threads()
+    bool uses_global_thread_pools() const { return global_thread_pools_; }
+
+    // Intra-op threads for a sherpa-onnx model that asked for `requested` (0 = the
+    // backend setting). With global pools on, num_threads is the thread budget, so a
+    // per-model override cannot give sherpa's own pools more than that
+    int sherpa_num_threads(int requested) const;
+
+    // File a session should load for model_path: its cached optimized graph
+    // (see ort_model_cache.h) when the cache is enabled and the provider is the
+    // CPU, whose fused kernels the saved graph may depend on; model_path otherwise
+    OptimizedModel resolve_model(const std::string& model_path,
+                                 GraphOptimizationLevel level) const;
+
     const DeviceInfo& get_device_info() const { return device_info_; }
 
     void set_telemetry_callback(TelemetryCallback callback);
@@ -218,12 +251,18 @@ class ONNXBackendNew {
 
    private:
     bool initialize_ort();
+    bool create_env_with_global_thread_pools();
     void create_capabilities();
 
     bool initialized_ = false;
     const OrtApi* ort_api_ = nullptr;
     OrtEnv* ort_env_ = nullptr;
     nlohmann::json config_;
+    int num_threads_ = 2;
+    std::string provider_ = "cpu";
+    bool debug_ = false;
+    bool global_thread_pools_ = false;
+    bool model_cache_ = true;
     DeviceInfo device_info_;
     TelemetryCollector telemetry_;
 
@@ -265,15 +304,61 @@ class ONNXSTT {
     void cancel();
     std::vector<std::string> get_supported_languages() const;
 
+    RecognizerCacheStats get_recognizer_cache_stats() const;
+
    private:
+#if SHERPA_ONNX_AVAILABLE
+    const SherpaOnnxOfflineRecognizer* create_recognizer(const std::string& language) const;
+    bool activate_language(const std::string& language);
+    void destroy_recognizers();
+
+    // Recognizers are language-specific for whisper; keep the recently used ones
+    // so alternating languages does not rebuild the encoder/decoder every request
+    struct CachedRecognizer {
+        std::string language;
+        const SherpaOnnxOfflineRecognizer* recognizer = nullptr;
+    };
+
+    // Zipformer/transducer models decode incrementally on the online recognizer.
+    // Each decode only consumes the frames fed since the last one, and the
+    // hypothesis restarts at every endpoint, so per-chunk work stays bounded
+    struct OnlineStream {
+        const SherpaOnnxOnlineStream* stream = nullptr;
+        bool endpoint = false;        // Last decode hit an endpoint (and reset the stream)
+        bool input_finished = false;
+        int sample_rate = 16000;  // Rate of the last fed audio, for the tail padding
+    };
+
+    const SherpaOnnxOnlineRecognizer* create_online_recognizer() const;
+    void destroy_online_recognizer();
+    void finish_online_input(const SherpaOnnxOnlineStream* stream, int sample_rate);
+    STTResult transcribe_online(const STTRequest& request);
+    STTResult decode_online(OnlineStream& stream);
+#endif
+
     ONNXBackendNew* backend_;
     OrtSession* whisper_session_ = nullptr;
 #if SHERPA_ONNX_AVAILABLE
     const SherpaOnnxOfflineRecognizer* sherpa_recognizer_ = nullptr;
     std::unordered_map<std::string, const SherpaOnnxOfflineStream*> sherpa_streams_;
+    std::vector<CachedRecognizer> recognizer_cache_;  // Most recently used first
+    const SherpaOnnxOnlineRecognizer* online_recognizer_ = nullptr;
+    std::unordered_map<std::string, OnlineStream> online_streams_;
 #else
     void* sherpa_recognizer_ = nullptr;
 #endif
+    size_t recognizer_cache_size_ = 2;
+    int num_threads_ = 2;
+    RecognizerCacheStats cache_stats_;
+    std::string encoder_path_;
+    std::string decoder_path_;
+    std::string tokens_path_;
+    std::string joiner_path_;
+    // Endpoint rules (seconds): trailing silence with nothing decoded, trailing
+    // silence after some text, and the longest utterance before a forced endpoint
+    float rule1_min_trailing_silence_ = 2.4f;
+    float rule2_min_trailing_silence_ = 1.2f;
+    float rule3_min_utterance_length_ = 20.0f;
     STTModelType model_type_ = STTModelType::WHISPER;
     bool model_loaded_ = false;
     std::atomic<bool> cancel_requested_{false};
@@ -303,11 +388,24 @@ class ONNXTTS {
     TTSResult synthesize(const TTSRequest& request);
     bool supports_streaming() const;
 
+    // Synthesizes sentence by sentence, handing each chunk over as soon as it is
+    // generated. Returning false from on_chunk stops after the current chunk.
+    using ChunkCallback = std::function<bool(const TTSResult& chunk)>;
+    bool synthesize_stream(const TTSRequest& request, const ChunkCallback& on_chunk,
+                           bool* cancelled = nullptr);
+
+    // Stops every synthesis in flight once its current sentence is generated
     void cancel();
     std::vector<VoiceInfo> get_voices() const;
     std::string get_default_voice(const std::string& language) const;
 
    private:
+#if SHERPA_ONNX_AVAILABLE
+    const SherpaOnnxOfflineTts* acquire_tts() const;
+    bool generate(const SherpaOnnxOfflineTts* tts, const std::string& text, int speaker_id,
+                  float speed, uint64_t generation, TTSResult& out);
+#endif
+
     ONNXBackendNew* backend_;
 #if SHERPA_ONNX_AVAILABLE
     const SherpaOnnxOfflineTts* sherpa_tts_ = nullptr;
@@ -316,7 +414,9 @@ class ONNXTTS {
 #endif
     TTSModelType model_type_ = TTSModelType::PIPER;
     bool model_loaded_ = false;
-    std::atomic<bool> cancel_requested_{false};
+    // Bumped by cancel(); a synthesis is cancelled once it differs from the
+    // value seen at its start, so concurrent requests are all stopped
+    std::atomic<uint64_t> cancel_generation_{0};
     std::atomic<int> active_synthesis_count_{0};
     std::vector<VoiceInfo> voices_;
     std::string model_dir_;
@@ -340,6 +440,8 @@ class ONNXVAD {
     bool unload_model();
 
     bool configure_vad(const VADConfig& config);
+
+    // Runs on an internal stream, so consecutive calls keep the model state
     VADResult process(const std::vector<float>& audio_samples, int sample_rate);
     std::vector<SpeechSegment> detect_segments(const std::vector<float>& audio_samples, int sample_rate);
 
@@ -347,14 +449,54 @@ class ONNXVAD {
     VADResult feed_audio(const std::string& stream_id, const std::vector<float>& samples, int sample_rate);
     void destroy_stream(const std::string& stream_id);
 
+    // Feeds audio to several streams and evaluates their frames together, one
+    // session run per frame step instead of one per stream
+    std::vector<VADResult> feed_audio_batch(const std::vector<std::string>& stream_ids,
+                                            const std::vector<std::vector<float>>& samples,
+                                            int sample_rate);
+
+    // True while the internal stream used by process() is inside a speech segment
+    bool is_speech_active() const;
+
     void reset();
     VADConfig get_vad_config() const;
 
    private:
+    struct VADStream {
+        VADConfig config;
+        std::vector<float> pending;      // Samples not yet part of a frame
+        std::vector<float> context;      // Tail of the previous frame (Silero v5)
+        std::vector<float> model_state;  // Recurrent tensors between frames
+        int sample_rate = 16000;         // Rate the model runs at for this stream
+        int64_t processed_samples = 0;
+
+        // Hysteresis
+        bool triggered = false;
+        int64_t speech_start = 0;
+        int64_t silence_start = -1;  // First sample of the current silence run, if any
+        float speech_prob_sum = 0.0f;
+        int speech_frames = 0;
+    };
+
+    std::unique_ptr<VADStream> make_stream(const VADConfig& config) const;
+    void reset_stream(VADStream& stream) const;
+    std::vector<VADResult> run_streams(const std::vector<VADStream*>& streams,
+                                       const std::vector<const std::vector<float>*>& samples,
+                                       int sample_rate);
+    void advance(VADStream& stream, float probability, int sample_rate,
+                 std::vector<SpeechSegment>& segments) const;
+    void close_segment(VADStream& stream, int64_t end_sample, int sample_rate,
+                       std::vector<SpeechSegment>& segments) const;
+
     ONNXBackendNew* backend_;
-    void* sherpa_vad_ = nullptr;
+    std::unique_ptr<SileroVadModel> model_;
     VADConfig config_;
     bool model_loaded_ = false;
+    int max_batch_size_ = 32;
+
+    std::unique_ptr<VADStream> default_stream_;
+    std::unordered_map<std::string, std::unique_ptr<VADStream>> streams_;
+    uint64_t next_stream_id_ = 0;
     mutable std::mutex mutex_;
 };
 
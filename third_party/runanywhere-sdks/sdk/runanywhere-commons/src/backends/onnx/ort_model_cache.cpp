@@ -0,0 +1,194 @@
+/**
+ * Optimized ONNX model cache - Implementation
+ */
+
+#include "ort_model_cache.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+#include "rac/core/rac_logger.h"
+
+namespace runanywhere {
+
+namespace {
+
+constexpr const char* kSuffix = ".optimized";
+
+// Bumped when the layout of cache files changes (2: ort_config stamp)
+constexpr int kCacheFormat = 2;
+
+// Session options ORT applies from the model under ORT_LOAD_CONFIG_FROM_MODEL;
+// 0 is ORT_DISABLE_ALL
+constexpr const char* kOrtConfigKey = "ort_config";
+constexpr const char* kOrtConfig = "{\"session_options\":{\"graph_optimization_level\":0}}";
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool ends_with(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Drops entries left behind by older ORT versions or replaced models
+void remove_stale_entries(const std::string& model_path, const std::string& keep) {
+    const size_t slash = model_path.find_last_of('/');
+    const std::string dir = slash == std::string::npos ? "." : model_path.substr(0, slash);
+    const std::string prefix =
+        (slash == std::string::npos ? model_path : model_path.substr(slash + 1)) + ".";
+
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) {
+        return;
+    }
+    while (struct dirent* entry = readdir(handle)) {
+        const std::string name = entry->d_name;
+        const std::string path = dir + "/" + name;
+        if (name.compare(0, prefix.size(), prefix) == 0 && ends_with(name, kSuffix) &&
+            path != keep) {
+            std::remove(path.c_str());
+        }
+    }
+    closedir(handle);
+}
+
+void append_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void append_bytes_field(std::string& out, int field, const std::string& bytes) {
+    append_varint(out, static_cast<uint64_t>(field) << 3 | 2);  // Length-delimited
+    append_varint(out, bytes.size());
+    out += bytes;
+}
+
+/**
+ * Adds a ModelProto.metadata_props entry (field 14) to a saved ONNX model.
+ * Protobuf merges repeated fields across concatenated messages, so appending
+ * the serialized entry is enough.
+ */
+bool stamp_ort_config(const std::string& path) {
+    std::string entry;
+    append_bytes_field(entry, 1, kOrtConfigKey);  // StringStringEntryProto.key
+    append_bytes_field(entry, 2, kOrtConfig);     // StringStringEntryProto.value
+    std::string field;
+    append_bytes_field(field, 14, entry);
+
+    FILE* file = fopen(path.c_str(), "ab");
+    if (!file) {
+        return false;
+    }
+    const bool ok = fwrite(field.data(), 1, field.size(), file) == field.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool optimize(const OrtApi* api, OrtEnv* env, const std::string& model_path,
+              GraphOptimizationLevel level, const std::string& output_path) {
+    OrtSessionOptions* options = nullptr;
+    OrtSession* session = nullptr;
+    OrtStatus* status = api->CreateSessionOptions(&options);
+    if (!status) {
+        status = api->SetSessionGraphOptimizationLevel(options, level);
+    }
+    if (!status) {
+        status = api->SetIntraOpNumThreads(options, 1);
+    }
+    if (!status) {
+        status = api->SetOptimizedModelFilePath(options, output_path.c_str());
+    }
+    if (!status) {
+        status = api->CreateSession(env, model_path.c_str(), options, &session);
+    }
+
+    if (session) {
+        api->ReleaseSession(session);
+    }
+    if (options) {
+        api->ReleaseSessionOptions(options);
+    }
+    if (status) {
+        RAC_LOG_WARNING("ONNX", "Could not optimize %s: %s", model_path.c_str(),
+                        api->GetErrorMessage(status));
+        api->ReleaseStatus(status);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+OptimizedModel resolve_optimized_model(const OrtApi* api, OrtEnv* env,
+                                       const std::string& model_path,
+                                       GraphOptimizationLevel level,
+                                       const std::string& provider) {
+    OptimizedModel result;
+    result.path = model_path;
+
+    struct stat source;
+    if (!api || !env || stat(model_path.c_str(), &source) != 0 || !S_ISREG(source.st_mode)) {
+        return result;
+    }
+
+    level = std::min(level, ORT_ENABLE_EXTENDED);
+
+    char key_text[256];
+    snprintf(key_text, sizeof(key_text), "%d|%s|%d|%s|%lld|%lld", kCacheFormat,
+             OrtGetApiBase()->GetVersionString(), static_cast<int>(level), provider.c_str(),
+             static_cast<long long>(source.st_size), static_cast<long long>(source.st_mtime));
+    char key[17];
+    snprintf(key, sizeof(key), "%016" PRIx64, fnv1a(key_text));
+
+    const std::string cache_path = model_path + "." + key + kSuffix;
+
+    struct stat cached;
+    if (stat(cache_path.c_str(), &cached) == 0 && cached.st_size > 0) {
+        result.path = cache_path;
+        result.from_cache = true;
+        return result;
+    }
+
+    // Probe writability first so read-only bundles don't pay for an
+    // optimization pass on every launch
+    const std::string temp_path = cache_path + ".tmp";
+    FILE* probe = fopen(temp_path.c_str(), "wb");
+    if (!probe) {
+        return result;
+    }
+    fclose(probe);
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!optimize(api, env, model_path, level, temp_path) || !stamp_ort_config(temp_path) ||
+        std::rename(temp_path.c_str(), cache_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return result;
+    }
+
+    remove_stale_entries(model_path, cache_path);
+
+    RAC_LOG_INFO("ONNX", "Cached optimized graph for %s in %.0fms", model_path.c_str(),
+                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                           start)
+                     .count());
+
+    result.path = cache_path;
+    result.created = true;
+    return result;
+}
+
+}  // namespace runanywhere
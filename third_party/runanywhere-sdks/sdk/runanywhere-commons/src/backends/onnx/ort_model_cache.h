@@ -0,0 +1,58 @@
+#ifndef RUNANYWHERE_ONNX_ORT_MODEL_CACHE_H
+#define RUNANYWHERE_ONNX_ORT_MODEL_CACHE_H
+
+/**
+ * Optimized ONNX model cache
+ *
+ * Graph optimization runs every time ONNX Runtime creates a session, and for
+ * large encoders it dominates time-to-ready. The first load of a model saves
+ * the optimized graph next to the original as
+ *
+ *   <model>.<key>.optimized
+ *
+ * where <key> hashes the ORT version, the session options that shape the
+ * optimized graph (optimization level and execution provider) and the source
+ * file's size and mtime, so an ORT upgrade, a different provider or a replaced
+ * model gets a fresh entry. The suffix keeps cache files out of the backend's
+ * *.onnx directory scans.
+ *
+ * Sessions the backend creates load a cached graph with optimization disabled
+ * in their own session options. Sessions built inside sherpa-onnx, whose options
+ * we cannot set, run their optimizer over the already-fused graph, which finds
+ * little left to do. Saved graphs also carry an "ort_config" metadata entry that
+ * disables optimization; ORT applies it only when the host process sets
+ * ORT_LOAD_CONFIG_FROM_MODEL=1 itself. The library never sets the variable, since
+ * changing the environment is process-wide and races other threads.
+ *
+ * Graphs are cached at ORT_ENABLE_EXTENDED at most: the ORT_ENABLE_ALL layout
+ * transforms depend on the CPU they ran on, and cache files can outlive it
+ * (backups, device migration).
+ */
+
+#include <onnxruntime_c_api.h>
+
+#include <string>
+
+namespace runanywhere {
+
+struct OptimizedModel {
+    std::string path;        // File to load
+    bool from_cache = false; // An existing optimized graph was found (warm load)
+    bool created = false;    // The optimized graph was written by this call (cold load)
+};
+
+/**
+ * Resolves the file a session should load for `model_path`.
+ *
+ * Returns the cached optimized graph, creating it on a miss. Falls back to
+ * `model_path` itself when the model directory is not writable or ORT cannot
+ * optimize the graph, so callers can always load the returned path.
+ */
+OptimizedModel resolve_optimized_model(const OrtApi* api, OrtEnv* env,
+                                       const std::string& model_path,
+                                       GraphOptimizationLevel level,
+                                       const std::string& provider);
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_ONNX_ORT_MODEL_CACHE_H
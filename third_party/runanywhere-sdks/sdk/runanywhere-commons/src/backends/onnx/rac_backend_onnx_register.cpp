@@ -10,11 +10,14 @@
 #include "rac_tts_onnx.h"
 #include "rac_vad_onnx.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 #include <vector>
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
@@ -36,13 +39,11 @@ const char* LOG_CAT = "ONNX";
  * SDKs may send Int16 audio but Sherpa-ONNX expects Float32.
  */
 static std::vector<float> convert_int16_to_float32(const void* int16_data, size_t byte_count) {
-    const int16_t* samples = static_cast<const int16_t*>(int16_data);
     size_t num_samples = byte_count / sizeof(int16_t);
 
     std::vector<float> float_samples(num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        float_samples[i] = static_cast<float>(samples[i]) / 32768.0f;
-    }
+    rac_audio_int16_to_float32(static_cast<const int16_t*>(int16_data), num_samples,
+                               float_samples.data());
 
     return float_samples;
 }
@@ -79,7 +80,32 @@ static rac_result_t onnx_stt_vtable_transcribe_stream(void* impl, const void* au
 
     std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
 
-    result = rac_stt_onnx_feed_audio(impl, stream, float_samples.data(), float_samples.size());
+    // Streaming models get the audio in chunks and report partials as they
+    // decode; offline models see it all at once and only produce a final
+    const size_t chunk_samples =
+        rac_stt_onnx_supports_streaming(impl) ? 1600 : std::max<size_t>(float_samples.size(), 1);
+    std::string last_partial;
+
+    for (size_t offset = 0; offset < float_samples.size() && result == RAC_SUCCESS;
+         offset += chunk_samples) {
+        const size_t count = std::min(chunk_samples, float_samples.size() - offset);
+        result = rac_stt_onnx_feed_audio(impl, stream, float_samples.data() + offset, count);
+        if (result != RAC_SUCCESS || chunk_samples >= float_samples.size()) {
+            break;
+        }
+
+        char* text = nullptr;
+        result = rac_stt_onnx_decode_stream(impl, stream, &text);
+        if (result == RAC_SUCCESS && text) {
+            const bool endpoint = rac_stt_onnx_is_endpoint(impl, stream) == RAC_TRUE;
+            if (callback && text[0] != '\0' && (endpoint || last_partial != text)) {
+                callback(text, endpoint ? RAC_TRUE : RAC_FALSE, user_data);
+            }
+            last_partial = endpoint ? "" : text;
+        }
+        free(text);
+    }
+
     if (result != RAC_SUCCESS) {
         rac_stt_onnx_destroy_stream(impl, stream);
         return result;
@@ -152,12 +178,7 @@ static rac_result_t onnx_tts_vtable_synthesize_stream(void* impl, const char* te
                                                       const rac_tts_options_t* options,
                                                       rac_tts_stream_callback_t callback,
                                                       void* user_data) {
-    rac_tts_result_t result = {};
-    rac_result_t status = rac_tts_onnx_synthesize(impl, text, options, &result);
-    if (status == RAC_SUCCESS && callback) {
-        callback(result.audio_data, result.audio_size, user_data);
-    }
-    return status;
+    return rac_tts_onnx_synthesize_stream(impl, text, options, callback, user_data);
 }
 
 static rac_result_t onnx_tts_vtable_stop(void* impl) {
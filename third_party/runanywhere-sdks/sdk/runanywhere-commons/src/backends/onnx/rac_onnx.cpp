@@ -14,9 +14,12 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "onnx_backend.h"
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_error.h"
 #include "rac/infrastructure/events/rac_events.h"
 
@@ -39,6 +42,70 @@ struct rac_onnx_vad_handle_impl {
     runanywhere::ONNXVAD* vad;  // Owned by backend
 };
 
+namespace {
+
+// The STT, TTS and VAD configs share their session settings
+template <typename Config>
+nlohmann::json make_backend_config(const Config* config) {
+    nlohmann::json init_config;
+    if (config != nullptr) {
+        if (config->num_threads > 0) {
+            init_config["num_threads"] = config->num_threads;
+        }
+        if (config->provider != nullptr) {
+            init_config["provider"] = config->provider;
+        }
+        init_config["debug"] = config->debug == RAC_TRUE;
+        init_config["global_thread_pool"] = config->use_global_thread_pool == RAC_TRUE;
+        init_config["model_cache"] = config->disable_model_cache != RAC_TRUE;
+    }
+    return init_config;
+}
+
+void release_borrowed_samples(void* /*audio_data*/, void* context) {
+    delete static_cast<std::vector<float>*>(context);
+}
+
+// Hands synthesized samples to the caller in the requested encoding. Float32
+// output moves into the result without a copy when the caller accepts a
+// borrowed buffer; int16 output is converted straight into the result buffer.
+rac_result_t fill_tts_result(std::vector<float>& samples, const rac_tts_options_t* options,
+                             rac_tts_result_t* out_result) {
+    const bool int16 = options && options->sample_format == RAC_TTS_SAMPLE_FORMAT_INT16;
+    const bool borrow = options && options->borrow_audio == RAC_TRUE;
+
+    out_result->release_audio = nullptr;
+    out_result->release_context = nullptr;
+    out_result->sample_format = int16 ? RAC_TTS_SAMPLE_FORMAT_INT16 : RAC_TTS_SAMPLE_FORMAT_FLOAT32;
+
+    if (int16) {
+        auto* pcm = static_cast<int16_t*>(malloc(samples.size() * sizeof(int16_t)));
+        if (!pcm) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        rac_audio_float32_to_int16(samples.data(), samples.size(), pcm);
+        out_result->audio_data = pcm;
+        out_result->audio_size = samples.size() * sizeof(int16_t);
+    } else if (borrow) {
+        auto* owned = new std::vector<float>(std::move(samples));
+        out_result->audio_data = owned->data();
+        out_result->audio_size = owned->size() * sizeof(float);
+        out_result->release_audio = release_borrowed_samples;
+        out_result->release_context = owned;
+    } else {
+        auto* pcm = static_cast<float*>(malloc(samples.size() * sizeof(float)));
+        if (!pcm) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(pcm, samples.data(), samples.size() * sizeof(float));
+        out_result->audio_data = pcm;
+        out_result->audio_size = samples.size() * sizeof(float);
+    }
+    return RAC_SUCCESS;
+}
+
+}  // namespace
+
 // =============================================================================
 // STT IMPLEMENTATION
 // =============================================================================
@@ -58,12 +125,7 @@ rac_result_t rac_stt_onnx_create(const char* model_path, const rac_stt_onnx_conf
 
     // Create and initialize backend
     handle->backend = std::make_unique<runanywhere::ONNXBackendNew>();
-    nlohmann::json init_config;
-    if (config != nullptr && config->num_threads > 0) {
-        init_config["num_threads"] = config->num_threads;
-    }
-
-    if (!handle->backend->initialize(init_config)) {
+    if (!handle->backend->initialize(make_backend_config(config))) {
         delete handle;
         rac_error_set_details("Failed to initialize ONNX backend");
         return RAC_ERROR_BACKEND_INIT_FAILED;
@@ -93,7 +155,12 @@ rac_result_t rac_stt_onnx_create(const char* model_path, const rac_stt_onnx_conf
             }
         }
 
-        if (!handle->stt->load_model(model_path, model_type)) {
+        nlohmann::json model_config;
+        if (config != nullptr && config->recognizer_cache_size > 0) {
+            model_config["recognizer_cache_size"] = config->recognizer_cache_size;
+        }
+
+        if (!handle->stt->load_model(model_path, model_type, model_config)) {
             delete handle;
             rac_error_set_details("Failed to load STT model");
             return RAC_ERROR_MODEL_LOAD_FAILED;
@@ -247,6 +314,25 @@ void rac_stt_onnx_destroy_stream(rac_handle_t handle, rac_handle_t stream) {
     free(stream_id);
 }
 
+rac_result_t rac_stt_onnx_get_recognizer_stats(rac_handle_t handle,
+                                               rac_stt_onnx_recognizer_stats_t* out_stats) {
+    if (handle == nullptr || out_stats == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_onnx_stt_handle_impl*>(handle);
+    if (!h->stt) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    runanywhere::RecognizerCacheStats stats = h->stt->get_recognizer_cache_stats();
+    out_stats->language_switches = static_cast<int64_t>(stats.language_switches);
+    out_stats->recognizer_loads = static_cast<int64_t>(stats.recognizer_loads);
+    out_stats->reloads_avoided = static_cast<int64_t>(stats.reloads_avoided);
+    out_stats->evictions = static_cast<int64_t>(stats.evictions);
+    return RAC_SUCCESS;
+}
+
 void rac_stt_onnx_destroy(rac_handle_t handle) {
     if (handle == nullptr) {
         return;
@@ -281,12 +367,7 @@ rac_result_t rac_tts_onnx_create(const char* model_path, const rac_tts_onnx_conf
     }
 
     handle->backend = std::make_unique<runanywhere::ONNXBackendNew>();
-    nlohmann::json init_config;
-    if (config != nullptr && config->num_threads > 0) {
-        init_config["num_threads"] = config->num_threads;
-    }
-
-    if (!handle->backend->initialize(init_config)) {
+    if (!handle->backend->initialize(make_backend_config(config))) {
         delete handle;
         rac_error_set_details("Failed to initialize ONNX backend");
         return RAC_ERROR_BACKEND_INIT_FAILED;
@@ -338,19 +419,19 @@ rac_result_t rac_tts_onnx_synthesize(rac_handle_t handle, const char* text,
     }
 
     auto result = h->tts->synthesize(request);
+    if (result.cancelled) {
+        rac_error_set_details("TTS synthesis cancelled");
+        return RAC_ERROR_CANCELLED;
+    }
     if (result.audio_samples.empty()) {
         rac_error_set_details("TTS synthesis failed");
         return RAC_ERROR_INFERENCE_FAILED;
     }
 
-    float* audio_copy = static_cast<float*>(malloc(result.audio_samples.size() * sizeof(float)));
-    if (!audio_copy) {
-        return RAC_ERROR_OUT_OF_MEMORY;
+    rac_result_t status = fill_tts_result(result.audio_samples, options, out_result);
+    if (status != RAC_SUCCESS) {
+        return status;
     }
-    memcpy(audio_copy, result.audio_samples.data(), result.audio_samples.size() * sizeof(float));
-
-    out_result->audio_data = audio_copy;
-    out_result->audio_size = result.audio_samples.size() * sizeof(float);
     out_result->audio_format = RAC_AUDIO_FORMAT_PCM;
     out_result->sample_rate = result.sample_rate;
     out_result->duration_ms = result.duration_ms;
@@ -362,6 +443,61 @@ rac_result_t rac_tts_onnx_synthesize(rac_handle_t handle, const char* text,
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_tts_onnx_synthesize_stream(rac_handle_t handle, const char* text,
+                                            const rac_tts_options_t* options,
+                                            rac_tts_stream_callback_t callback, void* user_data) {
+    if (handle == nullptr || text == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_onnx_tts_handle_impl*>(handle);
+    if (!h->tts) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    runanywhere::TTSRequest request;
+    request.text = text;
+    if (options && options->voice) {
+        request.voice_id = options->voice;
+    }
+    if (options && options->rate > 0) {
+        request.speed_rate = options->rate;
+    }
+
+    const bool int16 = options && options->sample_format == RAC_TTS_SAMPLE_FORMAT_INT16;
+    std::vector<int16_t> pcm;
+    bool cancelled = false;
+
+    auto on_chunk = [&](const runanywhere::TTSResult& chunk) {
+        if (!callback) {
+            return true;
+        }
+        if (int16) {
+            pcm.resize(chunk.audio_samples.size());
+            rac_audio_float32_to_int16(chunk.audio_samples.data(), pcm.size(), pcm.data());
+            callback(pcm.data(), pcm.size() * sizeof(int16_t), user_data);
+        } else {
+            callback(chunk.audio_samples.data(), chunk.audio_samples.size() * sizeof(float),
+                     user_data);
+        }
+        return true;
+    };
+    bool ok = h->tts->synthesize_stream(request, on_chunk, &cancelled);
+    if (!ok && cancelled) {
+        rac_error_set_details("TTS synthesis cancelled");
+        return RAC_ERROR_CANCELLED;
+    }
+    if (!ok) {
+        rac_error_set_details("TTS synthesis failed");
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    rac_event_track("tts.synthesis.completed", RAC_EVENT_CATEGORY_TTS, RAC_EVENT_DESTINATION_ALL,
+                    nullptr);
+
+    return RAC_SUCCESS;
+}
+
 rac_result_t rac_tts_onnx_get_voices(rac_handle_t handle, char*** out_voices, size_t* out_count) {
     if (handle == nullptr || out_voices == nullptr || out_count == nullptr) {
         return RAC_ERROR_NULL_POINTER;
@@ -432,12 +568,7 @@ rac_result_t rac_vad_onnx_create(const char* model_path, const rac_vad_onnx_conf
     }
 
     handle->backend = std::make_unique<runanywhere::ONNXBackendNew>();
-    nlohmann::json init_config;
-    if (config != nullptr && config->num_threads > 0) {
-        init_config["num_threads"] = config->num_threads;
-    }
-
-    if (!handle->backend->initialize(init_config)) {
+    if (!handle->backend->initialize(make_backend_config(config))) {
         delete handle;
         rac_error_set_details("Failed to initialize ONNX backend");
         return RAC_ERROR_BACKEND_INIT_FAILED;
@@ -534,7 +665,7 @@ rac_bool_t rac_vad_onnx_is_speech_active(rac_handle_t handle) {
     }
 
     auto* h = static_cast<rac_onnx_vad_handle_impl*>(handle);
-    return (h->vad && h->vad->is_ready()) ? RAC_TRUE : RAC_FALSE;
+    return (h->vad && h->vad->is_speech_active()) ? RAC_TRUE : RAC_FALSE;
 }
 
 void rac_vad_onnx_destroy(rac_handle_t handle) {
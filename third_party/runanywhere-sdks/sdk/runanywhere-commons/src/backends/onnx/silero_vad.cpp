@@ -0,0 +1,284 @@
+/**
+ * Silero VAD on ONNX Runtime - Implementation
+ */
+
+#include "silero_vad.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "rac/core/rac_logger.h"
+
+namespace runanywhere {
+
+namespace {
+
+constexpr size_t kLayers = 2;  // Leading dimension of every recurrent tensor
+
+}  // namespace
+
+SileroVadModel::SileroVadModel(const OrtApi* api, OrtEnv* env) : api_(api), env_(env) {}
+
+SileroVadModel::~SileroVadModel() {
+    unload();
+}
+
+bool SileroVadModel::check(OrtStatus* status, const char* what) {
+    if (!status) {
+        return true;
+    }
+    RAC_LOG_ERROR("ONNX.VAD", "%s failed: %s", what, api_->GetErrorMessage(status));
+    api_->ReleaseStatus(status);
+    return false;
+}
+
+bool SileroVadModel::load(const std::string& model_path, int num_threads,
+                          bool global_thread_pools, bool pre_optimized) {
+    unload();
+
+    if (!api_ || !env_) {
+        RAC_LOG_ERROR("ONNX.VAD", "ONNX Runtime not initialized");
+        return false;
+    }
+
+    OrtSessionOptions* options = nullptr;
+    if (!check(api_->CreateSessionOptions(&options), "CreateSessionOptions")) {
+        return false;
+    }
+
+    // The graph is tiny and latency-bound; extra inter-op threads only add wakeups
+    bool ok = check(api_->SetSessionGraphOptimizationLevel(
+                        options, pre_optimized ? ORT_DISABLE_ALL : ORT_ENABLE_ALL),
+                    "SetSessionGraphOptimizationLevel");
+    if (ok && global_thread_pools) {
+        ok = check(api_->DisablePerSessionThreads(options), "DisablePerSessionThreads");
+    } else if (ok) {
+        ok = check(api_->SetIntraOpNumThreads(options, std::max(1, num_threads)),
+                   "SetIntraOpNumThreads") &&
+             check(api_->SetInterOpNumThreads(options, 1), "SetInterOpNumThreads");
+    }
+    if (ok) {
+        ok = check(api_->CreateSession(env_, model_path.c_str(), options, &session_),
+                   "CreateSession");
+    }
+    api_->ReleaseSessionOptions(options);
+    if (!ok) {
+        session_ = nullptr;
+        return false;
+    }
+
+    // Tell the graph revisions apart by their recurrent inputs
+    size_t input_count = 0;
+    OrtAllocator* allocator = nullptr;
+    ok = check(api_->SessionGetInputCount(session_, &input_count), "SessionGetInputCount") &&
+         check(api_->GetAllocatorWithDefaultOptions(&allocator), "GetAllocatorWithDefaultOptions");
+
+    std::vector<std::string> input_names;
+    for (size_t i = 0; ok && i < input_count; ++i) {
+        char* name = nullptr;
+        ok = check(api_->SessionGetInputName(session_, i, allocator, &name), "SessionGetInputName");
+        if (ok) {
+            input_names.emplace_back(name);
+            check(api_->AllocatorFree(allocator, name), "AllocatorFree");
+        }
+    }
+
+    auto has_input = [&input_names](const char* name) {
+        return std::find(input_names.begin(), input_names.end(), name) != input_names.end();
+    };
+
+    recurrent_.clear();
+    if (ok && has_input("state")) {
+        has_context_ = true;
+        recurrent_.push_back({"state", "stateN", 128});
+    } else if (ok && has_input("h") && has_input("c")) {
+        has_context_ = false;
+        recurrent_.push_back({"h", "hn", 64});
+        recurrent_.push_back({"c", "cn", 64});
+    } else if (ok) {
+        RAC_LOG_ERROR("ONNX.VAD", "Unrecognized Silero VAD graph: %s", model_path.c_str());
+        ok = false;
+    }
+
+    if (ok) {
+        ok = check(api_->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info_),
+                   "CreateCpuMemoryInfo");
+    }
+
+    if (!ok) {
+        unload();
+        return false;
+    }
+
+    RAC_LOG_INFO("ONNX.VAD", "Silero VAD %s loaded: %s", has_context_ ? "v5" : "v4",
+                 model_path.c_str());
+    return true;
+}
+
+void SileroVadModel::unload() {
+    for (auto& [key, binding] : bindings_) {
+        release_binding(binding.get());
+    }
+    bindings_.clear();
+
+    if (memory_info_) {
+        api_->ReleaseMemoryInfo(memory_info_);
+        memory_info_ = nullptr;
+    }
+    if (session_) {
+        api_->ReleaseSession(session_);
+        session_ = nullptr;
+    }
+    recurrent_.clear();
+}
+
+size_t SileroVadModel::context_samples(int sample_rate) const {
+    if (!has_context_) {
+        return 0;
+    }
+    return sample_rate == 8000 ? 32 : 64;
+}
+
+size_t SileroVadModel::state_size() const {
+    size_t size = 0;
+    for (const auto& tensor : recurrent_) {
+        size += kLayers * tensor.width;
+    }
+    return size;
+}
+
+void SileroVadModel::release_binding(Binding* binding) {
+    if (binding->io) {
+        api_->ReleaseIoBinding(binding->io);
+        binding->io = nullptr;
+    }
+    for (OrtValue* value : binding->values) {
+        api_->ReleaseValue(value);
+    }
+    binding->values.clear();
+}
+
+SileroVadModel::Binding* SileroVadModel::get_binding(size_t batch, int sample_rate) {
+    const auto key = std::make_pair(batch, sample_rate);
+    auto it = bindings_.find(key);
+    if (it != bindings_.end()) {
+        return it->second.get();
+    }
+
+    auto binding = std::make_unique<Binding>();
+    const size_t row = context_samples(sample_rate) + frame_samples(sample_rate);
+    binding->input.resize(batch * row);
+    binding->sr.assign(1, sample_rate);
+    binding->output.resize(batch);
+
+    auto make_float = [&](std::vector<float>& data, const std::vector<int64_t>& shape) {
+        OrtValue* value = nullptr;
+        if (!check(api_->CreateTensorWithDataAsOrtValue(
+                       memory_info_, data.data(), data.size() * sizeof(float), shape.data(),
+                       shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &value),
+                   "CreateTensorWithDataAsOrtValue")) {
+            return static_cast<OrtValue*>(nullptr);
+        }
+        binding->values.push_back(value);
+        return value;
+    };
+
+    const auto n = static_cast<int64_t>(batch);
+    bool ok = check(api_->CreateIoBinding(session_, &binding->io), "CreateIoBinding");
+
+    OrtValue* input = ok ? make_float(binding->input, {n, static_cast<int64_t>(row)}) : nullptr;
+    OrtValue* output = input ? make_float(binding->output, {n, 1}) : nullptr;
+    OrtValue* sr = nullptr;
+    if (output) {
+        // Silero declares sr as an int64 scalar
+        ok = check(api_->CreateTensorWithDataAsOrtValue(memory_info_, binding->sr.data(),
+                                                        sizeof(int64_t), nullptr, 0,
+                                                        ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &sr),
+                   "CreateTensorWithDataAsOrtValue");
+        if (ok) {
+            binding->values.push_back(sr);
+        }
+    }
+    ok = ok && input && output && sr &&
+         check(api_->BindInput(binding->io, "input", input), "BindInput") &&
+         check(api_->BindInput(binding->io, "sr", sr), "BindInput") &&
+         check(api_->BindOutput(binding->io, "output", output), "BindOutput");
+
+    binding->state_in.resize(recurrent_.size());
+    binding->state_out.resize(recurrent_.size());
+    for (size_t i = 0; ok && i < recurrent_.size(); ++i) {
+        const RecurrentTensor& tensor = recurrent_[i];
+        const std::vector<int64_t> shape = {static_cast<int64_t>(kLayers), n,
+                                            static_cast<int64_t>(tensor.width)};
+        binding->state_in[i].resize(kLayers * batch * tensor.width);
+        binding->state_out[i].resize(kLayers * batch * tensor.width);
+
+        OrtValue* state_in = make_float(binding->state_in[i], shape);
+        OrtValue* state_out = state_in ? make_float(binding->state_out[i], shape) : nullptr;
+        ok = state_out &&
+             check(api_->BindInput(binding->io, tensor.input_name.c_str(), state_in),
+                   "BindInput") &&
+             check(api_->BindOutput(binding->io, tensor.output_name.c_str(), state_out),
+                   "BindOutput");
+    }
+
+    if (!ok) {
+        release_binding(binding.get());
+        return nullptr;
+    }
+
+    Binding* result = binding.get();
+    bindings_.emplace(key, std::move(binding));
+    return result;
+}
+
+bool SileroVadModel::run(int sample_rate, size_t count, const float* inputs, float* states,
+                         float* probs) {
+    if (!session_ || count == 0 || !supports_sample_rate(sample_rate)) {
+        return false;
+    }
+
+    Binding* binding = get_binding(count, sample_rate);
+    if (!binding) {
+        return false;
+    }
+
+    std::memcpy(binding->input.data(), inputs, binding->input.size() * sizeof(float));
+
+    // Streams keep their state as [layer][width]; the graph wants [layer][batch][width]
+    const size_t stride = state_size();
+    size_t offset = 0;
+    for (size_t i = 0; i < recurrent_.size(); ++i) {
+        const size_t width = recurrent_[i].width;
+        float* dst = binding->state_in[i].data();
+        for (size_t b = 0; b < count; ++b) {
+            for (size_t layer = 0; layer < kLayers; ++layer) {
+                std::memcpy(dst + (layer * count + b) * width,
+                            states + b * stride + offset + layer * width, width * sizeof(float));
+            }
+        }
+        offset += kLayers * width;
+    }
+
+    if (!check(api_->RunWithBinding(session_, nullptr, binding->io), "RunWithBinding")) {
+        return false;
+    }
+
+    offset = 0;
+    for (size_t i = 0; i < recurrent_.size(); ++i) {
+        const size_t width = recurrent_[i].width;
+        const float* src = binding->state_out[i].data();
+        for (size_t b = 0; b < count; ++b) {
+            for (size_t layer = 0; layer < kLayers; ++layer) {
+                std::memcpy(states + b * stride + offset + layer * width,
+                            src + (layer * count + b) * width, width * sizeof(float));
+            }
+        }
+        offset += kLayers * width;
+    }
+
+    std::memcpy(probs, binding->output.data(), count * sizeof(float));
+    return true;
+}
+
+}  // namespace runanywhere
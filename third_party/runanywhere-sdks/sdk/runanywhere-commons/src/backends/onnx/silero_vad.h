@@ -0,0 +1,102 @@
+#ifndef RUNANYWHERE_ONNX_SILERO_VAD_H
+#define RUNANYWHERE_ONNX_SILERO_VAD_H
+
+/**
+ * Silero VAD on ONNX Runtime
+ *
+ * Thin session wrapper around the Silero VAD graph. The recurrent state is
+ * owned by the caller, so one session serves any number of streams; run()
+ * evaluates one frame for each of N streams in a single session call.
+ * Input/output tensors are preallocated per batch size and bound once
+ * through IoBinding, so steady-state inference does no tensor allocation.
+ *
+ * Both graph revisions are supported:
+ *   v5: input [N, context + frame], state [2, N, 128], sr
+ *   v4: input [N, frame], sr, h [2, N, 64], c [2, N, 64]
+ */
+
+#include <onnxruntime_c_api.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace runanywhere {
+
+class SileroVadModel {
+   public:
+    SileroVadModel(const OrtApi* api, OrtEnv* env);
+    ~SileroVadModel();
+
+    SileroVadModel(const SileroVadModel&) = delete;
+    SileroVadModel& operator=(const SileroVadModel&) = delete;
+
+    // pre_optimized skips graph optimization for graphs already saved optimized
+    bool load(const std::string& model_path, int num_threads, bool global_thread_pools,
+              bool pre_optimized = false);
+    void unload();
+    bool is_loaded() const { return session_ != nullptr; }
+
+    // Silero runs natively at 8kHz and 16kHz only
+    static bool supports_sample_rate(int sample_rate) {
+        return sample_rate == 8000 || sample_rate == 16000;
+    }
+
+    // New samples consumed per frame
+    size_t frame_samples(int sample_rate) const { return sample_rate == 8000 ? 256 : 512; }
+
+    // Trailing samples of the previous frame prepended to each input (v5 only)
+    size_t context_samples(int sample_rate) const;
+
+    // Recurrent floats a stream has to keep between frames
+    size_t state_size() const;
+
+    /**
+     * Evaluates one frame for each of `count` streams.
+     *
+     * @param inputs  count rows of context_samples() + frame_samples() floats
+     * @param states  count rows of state_size() floats, updated in place
+     * @param probs   count speech probabilities
+     */
+    bool run(int sample_rate, size_t count, const float* inputs, float* states, float* probs);
+
+   private:
+    struct RecurrentTensor {
+        std::string input_name;
+        std::string output_name;
+        size_t width = 0;  // Floats per layer per stream
+    };
+
+    // Preallocated tensors for one (batch size, sample rate) pair
+    struct Binding {
+        std::vector<float> input;
+        std::vector<int64_t> sr;
+        std::vector<float> output;
+        std::vector<std::vector<float>> state_in;
+        std::vector<std::vector<float>> state_out;
+        std::vector<OrtValue*> values;
+        OrtIoBinding* io = nullptr;
+    };
+
+    Binding* get_binding(size_t batch, int sample_rate);
+    void release_binding(Binding* binding);
+    bool check(OrtStatus* status, const char* what);
+
+    const OrtApi* api_;
+    OrtEnv* env_;
+    OrtSession* session_ = nullptr;
+    OrtMemoryInfo* memory_info_ = nullptr;
+
+    bool has_context_ = false;  // v5 graph
+    std::vector<RecurrentTensor> recurrent_;
+
+    std::map<std::pair<size_t, int>, std::unique_ptr<Binding>> bindings_;
+};
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_ONNX_SILERO_VAD_H
@@ -9,8 +9,10 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <string>
 #include <vector>
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
@@ -28,13 +30,11 @@ const char* LOG_CAT = "WhisperCPP";
  * Convert Int16 PCM audio to Float32 normalized to [-1.0, 1.0].
  */
 static std::vector<float> convert_int16_to_float32(const void* int16_data, size_t byte_count) {
-    const int16_t* samples = static_cast<const int16_t*>(int16_data);
     size_t num_samples = byte_count / sizeof(int16_t);
 
     std::vector<float> float_samples(num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        float_samples[i] = static_cast<float>(samples[i]) / 32768.0f;
-    }
+    rac_audio_int16_to_float32(static_cast<const int16_t*>(int16_data), num_samples,
+                               float_samples.data());
 
     return float_samples;
 }
@@ -56,13 +56,14 @@ static rac_result_t whispercpp_stt_vtable_transcribe(void* impl, const void* aud
                                          out_result);
 }
 
-// Stream transcription (not implemented for WhisperCPP - use batch)
+// Stream transcription: one call, so it takes the batch path, which honours
+// language detection, word timestamps and escalation. Incremental streams go
+// through rac_stt_whispercpp_create_stream and its scheduler.
 static rac_result_t whispercpp_stt_vtable_transcribe_stream(void* impl, const void* audio_data,
                                                             size_t audio_size,
                                                             const rac_stt_options_t* options,
                                                             rac_stt_stream_callback_t callback,
                                                             void* user_data) {
-    // Fall back to batch transcription
     rac_stt_result_t result = {};
     std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
     rac_result_t status =
@@ -71,6 +72,7 @@ static rac_result_t whispercpp_stt_vtable_transcribe_stream(void* impl, const vo
     if (status == RAC_SUCCESS && callback && result.text) {
         callback(result.text, RAC_TRUE, user_data);
     }
+    rac_stt_result_free(&result);
     return status;
 }
 
@@ -114,6 +116,33 @@ static const rac_stt_service_ops_t g_whispercpp_stt_ops = {
 
 const char* const MODULE_ID = "whispercpp";
 const char* const STT_PROVIDER_NAME = "WhisperCPPSTTService";
+const char* const STT_ROUTER_PROVIDER_NAME = "WhisperCPPRouterSTTService";
+
+// Router identifiers name two GGML models: "<primary>.bin|<escalation>.bin"
+const char ROUTER_SEPARATOR = '|';
+
+bool is_ggml_model_path(const std::string& path) {
+    if (path.size() < 4) {
+        return false;
+    }
+    const std::string ext = path.substr(path.size() - 4);
+    return (ext == ".bin" || ext == ".BIN") &&
+           (path.find("whisper") != std::string::npos || path.find("ggml") != std::string::npos);
+}
+
+bool split_router_identifier(const char* identifier, std::string* primary,
+                             std::string* escalation) {
+    if (identifier == nullptr) {
+        return false;
+    }
+    const char* sep = strchr(identifier, ROUTER_SEPARATOR);
+    if (sep == nullptr || strchr(sep + 1, ROUTER_SEPARATOR) != nullptr) {
+        return false;
+    }
+    *primary = std::string(identifier, sep);
+    *escalation = std::string(sep + 1);
+    return is_ggml_model_path(*primary) && is_ggml_model_path(*escalation);
+}
 
 // STT can_handle
 rac_bool_t whispercpp_stt_can_handle(const rac_service_request_t* request, void* user_data) {
@@ -128,19 +157,15 @@ rac_bool_t whispercpp_stt_can_handle(const rac_service_request_t* request, void*
         return RAC_FALSE;
     }
 
-    // Check for whisper GGML model patterns
-    const char* path = request->identifier;
-    size_t len = strlen(path);
+    // Router identifiers belong to the router provider
+    if (strchr(request->identifier, ROUTER_SEPARATOR) != nullptr) {
+        return RAC_FALSE;
+    }
 
-    // Check for .bin extension (whisper GGML format)
-    if (len >= 4) {
-        const char* ext = path + len - 4;
-        if (strcmp(ext, ".bin") == 0 || strcmp(ext, ".BIN") == 0) {
-            if (strstr(path, "whisper") != nullptr || strstr(path, "ggml") != nullptr) {
-                RAC_LOG_INFO(LOG_CAT, "whispercpp_stt_can_handle: path matches -> TRUE");
-                return RAC_TRUE;
-            }
-        }
+    // Check for whisper GGML model patterns (.bin extension)
+    if (is_ggml_model_path(request->identifier)) {
+        RAC_LOG_INFO(LOG_CAT, "whispercpp_stt_can_handle: path matches -> TRUE");
+        return RAC_TRUE;
     }
 
     return RAC_FALSE;
@@ -179,6 +204,57 @@ rac_handle_t whispercpp_stt_create(const rac_service_request_t* request, void* u
     return service;
 }
 
+// Router can_handle
+rac_bool_t whispercpp_router_can_handle(const rac_service_request_t* request, void* user_data) {
+    (void)user_data;
+
+    if (request == nullptr) {
+        return RAC_FALSE;
+    }
+
+    std::string primary;
+    std::string escalation;
+    return split_router_identifier(request->identifier, &primary, &escalation) ? RAC_TRUE
+                                                                                : RAC_FALSE;
+}
+
+// Router create with vtable
+rac_handle_t whispercpp_router_create(const rac_service_request_t* request, void* user_data) {
+    (void)user_data;
+
+    std::string primary;
+    std::string escalation;
+    if (request == nullptr ||
+        !split_router_identifier(request->identifier, &primary, &escalation)) {
+        return nullptr;
+    }
+
+    RAC_LOG_INFO(LOG_CAT, "Creating WhisperCPP router STT service: %s -> %s", primary.c_str(),
+                 escalation.c_str());
+
+    rac_handle_t backend_handle = nullptr;
+    rac_result_t result = rac_stt_whispercpp_create_router(primary.c_str(), escalation.c_str(),
+                                                           nullptr, nullptr, &backend_handle);
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "rac_stt_whispercpp_create_router failed with result: %d", result);
+        return nullptr;
+    }
+
+    auto* service = static_cast<rac_stt_service_t*>(malloc(sizeof(rac_stt_service_t)));
+    if (!service) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to allocate rac_stt_service_t");
+        rac_stt_whispercpp_destroy(backend_handle);
+        return nullptr;
+    }
+
+    service->ops = &g_whispercpp_stt_ops;
+    service->impl = backend_handle;
+    service->model_id = strdup(request->identifier);
+
+    RAC_LOG_INFO(LOG_CAT, "WhisperCPP router STT service created successfully");
+    return service;
+}
+
 bool g_registered = false;
 
 }  // namespace
@@ -225,6 +301,22 @@ rac_result_t rac_backend_whispercpp_register(void) {
         return result;
     }
 
+    // Router identifiers also contain "whisper", so the router provider must
+    // rank above ONNX to receive them; its can_handle accepts nothing else.
+    rac_service_provider_t router_provider = {};
+    router_provider.name = STT_ROUTER_PROVIDER_NAME;
+    router_provider.capability = RAC_CAPABILITY_STT;
+    router_provider.priority = 110;
+    router_provider.can_handle = whispercpp_router_can_handle;
+    router_provider.create = whispercpp_router_create;
+
+    result = rac_service_register_provider(&router_provider);
+    if (result != RAC_SUCCESS) {
+        rac_service_unregister_provider(STT_PROVIDER_NAME, RAC_CAPABILITY_STT);
+        rac_module_unregister(MODULE_ID);
+        return result;
+    }
+
     g_registered = true;
     RAC_LOG_INFO(LOG_CAT, "WhisperCPP backend registered (STT)");
     return RAC_SUCCESS;
@@ -235,6 +327,7 @@ rac_result_t rac_backend_whispercpp_unregister(void) {
         return RAC_ERROR_MODULE_NOT_FOUND;
     }
 
+    rac_service_unregister_provider(STT_ROUTER_PROVIDER_NAME, RAC_CAPABILITY_STT);
     rac_service_unregister_provider(STT_PROVIDER_NAME, RAC_CAPABILITY_STT);
     rac_module_unregister(MODULE_ID);
 
@@ -7,12 +7,17 @@
 
 #include "rac_stt_whispercpp.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "whispercpp_backend.h"
+#include "whispercpp_router.h"
+#include "whispercpp_stream_scheduler.h"
 
 #include "rac/core/rac_error.h"
 #include "rac/infrastructure/events/rac_events.h"
@@ -25,8 +30,104 @@ struct rac_whispercpp_handle_impl {
     std::unique_ptr<runanywhere::WhisperCppBackend> backend;
     runanywhere::WhisperCppSTT* stt;  // Owned by backend
     std::string detected_language;
+    double deadline_ms = 0.0;
+
+    // Created with the first stream; decodes every stream on this handle
+    int max_concurrent_streams = 0;
+    std::unique_ptr<runanywhere::WhisperCppStreamScheduler> scheduler;
+    std::mutex scheduler_mutex;
+
+    // Set only for handles created with rac_stt_whispercpp_create_router
+    std::unique_ptr<runanywhere::WhisperCppBackend> escalation_backend;
+    std::unique_ptr<runanywhere::WhisperCppRouter> router;
+};
+
+struct rac_whispercpp_stream_impl {
+    std::string id;
+    int sample_rate = 16000;
+    rac_stt_stream_callback_t callback = nullptr;
+    void* user_data = nullptr;
+    std::atomic<rac_result_t> last_error{RAC_SUCCESS};  // Set on the scheduler thread
 };
 
+namespace {
+
+nlohmann::json make_init_config(const rac_stt_whispercpp_config_t* config) {
+    nlohmann::json init_config;
+    if (config != nullptr) {
+        if (config->num_threads > 0) {
+            init_config["num_threads"] = config->num_threads;
+        }
+        init_config["use_gpu"] = config->use_gpu == RAC_TRUE;
+    }
+    return init_config;
+}
+
+nlohmann::json make_model_config(const rac_stt_whispercpp_config_t* config) {
+    nlohmann::json model_config;
+    if (config != nullptr) {
+        if (config->translate == RAC_TRUE) {
+            model_config["translate"] = true;
+        }
+        // Zero keeps the backend default; negative values switch the guard off
+        if (config->repetition_ngram != 0) {
+            model_config["repetition_ngram"] = config->repetition_ngram;
+        }
+        if (config->max_ngram_repeats != 0) {
+            model_config["max_ngram_repeats"] = config->max_ngram_repeats;
+        }
+        if (config->max_fallback_steps != 0) {
+            model_config["max_fallback_steps"] = config->max_fallback_steps;
+        }
+        if (config->no_speech_threshold > 0.0f) {
+            model_config["no_speech_threshold"] = config->no_speech_threshold;
+        }
+        if (config->dtw_word_timestamps == RAC_TRUE) {
+            model_config["word_timestamps"] = true;
+        }
+    }
+    return model_config;
+}
+
+runanywhere::WhisperCppStreamScheduler* get_scheduler(rac_whispercpp_handle_impl* h) {
+    std::lock_guard<std::mutex> lock(h->scheduler_mutex);
+    if (!h->scheduler) {
+        runanywhere::StreamSchedulerConfig config;
+        config.max_concurrent_decodes = h->max_concurrent_streams;
+        h->scheduler = std::make_unique<runanywhere::WhisperCppStreamScheduler>(h->stt, config);
+        h->scheduler->start();
+    }
+    return h->scheduler.get();
+}
+
+rac_result_t stream_result_error(const runanywhere::STTResult& result) {
+    if (result.failed) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+    if (result.aborted) {
+        return result.abort_reason == runanywhere::AbortReason::DEADLINE_EXCEEDED
+                   ? RAC_ERROR_GENERATION_TIMEOUT
+                   : RAC_ERROR_CANCELLED;
+    }
+    return RAC_SUCCESS;
+}
+
+void deliver_stream_result(rac_whispercpp_stream_impl* stream,
+                           const runanywhere::STTResult& result) {
+    stream->last_error = stream_result_error(result);
+    if (!stream->callback) {
+        return;
+    }
+    if (result.is_final) {
+        const bool has_text = !result.aborted && !result.failed && !result.text.empty();
+        stream->callback(has_text ? result.text.c_str() : nullptr, RAC_TRUE, stream->user_data);
+    } else if (!result.aborted && !result.text.empty()) {
+        stream->callback(result.text.c_str(), RAC_FALSE, stream->user_data);
+    }
+}
+
+}  // namespace
+
 // =============================================================================
 // RAC API IMPLEMENTATION
 // =============================================================================
@@ -48,15 +149,14 @@ rac_result_t rac_stt_whispercpp_create(const char* model_path,
     // Create and initialize backend
     handle->backend = std::make_unique<runanywhere::WhisperCppBackend>();
 
-    nlohmann::json init_config;
-    if (config != nullptr) {
-        if (config->num_threads > 0) {
-            init_config["num_threads"] = config->num_threads;
-        }
-        init_config["use_gpu"] = config->use_gpu == RAC_TRUE;
+    if (config != nullptr && config->deadline_ms > 0) {
+        handle->deadline_ms = static_cast<double>(config->deadline_ms);
+    }
+    if (config != nullptr && config->max_concurrent_streams > 0) {
+        handle->max_concurrent_streams = config->max_concurrent_streams;
     }
 
-    if (!handle->backend->initialize(init_config)) {
+    if (!handle->backend->initialize(make_init_config(config))) {
         delete handle;
         rac_error_set_details("Failed to initialize WhisperCPP backend");
         return RAC_ERROR_BACKEND_INIT_FAILED;
@@ -72,12 +172,8 @@ rac_result_t rac_stt_whispercpp_create(const char* model_path,
 
     // Load model if path provided
     if (model_path != nullptr) {
-        nlohmann::json model_config;
-        if (config != nullptr && config->translate == RAC_TRUE) {
-            model_config["translate"] = true;
-        }
-
-        if (!handle->stt->load_model(model_path, runanywhere::STTModelType::WHISPER, model_config)) {
+        if (!handle->stt->load_model(model_path, runanywhere::STTModelType::WHISPER,
+                                     make_model_config(config))) {
             delete handle;
             rac_error_set_details("Failed to load WhisperCPP model");
             return RAC_ERROR_MODEL_LOAD_FAILED;
@@ -92,6 +188,52 @@ rac_result_t rac_stt_whispercpp_create(const char* model_path,
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_stt_whispercpp_create_router(
+    const char* primary_model_path, const char* escalation_model_path,
+    const rac_stt_whispercpp_config_t* config,
+    const rac_stt_whispercpp_router_config_t* router_config, rac_handle_t* out_handle) {
+    if (primary_model_path == nullptr || escalation_model_path == nullptr ||
+        out_handle == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    rac_handle_t primary_handle = nullptr;
+    rac_result_t result = rac_stt_whispercpp_create(primary_model_path, config, &primary_handle);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    auto* handle = static_cast<rac_whispercpp_handle_impl*>(primary_handle);
+
+    handle->escalation_backend = std::make_unique<runanywhere::WhisperCppBackend>();
+    if (!handle->escalation_backend->initialize(make_init_config(config))) {
+        rac_stt_whispercpp_destroy(handle);
+        rac_error_set_details("Failed to initialize WhisperCPP escalation backend");
+        return RAC_ERROR_BACKEND_INIT_FAILED;
+    }
+
+    runanywhere::WhisperCppSTT* escalation_stt = handle->escalation_backend->get_stt();
+    if (!escalation_stt ||
+        !escalation_stt->load_model(escalation_model_path, runanywhere::STTModelType::WHISPER,
+                                    make_model_config(config))) {
+        rac_stt_whispercpp_destroy(handle);
+        rac_error_set_details("Failed to load WhisperCPP escalation model");
+        return RAC_ERROR_MODEL_LOAD_FAILED;
+    }
+
+    runanywhere::RouterConfig rc;
+    if (router_config != nullptr) {
+        rc.min_segment_confidence = router_config->min_segment_confidence;
+        rc.min_avg_token_prob = router_config->min_avg_token_prob;
+        if (router_config->padding_ms >= 0) {
+            rc.padding_ms = static_cast<double>(router_config->padding_ms);
+        }
+    }
+    handle->router = std::make_unique<runanywhere::WhisperCppRouter>(handle->stt, escalation_stt, rc);
+
+    *out_handle = static_cast<rac_handle_t>(handle);
+    return RAC_SUCCESS;
+}
+
 rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handle, const float* audio_samples,
                                            size_t num_samples, const rac_stt_options_t* options,
                                            rac_stt_result_t* out_result) {
@@ -112,9 +254,21 @@ rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handle, const float* aud
     if (options && options->language) {
         request.language = options->language;
     }
+    request.word_timestamps = options && options->enable_word_timestamps == RAC_TRUE;
+    request.deadline_ms = h->deadline_ms;
 
     // Perform transcription
-    auto result = h->stt->transcribe(request);
+    auto result = h->router ? h->router->transcribe(request) : h->stt->transcribe(request);
+
+    if (result.aborted) {
+        *out_result = {};
+        if (result.abort_reason == runanywhere::AbortReason::DEADLINE_EXCEEDED) {
+            rac_error_set_details("WhisperCPP transcription exceeded its deadline");
+            return RAC_ERROR_GENERATION_TIMEOUT;
+        }
+        rac_error_set_details("WhisperCPP transcription was cancelled");
+        return RAC_ERROR_CANCELLED;
+    }
 
     // Store detected language for later retrieval
     h->detected_language = result.detected_language;
@@ -151,6 +305,129 @@ rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handle, const float* aud
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_stt_whispercpp_create_stream(rac_handle_t handle, const rac_stt_options_t* options,
+                                              rac_stt_stream_callback_t callback, void* user_data,
+                                              rac_handle_t* out_stream) {
+    if (handle == nullptr || out_stream == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    if (!h->stt) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    auto* stream = new (std::nothrow) rac_whispercpp_stream_impl();
+    if (!stream) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    stream->sample_rate = (options && options->sample_rate > 0) ? options->sample_rate : 16000;
+    stream->callback = callback;
+    stream->user_data = user_data;
+
+    nlohmann::json stream_config;
+    stream_config["sample_rate"] = stream->sample_rate;
+    if (options && options->language) {
+        stream_config["language"] = options->language;
+    }
+    stream_config["detect_language"] = options && options->detect_language == RAC_TRUE;
+    if (h->deadline_ms > 0.0) {
+        stream_config["deadline_ms"] = h->deadline_ms;
+    }
+
+    stream->id = h->stt->create_stream(stream_config);
+    if (stream->id.empty()) {
+        delete stream;
+        rac_error_set_details("Failed to create WhisperCPP stream");
+        return RAC_ERROR_BACKEND_NOT_READY;
+    }
+
+    get_scheduler(h)->add_stream(
+        stream->id, [stream](const std::string&, const runanywhere::STTResult& result) {
+            deliver_stream_result(stream, result);
+        });
+
+    *out_stream = static_cast<rac_handle_t>(stream);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_stt_whispercpp_feed_audio(rac_handle_t handle, rac_handle_t stream,
+                                           const float* audio_samples, size_t num_samples,
+                                           rac_bool_t last_chunk) {
+    if (handle == nullptr || stream == nullptr || (audio_samples == nullptr && num_samples > 0)) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    auto* s = static_cast<rac_whispercpp_stream_impl*>(stream);
+    std::vector<float> samples(audio_samples, audio_samples + num_samples);
+    if (!h->stt->feed_audio(s->id, samples, s->sample_rate, last_chunk == RAC_TRUE)) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+    return RAC_SUCCESS;
+}
+
+void rac_stt_whispercpp_input_finished(rac_handle_t handle, rac_handle_t stream) {
+    if (handle == nullptr || stream == nullptr) {
+        return;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    h->stt->input_finished(static_cast<rac_whispercpp_stream_impl*>(stream)->id);
+}
+
+void rac_stt_whispercpp_cancel_stream(rac_handle_t handle, rac_handle_t stream) {
+    if (handle == nullptr || stream == nullptr) {
+        return;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    h->stt->cancel_stream(static_cast<rac_whispercpp_stream_impl*>(stream)->id);
+}
+
+rac_result_t rac_stt_whispercpp_get_stream_error(rac_handle_t handle, rac_handle_t stream) {
+    if (handle == nullptr || stream == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    return static_cast<rac_whispercpp_stream_impl*>(stream)->last_error.load();
+}
+
+void rac_stt_whispercpp_destroy_stream(rac_handle_t handle, rac_handle_t stream) {
+    if (handle == nullptr || stream == nullptr) {
+        return;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    auto* s = static_cast<rac_whispercpp_stream_impl*>(stream);
+
+    // Cut a decode in flight short, then wait for its callback before freeing
+    h->stt->cancel_stream(s->id);
+    runanywhere::WhisperCppStreamScheduler* scheduler = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(h->scheduler_mutex);
+        scheduler = h->scheduler.get();
+    }
+    if (scheduler) {
+        scheduler->remove_stream(s->id);
+    }
+    h->stt->destroy_stream(s->id);
+    delete s;
+}
+
+void rac_stt_whispercpp_cancel(rac_handle_t handle) {
+    if (handle == nullptr) {
+        return;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    if (h->router) {
+        h->router->cancel();
+    } else if (h->stt) {
+        h->stt->cancel();
+    }
+}
+
 rac_result_t rac_stt_whispercpp_get_language(rac_handle_t handle, char** out_language) {
     if (handle == nullptr || out_language == nullptr) {
         return RAC_ERROR_NULL_POINTER;
@@ -166,6 +443,88 @@ rac_result_t rac_stt_whispercpp_get_language(rac_handle_t handle, char** out_lan
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_stt_whispercpp_get_guard_stats(rac_handle_t handle,
+                                                rac_stt_whispercpp_guard_stats_t* out_stats) {
+    if (handle == nullptr || out_stats == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    if (!h->stt) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    runanywhere::DecodeGuardStats stats = h->stt->get_guard_stats();
+    if (h->escalation_backend && h->escalation_backend->get_stt()) {
+        // A routed handle decodes on both models; report them together
+        stats.add(h->escalation_backend->get_stt()->get_guard_stats());
+    }
+    out_stats->windows_decoded = static_cast<int64_t>(stats.windows_decoded);
+    out_stats->decoder_steps = static_cast<int64_t>(stats.decoder_steps);
+    out_stats->repetition_stops = static_cast<int64_t>(stats.repetition_stops);
+    out_stats->fallback_decodes = static_cast<int64_t>(stats.fallback_decodes);
+    out_stats->fallback_cap_hits = static_cast<int64_t>(stats.fallback_cap_hits);
+    out_stats->no_speech_skips = static_cast<int64_t>(stats.no_speech_skips);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_stt_whispercpp_get_stream_stats(rac_handle_t handle,
+                                                 rac_stt_whispercpp_stream_stats_t* out_stats) {
+    if (handle == nullptr || out_stats == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    runanywhere::StreamSchedulerStats scheduler_stats;
+    {
+        std::lock_guard<std::mutex> lock(h->scheduler_mutex);
+        if (h->scheduler) {
+            scheduler_stats = h->scheduler->get_stats();
+        }
+    }
+    out_stats->scheduler_ticks = static_cast<int64_t>(scheduler_stats.ticks);
+    out_stats->stream_decodes = static_cast<int64_t>(scheduler_stats.dispatched);
+    out_stats->streams_deferred = static_cast<int64_t>(scheduler_stats.deferred);
+    out_stats->fairness_promotions = static_cast<int64_t>(scheduler_stats.fairness_promotions);
+    out_stats->failed_decodes = static_cast<int64_t>(scheduler_stats.failed_decodes);
+    out_stats->avg_stream_lag_ms =
+        scheduler_stats.decodes > 0 ? scheduler_stats.total_lag_ms / scheduler_stats.decodes : 0.0;
+    out_stats->max_stream_lag_ms = scheduler_stats.max_lag_ms;
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_stt_whispercpp_get_router_stats(rac_handle_t handle,
+                                                 rac_stt_whispercpp_router_stats_t* out_stats) {
+    if (handle == nullptr || out_stats == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    if (!h->router) {
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    runanywhere::RouterStats stats = h->router->get_stats();
+    out_stats->requests = static_cast<int64_t>(stats.requests);
+    out_stats->segments = static_cast<int64_t>(stats.segments);
+    out_stats->escalated_segments = static_cast<int64_t>(stats.escalated_segments);
+    out_stats->escalation_rate =
+        stats.segments > 0 ? static_cast<float>(stats.escalated_segments) / stats.segments : 0.0f;
+    out_stats->audio_ms = stats.audio_ms;
+    out_stats->escalated_audio_ms = stats.escalated_audio_ms;
+    out_stats->primary_time_ms = stats.primary_time_ms;
+    out_stats->escalation_time_ms = stats.escalation_time_ms;
+    out_stats->mean_token_prob_before = 0.0f;
+    out_stats->mean_token_prob_after = 0.0f;
+    if (stats.escalated_segments > 0) {
+        out_stats->mean_token_prob_before =
+            static_cast<float>(stats.token_prob_before_sum / stats.escalated_segments);
+        out_stats->mean_token_prob_after =
+            static_cast<float>(stats.token_prob_after_sum / stats.escalated_segments);
+    }
+    return RAC_SUCCESS;
+}
+
 rac_bool_t rac_stt_whispercpp_is_ready(rac_handle_t handle) {
     if (handle == nullptr) {
         return RAC_FALSE;
@@ -181,6 +540,11 @@ void rac_stt_whispercpp_destroy(rac_handle_t handle) {
     }
 
     auto* h = static_cast<rac_whispercpp_handle_impl*>(handle);
+    h->scheduler.reset();
+    h->router.reset();
+    if (h->escalation_backend) {
+        h->escalation_backend->cleanup();
+    }
     if (h->stt) {
         h->stt->unload_model();
     }
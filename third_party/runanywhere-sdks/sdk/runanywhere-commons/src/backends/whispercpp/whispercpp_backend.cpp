@@ -7,10 +7,12 @@
 #include "whispercpp_backend.h"
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 
 #include "rac/core/rac_logger.h"
 
@@ -26,6 +28,66 @@
 
 namespace runanywhere {
 
+namespace {
+
+const char* abort_reason_str(AbortReason reason) {
+    switch (reason) {
+        case AbortReason::CANCELLED:
+            return "cancelled";
+        case AbortReason::DEADLINE_EXCEEDED:
+            return "deadline exceeded";
+        default:
+            return "none";
+    }
+}
+
+bool whisper_abort_callback(void* user_data) {
+    return static_cast<AbortMonitor*>(user_data)->should_abort();
+}
+
+/**
+ * Checkpoint name from a GGML file path: "/m/ggml-large-v3-q5_0.bin" -> "large-v3"
+ */
+std::string whisper_model_id(const std::string& model_path) {
+    std::string id = model_path.substr(model_path.find_last_of("/\\") + 1);
+    const size_t ext = id.rfind('.');
+    if (ext != std::string::npos && id.compare(ext, std::string::npos, ".bin") == 0) {
+        id.erase(ext);
+    }
+    if (id.compare(0, 5, "ggml-") == 0) {
+        id.erase(0, 5);
+    }
+
+    // Quantized files append the type, e.g. -q5_0, -q8_0 or -q4_k
+    const size_t dash = id.rfind('-');
+    if (dash != std::string::npos && dash + 1 < id.size() && id[dash + 1] == 'q' &&
+        dash + 2 < id.size() && std::isdigit(static_cast<unsigned char>(id[dash + 2]))) {
+        id.erase(dash);
+    }
+    return id;
+}
+
+}  // namespace
+
+// =============================================================================
+// ABORT MONITOR
+// =============================================================================
+
+bool AbortMonitor::should_abort() {
+    if (reason != AbortReason::NONE) {
+        return true;
+    }
+
+    if ((cancel_generation && cancel_generation->load() != generation) ||
+        (token && token->is_cancelled())) {
+        reason = AbortReason::CANCELLED;
+    } else if (has_deadline && std::chrono::steady_clock::now() >= deadline) {
+        reason = AbortReason::DEADLINE_EXCEEDED;
+    }
+
+    return reason != AbortReason::NONE;
+}
+
 // =============================================================================
 // WHISPERCPP BACKEND IMPLEMENTATION
 // =============================================================================
@@ -120,12 +182,10 @@ WhisperCppSTT::WhisperCppSTT(WhisperCppBackend* backend) : backend_(backend) {
 WhisperCppSTT::~WhisperCppSTT() {
     unload_model();
 
-    for (auto& [id, state] : streams_) {
-        if (state && state->state) {
-            whisper_free_state(state->state);
-        }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        release_streams();
     }
-    streams_.clear();
 
     LOGI("WhisperCppSTT destroyed");
 }
@@ -140,8 +200,8 @@ bool WhisperCppSTT::load_model(const std::string& model_path, STTModelType model
 
     if (model_loaded_ && ctx_) {
         LOGI("Unloading previous model");
-        whisper_free(ctx_);
-        ctx_ = nullptr;
+        release_streams();
+        free_contexts();
         model_loaded_ = false;
     }
 
@@ -150,28 +210,51 @@ bool WhisperCppSTT::load_model(const std::string& model_path, STTModelType model
     whisper_context_params cparams = whisper_context_default_params();
     cparams.use_gpu = backend_->is_gpu_enabled();
 
-    if (config.contains("word_timestamps") && config["word_timestamps"].get<bool>()) {
-        cparams.dtw_token_timestamps = true;
-        cparams.dtw_aheads_preset = WHISPER_AHEADS_LARGE_V3;
-    }
+    // DTW needs alignment heads matching the model, which are only known once it
+    // is loaded; the main context is built without DTW and an aligner added lazily
+    dtw_enabled_ = config.contains("word_timestamps") && config["word_timestamps"].get<bool>();
 
     if (config.contains("flash_attention")) {
         cparams.flash_attn = config["flash_attention"].get<bool>();
     }
 
-    ctx_ = whisper_init_from_file_with_params(model_path.c_str(), cparams);
+    guard_config_ = DecodeGuardConfig();
+    if (config.contains("repetition_ngram")) {
+        guard_config_.repetition_ngram = config["repetition_ngram"].get<int>();
+    }
+    if (config.contains("max_ngram_repeats")) {
+        guard_config_.max_ngram_repeats = config["max_ngram_repeats"].get<int>();
+    }
+    if (config.contains("max_fallback_steps")) {
+        guard_config_.max_fallback_steps = config["max_fallback_steps"].get<int>();
+    }
+    if (config.contains("no_speech_threshold")) {
+        guard_config_.no_speech_threshold = config["no_speech_threshold"].get<float>();
+    }
+
+    ctx_ = whisper_init_from_file_with_params_no_state(model_path.c_str(), cparams);
 
     if (!ctx_) {
         LOGE("Failed to load whisper model from: %s", model_path.c_str());
         return false;
     }
 
+    transcribe_state_ = whisper_init_state(ctx_);
+    if (!transcribe_state_) {
+        LOGE("Failed to create whisper state for: %s", model_path.c_str());
+        whisper_free(ctx_);
+        ctx_ = nullptr;
+        return false;
+    }
+
     model_path_ = model_path;
     model_config_ = config;
     model_loaded_ = true;
 
-    LOGI("Whisper model loaded successfully. Multilingual: %s",
-         whisper_is_multilingual(ctx_) ? "yes" : "no");
+    aheads_preset_ = select_aheads_preset();
+
+    LOGI("Whisper model loaded successfully. Type: %s, multilingual: %s",
+         whisper_model_type_readable(ctx_), whisper_is_multilingual(ctx_) ? "yes" : "no");
 
     return true;
 }
@@ -187,15 +270,9 @@ bool WhisperCppSTT::unload_model() {
         return true;
     }
 
-    for (auto& [id, state] : streams_) {
-        if (state && state->state) {
-            whisper_free_state(state->state);
-        }
-    }
-    streams_.clear();
+    release_streams();
+    free_contexts();
 
-    whisper_free(ctx_);
-    ctx_ = nullptr;
     model_loaded_ = false;
     model_path_.clear();
 
@@ -203,11 +280,197 @@ bool WhisperCppSTT::unload_model() {
     return true;
 }
 
+void WhisperCppSTT::free_contexts() {
+    if (aligner_state_) {
+        whisper_free_state(aligner_state_);
+        aligner_state_ = nullptr;
+    }
+    if (aligner_ctx_) {
+        whisper_free(aligner_ctx_);
+        aligner_ctx_ = nullptr;
+    }
+    if (transcribe_state_) {
+        whisper_free_state(transcribe_state_);
+        transcribe_state_ = nullptr;
+    }
+    if (ctx_) {
+        whisper_free(ctx_);
+        ctx_ = nullptr;
+    }
+}
+
+whisper_alignment_heads_preset WhisperCppSTT::select_aheads_preset() const {
+    // Alignment heads are (layer, head) pairs of one exact checkpoint, so a
+    // fine-tuned or distilled variant with the same encoder must not reuse them.
+    // Known file names come first; otherwise only layouts that a single OpenAI
+    // checkpoint has are trusted.
+    static const std::pair<const char*, whisper_alignment_heads_preset> KNOWN_MODELS[] = {
+        {"tiny.en", WHISPER_AHEADS_TINY_EN},
+        {"tiny", WHISPER_AHEADS_TINY},
+        {"base.en", WHISPER_AHEADS_BASE_EN},
+        {"base", WHISPER_AHEADS_BASE},
+        {"small.en", WHISPER_AHEADS_SMALL_EN},
+        {"small", WHISPER_AHEADS_SMALL},
+        {"medium.en", WHISPER_AHEADS_MEDIUM_EN},
+        {"medium", WHISPER_AHEADS_MEDIUM},
+        {"large-v1", WHISPER_AHEADS_LARGE_V1},
+        {"large-v2", WHISPER_AHEADS_LARGE_V2},
+        {"large-v3", WHISPER_AHEADS_LARGE_V3},
+        {"large-v3-turbo", WHISPER_AHEADS_LARGE_V3_TURBO},
+    };
+
+    const std::string model_id = whisper_model_id(model_path_);
+    for (const auto& [id, preset] : KNOWN_MODELS) {
+        if (model_id == id) {
+            return preset;
+        }
+    }
+
+    const bool multilingual = whisper_is_multilingual(ctx_) != 0;
+    const int n_audio_layer = whisper_model_n_audio_layer(ctx_);
+    const int n_text_layer = whisper_model_n_text_layer(ctx_);
+
+    // Distilled models keep the encoder but shrink the decoder
+    if (n_text_layer == n_audio_layer) {
+        switch (n_audio_layer) {
+            case 4:
+                return multilingual ? WHISPER_AHEADS_TINY : WHISPER_AHEADS_TINY_EN;
+            case 6:
+                return multilingual ? WHISPER_AHEADS_BASE : WHISPER_AHEADS_BASE_EN;
+            case 12:
+                return multilingual ? WHISPER_AHEADS_SMALL : WHISPER_AHEADS_SMALL_EN;
+            case 24:
+                return multilingual ? WHISPER_AHEADS_MEDIUM : WHISPER_AHEADS_MEDIUM_EN;
+            case 32:
+                // large-v1 and v2 share hparams; v3 moved to 128 mel bins
+                if (whisper_model_n_mels(ctx_) == 128) {
+                    return WHISPER_AHEADS_LARGE_V3;
+                }
+                break;
+            default:
+                break;
+        }
+    } else if (n_audio_layer == 32 && n_text_layer == 4 && whisper_model_n_mels(ctx_) == 128) {
+        return WHISPER_AHEADS_LARGE_V3_TURBO;
+    }
+
+    LOGW("No alignment heads known for model '%s'; using the top decoder layers",
+         model_id.c_str());
+    return WHISPER_AHEADS_N_TOP_MOST;
+}
+
+bool WhisperCppSTT::ensure_aligner() {
+    // Called with mutex_ held
+    if (aligner_state_) {
+        return true;
+    }
+
+    whisper_context_params cparams = whisper_context_default_params();
+    cparams.use_gpu = backend_->is_gpu_enabled();
+    cparams.flash_attn = false;  // whisper.cpp does not support DTW with flash attention
+    cparams.dtw_token_timestamps = true;
+    cparams.dtw_aheads_preset = aheads_preset_;
+
+    aligner_ctx_ = whisper_init_from_file_with_params_no_state(model_path_.c_str(), cparams);
+    if (!aligner_ctx_) {
+        LOGE("Failed to create DTW aligner for: %s", model_path_.c_str());
+        return false;
+    }
+
+    aligner_state_ = whisper_init_state(aligner_ctx_);
+    if (!aligner_state_) {
+        LOGE("Failed to create DTW aligner state");
+        whisper_free(aligner_ctx_);
+        aligner_ctx_ = nullptr;
+        return false;
+    }
+
+    LOGI("DTW aligner created (alignment heads preset %d)", static_cast<int>(aheads_preset_));
+    return true;
+}
+
+void WhisperCppSTT::release_streams() {
+    // Called with mutex_ held. decode() never takes mutex_ while holding a stream's
+    // decode_mutex, so waiting here for in-flight decodes cannot deadlock.
+    for (auto& [id, stream] : streams_) {
+        stream->cancel_token->cancel();
+        std::lock_guard<std::mutex> decode_lock(stream->decode_mutex);
+        if (stream->state) {
+            whisper_free_state(stream->state);
+            stream->state = nullptr;
+        }
+    }
+    streams_.clear();
+
+    std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
+    stream_tokens_.clear();
+}
+
+std::shared_ptr<WhisperStreamState> WhisperCppSTT::find_stream(
+    const std::string& stream_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = streams_.find(stream_id);
+    return it != streams_.end() ? it->second : nullptr;
+}
+
 STTModelType WhisperCppSTT::get_model_type() const {
     return STTModelType::WHISPER;
 }
 
+AbortMonitor WhisperCppSTT::make_abort_monitor(const CancellationToken* token,
+                                               double deadline_ms) const {
+    AbortMonitor monitor;
+    monitor.cancel_generation = &cancel_generation_;
+    monitor.generation = cancel_generation_.load();
+    monitor.token = token;
+    if (deadline_ms > 0.0) {
+        monitor.has_deadline = true;
+        monitor.deadline = std::chrono::steady_clock::now() +
+                           std::chrono::microseconds(static_cast<int64_t>(deadline_ms * 1000.0));
+    }
+    return monitor;
+}
+
+float WhisperCppSTT::average_token_prob(whisper_state* state, int segment) const {
+    const whisper_token token_eot = whisper_token_eot(ctx_);
+    const int n_tokens = whisper_full_n_tokens_from_state(state, segment);
+
+    double sum = 0.0;
+    int n_text = 0;
+    for (int j = 0; j < n_tokens; ++j) {
+        const whisper_token_data data = whisper_full_get_token_data_from_state(state, segment, j);
+        if (data.id < token_eot) {
+            sum += data.p;
+            ++n_text;
+        }
+    }
+    return n_text > 0 ? static_cast<float>(sum / n_text) : 0.0f;
+}
+
+void WhisperCppSTT::record_guard_stats(const DecodeGuard& guard, uint64_t no_speech_skips) {
+    DecodeGuardStats stats = guard.snapshot();
+    stats.no_speech_skips = no_speech_skips;
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    guard_stats_.add(stats);
+}
+
+DecodeGuardStats WhisperCppSTT::get_guard_stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return guard_stats_;
+}
+
+void WhisperCppSTT::reset_guard_stats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    guard_stats_ = DecodeGuardStats();
+}
+
 STTResult WhisperCppSTT::transcribe(const STTRequest& request) {
+    // Arm cancellation and the deadline before waiting on the context, so time spent
+    // queued behind another transcription counts against the request's budget
+    AbortMonitor monitor = make_abort_monitor(request.cancel_token.get(), request.deadline_ms);
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     STTResult result;
@@ -218,7 +481,12 @@ STTResult WhisperCppSTT::transcribe(const STTRequest& request) {
         return result;
     }
 
-    cancel_requested_.store(false);
+    if (monitor.should_abort()) {
+        LOGW("Transcription dropped before inference: %s", abort_reason_str(monitor.reason));
+        result.aborted = true;
+        result.abort_reason = monitor.reason;
+        return result;
+    }
 
     std::vector<float> audio = request.audio_samples;
     if (request.sample_rate != WHISPER_SAMPLE_RATE) {
@@ -227,12 +495,13 @@ STTResult WhisperCppSTT::transcribe(const STTRequest& request) {
 
     return transcribe_internal(audio, request.language,
                                request.detect_language || request.language.empty(),
-                               request.translate_to_english, request.word_timestamps);
+                               request.translate_to_english, request.word_timestamps, monitor);
 }
 
 STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
                                              const std::string& language, bool detect_language,
-                                             bool translate, bool word_timestamps) {
+                                             bool translate, bool word_timestamps,
+                                             AbortMonitor& monitor) {
     STTResult result;
     result.is_final = true;
 
@@ -256,15 +525,32 @@ STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
     wparams.translate = translate;
     wparams.token_timestamps = word_timestamps;
 
-    wparams.abort_callback = [](void* user_data) -> bool {
-        auto* cancel_flag = static_cast<std::atomic<bool>*>(user_data);
-        return cancel_flag->load();
-    };
-    wparams.abort_callback_user_data = &cancel_requested_;
+    wparams.abort_callback = whisper_abort_callback;
+    wparams.abort_callback_user_data = &monitor;
 
-    int ret = whisper_full(ctx_, wparams, audio.data(), static_cast<int>(audio.size()));
+    DecodeGuard guard;
+    guard.attach(ctx_, guard_config_, wparams);
 
-    if (ret != 0) {
+    // Only word-timestamp requests go through the DTW aligner; everything else
+    // decodes on the main context without alignment-head bookkeeping
+    whisper_context* ctx = ctx_;
+    whisper_state* state = transcribe_state_;
+    const bool use_dtw = word_timestamps && dtw_enabled_ && ensure_aligner();
+    if (use_dtw) {
+        ctx = aligner_ctx_;
+        state = aligner_state_;
+    }
+
+    int ret = whisper_full_with_state(ctx, state, wparams, audio.data(),
+                                      static_cast<int>(audio.size()));
+    guard.end_window();
+
+    if (monitor.reason != AbortReason::NONE) {
+        // Keep whatever segments completed before the abort
+        result.aborted = true;
+        result.abort_reason = monitor.reason;
+        LOGW("Transcription cut short: %s", abort_reason_str(monitor.reason));
+    } else if (ret != 0) {
         LOGE("whisper_full failed with code: %d", ret);
         return result;
     }
@@ -272,35 +558,49 @@ STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
-    const int n_segments = whisper_full_n_segments(ctx_);
+    const int n_segments = whisper_full_n_segments_from_state(state);
     std::string full_text;
+    uint64_t no_speech_skips = 0;
 
     for (int i = 0; i < n_segments; ++i) {
-        const char* text = whisper_full_get_segment_text(ctx_, i);
+        if (is_no_speech_segment(guard_config_, ctx_, state, i)) {
+            ++no_speech_skips;
+            continue;
+        }
+
+        const char* text = whisper_full_get_segment_text_from_state(state, i);
         if (text) {
             full_text += text;
 
             AudioSegment segment;
             segment.text = text;
-            segment.start_time_ms = whisper_full_get_segment_t0(ctx_, i) * 10.0;
-            segment.end_time_ms = whisper_full_get_segment_t1(ctx_, i) * 10.0;
+            segment.start_time_ms = whisper_full_get_segment_t0_from_state(state, i) * 10.0;
+            segment.end_time_ms = whisper_full_get_segment_t1_from_state(state, i) * 10.0;
 
-            float no_speech_prob = whisper_full_get_segment_no_speech_prob(ctx_, i);
+            float no_speech_prob = whisper_full_get_segment_no_speech_prob_from_state(state, i);
             segment.confidence = 1.0f - no_speech_prob;
+            segment.avg_token_prob = average_token_prob(state, i);
 
             result.segments.push_back(segment);
 
             if (word_timestamps) {
-                const int n_tokens = whisper_full_n_tokens(ctx_, i);
+                const int n_tokens = whisper_full_n_tokens_from_state(state, i);
                 for (int j = 0; j < n_tokens; ++j) {
-                    whisper_token_data token_data = whisper_full_get_token_data(ctx_, i, j);
-                    const char* token_text = whisper_full_get_token_text(ctx_, i, j);
+                    whisper_token_data token_data =
+                        whisper_full_get_token_data_from_state(state, i, j);
+                    const char* token_text =
+                        whisper_full_get_token_text_from_state(ctx, state, i, j);
 
                     if (token_text && token_text[0] != '\0' && token_text[0] != '<') {
                         WordTiming word;
                         word.word = token_text;
                         word.start_time_ms = token_data.t0 * 10.0;
                         word.end_time_ms = token_data.t1 * 10.0;
+                        if (use_dtw && token_data.t_dtw >= 0) {
+                            // DTW places the token onset more precisely than timestamp tokens
+                            word.start_time_ms = token_data.t_dtw * 10.0;
+                            word.end_time_ms = std::max(word.end_time_ms, word.start_time_ms);
+                        }
                         word.confidence = token_data.p;
                         result.word_timings.push_back(word);
                     }
@@ -309,11 +609,13 @@ STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
         }
     }
 
+    record_guard_stats(guard, no_speech_skips);
+
     result.text = full_text;
     result.audio_duration_ms = (audio.size() / static_cast<double>(WHISPER_SAMPLE_RATE)) * 1000.0;
     result.inference_time_ms = static_cast<double>(duration.count());
 
-    int lang_id = whisper_full_lang_id(ctx_);
+    int lang_id = whisper_full_lang_id_from_state(state);
     if (lang_id >= 0) {
         result.detected_language = whisper_lang_str(lang_id);
     }
@@ -353,7 +655,7 @@ std::string WhisperCppSTT::create_stream(const nlohmann::json& config) {
 
     std::string stream_id = generate_stream_id();
 
-    auto state = std::make_unique<WhisperStreamState>();
+    auto state = std::make_shared<WhisperStreamState>();
     state->state = whisper_init_state(ctx_);
 
     if (!state->state) {
@@ -364,11 +666,35 @@ std::string WhisperCppSTT::create_stream(const nlohmann::json& config) {
     if (config.contains("language")) {
         state->language = config["language"].get<std::string>();
     }
+    if (config.contains("detect_language")) {
+        state->detect_language = config["detect_language"].get<bool>();
+    }
+    state->detect_language = state->detect_language || state->language.empty();
+
+    // The model's translate setting applies unless the stream overrides it
+    if (config.contains("translate")) {
+        state->translate = config["translate"].get<bool>();
+    } else if (model_config_.contains("translate")) {
+        state->translate = model_config_["translate"].get<bool>();
+    }
 
     if (config.contains("sample_rate")) {
         state->sample_rate = config["sample_rate"].get<int>();
     }
 
+    if (config.contains("deadline_ms")) {
+        state->deadline_ms = config["deadline_ms"].get<double>();
+    }
+
+    if (config.contains("num_threads")) {
+        state->num_threads = config["num_threads"].get<int>();
+    }
+
+    {
+        std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
+        stream_tokens_[stream_id] = state->cancel_token;
+    }
+
     streams_[stream_id] = std::move(state);
 
     LOGI("Created stream: %s", stream_id.c_str());
@@ -376,82 +702,169 @@ std::string WhisperCppSTT::create_stream(const nlohmann::json& config) {
 }
 
 bool WhisperCppSTT::feed_audio(const std::string& stream_id, const std::vector<float>& samples,
-                               int sample_rate) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = streams_.find(stream_id);
-    if (it == streams_.end()) {
+                               int sample_rate, bool last_chunk) {
+    auto stream = find_stream(stream_id);
+    if (!stream) {
         LOGE("Stream not found: %s", stream_id.c_str());
         return false;
     }
 
-    auto& state = it->second;
-
     std::vector<float> resampled = samples;
     if (sample_rate != WHISPER_SAMPLE_RATE) {
         resampled = resample_to_16khz(samples, sample_rate);
     }
 
-    state->audio_buffer.insert(state->audio_buffer.end(), resampled.begin(), resampled.end());
+    std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+    if (stream->audio_buffer.empty()) {
+        stream->pending_since = std::chrono::steady_clock::now();
+    }
+    stream->audio_buffer.insert(stream->audio_buffer.end(), resampled.begin(), resampled.end());
+    if (last_chunk) {
+        stream->input_finished = true;
+    }
 
     return true;
 }
 
 bool WhisperCppSTT::is_stream_ready(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    StreamStatus status;
+    return get_stream_status(stream_id, &status) && status.ready;
+}
 
-    auto it = streams_.find(stream_id);
-    if (it == streams_.end()) {
+bool WhisperCppSTT::get_stream_status(const std::string& stream_id, StreamStatus* out_status) {
+    auto stream = find_stream(stream_id);
+    if (!stream || !out_status) {
         return false;
     }
 
     const size_t min_samples = WHISPER_SAMPLE_RATE;
-    return it->second->audio_buffer.size() >= min_samples || it->second->input_finished;
+
+    std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+    const size_t buffered = stream->audio_buffer.size();
+    out_status->ready = buffered >= min_samples || stream->input_finished;
+    out_status->input_finished = stream->input_finished;
+    out_status->buffered_ms = buffered * 1000.0 / WHISPER_SAMPLE_RATE;
+    out_status->pending_age_ms =
+        buffered > 0 ? std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                 stream->pending_since)
+                           .count()
+                     : 0.0;
+    out_status->deadline_ms = stream->deadline_ms;
+    return true;
 }
 
 STTResult WhisperCppSTT::decode(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    // The stream's deadline applies from the moment the chunk is requested
+    auto decode_start = std::chrono::steady_clock::now();
 
     STTResult result;
 
-    auto it = streams_.find(stream_id);
-    if (it == streams_.end()) {
+    // Only the stream lookup goes through mutex_; inference runs under the
+    // stream's own decode_mutex so other streams can decode concurrently
+    whisper_context* ctx = nullptr;
+    std::shared_ptr<WhisperStreamState> stream_state;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(stream_id);
+        if (it != streams_.end()) {
+            stream_state = it->second;
+            ctx = ctx_;
+        }
+    }
+
+    if (!stream_state) {
         LOGE("Stream not found: %s", stream_id.c_str());
         return result;
     }
 
-    auto& stream_state = it->second;
+    std::lock_guard<std::mutex> decode_lock(stream_state->decode_mutex);
+
+    // release_streams() frees the state under decode_mutex before freeing the context
+    if (!stream_state->state || !ctx) {
+        LOGE("Stream released: %s", stream_id.c_str());
+        return result;
+    }
+
+    std::vector<float> audio;
+    bool input_finished = false;
+    {
+        std::lock_guard<std::mutex> buffer_lock(stream_state->buffer_mutex);
+        audio.swap(stream_state->audio_buffer);
+        input_finished = stream_state->input_finished;
+    }
+
+    result.is_final = input_finished;
+    if (audio.empty()) {
+        return result;
+    }
+
+    AbortMonitor monitor = make_abort_monitor(stream_state->cancel_token.get(), 0.0);
+    if (stream_state->deadline_ms > 0.0) {
+        monitor.has_deadline = true;
+        monitor.deadline = decode_start + std::chrono::microseconds(static_cast<int64_t>(
+                                              stream_state->deadline_ms * 1000.0));
+    }
 
-    if (stream_state->audio_buffer.empty()) {
-        result.is_final = stream_state->input_finished;
+    if (monitor.should_abort()) {
+        // Drop the pending chunk instead of letting it delay the next one
+        LOGW("Stream %s chunk dropped before inference: %s", stream_id.c_str(),
+             abort_reason_str(monitor.reason));
+        result.aborted = true;
+        result.abort_reason = monitor.reason;
         return result;
     }
 
     whisper_full_params wparams = whisper_full_default_params(WHISPER_SAMPLING_GREEDY);
-    wparams.n_threads = backend_->get_num_threads();
-    wparams.single_segment = !stream_state->input_finished;
+    wparams.n_threads =
+        stream_state->num_threads > 0 ? stream_state->num_threads : backend_->get_num_threads();
+    wparams.single_segment = !input_finished;
     wparams.no_context = false;
     wparams.print_progress = false;
     wparams.print_realtime = false;
     wparams.print_timestamps = false;
 
-    if (!stream_state->language.empty()) {
-        wparams.language = stream_state->language.c_str();
-    }
+    // A null language makes whisper detect it and still transcribe; setting
+    // wparams.detect_language would stop after detection
+    wparams.language = stream_state->detect_language ? nullptr : stream_state->language.c_str();
+    wparams.translate = stream_state->translate;
 
-    int ret = whisper_full_with_state(ctx_, stream_state->state, wparams,
-                                      stream_state->audio_buffer.data(),
-                                      static_cast<int>(stream_state->audio_buffer.size()));
+    wparams.abort_callback = whisper_abort_callback;
+    wparams.abort_callback_user_data = &monitor;
 
-    if (ret != 0) {
+    DecodeGuard guard;
+    guard.attach(ctx, guard_config_, wparams);
+
+    int ret = whisper_full_with_state(ctx, stream_state->state, wparams, audio.data(),
+                                      static_cast<int>(audio.size()));
+    guard.end_window();
+
+    if (monitor.reason != AbortReason::NONE) {
+        LOGW("Stream %s decode cut short: %s", stream_id.c_str(),
+             abort_reason_str(monitor.reason));
+        result.aborted = true;
+        result.abort_reason = monitor.reason;
+    } else if (ret != 0) {
         LOGE("whisper_full_with_state failed: %d", ret);
+        result.failed = true;
+
+        // Put the chunk back ahead of anything fed during the failed decode
+        std::lock_guard<std::mutex> buffer_lock(stream_state->buffer_mutex);
+        audio.insert(audio.end(), stream_state->audio_buffer.begin(),
+                     stream_state->audio_buffer.end());
+        stream_state->audio_buffer.swap(audio);
         return result;
     }
 
     const int n_segments = whisper_full_n_segments_from_state(stream_state->state);
     std::string full_text;
+    uint64_t no_speech_skips = 0;
 
     for (int i = 0; i < n_segments; ++i) {
+        if (is_no_speech_segment(guard_config_, ctx, stream_state->state, i)) {
+            ++no_speech_skips;
+            continue;
+        }
+
         const char* text = whisper_full_get_segment_text_from_state(stream_state->state, i);
         if (text) {
             full_text += text;
@@ -462,72 +875,102 @@ STTResult WhisperCppSTT::decode(const std::string& stream_id) {
                 whisper_full_get_segment_t0_from_state(stream_state->state, i) * 10.0;
             segment.end_time_ms =
                 whisper_full_get_segment_t1_from_state(stream_state->state, i) * 10.0;
+            segment.confidence =
+                1.0f - whisper_full_get_segment_no_speech_prob_from_state(stream_state->state, i);
+            segment.avg_token_prob = average_token_prob(stream_state->state, i);
             result.segments.push_back(segment);
         }
     }
 
+    record_guard_stats(guard, no_speech_skips);
+
     result.text = full_text;
-    result.is_final = stream_state->input_finished;
-    result.audio_duration_ms =
-        (stream_state->audio_buffer.size() / static_cast<double>(WHISPER_SAMPLE_RATE)) * 1000.0;
+    result.audio_duration_ms = (audio.size() / static_cast<double>(WHISPER_SAMPLE_RATE)) * 1000.0;
+    result.inference_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decode_start)
+            .count();
 
     int lang_id = whisper_full_lang_id_from_state(stream_state->state);
     if (lang_id >= 0) {
         result.detected_language = whisper_lang_str(lang_id);
     }
 
-    stream_state->audio_buffer.clear();
-
     return result;
 }
 
 bool WhisperCppSTT::is_endpoint(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = streams_.find(stream_id);
-    if (it == streams_.end()) {
+    auto stream = find_stream(stream_id);
+    if (!stream) {
         return false;
     }
 
-    return it->second->input_finished;
+    std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+    return stream->input_finished;
 }
 
 void WhisperCppSTT::input_finished(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = streams_.find(stream_id);
-    if (it != streams_.end()) {
-        it->second->input_finished = true;
+    auto stream = find_stream(stream_id);
+    if (stream) {
+        std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+        stream->input_finished = true;
         LOGI("Input finished for stream: %s", stream_id.c_str());
     }
 }
 
 void WhisperCppSTT::reset_stream(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = streams_.find(stream_id);
-    if (it != streams_.end()) {
-        it->second->audio_buffer.clear();
-        it->second->input_finished = false;
+    auto stream = find_stream(stream_id);
+    if (stream) {
+        std::lock_guard<std::mutex> buffer_lock(stream->buffer_mutex);
+        stream->audio_buffer.clear();
+        stream->input_finished = false;
+        stream->cancel_token->reset();
         LOGI("Reset stream: %s", stream_id.c_str());
     }
 }
 
 void WhisperCppSTT::destroy_stream(const std::string& stream_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<WhisperStreamState> stream;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(stream_id);
+        if (it != streams_.end()) {
+            stream = std::move(it->second);
+            streams_.erase(it);
+        }
+    }
 
-    auto it = streams_.find(stream_id);
-    if (it != streams_.end()) {
-        if (it->second && it->second->state) {
-            whisper_free_state(it->second->state);
+    {
+        std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
+        stream_tokens_.erase(stream_id);
+    }
+
+    if (stream) {
+        // Abort an in-flight decode of this stream and wait for it to let go of the state
+        stream->cancel_token->cancel();
+        std::lock_guard<std::mutex> decode_lock(stream->decode_mutex);
+        if (stream->state) {
+            whisper_free_state(stream->state);
+            stream->state = nullptr;
         }
-        streams_.erase(it);
         LOGI("Destroyed stream: %s", stream_id.c_str());
     }
 }
 
+void WhisperCppSTT::cancel_stream(const std::string& stream_id) {
+    // Deliberately avoids mutex_, which an in-flight transcription holds
+    std::lock_guard<std::mutex> tokens_lock(tokens_mutex_);
+
+    auto it = stream_tokens_.find(stream_id);
+    if (it != stream_tokens_.end()) {
+        it->second->cancel();
+        LOGI("Cancellation requested for stream: %s", stream_id.c_str());
+    }
+}
+
 void WhisperCppSTT::cancel() {
-    cancel_requested_.store(true);
+    // Aborts every transcription submitted before this call, including ones still
+    // waiting for the context; later requests are unaffected
+    cancel_generation_.fetch_add(1);
     LOGI("Cancellation requested");
 }
 
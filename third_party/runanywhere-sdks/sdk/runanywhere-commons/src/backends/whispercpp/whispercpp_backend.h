@@ -11,6 +11,7 @@
 #include <whisper.h>
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -20,6 +21,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "rac/backends/rac_whispercpp_decode_guard.h"
+
 namespace runanywhere {
 
 // =============================================================================
@@ -41,6 +44,46 @@ enum class STTModelType {
     CUSTOM
 };
 
+// =============================================================================
+// CANCELLATION
+// =============================================================================
+
+/**
+ * Cooperative cancellation flag shared between a caller and an in-flight decode.
+ * Polled from whisper's abort_callback, so cancelling takes effect mid-inference.
+ */
+class CancellationToken {
+   public:
+    void cancel() { cancelled_.store(true); }
+    void reset() { cancelled_.store(false); }
+    bool is_cancelled() const { return cancelled_.load(); }
+
+   private:
+    std::atomic<bool> cancelled_{false};
+};
+
+enum class AbortReason {
+    NONE = 0,
+    CANCELLED = 1,
+    DEADLINE_EXCEEDED = 2,
+};
+
+/**
+ * Abort conditions for a single decode, evaluated from whisper's abort_callback.
+ * The cancel generation is captured when the request arrives, so a cancel() issued
+ * while the request is still waiting for the context is not lost.
+ */
+struct AbortMonitor {
+    const std::atomic<uint64_t>* cancel_generation = nullptr;
+    uint64_t generation = 0;
+    const CancellationToken* token = nullptr;
+    bool has_deadline = false;
+    std::chrono::steady_clock::time_point deadline;
+    AbortReason reason = AbortReason::NONE;
+
+    bool should_abort();
+};
+
 // =============================================================================
 // STT RESULT TYPES
 // =============================================================================
@@ -57,6 +100,7 @@ struct AudioSegment {
     double start_time_ms = 0.0;
     double end_time_ms = 0.0;
     float confidence = 0.0f;
+    float avg_token_prob = 0.0f;  // Mean probability of the segment's text tokens
     std::string language;
 };
 
@@ -67,6 +111,8 @@ struct STTRequest {
     bool detect_language = false;
     bool word_timestamps = false;
     bool translate_to_english = false;
+    std::shared_ptr<CancellationToken> cancel_token;  // Optional per-request token
+    double deadline_ms = 0.0;  // Latency budget measured from submission (0 = none)
 };
 
 struct STTResult {
@@ -78,6 +124,9 @@ struct STTResult {
     double inference_time_ms = 0.0;
     float confidence = 0.0f;
     bool is_final = true;
+    bool aborted = false;  // Cut short by cancellation or deadline; text may be partial
+    AbortReason abort_reason = AbortReason::NONE;
+    bool failed = false;  // Inference returned an error; the chunk's audio was kept
 };
 
 // =============================================================================
@@ -126,8 +175,28 @@ struct WhisperStreamState {
     whisper_state* state = nullptr;
     std::vector<float> audio_buffer;
     std::string language;
+    bool detect_language = false;
+    bool translate = false;
     bool input_finished = false;
     int sample_rate = 16000;
+    int num_threads = 0;  // Threads per decode (0 = backend setting)
+    std::shared_ptr<CancellationToken> cancel_token = std::make_shared<CancellationToken>();
+    double deadline_ms = 0.0;  // Per-decode latency budget (0 = none)
+    std::chrono::steady_clock::time_point pending_since;  // Arrival of oldest buffered sample
+
+    // audio_buffer, input_finished and pending_since are guarded by buffer_mutex.
+    // decode_mutex is held for a whole inference, so streams decode in parallel
+    // with each other but a single whisper_state never runs two chunks at once.
+    std::mutex buffer_mutex;
+    std::mutex decode_mutex;
+};
+
+struct StreamStatus {
+    bool ready = false;
+    bool input_finished = false;
+    double buffered_ms = 0.0;
+    double pending_age_ms = 0.0;  // Wall time since the oldest buffered sample arrived
+    double deadline_ms = 0.0;
 };
 
 // =============================================================================
@@ -150,35 +219,71 @@ class WhisperCppSTT {
 
     bool supports_streaming() const;
     std::string create_stream(const nlohmann::json& config = {});
-    bool feed_audio(const std::string& stream_id, const std::vector<float>& samples, int sample_rate);
+    // last_chunk marks input finished together with the samples, so no decode
+    // can take the samples as a partial chunk in between
+    bool feed_audio(const std::string& stream_id, const std::vector<float>& samples,
+                    int sample_rate, bool last_chunk = false);
     bool is_stream_ready(const std::string& stream_id);
+    bool get_stream_status(const std::string& stream_id, StreamStatus* out_status);
     STTResult decode(const std::string& stream_id);
     bool is_endpoint(const std::string& stream_id);
     void input_finished(const std::string& stream_id);
     void reset_stream(const std::string& stream_id);
     void destroy_stream(const std::string& stream_id);
 
+    // Aborts the stream's in-flight decode and drops its chunks until reset_stream()
+    void cancel_stream(const std::string& stream_id);
+
+    // Aborts every transcription and decode submitted before the call
     void cancel();
     std::vector<std::string> get_supported_languages() const;
 
+    DecodeGuardStats get_guard_stats() const;
+    void reset_guard_stats();
+
    private:
     STTResult transcribe_internal(const std::vector<float>& audio, const std::string& language,
-                                  bool detect_language, bool translate, bool word_timestamps);
+                                  bool detect_language, bool translate, bool word_timestamps,
+                                  AbortMonitor& monitor);
+    AbortMonitor make_abort_monitor(const CancellationToken* token, double deadline_ms) const;
+    float average_token_prob(whisper_state* state, int segment) const;
+    void record_guard_stats(const DecodeGuard& guard, uint64_t no_speech_skips);
     std::vector<float> resample_to_16khz(const std::vector<float>& samples, int source_rate);
     std::string generate_stream_id();
+    whisper_alignment_heads_preset select_aheads_preset() const;
+    bool ensure_aligner();
+    void free_contexts();
+    std::shared_ptr<WhisperStreamState> find_stream(const std::string& stream_id) const;
+    void release_streams();
 
     WhisperCppBackend* backend_;
     whisper_context* ctx_ = nullptr;
+    whisper_state* transcribe_state_ = nullptr;  // Batch transcription state on ctx_
+
+    // DTW word alignment runs on a second context, created on the first request
+    // that asks for word timestamps, so other requests never pay for it
+    bool dtw_enabled_ = false;
+    whisper_alignment_heads_preset aheads_preset_ = WHISPER_AHEADS_NONE;
+    whisper_context* aligner_ctx_ = nullptr;
+    whisper_state* aligner_state_ = nullptr;
 
     bool model_loaded_ = false;
-    std::atomic<bool> cancel_requested_{false};
+    std::atomic<uint64_t> cancel_generation_{0};
 
     std::string model_path_;
     nlohmann::json model_config_;
 
-    std::unordered_map<std::string, std::unique_ptr<WhisperStreamState>> streams_;
+    DecodeGuardConfig guard_config_;
+    DecodeGuardStats guard_stats_;
+    mutable std::mutex stats_mutex_;
+
+    std::unordered_map<std::string, std::shared_ptr<WhisperStreamState>> streams_;
     int stream_counter_ = 0;
 
+    // Stream cancel tokens, reachable without mutex_ while a transcription holds it
+    std::unordered_map<std::string, std::shared_ptr<CancellationToken>> stream_tokens_;
+    std::mutex tokens_mutex_;
+
     mutable std::mutex mutex_;
 };
 
@@ -0,0 +1,265 @@
+/**
+ * WhisperCPP Escalation Router Implementation
+ */
+
+#include "whispercpp_router.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+
+#define LOGI(...) RAC_LOG_INFO("STT.WhisperCpp.Router", __VA_ARGS__)
+#define LOGW(...) RAC_LOG_WARNING("STT.WhisperCpp.Router", __VA_ARGS__)
+
+namespace runanywhere {
+
+namespace {
+
+double elapsed_ms(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+// Consecutive low-confidence segments [first, last], escalated as one call
+struct EscalationSpan {
+    size_t first;
+    size_t last;
+};
+
+// Whether a piece of escalated output centers inside the escalated span
+bool within_span(double start_ms, double end_ms, double t0, double t1) {
+    const double mid = (start_ms + end_ms) / 2.0;
+    return mid >= t0 && mid < t1;
+}
+
+// Escalated segments shifted to request time, minus those in the padding
+std::vector<AudioSegment> trim_segments(const std::vector<AudioSegment>& segments,
+                                        double offset_ms, double t0, double t1) {
+    std::vector<AudioSegment> kept;
+    for (auto seg : segments) {
+        seg.start_time_ms += offset_ms;
+        seg.end_time_ms += offset_ms;
+        if (within_span(seg.start_time_ms, seg.end_time_ms, t0, t1)) {
+            kept.push_back(std::move(seg));
+        }
+    }
+    return kept;
+}
+
+}  // namespace
+
+WhisperCppRouter::WhisperCppRouter(WhisperCppSTT* primary, WhisperCppSTT* escalation,
+                                   const RouterConfig& config)
+    : primary_(primary), escalation_(escalation), config_(config) {
+    LOGI("WhisperCppRouter created (confidence < %.2f or token prob < %.2f escalates)",
+         config_.min_segment_confidence, config_.min_avg_token_prob);
+}
+
+bool WhisperCppRouter::needs_escalation(const AudioSegment& segment) const {
+    return segment.confidence < config_.min_segment_confidence ||
+           segment.avg_token_prob < config_.min_avg_token_prob;
+}
+
+STTResult WhisperCppRouter::transcribe(const STTRequest& request) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    STTResult result = primary_->transcribe(request);
+    const double primary_ms = elapsed_ms(start_time);
+
+    std::vector<EscalationSpan> spans;
+    if (!result.aborted) {
+        for (size_t i = 0; i < result.segments.size(); ++i) {
+            if (!needs_escalation(result.segments[i])) {
+                continue;
+            }
+            if (!spans.empty() && spans.back().last + 1 == i) {
+                spans.back().last = i;
+            } else {
+                spans.push_back({i, i});
+            }
+        }
+    }
+
+    RouterStats delta;
+    delta.requests = 1;
+    delta.segments = result.segments.size();
+    delta.audio_ms = result.audio_duration_ms;
+    delta.primary_time_ms = primary_ms;
+
+    if (!spans.empty() && escalation_ && escalation_->is_ready()) {
+        const int sample_rate = request.sample_rate > 0 ? request.sample_rate : 16000;
+        const size_t total_samples = request.audio_samples.size();
+        const std::string& language =
+            result.detected_language.empty() ? request.language : result.detected_language;
+
+        std::vector<AudioSegment> segments;
+        std::vector<std::pair<double, double>> replaced_ranges;
+        std::vector<WordTiming> escalated_words;
+        size_t next = 0;
+
+        for (const auto& span : spans) {
+            segments.insert(segments.end(), result.segments.begin() + next,
+                            result.segments.begin() + span.first);
+            next = span.last + 1;
+
+            const double t0 = result.segments[span.first].start_time_ms;
+            const double t1 = result.segments[span.last].end_time_ms;
+            const double padded_t0 = std::max(0.0, t0 - config_.padding_ms);
+            const size_t s0 = std::min(
+                total_samples, static_cast<size_t>(padded_t0 * sample_rate / 1000.0));
+            const size_t s1 = std::min(
+                total_samples, static_cast<size_t>((t1 + config_.padding_ms) * sample_rate / 1000.0));
+
+            STTRequest sub;
+            sub.audio_samples.assign(request.audio_samples.begin() + s0,
+                                     request.audio_samples.begin() + s1);
+            sub.sample_rate = sample_rate;
+            sub.language = language;
+            sub.detect_language = language.empty();
+            sub.word_timestamps = request.word_timestamps;
+            sub.translate_to_english = request.translate_to_english;
+            sub.cancel_token = request.cancel_token;
+
+            bool escalated = false;
+            if (s1 > s0) {
+                // Escalations share whatever is left of the request's latency budget
+                double remaining_ms = 0.0;
+                if (request.deadline_ms > 0.0) {
+                    remaining_ms = request.deadline_ms - elapsed_ms(start_time);
+                }
+                if (request.deadline_ms <= 0.0 || remaining_ms > 0.0) {
+                    sub.deadline_ms = remaining_ms;
+
+                    auto escalation_start = std::chrono::steady_clock::now();
+                    STTResult upgraded = escalation_->transcribe(sub);
+                    delta.escalation_time_ms += elapsed_ms(escalation_start);
+
+                    // The padding is only context: keep what the escalation model
+                    // placed inside [t0, t1], or its edge words would be duplicated
+                    const double offset_ms = s0 * 1000.0 / sample_rate;
+                    std::vector<AudioSegment> kept;
+                    if (!upgraded.aborted) {
+                        kept = trim_segments(upgraded.segments, offset_ms, t0, t1);
+                    }
+
+                    if (!kept.empty()) {
+                        AudioSegment merged;
+                        merged.start_time_ms = t0;
+                        merged.end_time_ms = t1;
+                        merged.language = upgraded.detected_language;
+                        float confidence_sum = 0.0f;
+                        float token_prob_sum = 0.0f;
+                        for (const auto& seg : kept) {
+                            merged.text += seg.text;
+                            confidence_sum += seg.confidence;
+                            token_prob_sum += seg.avg_token_prob;
+                        }
+                        const auto n = static_cast<float>(kept.size());
+                        merged.confidence = confidence_sum / n;
+                        merged.avg_token_prob = token_prob_sum / n;
+
+                        // With word timings the trim can go below segment granularity
+                        std::string words_text;
+                        for (auto word : upgraded.word_timings) {
+                            word.start_time_ms += offset_ms;
+                            word.end_time_ms += offset_ms;
+                            if (within_span(word.start_time_ms, word.end_time_ms, t0, t1)) {
+                                words_text += word.word;
+                                escalated_words.push_back(std::move(word));
+                            }
+                        }
+                        if (!words_text.empty()) {
+                            merged.text = std::move(words_text);
+                        }
+
+                        const size_t n_span = span.last - span.first + 1;
+                        for (size_t i = span.first; i <= span.last; ++i) {
+                            delta.token_prob_before_sum += result.segments[i].avg_token_prob;
+                        }
+                        delta.token_prob_after_sum += merged.avg_token_prob * n_span;
+                        delta.escalated_segments += n_span;
+                        delta.escalated_audio_ms += t1 - t0;
+
+                        segments.push_back(std::move(merged));
+                        replaced_ranges.emplace_back(t0, t1);
+                        escalated = true;
+                    }
+                }
+            }
+
+            if (!escalated) {
+                segments.insert(segments.end(), result.segments.begin() + span.first,
+                                result.segments.begin() + span.last + 1);
+            }
+        }
+        segments.insert(segments.end(), result.segments.begin() + next, result.segments.end());
+
+        if (!replaced_ranges.empty()) {
+            result.segments = std::move(segments);
+
+            result.text.clear();
+            float confidence_sum = 0.0f;
+            for (const auto& seg : result.segments) {
+                result.text += seg.text;
+                confidence_sum += seg.confidence;
+            }
+            result.confidence = confidence_sum / static_cast<float>(result.segments.size());
+
+            std::vector<WordTiming> words;
+            for (auto& word : result.word_timings) {
+                const bool replaced = std::any_of(
+                    replaced_ranges.begin(), replaced_ranges.end(), [&](const auto& range) {
+                        return word.start_time_ms >= range.first && word.start_time_ms < range.second;
+                    });
+                if (!replaced) {
+                    words.push_back(std::move(word));
+                }
+            }
+            words.insert(words.end(), escalated_words.begin(), escalated_words.end());
+            std::stable_sort(words.begin(), words.end(), [](const auto& a, const auto& b) {
+                return a.start_time_ms < b.start_time_ms;
+            });
+            result.word_timings = std::move(words);
+        }
+    } else if (!spans.empty()) {
+        LOGW("Escalation model not ready; keeping %zu low-confidence spans", spans.size());
+    }
+
+    result.inference_time_ms = elapsed_ms(start_time);
+
+    LOGI("Routed transcription: %llu/%llu segments escalated, primary %.0fms, escalation %.0fms",
+         static_cast<unsigned long long>(delta.escalated_segments),
+         static_cast<unsigned long long>(delta.segments), delta.primary_time_ms,
+         delta.escalation_time_ms);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.requests += delta.requests;
+    stats_.segments += delta.segments;
+    stats_.escalated_segments += delta.escalated_segments;
+    stats_.audio_ms += delta.audio_ms;
+    stats_.escalated_audio_ms += delta.escalated_audio_ms;
+    stats_.primary_time_ms += delta.primary_time_ms;
+    stats_.escalation_time_ms += delta.escalation_time_ms;
+    stats_.token_prob_before_sum += delta.token_prob_before_sum;
+    stats_.token_prob_after_sum += delta.token_prob_after_sum;
+
+    return result;
+}
+
+void WhisperCppRouter::cancel() {
+    primary_->cancel();
+    if (escalation_) {
+        escalation_->cancel();
+    }
+}
+
+RouterStats WhisperCppRouter::get_stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+}  // namespace runanywhere
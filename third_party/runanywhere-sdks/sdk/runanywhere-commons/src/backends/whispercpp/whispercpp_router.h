@@ -0,0 +1,68 @@
+#ifndef RUNANYWHERE_WHISPERCPP_ROUTER_H
+#define RUNANYWHERE_WHISPERCPP_ROUTER_H
+
+/**
+ * WhisperCPP Escalation Router
+ *
+ * Transcribes with a small whisper model first and re-transcribes only the
+ * segments it is unsure about with a larger model. Confidence comes from the
+ * segment's no-speech probability and the mean probability of its text tokens.
+ */
+
+#include <cstdint>
+#include <mutex>
+
+#include "whispercpp_backend.h"
+
+namespace runanywhere {
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+struct RouterConfig {
+    float min_segment_confidence = 0.5f;  // Escalate below this (1 - no_speech_prob)
+    float min_avg_token_prob = 0.6f;      // Escalate below this mean token probability
+    double padding_ms = 200.0;            // Audio context added around escalated spans
+};
+
+struct RouterStats {
+    uint64_t requests = 0;
+    uint64_t segments = 0;
+    uint64_t escalated_segments = 0;
+    double audio_ms = 0.0;
+    double escalated_audio_ms = 0.0;
+    double primary_time_ms = 0.0;
+    double escalation_time_ms = 0.0;
+    double token_prob_before_sum = 0.0;  // Primary token prob over escalated segments
+    double token_prob_after_sum = 0.0;   // Escalation token prob over the same segments
+};
+
+// =============================================================================
+// ROUTER
+// =============================================================================
+
+class WhisperCppRouter {
+   public:
+    WhisperCppRouter(WhisperCppSTT* primary, WhisperCppSTT* escalation,
+                     const RouterConfig& config = {});
+
+    STTResult transcribe(const STTRequest& request);
+
+    void cancel();
+    RouterStats get_stats() const;
+
+   private:
+    bool needs_escalation(const AudioSegment& segment) const;
+
+    WhisperCppSTT* primary_;     // Not owned
+    WhisperCppSTT* escalation_;  // Not owned
+    RouterConfig config_;
+
+    RouterStats stats_;
+    mutable std::mutex stats_mutex_;
+};
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_WHISPERCPP_ROUTER_H
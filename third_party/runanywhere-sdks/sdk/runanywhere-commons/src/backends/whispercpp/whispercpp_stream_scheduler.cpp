@@ -0,0 +1,293 @@
+/**
+ * WhisperCPP Stream Scheduler Implementation
+ */
+
+#include "whispercpp_stream_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include "rac/core/rac_logger.h"
+
+#define LOGI(...) RAC_LOG_INFO("STT.WhisperCpp.Scheduler", __VA_ARGS__)
+
+namespace runanywhere {
+
+namespace {
+
+double elapsed_ms(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+struct Candidate {
+    std::string stream_id;
+    StreamStatus status;
+    bool starved = false;
+    double slack_ms = 0.0;  // Deadline budget left for the oldest buffered sample
+};
+
+}  // namespace
+
+WhisperCppStreamScheduler::WhisperCppStreamScheduler(WhisperCppSTT* stt,
+                                                     const StreamSchedulerConfig& config)
+    : stt_(stt), config_(config) {
+    if (config_.max_concurrent_decodes <= 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        config_.max_concurrent_decodes = std::max(1, static_cast<int>(hw) / 4);
+    }
+    if (config_.tick_interval_ms <= 0.0) {
+        config_.tick_interval_ms = 50.0;
+    }
+}
+
+WhisperCppStreamScheduler::~WhisperCppStreamScheduler() {
+    stop();
+}
+
+void WhisperCppStreamScheduler::add_stream(const std::string& stream_id, ResultCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ScheduledStream& stream = streams_[stream_id];
+    stream.callback = std::move(callback);
+    stream.finished = false;
+    stream.skipped_ticks = 0;
+}
+
+void WhisperCppStreamScheduler::remove_stream(const std::string& stream_id) {
+    // Wait out a decode in flight so its callback never runs after removal
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [&] {
+        auto it = streams_.find(stream_id);
+        return it == streams_.end() || !it->second.in_flight;
+    });
+    streams_.erase(stream_id);
+    stats_.streams.erase(stream_id);
+}
+
+void WhisperCppStreamScheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+
+    for (int i = 0; i < config_.max_concurrent_decodes; ++i) {
+        workers_.emplace_back(&WhisperCppStreamScheduler::worker_loop, this);
+    }
+    scheduler_thread_ = std::thread(&WhisperCppStreamScheduler::scheduler_loop, this);
+
+    LOGI("Stream scheduler started: %d decode workers, %.0fms tick",
+         config_.max_concurrent_decodes, config_.tick_interval_ms);
+}
+
+void WhisperCppStreamScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    tick_cv_.notify_all();
+    jobs_cv_.notify_all();
+
+    if (scheduler_thread_.joinable()) {
+        scheduler_thread_.join();
+    }
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.clear();
+    for (auto& [id, stream] : streams_) {
+        stream.in_flight = false;
+    }
+    idle_cv_.notify_all();
+
+    LOGI("Stream scheduler stopped");
+}
+
+size_t WhisperCppStreamScheduler::tick() {
+    std::vector<std::string> idle;
+    size_t in_flight = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.ticks;
+        for (const auto& [id, stream] : streams_) {
+            if (stream.in_flight) {
+                ++in_flight;
+            } else if (!stream.finished) {
+                idle.push_back(id);
+            }
+        }
+    }
+
+    const size_t slots = static_cast<size_t>(config_.max_concurrent_decodes);
+    if (idle.empty() || in_flight >= slots) {
+        return 0;
+    }
+
+    // Stream status takes the STT's locks, so gather it outside our own
+    std::vector<Candidate> candidates;
+    for (auto& id : idle) {
+        Candidate candidate;
+        // A finished stream is decoded once more, even empty, to deliver its final result
+        if (!stt_->get_stream_status(id, &candidate.status) || !candidate.status.ready ||
+            (candidate.status.buffered_ms <= 0.0 && !candidate.status.input_finished)) {
+            continue;
+        }
+        candidate.slack_ms = candidate.status.deadline_ms > 0.0
+                                 ? candidate.status.deadline_ms - candidate.status.pending_age_ms
+                                 : std::numeric_limits<double>::infinity();
+        candidate.stream_id = std::move(id);
+        candidates.push_back(std::move(candidate));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& candidate : candidates) {
+        auto it = streams_.find(candidate.stream_id);
+        candidate.starved =
+            it != streams_.end() && it->second.skipped_ticks >= config_.max_skipped_ticks;
+    }
+
+    // Streams starved by the fairness bound go first, then the tightest deadline
+    // slack, then the oldest audio
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.starved != b.starved) {
+            return a.starved;
+        }
+        if (a.slack_ms != b.slack_ms) {
+            return a.slack_ms < b.slack_ms;
+        }
+        return a.status.pending_age_ms > b.status.pending_age_ms;
+    });
+
+    const auto now = std::chrono::steady_clock::now();
+    size_t available = slots - in_flight;
+    size_t dispatched = 0;
+
+    for (const auto& candidate : candidates) {
+        auto it = streams_.find(candidate.stream_id);
+        if (it == streams_.end() || it->second.in_flight) {
+            continue;
+        }
+        ScheduledStream& stream = it->second;
+
+        if (dispatched >= available) {
+            ++stream.skipped_ticks;
+            ++stats_.deferred;
+            continue;
+        }
+
+        if (candidate.starved) {
+            ++stats_.fairness_promotions;
+        }
+        stream.in_flight = true;
+        stream.skipped_ticks = 0;
+        jobs_.push_back(
+            {candidate.stream_id, stream.callback, candidate.status.pending_age_ms, now});
+        ++dispatched;
+    }
+
+    stats_.dispatched += dispatched;
+    if (dispatched > 0) {
+        jobs_cv_.notify_all();
+    }
+    return dispatched;
+}
+
+void WhisperCppStreamScheduler::scheduler_loop() {
+    const auto interval =
+        std::chrono::microseconds(static_cast<int64_t>(config_.tick_interval_ms * 1000.0));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        lock.unlock();
+        tick();
+        lock.lock();
+        tick_cv_.wait_for(lock, interval, [this] { return !running_ || tick_requested_; });
+        tick_requested_ = false;
+    }
+}
+
+void WhisperCppStreamScheduler::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        jobs_cv_.wait(lock, [this] { return !running_ || !jobs_.empty(); });
+        if (!running_) {
+            return;
+        }
+
+        DecodeJob job = std::move(jobs_.front());
+        jobs_.pop_front();
+
+        lock.unlock();
+        run_job(job);
+        lock.lock();
+    }
+}
+
+void WhisperCppStreamScheduler::run_job(const DecodeJob& job) {
+    STTResult result = stt_->decode(job.stream_id);
+
+    // How far the transcript trails the audio: the chunk's oldest sample had
+    // already waited pending_age_ms when dispatched, plus queueing and inference
+    const double lag_ms = job.pending_age_ms + elapsed_ms(job.dispatched_at);
+
+    bool deliver = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(job.stream_id);
+        if (it != streams_.end()) {
+            deliver = true;
+            it->second.finished = result.is_final;
+
+            StreamLagStats& lag = stats_.streams[job.stream_id];
+            ++lag.decodes;
+            if (result.aborted) {
+                ++lag.aborted_decodes;
+            }
+            lag.audio_ms += result.audio_duration_ms;
+            lag.inference_ms += result.inference_time_ms;
+            lag.last_lag_ms = lag_ms;
+            lag.max_lag_ms = std::max(lag.max_lag_ms, lag_ms);
+            lag.total_lag_ms += lag_ms;
+
+            ++stats_.decodes;
+            if (result.failed) {
+                ++stats_.failed_decodes;
+            }
+            stats_.total_lag_ms += lag_ms;
+            stats_.max_lag_ms = std::max(stats_.max_lag_ms, lag_ms);
+        }
+    }
+
+    if (deliver && job.callback) {
+        job.callback(job.stream_id, result);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = streams_.find(job.stream_id);
+        if (it != streams_.end()) {
+            it->second.in_flight = false;
+        }
+        tick_requested_ = true;
+    }
+    idle_cv_.notify_all();
+
+    // A freed worker may let a deferred stream go right away
+    tick_cv_.notify_all();
+}
+
+StreamSchedulerStats WhisperCppStreamScheduler::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}  // namespace runanywhere
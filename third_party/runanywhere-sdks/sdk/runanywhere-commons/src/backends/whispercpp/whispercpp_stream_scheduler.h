@@ -0,0 +1,124 @@
+#ifndef RUNANYWHERE_WHISPERCPP_STREAM_SCHEDULER_H
+#define RUNANYWHERE_WHISPERCPP_STREAM_SCHEDULER_H
+
+/**
+ * WhisperCPP Stream Scheduler
+ *
+ * Drives decode() for many concurrent streams. Each tick gathers the ready
+ * streams, orders them by deadline slack and audio age, and hands them to a
+ * fixed pool of decode workers. Every stream owns its whisper_state, so the
+ * workers run in parallel instead of queueing one stream behind another.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "whispercpp_backend.h"
+
+namespace runanywhere {
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+struct StreamSchedulerConfig {
+    int max_concurrent_decodes = 2;  // Decode workers (<= 0 = based on hardware threads)
+    double tick_interval_ms = 50.0;  // How often ready streams are gathered
+    int max_skipped_ticks = 4;       // Fairness: a stream passed over this often goes first
+};
+
+struct StreamLagStats {
+    uint64_t decodes = 0;
+    uint64_t aborted_decodes = 0;
+    double audio_ms = 0.0;
+    double inference_ms = 0.0;
+    double last_lag_ms = 0.0;  // Age of a chunk's oldest sample when its result was delivered
+    double max_lag_ms = 0.0;
+    double total_lag_ms = 0.0;
+};
+
+struct StreamSchedulerStats {
+    uint64_t ticks = 0;
+    uint64_t dispatched = 0;
+    uint64_t deferred = 0;             // Ready streams left for a later tick
+    uint64_t fairness_promotions = 0;  // Dispatches forced by max_skipped_ticks
+    uint64_t decodes = 0;              // Results delivered, including removed streams
+    uint64_t failed_decodes = 0;       // Delivered results whose inference failed
+    double total_lag_ms = 0.0;
+    double max_lag_ms = 0.0;
+    std::unordered_map<std::string, StreamLagStats> streams;
+};
+
+// =============================================================================
+// SCHEDULER
+// =============================================================================
+
+class WhisperCppStreamScheduler {
+   public:
+    using ResultCallback = std::function<void(const std::string& stream_id, const STTResult&)>;
+
+    WhisperCppStreamScheduler(WhisperCppSTT* stt, const StreamSchedulerConfig& config = {});
+    ~WhisperCppStreamScheduler();
+
+    // Streams are created on the STT instance and then handed to the scheduler.
+    // remove_stream() waits for a result being delivered, so it must not be
+    // called from the stream's own callback.
+    void add_stream(const std::string& stream_id, ResultCallback callback);
+    void remove_stream(const std::string& stream_id);
+
+    void start();
+    void stop();
+
+    // Runs one scheduling round; returns the number of streams dispatched
+    size_t tick();
+
+    StreamSchedulerStats get_stats() const;
+
+   private:
+    struct ScheduledStream {
+        ResultCallback callback;
+        bool in_flight = false;
+        bool finished = false;  // Final result delivered; nothing left to decode
+        int skipped_ticks = 0;
+    };
+
+    struct DecodeJob {
+        std::string stream_id;
+        ResultCallback callback;
+        double pending_age_ms = 0.0;
+        std::chrono::steady_clock::time_point dispatched_at;
+    };
+
+    void scheduler_loop();
+    void worker_loop();
+    void run_job(const DecodeJob& job);
+
+    WhisperCppSTT* stt_;  // Not owned
+    StreamSchedulerConfig config_;
+
+    std::unordered_map<std::string, ScheduledStream> streams_;
+    StreamSchedulerStats stats_;
+    mutable std::mutex mutex_;
+
+    std::deque<DecodeJob> jobs_;
+    std::condition_variable jobs_cv_;
+    std::condition_variable tick_cv_;
+    std::condition_variable idle_cv_;  // A stream's in-flight decode was delivered
+    bool running_ = false;
+    bool tick_requested_ = false;  // A worker freed up; tick without waiting out the interval
+
+    std::thread scheduler_thread_;
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_WHISPERCPP_STREAM_SCHEDULER_H
@@ -0,0 +1,226 @@
+/**
+ * @file audio_decoder.cpp
+ * @brief RunAnywhere Commons - Compressed audio decoders
+ *
+ * FLAC and MP3 use the single-header dr_flac/dr_mp3 decoders, Ogg Opus uses
+ * opusfile. All three pull compressed data from the file as they decode, so
+ * memory use is bounded by one codec frame plus the caller's block.
+ */
+
+#include "audio_decoder.h"
+
+#include <algorithm>
+#include <new>
+
+#define DR_FLAC_IMPLEMENTATION
+#include "dr_flac.h"
+#define DR_MP3_IMPLEMENTATION
+#include "dr_mp3.h"
+
+#if defined(RAC_AUDIO_DECODER_OPUS)
+#include <opusfile.h>
+#endif
+
+#include "rac/core/rac_logger.h"
+
+static const char* LOG_CAT = "AudioDecoder";
+
+// Opus always decodes at 48kHz, whatever rate the encoder was fed
+static constexpr int32_t OPUS_SAMPLE_RATE = 48000;
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+struct audio_decoder {
+    rac_audio_format_enum_t format = RAC_AUDIO_FORMAT_PCM;
+    int32_t channels = 0;
+    drflac* flac = nullptr;
+    drmp3* mp3 = nullptr;
+#if defined(RAC_AUDIO_DECODER_OPUS)
+    OggOpusFile* opus = nullptr;
+    // Chained streams may change channel count between links; those are
+    // decoded as stereo throughout
+    bool opus_stereo = false;
+#endif
+};
+
+// =============================================================================
+// OPEN
+// =============================================================================
+
+static rac_result_t open_flac(audio_decoder* decoder, const char* path,
+                              audio_decoder_format* out_format) {
+    decoder->flac = drflac_open_file(path, nullptr);
+    if (!decoder->flac) {
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+    decoder->channels = decoder->flac->channels;
+    out_format->sample_rate = static_cast<int32_t>(decoder->flac->sampleRate);
+    out_format->bits_per_sample = decoder->flac->bitsPerSample;
+    out_format->frame_count = decoder->flac->totalPCMFrameCount;
+    return RAC_SUCCESS;
+}
+
+static rac_result_t open_mp3(audio_decoder* decoder, const char* path,
+                             audio_decoder_format* out_format) {
+    decoder->mp3 = new (std::nothrow) drmp3();
+    if (!decoder->mp3) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    if (!drmp3_init_file(decoder->mp3, path, nullptr)) {
+        delete decoder->mp3;
+        decoder->mp3 = nullptr;
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+    decoder->channels = static_cast<int32_t>(decoder->mp3->channels);
+    out_format->sample_rate = static_cast<int32_t>(decoder->mp3->sampleRate);
+    out_format->bits_per_sample = 0;
+    // Counting MP3 frames means decoding the whole file; left unknown
+    out_format->frame_count = 0;
+    return RAC_SUCCESS;
+}
+
+#if defined(RAC_AUDIO_DECODER_OPUS)
+static rac_result_t open_opus(audio_decoder* decoder, const char* path,
+                              audio_decoder_format* out_format) {
+    int error = 0;
+    decoder->opus = op_open_file(path, &error);
+    if (!decoder->opus) {
+        RAC_LOG_ERROR(LOG_CAT, "op_open_file failed: %d", error);
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+    decoder->opus_stereo = op_link_count(decoder->opus) > 1;
+    decoder->channels = decoder->opus_stereo ? 2 : op_channel_count(decoder->opus, -1);
+    out_format->sample_rate = OPUS_SAMPLE_RATE;
+    out_format->bits_per_sample = 0;
+    const ogg_int64_t total = op_pcm_total(decoder->opus, -1);
+    out_format->frame_count = total > 0 ? static_cast<uint64_t>(total) : 0;
+    return RAC_SUCCESS;
+}
+#endif
+
+bool audio_decoder_supports(rac_audio_format_enum_t format) {
+    switch (format) {
+        case RAC_AUDIO_FORMAT_FLAC:
+        case RAC_AUDIO_FORMAT_MP3:
+            return true;
+#if defined(RAC_AUDIO_DECODER_OPUS)
+        case RAC_AUDIO_FORMAT_OPUS:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+rac_result_t audio_decoder_open(const char* path, rac_audio_format_enum_t format,
+                                audio_decoder** out_decoder, audio_decoder_format* out_format) {
+    if (!audio_decoder_supports(format)) {
+        return RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+    }
+
+    auto* decoder = new (std::nothrow) audio_decoder();
+    if (!decoder) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    decoder->format = format;
+
+    rac_result_t result = RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+    switch (format) {
+        case RAC_AUDIO_FORMAT_FLAC:
+            result = open_flac(decoder, path, out_format);
+            break;
+        case RAC_AUDIO_FORMAT_MP3:
+            result = open_mp3(decoder, path, out_format);
+            break;
+#if defined(RAC_AUDIO_DECODER_OPUS)
+        case RAC_AUDIO_FORMAT_OPUS:
+            result = open_opus(decoder, path, out_format);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (result == RAC_SUCCESS && decoder->channels <= 0) {
+        result = RAC_ERROR_INVALID_FORMAT;
+    }
+    if (result != RAC_SUCCESS) {
+        audio_decoder_close(decoder);
+        return result;
+    }
+
+    out_format->channels = decoder->channels;
+    *out_decoder = decoder;
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// DECODE
+// =============================================================================
+
+#if defined(RAC_AUDIO_DECODER_OPUS)
+static rac_result_t read_opus(audio_decoder* decoder, float* out, size_t max_frames,
+                              size_t* out_frames) {
+    // op_read_float takes the buffer size in samples, as an int
+    const size_t capped = std::min<size_t>(max_frames, 1u << 20);
+    const int buffer_size = static_cast<int>(capped * static_cast<size_t>(decoder->channels));
+
+    while (true) {
+        const int frames = decoder->opus_stereo
+                               ? op_read_float_stereo(decoder->opus, out, buffer_size)
+                               : op_read_float(decoder->opus, out, buffer_size, nullptr);
+        if (frames >= 0) {
+            *out_frames = static_cast<size_t>(frames);
+            return RAC_SUCCESS;
+        }
+        if (frames != OP_HOLE) {
+            RAC_LOG_ERROR(LOG_CAT, "Opus decode failed: %d", frames);
+            return RAC_ERROR_FILE_READ_FAILED;
+        }
+        // A gap in the page sequence: the decoder has resynchronized, keep going
+        RAC_LOG_WARNING(LOG_CAT, "Skipped a gap in the Opus stream");
+    }
+}
+#endif
+
+rac_result_t audio_decoder_read(audio_decoder* decoder, float* out, size_t max_frames,
+                                size_t* out_frames) {
+    switch (decoder->format) {
+        case RAC_AUDIO_FORMAT_FLAC:
+            *out_frames =
+                static_cast<size_t>(drflac_read_pcm_frames_f32(decoder->flac, max_frames, out));
+            return RAC_SUCCESS;
+        case RAC_AUDIO_FORMAT_MP3:
+            *out_frames =
+                static_cast<size_t>(drmp3_read_pcm_frames_f32(decoder->mp3, max_frames, out));
+            return RAC_SUCCESS;
+#if defined(RAC_AUDIO_DECODER_OPUS)
+        case RAC_AUDIO_FORMAT_OPUS:
+            return read_opus(decoder, out, max_frames, out_frames);
+#endif
+        default:
+            *out_frames = 0;
+            return RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+    }
+}
+
+void audio_decoder_close(audio_decoder* decoder) {
+    if (!decoder) {
+        return;
+    }
+    if (decoder->flac) {
+        drflac_close(decoder->flac);
+    }
+    if (decoder->mp3) {
+        drmp3_uninit(decoder->mp3);
+        delete decoder->mp3;
+    }
+#if defined(RAC_AUDIO_DECODER_OPUS)
+    if (decoder->opus) {
+        op_free(decoder->opus);
+    }
+#endif
+    delete decoder;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file audio_decoder.h
+ * @brief RunAnywhere Commons - Compressed audio decoders (internal)
+ *
+ * Incremental FLAC, MP3 and Ogg Opus decoding for rac_audio_reader. Only
+ * compiled with RAC_BUILD_AUDIO_DECODERS, which defines RAC_AUDIO_DECODERS;
+ * callers must guard their use with the same macro.
+ */
+
+#ifndef RAC_AUDIO_DECODER_H
+#define RAC_AUDIO_DECODER_H
+
+#include "rac/core/rac_error.h"
+#include "rac/features/stt/rac_stt_types.h"
+
+struct audio_decoder;
+
+/**
+ * Stream parameters reported by the decoder
+ */
+struct audio_decoder_format {
+    int32_t sample_rate;
+    int32_t channels;
+    int32_t bits_per_sample;  // 0 when the codec has no fixed sample size
+    uint64_t frame_count;     // 0 when unknown
+};
+
+/**
+ * Whether a decoder for format was built in
+ */
+bool audio_decoder_supports(rac_audio_format_enum_t format);
+
+/**
+ * Open path with the decoder for format (FLAC, MP3 or OPUS)
+ */
+rac_result_t audio_decoder_open(const char* path, rac_audio_format_enum_t format,
+                                audio_decoder** out_decoder, audio_decoder_format* out_format);
+
+/**
+ * Decode up to max_frames interleaved Float32 frames into out. Fewer frames
+ * may be returned; *out_frames is 0 only at the end of the stream.
+ */
+rac_result_t audio_decoder_read(audio_decoder* decoder, float* out, size_t max_frames,
+                                size_t* out_frames);
+
+void audio_decoder_close(audio_decoder* decoder);
+
+#endif /* RAC_AUDIO_DECODER_H */
@@ -0,0 +1,559 @@
+/**
+ * @file rac_audio_convert.cpp
+ * @brief RunAnywhere Commons - Vectorized PCM Conversion Kernels
+ *
+ * Sample format conversion, stereo downmix and gain, with SSE2, AVX2 and
+ * NEON implementations over a scalar reference. SSE2 and NEON are chosen at
+ * compile time (they are baseline on x86-64 and arm64); AVX2 is compiled
+ * with a target attribute and picked at runtime when the CPU supports it.
+ *
+ * This file depends only on rac_audio_utils.h so that tools outside the
+ * library (e.g. the Linux whisper CLI) can compile it directly.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "rac/core/rac_audio_utils.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define RAC_AUDIO_X86 1
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RAC_AUDIO_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define RAC_AUDIO_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RAC_AUDIO_NEON 1
+#include <arm_neon.h>
+#endif
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+static constexpr float kInt16ToFloat = 1.0f / 32768.0f;
+static constexpr float kFloatToInt16 = 32767.0f;
+
+// TPDF dither: two 16-bit uniforms from one hash, summed and centered gives a
+// triangular distribution over [-1, 1) LSB
+static constexpr float kDitherScale = 1.0f / 65536.0f;
+
+/**
+ * Counter-based hash used as the dither source. Indexing by sample position
+ * instead of chaining a generator keeps every lane independent, so the
+ * vector paths compute the same noise as the scalar one.
+ */
+static inline uint32_t dither_hash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+// =============================================================================
+// SCALAR REFERENCE
+// =============================================================================
+
+static void int16_to_float32_scalar(const int16_t* in, size_t count, float* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(in[i]) * kInt16ToFloat;
+    }
+}
+
+static void float32_to_int16_scalar(const float* in, size_t count, int16_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        float sample = std::max(-1.0f, std::min(1.0f, in[i]));
+        out[i] = static_cast<int16_t>(sample * kFloatToInt16);
+    }
+}
+
+static void float32_to_int16_dither_scalar(const float* in, size_t count, int16_t* out,
+                                           uint32_t counter) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t h = dither_hash(counter + static_cast<uint32_t>(i));
+        float tpdf = static_cast<float>((h & 0xFFFFU) + (h >> 16)) * kDitherScale - 1.0f;
+        float sample = std::max(-1.0f, std::min(1.0f, in[i])) * kFloatToInt16 + tpdf;
+        long value = std::lrint(sample);
+        out[i] = static_cast<int16_t>(std::max(-32768L, std::min(32767L, value)));
+    }
+}
+
+static void stereo_to_mono_float32_scalar(const float* in, size_t frames, float* out) {
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] = (in[2 * i] + in[2 * i + 1]) * 0.5f;
+    }
+}
+
+static void stereo_to_mono_int16_scalar(const int16_t* in, size_t frames, int16_t* out) {
+    for (size_t i = 0; i < frames; ++i) {
+        int32_t sum = static_cast<int32_t>(in[2 * i]) + static_cast<int32_t>(in[2 * i + 1]);
+        out[i] = static_cast<int16_t>(sum >> 1);
+    }
+}
+
+static void apply_gain_scalar(float* samples, size_t count, float gain) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] *= gain;
+    }
+}
+
+// =============================================================================
+// SSE2
+// =============================================================================
+
+#if defined(RAC_AUDIO_SSE2)
+
+static inline __m128i mullo_epi32_sse2(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static inline __m128 tpdf_sse2(__m128i index) {
+    __m128i h = index;
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    h = mullo_epi32_sse2(h, _mm_set1_epi32(0x7feb352d));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+    h = mullo_epi32_sse2(h, _mm_set1_epi32(static_cast<int32_t>(0x846ca68bU)));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    __m128i sum = _mm_add_epi32(_mm_and_si128(h, _mm_set1_epi32(0xFFFF)), _mm_srli_epi32(h, 16));
+    return _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(kDitherScale)),
+                      _mm_set1_ps(1.0f));
+}
+
+static void int16_to_float32_sse2(const int16_t* in, size_t count, float* out) {
+    const __m128 scale = _mm_set1_ps(kInt16ToFloat);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    int16_to_float32_scalar(in + i, count - i, out + i);
+}
+
+static void float32_to_int16_sse2(const float* in, size_t count, int16_t* out) {
+    const __m128 lo_clamp = _mm_set1_ps(-1.0f);
+    const __m128 hi_clamp = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(kFloatToInt16);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Both loads complete before the store, which keeps in-place use safe
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo_clamp), hi_clamp), scale);
+        b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo_clamp), hi_clamp), scale);
+        __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    float32_to_int16_scalar(in + i, count - i, out + i);
+}
+
+static void float32_to_int16_dither_sse2(const float* in, size_t count, int16_t* out,
+                                         uint32_t counter) {
+    const __m128 lo_clamp = _mm_set1_ps(-1.0f);
+    const __m128 hi_clamp = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(kFloatToInt16);
+    const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i index = _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(counter + i)), lane);
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo_clamp), hi_clamp), scale);
+        b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo_clamp), hi_clamp), scale);
+        a = _mm_add_ps(a, tpdf_sse2(index));
+        b = _mm_add_ps(b, tpdf_sse2(_mm_add_epi32(index, _mm_set1_epi32(4))));
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    float32_to_int16_dither_scalar(in + i, count - i, out + i,
+                                   counter + static_cast<uint32_t>(i));
+}
+
+static void stereo_to_mono_float32_sse2(const float* in, size_t frames, float* out) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128 a = _mm_loadu_ps(in + 2 * i);
+        __m128 b = _mm_loadu_ps(in + 2 * i + 4);
+        __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(left, right), half));
+    }
+    stereo_to_mono_float32_scalar(in + 2 * i, frames - i, out + i);
+}
+
+static void stereo_to_mono_int16_sse2(const int16_t* in, size_t frames, int16_t* out) {
+    const __m128i ones = _mm_set1_epi16(1);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 8));
+        __m128i sum_a = _mm_srai_epi32(_mm_madd_epi16(a, ones), 1);
+        __m128i sum_b = _mm_srai_epi32(_mm_madd_epi16(b, ones), 1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(sum_a, sum_b));
+    }
+    stereo_to_mono_int16_scalar(in + 2 * i, frames - i, out + i);
+}
+
+static void apply_gain_sse2(float* samples, size_t count, float gain) {
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), g));
+    }
+    apply_gain_scalar(samples + i, count - i, gain);
+}
+
+#endif  // RAC_AUDIO_SSE2
+
+// =============================================================================
+// AVX2
+// =============================================================================
+
+#if defined(RAC_AUDIO_AVX2)
+
+#define RAC_AVX2_FN __attribute__((target("avx2")))
+
+// 256-bit packs work per 128-bit lane; this restores sequential order
+#define RAC_AVX2_FIX_PACK(v) _mm256_permute4x64_epi64((v), _MM_SHUFFLE(3, 1, 2, 0))
+
+RAC_AVX2_FN static inline __m256 tpdf_avx2(__m256i index) {
+    __m256i h = index;
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x7feb352d));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32(static_cast<int32_t>(0x846ca68bU)));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    __m256i sum = _mm256_add_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0xFFFF)),
+                                   _mm256_srli_epi32(h, 16));
+    return _mm256_sub_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(sum), _mm256_set1_ps(kDitherScale)),
+                         _mm256_set1_ps(1.0f));
+}
+
+RAC_AVX2_FN static void int16_to_float32_avx2(const int16_t* in, size_t count, float* out) {
+    const __m256 scale = _mm256_set1_ps(kInt16ToFloat);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)),
+                                                scale));
+        _mm256_storeu_ps(out + i + 8,
+                         _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), scale));
+    }
+    int16_to_float32_scalar(in + i, count - i, out + i);
+}
+
+RAC_AVX2_FN static void float32_to_int16_avx2(const float* in, size_t count, int16_t* out) {
+    const __m256 lo_clamp = _mm256_set1_ps(-1.0f);
+    const __m256 hi_clamp = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(kFloatToInt16);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 a = _mm256_loadu_ps(in + i);
+        __m256 b = _mm256_loadu_ps(in + i + 8);
+        a = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(a, lo_clamp), hi_clamp), scale);
+        b = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(b, lo_clamp), hi_clamp), scale);
+        __m256i packed = _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), RAC_AVX2_FIX_PACK(packed));
+    }
+    float32_to_int16_scalar(in + i, count - i, out + i);
+}
+
+RAC_AVX2_FN static void float32_to_int16_dither_avx2(const float* in, size_t count,
+                                                     int16_t* out, uint32_t counter) {
+    const __m256 lo_clamp = _mm256_set1_ps(-1.0f);
+    const __m256 hi_clamp = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(kFloatToInt16);
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i index =
+            _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(counter + i)), lane);
+        __m256 a = _mm256_loadu_ps(in + i);
+        __m256 b = _mm256_loadu_ps(in + i + 8);
+        a = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(a, lo_clamp), hi_clamp), scale);
+        b = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(b, lo_clamp), hi_clamp), scale);
+        a = _mm256_add_ps(a, tpdf_avx2(index));
+        b = _mm256_add_ps(b, tpdf_avx2(_mm256_add_epi32(index, _mm256_set1_epi32(8))));
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), RAC_AVX2_FIX_PACK(packed));
+    }
+    float32_to_int16_dither_scalar(in + i, count - i, out + i,
+                                   counter + static_cast<uint32_t>(i));
+}
+
+RAC_AVX2_FN static void stereo_to_mono_float32_avx2(const float* in, size_t frames, float* out) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        __m256 a = _mm256_loadu_ps(in + 2 * i);
+        __m256 b = _mm256_loadu_ps(in + 2 * i + 8);
+        __m256 left = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 right = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 mono = _mm256_mul_ps(_mm256_add_ps(left, right), half);
+        mono = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(_mm256_castps_pd(mono), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm256_storeu_ps(out + i, mono);
+    }
+    stereo_to_mono_float32_scalar(in + 2 * i, frames - i, out + i);
+}
+
+RAC_AVX2_FN static void stereo_to_mono_int16_avx2(const int16_t* in, size_t frames,
+                                                  int16_t* out) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    size_t i = 0;
+    for (; i + 16 <= frames; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 16));
+        __m256i sum_a = _mm256_srai_epi32(_mm256_madd_epi16(a, ones), 1);
+        __m256i sum_b = _mm256_srai_epi32(_mm256_madd_epi16(b, ones), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            RAC_AVX2_FIX_PACK(_mm256_packs_epi32(sum_a, sum_b)));
+    }
+    stereo_to_mono_int16_scalar(in + 2 * i, frames - i, out + i);
+}
+
+RAC_AVX2_FN static void apply_gain_avx2(float* samples, size_t count, float gain) {
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(samples + i, _mm256_mul_ps(_mm256_loadu_ps(samples + i), g));
+    }
+    apply_gain_scalar(samples + i, count - i, gain);
+}
+
+#endif  // RAC_AUDIO_AVX2
+
+// =============================================================================
+// NEON
+// =============================================================================
+
+#if defined(RAC_AUDIO_NEON)
+
+static void int16_to_float32_neon(const int16_t* in, size_t count, float* out) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t x = vld1q_s16(in + i);
+        vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), kInt16ToFloat));
+        vst1q_f32(out + i + 4,
+                  vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), kInt16ToFloat));
+    }
+    int16_to_float32_scalar(in + i, count - i, out + i);
+}
+
+static void float32_to_int16_neon(const float* in, size_t count, int16_t* out) {
+    const float32x4_t lo_clamp = vdupq_n_f32(-1.0f);
+    const float32x4_t hi_clamp = vdupq_n_f32(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vld1q_f32(in + i);
+        float32x4_t b = vld1q_f32(in + i + 4);
+        a = vmulq_n_f32(vminq_f32(vmaxq_f32(a, lo_clamp), hi_clamp), kFloatToInt16);
+        b = vmulq_n_f32(vminq_f32(vmaxq_f32(b, lo_clamp), hi_clamp), kFloatToInt16);
+        vst1q_s16(out + i,
+                  vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b))));
+    }
+    float32_to_int16_scalar(in + i, count - i, out + i);
+}
+
+#if defined(__aarch64__)
+// Needs round-to-nearest conversion (vcvtnq), which 32-bit ARM lacks
+static inline float32x4_t tpdf_neon(uint32x4_t h) {
+    h = veorq_u32(h, vshrq_n_u32(h, 16));
+    h = vmulq_n_u32(h, 0x7feb352dU);
+    h = veorq_u32(h, vshrq_n_u32(h, 15));
+    h = vmulq_n_u32(h, 0x846ca68bU);
+    h = veorq_u32(h, vshrq_n_u32(h, 16));
+    uint32x4_t sum = vaddq_u32(vandq_u32(h, vdupq_n_u32(0xFFFF)), vshrq_n_u32(h, 16));
+    return vsubq_f32(vmulq_n_f32(vcvtq_f32_u32(sum), kDitherScale), vdupq_n_f32(1.0f));
+}
+
+static void float32_to_int16_dither_neon(const float* in, size_t count, int16_t* out,
+                                         uint32_t counter) {
+    const float32x4_t lo_clamp = vdupq_n_f32(-1.0f);
+    const float32x4_t hi_clamp = vdupq_n_f32(1.0f);
+    const uint32_t lanes[4] = {0, 1, 2, 3};
+    const uint32x4_t lane = vld1q_u32(lanes);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint32x4_t index = vaddq_u32(vdupq_n_u32(counter + static_cast<uint32_t>(i)), lane);
+        float32x4_t a = vld1q_f32(in + i);
+        float32x4_t b = vld1q_f32(in + i + 4);
+        a = vmulq_n_f32(vminq_f32(vmaxq_f32(a, lo_clamp), hi_clamp), kFloatToInt16);
+        b = vmulq_n_f32(vminq_f32(vmaxq_f32(b, lo_clamp), hi_clamp), kFloatToInt16);
+        a = vaddq_f32(a, tpdf_neon(index));
+        b = vaddq_f32(b, tpdf_neon(vaddq_u32(index, vdupq_n_u32(4))));
+        vst1q_s16(out + i,
+                  vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b))));
+    }
+    float32_to_int16_dither_scalar(in + i, count - i, out + i,
+                                   counter + static_cast<uint32_t>(i));
+}
+#endif  // __aarch64__
+
+static void stereo_to_mono_float32_neon(const float* in, size_t frames, float* out) {
+    size_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        float32x4x2_t lr = vld2q_f32(in + 2 * i);
+        vst1q_f32(out + i, vmulq_n_f32(vaddq_f32(lr.val[0], lr.val[1]), 0.5f));
+    }
+    stereo_to_mono_float32_scalar(in + 2 * i, frames - i, out + i);
+}
+
+static void stereo_to_mono_int16_neon(const int16_t* in, size_t frames, int16_t* out) {
+    size_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        int16x8x2_t lr = vld2q_s16(in + 2 * i);
+        int32x4_t lo = vshrq_n_s32(vaddl_s16(vget_low_s16(lr.val[0]), vget_low_s16(lr.val[1])), 1);
+        int32x4_t hi =
+            vshrq_n_s32(vaddl_s16(vget_high_s16(lr.val[0]), vget_high_s16(lr.val[1])), 1);
+        vst1q_s16(out + i, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+    }
+    stereo_to_mono_int16_scalar(in + 2 * i, frames - i, out + i);
+}
+
+static void apply_gain_neon(float* samples, size_t count, float gain) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(samples + i, vmulq_n_f32(vld1q_f32(samples + i), gain));
+    }
+    apply_gain_scalar(samples + i, count - i, gain);
+}
+
+#endif  // RAC_AUDIO_NEON
+
+// =============================================================================
+// DISPATCH
+// =============================================================================
+
+struct audio_kernels {
+    const char* name;
+    void (*int16_to_float32)(const int16_t*, size_t, float*);
+    void (*float32_to_int16)(const float*, size_t, int16_t*);
+    void (*float32_to_int16_dither)(const float*, size_t, int16_t*, uint32_t);
+    void (*stereo_to_mono_float32)(const float*, size_t, float*);
+    void (*stereo_to_mono_int16)(const int16_t*, size_t, int16_t*);
+    void (*apply_gain)(float*, size_t, float);
+};
+
+static audio_kernels select_kernels() {
+    audio_kernels k = {"scalar",
+                       int16_to_float32_scalar,
+                       float32_to_int16_scalar,
+                       float32_to_int16_dither_scalar,
+                       stereo_to_mono_float32_scalar,
+                       stereo_to_mono_int16_scalar,
+                       apply_gain_scalar};
+
+#if defined(RAC_AUDIO_SSE2)
+    k = {"sse2",
+         int16_to_float32_sse2,
+         float32_to_int16_sse2,
+         float32_to_int16_dither_sse2,
+         stereo_to_mono_float32_sse2,
+         stereo_to_mono_int16_sse2,
+         apply_gain_sse2};
+#endif
+
+#if defined(RAC_AUDIO_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        k = {"avx2",
+             int16_to_float32_avx2,
+             float32_to_int16_avx2,
+             float32_to_int16_dither_avx2,
+             stereo_to_mono_float32_avx2,
+             stereo_to_mono_int16_avx2,
+             apply_gain_avx2};
+    }
+#endif
+
+#if defined(RAC_AUDIO_NEON)
+    k.name = "neon";
+    k.int16_to_float32 = int16_to_float32_neon;
+    k.float32_to_int16 = float32_to_int16_neon;
+#if defined(__aarch64__)
+    k.float32_to_int16_dither = float32_to_int16_dither_neon;
+#endif
+    k.stereo_to_mono_float32 = stereo_to_mono_float32_neon;
+    k.stereo_to_mono_int16 = stereo_to_mono_int16_neon;
+    k.apply_gain = apply_gain_neon;
+#endif
+
+    return k;
+}
+
+static const audio_kernels& kernels() {
+    static const audio_kernels selected = select_kernels();
+    return selected;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+void rac_audio_int16_to_float32(const int16_t* samples, size_t sample_count, float* out_samples) {
+    if (!samples || !out_samples) {
+        return;
+    }
+    kernels().int16_to_float32(samples, sample_count, out_samples);
+}
+
+void rac_audio_float32_to_int16(const float* samples, size_t sample_count, int16_t* out_samples) {
+    if (!samples || !out_samples) {
+        return;
+    }
+    kernels().float32_to_int16(samples, sample_count, out_samples);
+}
+
+void rac_audio_float32_to_int16_dithered(const float* samples, size_t sample_count,
+                                         int16_t* out_samples, uint32_t* dither_state) {
+    if (!samples || !out_samples) {
+        return;
+    }
+    uint32_t counter = dither_state ? *dither_state : 0;
+    kernels().float32_to_int16_dither(samples, sample_count, out_samples, counter);
+    if (dither_state) {
+        *dither_state = counter + static_cast<uint32_t>(sample_count);
+    }
+}
+
+void rac_audio_stereo_to_mono_float32(const float* samples, size_t frame_count,
+                                      float* out_samples) {
+    if (!samples || !out_samples) {
+        return;
+    }
+    kernels().stereo_to_mono_float32(samples, frame_count, out_samples);
+}
+
+void rac_audio_stereo_to_mono_int16(const int16_t* samples, size_t frame_count,
+                                    int16_t* out_samples) {
+    if (!samples || !out_samples) {
+        return;
+    }
+    kernels().stereo_to_mono_int16(samples, frame_count, out_samples);
+}
+
+void rac_audio_apply_gain(float* samples, size_t sample_count, float gain) {
+    if (!samples) {
+        return;
+    }
+    kernels().apply_gain(samples, sample_count, gain);
+}
+
+const char* rac_audio_simd_backend(void) {
+    return kernels().name;
+}
@@ -0,0 +1,682 @@
+/**
+ * @file rac_audio_reader.cpp
+ * @brief RunAnywhere Commons - Streaming Audio File Reader Implementation
+ *
+ * Reader pipeline per decoded chunk: WAV bytes (mapped or read) or decoder
+ * output -> interleaved Float32 -> mono -> optional resampling (anti-aliasing
+ * low-pass when downsampling, then linear interpolation) -> pending output,
+ * from which fixed-size blocks are handed out.
+ */
+
+#include "rac/core/rac_audio_reader.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+
+#if defined(RAC_AUDIO_DECODERS)
+#include "audio_decoder.h"
+#endif
+
+static const char* LOG_CAT = "AudioReader";
+
+// WAV format tags
+static constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+static constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+static constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// Bytes 2-15 of the KSDATAFORMAT_SUBTYPE_* GUIDs; bytes 0-1 hold the format tag
+static constexpr uint8_t KSDATAFORMAT_SUBTYPE_TAIL[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                                          0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+
+// Source frames decoded per step
+static constexpr size_t DECODE_FRAMES = 4096;
+
+// Mapped pages behind the read position are released in steps of this size
+static constexpr uint64_t RELEASE_STEP = 8u << 20;
+
+// Anti-aliasing filter: cutoff as a fraction of the output Nyquist rate, and
+// filter half-length in output samples (scaled by the decimation ratio)
+static constexpr double LOWPASS_CUTOFF = 0.9;
+static constexpr double LOWPASS_HALF_LENGTH = 24.0;
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+/**
+ * Streaming resampler. When downsampling, input first goes through a
+ * Blackman-windowed sinc low-pass at LOWPASS_CUTOFF of the output Nyquist
+ * rate, so content the output rate cannot represent is removed instead of
+ * folded back into the speech band; the filter's delay is compensated.
+ * Output samples are then linearly interpolated. Positions are exact
+ * fractions of an input sample, in units of 1/out_rate, where -out_rate is
+ * the last sample of the previous call.
+ */
+struct audio_resampler {
+    int64_t in_rate = 1;
+    int64_t out_rate = 1;
+    int64_t pos = 0;
+    float prev = 0.0f;
+
+    std::vector<float> taps;      // Empty when upsampling
+    std::vector<float> window;    // taps.size() - 1 inputs of history, then the chunk
+    std::vector<float> filtered;  // Low-pass output of the current chunk
+    size_t delay_left = 0;        // Leading filter outputs still to discard
+    bool flushed = false;
+
+    void configure(int32_t source_rate, int32_t target_rate) {
+        in_rate = source_rate;
+        out_rate = target_rate;
+        if (in_rate <= out_rate) {
+            return;
+        }
+        const double step = static_cast<double>(in_rate) / static_cast<double>(out_rate);
+
+        // Cutoff in cycles per input sample
+        const double cutoff = 0.5 * LOWPASS_CUTOFF / step;
+        const auto half = static_cast<size_t>(std::ceil(LOWPASS_HALF_LENGTH * step));
+        const size_t length = 2 * half + 1;
+        taps.resize(length);
+        double sum = 0.0;
+        for (size_t k = 0; k < length; ++k) {
+            const double t = static_cast<double>(k) - static_cast<double>(half);
+            const double x = 2.0 * M_PI * cutoff * t;
+            const double sinc = t == 0.0 ? 1.0 : std::sin(x) / x;
+            const double phase = 2.0 * M_PI * static_cast<double>(k) / (length - 1);
+            const double blackman = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            taps[k] = static_cast<float>(sinc * blackman);
+            sum += taps[k];
+        }
+        for (float& tap : taps) {
+            tap = static_cast<float>(tap / sum);
+        }
+        window.assign(length - 1, 0.0f);
+        delay_left = half;
+    }
+
+    void process(const float* in, size_t count, std::vector<float>& out) {
+        if (taps.empty()) {
+            interpolate(in, count, out);
+            return;
+        }
+
+        const size_t history = taps.size() - 1;
+        window.insert(window.end(), in, in + count);
+        filtered.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const float* x = window.data() + i;
+            float acc = 0.0f;
+            for (size_t k = 0; k < taps.size(); ++k) {
+                acc += taps[k] * x[k];
+            }
+            filtered[i] = acc;
+        }
+        window.erase(window.begin(), window.end() - static_cast<ptrdiff_t>(history));
+
+        const size_t skip = std::min(delay_left, count);
+        delay_left -= skip;
+        interpolate(filtered.data() + skip, count - skip, out);
+    }
+
+    /**
+     * Emit what the end of the input still owes: the low-pass tail held back
+     * by its delay, and the positions past the last input sample
+     */
+    void flush(std::vector<float>& out) {
+        if (flushed) {
+            return;
+        }
+        flushed = true;
+        if (!taps.empty()) {
+            const std::vector<float> zeros((taps.size() - 1) / 2, 0.0f);
+            process(zeros.data(), zeros.size(), out);
+        }
+        while (pos < 0) {
+            out.push_back(prev);
+            pos += in_rate;
+        }
+    }
+
+  private:
+    void interpolate(const float* in, size_t count, std::vector<float>& out) {
+        if (count == 0) {
+            return;
+        }
+        const int64_t end = (static_cast<int64_t>(count) - 1) * out_rate;
+        const float scale = 1.0f / static_cast<float>(out_rate);
+        while (pos < end) {
+            const int64_t base = pos < 0 ? -1 : pos / out_rate;
+            const float a = base < 0 ? prev : in[base];
+            const float b = in[base + 1];
+            out.push_back(a + (b - a) * static_cast<float>(pos - base * out_rate) * scale);
+            pos += in_rate;
+        }
+        pos -= static_cast<int64_t>(count) * out_rate;
+        prev = in[count - 1];
+    }
+};
+
+struct rac_audio_reader {
+    rac_audio_format_enum_t format = RAC_AUDIO_FORMAT_WAV;
+
+    // WAV source
+    FILE* file = nullptr;  // Buffered path only
+    const uint8_t* map = nullptr;
+    size_t map_size = 0;
+    uint64_t released = 0;  // Bytes at the start of the mapping already released
+    uint64_t data_offset = 0;
+    uint64_t data_size = 0;
+    uint64_t data_pos = 0;
+    uint16_t wav_format = 0;
+    size_t sample_bytes = 0;
+    size_t frame_bytes = 0;
+
+#if defined(RAC_AUDIO_DECODERS)
+    // Compressed source
+    audio_decoder* decoder = nullptr;
+#endif
+
+    int32_t sample_rate = 0;
+    int32_t channels = 0;
+    int32_t bits_per_sample = 0;
+    uint64_t frame_count = 0;
+
+    int32_t out_rate = 0;
+    size_t block_size = 0;
+    bool resample = false;
+    audio_resampler resampler;
+
+    std::vector<uint8_t> raw;
+    std::vector<float> decoded;
+    std::vector<float> pending;
+    size_t pending_pos = 0;
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static uint16_t read_uint16_le(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_uint32_le(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static bool read_at(FILE* file, uint64_t offset, void* buffer, size_t size) {
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0 &&
+           fread(buffer, 1, size, file) == size;
+}
+
+/**
+ * Identify the container from the first bytes of the file
+ *
+ * @return false if the contents are not a recognized container
+ */
+static bool detect_format(FILE* file, rac_audio_format_enum_t* out_format) {
+    uint8_t magic[36] = {};
+    const size_t size = fread(magic, 1, sizeof(magic), file);
+
+    if (size >= 12 && memcmp(magic, "RIFF", 4) == 0 && memcmp(magic + 8, "WAVE", 4) == 0) {
+        *out_format = RAC_AUDIO_FORMAT_WAV;
+    } else if (size >= 4 && memcmp(magic, "fLaC", 4) == 0) {
+        *out_format = RAC_AUDIO_FORMAT_FLAC;
+    } else if (size >= 36 && memcmp(magic, "OggS", 4) == 0 &&
+               memcmp(magic + 28, "OpusHead", 8) == 0) {
+        *out_format = RAC_AUDIO_FORMAT_OPUS;
+    } else if ((size >= 3 && memcmp(magic, "ID3", 3) == 0) ||
+               (size >= 2 && magic[0] == 0xFF && (magic[1] & 0xE0) == 0xE0)) {
+        *out_format = RAC_AUDIO_FORMAT_MP3;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parse the fmt chunk into the reader's format fields
+ */
+static rac_result_t parse_fmt(rac_audio_reader* reader, const uint8_t* fmt, uint32_t size) {
+    if (size < 16) {
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+
+    uint16_t format = read_uint16_le(fmt);
+    const uint16_t channels = read_uint16_le(fmt + 2);
+    const uint32_t sample_rate = read_uint32_le(fmt + 4);
+    const uint16_t block_align = read_uint16_le(fmt + 12);
+    const uint16_t bits = read_uint16_le(fmt + 14);
+
+    if (format == WAVE_FORMAT_EXTENSIBLE) {
+        if (size < 40 || memcmp(fmt + 26, KSDATAFORMAT_SUBTYPE_TAIL, 14) != 0) {
+            return RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+        }
+        format = read_uint16_le(fmt + 24);
+    }
+
+    if (channels == 0 || sample_rate == 0 || sample_rate > static_cast<uint32_t>(INT32_MAX) ||
+        block_align == 0 || block_align % channels != 0) {
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+
+    // Samples are decoded by container size; with EXTENSIBLE the valid bits
+    // may be fewer, left-justified in the container
+    const size_t sample_bytes = block_align / channels;
+    const bool supported =
+        (format == WAVE_FORMAT_PCM && sample_bytes >= 1 && sample_bytes <= 4) ||
+        (format == WAVE_FORMAT_IEEE_FLOAT && (sample_bytes == 4 || sample_bytes == 8));
+    if (!supported) {
+        RAC_LOG_ERROR(LOG_CAT, "Unsupported WAV encoding: format 0x%04x, %u-bit", format, bits);
+        return RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+    }
+
+    reader->wav_format = format;
+    reader->channels = channels;
+    reader->sample_rate = static_cast<int32_t>(sample_rate);
+    reader->bits_per_sample = static_cast<int32_t>(sample_bytes * 8);
+    reader->sample_bytes = sample_bytes;
+    reader->frame_bytes = block_align;
+    return RAC_SUCCESS;
+}
+
+/**
+ * Walk the RIFF chunks up to the data chunk
+ */
+static rac_result_t parse_wav_header(rac_audio_reader* reader, FILE* file, uint64_t file_size) {
+    bool have_fmt = false;
+    uint64_t offset = 12;
+    while (offset + 8 <= file_size) {
+        uint8_t chunk[8];
+        if (!read_at(file, offset, chunk, sizeof(chunk))) {
+            return RAC_ERROR_FILE_READ_FAILED;
+        }
+        const uint32_t size = read_uint32_le(chunk + 4);
+        offset += 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {};
+            const uint32_t read_size = std::min<uint32_t>(size, sizeof(fmt));
+            if (offset + read_size > file_size || !read_at(file, offset, fmt, read_size)) {
+                return RAC_ERROR_INVALID_FORMAT;
+            }
+            rac_result_t result = parse_fmt(reader, fmt, size);
+            if (result != RAC_SUCCESS) {
+                return result;
+            }
+            have_fmt = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!have_fmt) {
+                return RAC_ERROR_INVALID_FORMAT;
+            }
+            // A zero or oversized length comes from a writer that never
+            // finalized the header: take everything up to the end of the file
+            const uint64_t available = file_size - offset;
+            const uint64_t size64 = (size == 0 || size > available) ? available : size;
+            reader->data_offset = offset;
+            reader->data_size = size64 - size64 % reader->frame_bytes;
+            reader->frame_count = reader->data_size / reader->frame_bytes;
+            return RAC_SUCCESS;
+        }
+
+        offset += size + (size & 1);
+    }
+
+    return RAC_ERROR_INVALID_FORMAT;
+}
+
+/**
+ * Set up a WAV source; takes ownership of file
+ */
+static rac_result_t open_wav(rac_audio_reader* reader, FILE* file, bool use_mmap) {
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0) {
+        fclose(file);
+        return RAC_ERROR_FILE_READ_FAILED;
+    }
+    const auto file_size = static_cast<uint64_t>(st.st_size);
+
+    rac_result_t result = parse_wav_header(reader, file, file_size);
+    if (result != RAC_SUCCESS) {
+        fclose(file);
+        return result;
+    }
+
+    // Map when possible; a failed mapping (e.g. no address space left on a
+    // 32-bit device) falls back to buffered reads
+    if (use_mmap && file_size <= SIZE_MAX && reader->data_size > 0) {
+        void* map = mmap(nullptr, static_cast<size_t>(file_size), PROT_READ, MAP_PRIVATE,
+                         fileno(file), 0);
+        if (map != MAP_FAILED) {
+            madvise(map, static_cast<size_t>(file_size), MADV_SEQUENTIAL);
+            reader->map = static_cast<const uint8_t*>(map);
+            reader->map_size = static_cast<size_t>(file_size);
+        }
+    }
+    if (reader->map) {
+        fclose(file);
+        return RAC_SUCCESS;
+    }
+
+    if (fseeko(file, static_cast<off_t>(reader->data_offset), SEEK_SET) != 0) {
+        fclose(file);
+        return RAC_ERROR_FILE_READ_FAILED;
+    }
+    reader->file = file;
+    return RAC_SUCCESS;
+}
+
+/**
+ * Convert frame_count interleaved WAV frames at src into reader->decoded
+ */
+static void decode_wav(rac_audio_reader* reader, const uint8_t* src, size_t frame_count) {
+    const size_t count = frame_count * static_cast<size_t>(reader->channels);
+    float* out = reader->decoded.data();
+
+    if (reader->wav_format == WAVE_FORMAT_IEEE_FLOAT) {
+        if (reader->sample_bytes == 4) {
+            memcpy(out, src, count * sizeof(float));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                double value;
+                memcpy(&value, src + i * 8, sizeof(value));
+                out[i] = static_cast<float>(value);
+            }
+        }
+        return;
+    }
+
+    switch (reader->sample_bytes) {
+        case 1:
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<float>(static_cast<int32_t>(src[i]) - 128) / 128.0f;
+            }
+            break;
+        case 2:
+            if (reinterpret_cast<uintptr_t>(src) % alignof(int16_t) != 0) {
+                reader->raw.assign(src, src + count * 2);
+                src = reader->raw.data();
+            }
+            rac_audio_int16_to_float32(reinterpret_cast<const int16_t*>(src), count, out);
+            break;
+        case 3:
+            for (size_t i = 0; i < count; ++i) {
+                const uint8_t* p = src + i * 3;
+                const auto value = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 |
+                                                        static_cast<uint32_t>(p[1]) << 16 |
+                                                        static_cast<uint32_t>(p[2]) << 24);
+                out[i] = static_cast<float>(value >> 8) / 8388608.0f;
+            }
+            break;
+        default:
+            for (size_t i = 0; i < count; ++i) {
+                int32_t value;
+                memcpy(&value, src + i * 4, sizeof(value));
+                out[i] = static_cast<float>(value) / 2147483648.0f;
+            }
+            break;
+    }
+}
+
+/**
+ * Decode the next chunk of the WAV data chunk into reader->decoded
+ *
+ * @return Frames decoded, 0 at the end of the data
+ */
+static size_t read_wav(rac_audio_reader* reader, rac_result_t* out_result) {
+    const uint64_t remaining = reader->data_size - reader->data_pos;
+    if (remaining == 0) {
+        return 0;
+    }
+
+    const size_t frame_count =
+        static_cast<size_t>(std::min<uint64_t>(DECODE_FRAMES, remaining / reader->frame_bytes));
+    const size_t byte_count = frame_count * reader->frame_bytes;
+
+    const uint8_t* src;
+    if (reader->map) {
+        src = reader->map + reader->data_offset + reader->data_pos;
+    } else {
+        reader->raw.resize(byte_count);
+        if (fread(reader->raw.data(), 1, byte_count, reader->file) != byte_count) {
+            RAC_LOG_ERROR(LOG_CAT, "Read failed at data offset %llu",
+                          static_cast<unsigned long long>(reader->data_pos));
+            *out_result = RAC_ERROR_FILE_READ_FAILED;
+            return 0;
+        }
+        src = reader->raw.data();
+    }
+
+    decode_wav(reader, src, frame_count);
+    reader->data_pos += byte_count;
+
+    if (reader->map) {
+        const uint64_t consumed = reader->data_offset + reader->data_pos;
+        if (consumed - reader->released >= RELEASE_STEP) {
+            const uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            const uint64_t upto = consumed / page * page;
+            madvise(const_cast<uint8_t*>(reader->map) + reader->released,
+                    static_cast<size_t>(upto - reader->released), MADV_DONTNEED);
+            reader->released = upto;
+        }
+    }
+    return frame_count;
+}
+
+/**
+ * Average reader->decoded down to mono, in place
+ */
+static void downmix(rac_audio_reader* reader, size_t frame_count) {
+    float* samples = reader->decoded.data();
+    const size_t channels = static_cast<size_t>(reader->channels);
+
+    if (channels == 2) {
+        rac_audio_stereo_to_mono_float32(samples, frame_count, samples);
+    } else if (channels > 2) {
+        const float scale = 1.0f / static_cast<float>(channels);
+        for (size_t i = 0; i < frame_count; ++i) {
+            float sum = 0.0f;
+            for (size_t c = 0; c < channels; ++c) {
+                sum += samples[i * channels + c];
+            }
+            samples[i] = sum * scale;
+        }
+    }
+}
+
+/**
+ * Decode the next chunk of the source into reader->pending
+ *
+ * @return false at the end of the source
+ */
+static bool decode_next(rac_audio_reader* reader, rac_result_t* out_result) {
+    size_t frame_count = 0;
+#if defined(RAC_AUDIO_DECODERS)
+    if (reader->decoder) {
+        *out_result = audio_decoder_read(reader->decoder, reader->decoded.data(), DECODE_FRAMES,
+                                         &frame_count);
+    } else
+#endif
+    {
+        frame_count = read_wav(reader, out_result);
+    }
+    if (frame_count == 0 || *out_result != RAC_SUCCESS) {
+        if (*out_result == RAC_SUCCESS && reader->resample) {
+            reader->resampler.flush(reader->pending);
+        }
+        return false;
+    }
+
+    downmix(reader, frame_count);
+
+    if (reader->resample) {
+        reader->resampler.process(reader->decoded.data(), frame_count, reader->pending);
+    } else {
+        reader->pending.insert(reader->pending.end(), reader->decoded.begin(),
+                               reader->decoded.begin() + static_cast<ptrdiff_t>(frame_count));
+    }
+    return true;
+}
+
+// =============================================================================
+// READER API
+// =============================================================================
+
+extern "C" rac_bool_t rac_audio_reader_supports_format(rac_audio_format_enum_t format) {
+    if (format == RAC_AUDIO_FORMAT_WAV) {
+        return RAC_TRUE;
+    }
+#if defined(RAC_AUDIO_DECODERS)
+    return audio_decoder_supports(format) ? RAC_TRUE : RAC_FALSE;
+#else
+    return RAC_FALSE;
+#endif
+}
+
+extern "C" rac_result_t rac_audio_reader_open(const char* path,
+                                              const rac_audio_reader_config_t* config,
+                                              rac_handle_t* out_reader) {
+    if (!path || !out_reader) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const rac_audio_reader_config_t cfg = config ? *config : RAC_AUDIO_READER_CONFIG_DEFAULT;
+    if (cfg.target_sample_rate < 0) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        RAC_LOG_ERROR(LOG_CAT, "Cannot open %s", path);
+        return RAC_ERROR_FILE_NOT_FOUND;
+    }
+
+    auto* reader = new (std::nothrow) rac_audio_reader();
+    if (!reader) {
+        fclose(file);
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    rac_result_t result;
+    if (!detect_format(file, &reader->format)) {
+        fclose(file);
+        result = RAC_ERROR_INVALID_FORMAT;
+    } else if (reader->format == RAC_AUDIO_FORMAT_WAV) {
+        result = open_wav(reader, file, cfg.disable_mmap == RAC_FALSE);
+    } else {
+        // The decoders open the file themselves
+        fclose(file);
+#if defined(RAC_AUDIO_DECODERS)
+        audio_decoder_format format = {};
+        result = audio_decoder_open(path, reader->format, &reader->decoder, &format);
+        if (result == RAC_SUCCESS) {
+            reader->sample_rate = format.sample_rate;
+            reader->channels = format.channels;
+            reader->bits_per_sample = format.bits_per_sample;
+            reader->frame_count = format.frame_count;
+        }
+#else
+        result = RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED;
+#endif
+    }
+
+    if (result == RAC_SUCCESS && reader->sample_rate <= 0) {
+        result = RAC_ERROR_INVALID_FORMAT;
+    }
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "Cannot read %s: %d", path, result);
+        rac_audio_reader_close(reinterpret_cast<rac_handle_t>(reader));
+        return result;
+    }
+
+    reader->out_rate = cfg.target_sample_rate > 0 ? cfg.target_sample_rate : reader->sample_rate;
+    reader->block_size = cfg.block_size > 0 ? cfg.block_size : 4096;
+    reader->resample = reader->out_rate != reader->sample_rate;
+    if (reader->resample) {
+        reader->resampler.configure(reader->sample_rate, reader->out_rate);
+    }
+    reader->decoded.resize(DECODE_FRAMES * static_cast<size_t>(reader->channels));
+
+    RAC_LOG_DEBUG(LOG_CAT, "Opened %s: format %d, %d Hz, %d ch%s", path, reader->format,
+                  reader->sample_rate, reader->channels, reader->map ? " (mapped)" : "");
+
+    *out_reader = reinterpret_cast<rac_handle_t>(reader);
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_audio_reader_get_info(rac_handle_t handle,
+                                                  rac_audio_file_info_t* out_info) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_info)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* reader = reinterpret_cast<rac_audio_reader*>(handle);
+    out_info->format = reader->format;
+    out_info->sample_rate = reader->sample_rate;
+    out_info->channels = reader->channels;
+    out_info->bits_per_sample = reader->bits_per_sample;
+    out_info->is_float = reader->wav_format == WAVE_FORMAT_IEEE_FLOAT ? RAC_TRUE : RAC_FALSE;
+    out_info->frame_count = reader->frame_count;
+    out_info->is_mapped = reader->map ? RAC_TRUE : RAC_FALSE;
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_audio_reader_read(rac_handle_t handle, const float** out_samples,
+                                              size_t* out_count) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_samples || !out_count)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* reader = reinterpret_cast<rac_audio_reader*>(handle);
+
+    // Drop the block handed out by the previous call
+    reader->pending.erase(reader->pending.begin(),
+                          reader->pending.begin() + static_cast<ptrdiff_t>(reader->pending_pos));
+    reader->pending_pos = 0;
+
+    rac_result_t result = RAC_SUCCESS;
+    while (reader->pending.size() < reader->block_size && decode_next(reader, &result)) {
+    }
+    if (result != RAC_SUCCESS) {
+        *out_samples = nullptr;
+        *out_count = 0;
+        return result;
+    }
+
+    reader->pending_pos = std::min(reader->block_size, reader->pending.size());
+    *out_samples = reader->pending.data();
+    *out_count = reader->pending_pos;
+    return RAC_SUCCESS;
+}
+
+extern "C" void rac_audio_reader_close(rac_handle_t handle) {
+    if (!handle)
+        return;
+
+    auto* reader = reinterpret_cast<rac_audio_reader*>(handle);
+    if (reader->map) {
+        munmap(const_cast<uint8_t*>(reader->map), reader->map_size);
+    }
+    if (reader->file) {
+        fclose(reader->file);
+    }
+#if defined(RAC_AUDIO_DECODERS)
+    audio_decoder_close(reader->decoder);
+#endif
+    delete reader;
+}
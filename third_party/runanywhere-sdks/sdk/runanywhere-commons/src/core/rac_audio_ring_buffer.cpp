@@ -0,0 +1,272 @@
+/**
+ * @file rac_audio_ring_buffer.cpp
+ * @brief RunAnywhere Commons - Multi-Reader Audio Ring Buffer
+ *
+ * Positions are 64-bit sample counts that only grow; a position maps to
+ * index (position & mask) in the ring. The first max_read_size samples of
+ * the ring are mirrored past its end, so any view of up to max_read_size
+ * samples is contiguous.
+ *
+ * The writer publishes two positions. write_begin is raised before samples
+ * are copied in and write_end after, so a reader can tell whether its
+ * samples were overwritten while it was using them (in the manner of a
+ * seqlock): position p is intact as long as write_begin <= p + capacity.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_error.h"
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+namespace {
+
+// Reader cursors are written on every consume; keep each on its own line
+struct alignas(64) ring_reader {
+    std::atomic<bool> active{false};
+    std::atomic<uint64_t> cursor{0};
+    uint64_t dropped = 0;  // Skipped since the last peek; reader thread only
+};
+
+}  // namespace
+
+struct rac_audio_ring_buffer {
+    size_t capacity = 0;
+    size_t mask = 0;
+    size_t mirror = 0;  // Samples mirrored past the end (max_read_size)
+    std::vector<float> data;
+    std::vector<ring_reader> readers;
+
+    alignas(64) std::atomic<uint64_t> write_begin{0};
+    std::atomic<uint64_t> write_end{0};
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static ring_reader* get_reader(rac_audio_ring_buffer* ring, int32_t reader) {
+    if (reader < 0 || static_cast<size_t>(reader) >= ring->readers.size()) {
+        return nullptr;
+    }
+    ring_reader* slot = &ring->readers[static_cast<size_t>(reader)];
+    return slot->active.load(std::memory_order_acquire) ? slot : nullptr;
+}
+
+/**
+ * Oldest position that is not being overwritten
+ */
+static uint64_t oldest_position(const rac_audio_ring_buffer* ring) {
+    const uint64_t begin = ring->write_begin.load(std::memory_order_relaxed);
+    return begin > ring->capacity ? begin - ring->capacity : 0;
+}
+
+/**
+ * Copy samples to ring indices [index, index + count), which must not wrap,
+ * and to the mirror of any part of that range inside it
+ */
+static void copy_in(rac_audio_ring_buffer* ring, size_t index, const float* samples,
+                    size_t count) {
+    memcpy(ring->data.data() + index, samples, count * sizeof(float));
+    if (index < ring->mirror) {
+        const size_t mirrored = std::min(count, ring->mirror - index);
+        memcpy(ring->data.data() + ring->capacity + index, samples, mirrored * sizeof(float));
+    }
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+extern "C" {
+
+rac_result_t rac_audio_ring_buffer_create(const rac_audio_ring_buffer_config_t* config,
+                                          rac_handle_t* out_handle) {
+    if (!out_handle) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    const rac_audio_ring_buffer_config_t cfg =
+        config ? *config : RAC_AUDIO_RING_BUFFER_CONFIG_DEFAULT;
+    if (cfg.capacity == 0 || cfg.max_readers <= 0 || cfg.capacity > (SIZE_MAX >> 2)) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t capacity = 1;
+    while (capacity < cfg.capacity) {
+        capacity <<= 1;
+    }
+
+    auto* ring = new (std::nothrow) rac_audio_ring_buffer();
+    if (!ring) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    ring->mirror = cfg.max_read_size > 0 ? std::min(cfg.max_read_size, capacity) : capacity;
+    try {
+        ring->data.assign(capacity + ring->mirror, 0.0f);
+        ring->readers = std::vector<ring_reader>(static_cast<size_t>(cfg.max_readers));
+    } catch (const std::bad_alloc&) {
+        delete ring;
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    *out_handle = ring;
+    return RAC_SUCCESS;
+}
+
+void rac_audio_ring_buffer_destroy(rac_handle_t handle) {
+    delete static_cast<rac_audio_ring_buffer*>(handle);
+}
+
+rac_result_t rac_audio_ring_buffer_write(rac_handle_t handle, const float* samples,
+                                         size_t sample_count) {
+    if (!handle || (!samples && sample_count > 0)) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    auto* ring = static_cast<rac_audio_ring_buffer*>(handle);
+
+    // Only the writer stores write_end, so its own value is current
+    const uint64_t end = ring->write_end.load(std::memory_order_relaxed) + sample_count;
+    if (sample_count > ring->capacity) {
+        samples += sample_count - ring->capacity;
+        sample_count = ring->capacity;
+    }
+    const uint64_t start = end - sample_count;
+
+    // Announce the overwrite before touching the samples; readers check
+    // write_begin after reading theirs
+    ring->write_begin.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t index = static_cast<size_t>(start) & ring->mask;
+    const size_t first = std::min(sample_count, ring->capacity - index);
+    copy_in(ring, index, samples, first);
+    if (first < sample_count) {
+        copy_in(ring, 0, samples + first, sample_count - first);
+    }
+
+    ring->write_end.store(end, std::memory_order_release);
+    return RAC_SUCCESS;
+}
+
+uint64_t rac_audio_ring_buffer_write_position(rac_handle_t handle) {
+    if (!handle) {
+        return 0;
+    }
+    return static_cast<rac_audio_ring_buffer*>(handle)->write_end.load(std::memory_order_acquire);
+}
+
+rac_result_t rac_audio_ring_buffer_add_reader(rac_handle_t handle, int32_t* out_reader) {
+    if (!handle || !out_reader) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    auto* ring = static_cast<rac_audio_ring_buffer*>(handle);
+
+    for (size_t i = 0; i < ring->readers.size(); ++i) {
+        ring_reader& slot = ring->readers[i];
+        bool expected = false;
+        if (slot.active.load(std::memory_order_relaxed) ||
+            !slot.active.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            continue;
+        }
+        slot.cursor.store(ring->write_end.load(std::memory_order_acquire),
+                          std::memory_order_relaxed);
+        slot.dropped = 0;
+        *out_reader = static_cast<int32_t>(i);
+        return RAC_SUCCESS;
+    }
+    return RAC_ERROR_SERVICE_BUSY;
+}
+
+rac_result_t rac_audio_ring_buffer_remove_reader(rac_handle_t handle, int32_t reader) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    ring_reader* slot = get_reader(static_cast<rac_audio_ring_buffer*>(handle), reader);
+    if (!slot) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    slot->active.store(false, std::memory_order_release);
+    return RAC_SUCCESS;
+}
+
+uint64_t rac_audio_ring_buffer_available(rac_handle_t handle, int32_t reader) {
+    if (!handle) {
+        return 0;
+    }
+    auto* ring = static_cast<rac_audio_ring_buffer*>(handle);
+    ring_reader* slot = get_reader(ring, reader);
+    if (!slot) {
+        return 0;
+    }
+    const uint64_t end = ring->write_end.load(std::memory_order_acquire);
+    const uint64_t cursor = slot->cursor.load(std::memory_order_relaxed);
+    return end > cursor ? end - cursor : 0;
+}
+
+rac_result_t rac_audio_ring_buffer_peek(rac_handle_t handle, int32_t reader, size_t max_count,
+                                        rac_audio_ring_view_t* out_view) {
+    if (!handle || !out_view) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    auto* ring = static_cast<rac_audio_ring_buffer*>(handle);
+    ring_reader* slot = get_reader(ring, reader);
+    if (!slot) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const uint64_t end = ring->write_end.load(std::memory_order_acquire);
+    uint64_t cursor = slot->cursor.load(std::memory_order_relaxed);
+
+    // Fell behind: resume at the oldest sample the writer is not replacing
+    const uint64_t oldest = oldest_position(ring);
+    if (cursor < oldest) {
+        slot->dropped += oldest - cursor;
+        cursor = oldest;
+        slot->cursor.store(cursor, std::memory_order_relaxed);
+    }
+
+    const uint64_t unread = end > cursor ? end - cursor : 0;
+    const size_t count = static_cast<size_t>(
+        std::min<uint64_t>(unread, std::min(max_count, ring->mirror)));
+
+    out_view->samples = ring->data.data() + (static_cast<size_t>(cursor) & ring->mask);
+    out_view->count = count;
+    out_view->position = cursor;
+    out_view->dropped = slot->dropped;
+    slot->dropped = 0;
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_audio_ring_buffer_consume(rac_handle_t handle, int32_t reader,
+                                           size_t sample_count) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    auto* ring = static_cast<rac_audio_ring_buffer*>(handle);
+    ring_reader* slot = get_reader(ring, reader);
+    if (!slot) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Order the caller's reads of the view before the write_begin check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const bool overrun = slot->cursor.load(std::memory_order_relaxed) < oldest_position(ring);
+
+    const uint64_t end = ring->write_end.load(std::memory_order_acquire);
+    const uint64_t cursor = slot->cursor.load(std::memory_order_relaxed);
+    slot->cursor.store(std::min<uint64_t>(cursor + sample_count, std::max(end, cursor)),
+                       std::memory_order_relaxed);
+
+    return overrun ? RAC_ERROR_AUDIO_BUFFER_OVERRUN : RAC_SUCCESS;
+}
+
+}  // extern "C"
@@ -7,7 +7,6 @@
 
 #include "rac/core/rac_audio_utils.h"
 
-#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -143,12 +142,7 @@ rac_result_t rac_audio_float32_to_wav(const void* pcm_data, size_t pcm_size, int
     const float* float_samples = static_cast<const float*>(pcm_data);
     int16_t* int16_samples = reinterpret_cast<int16_t*>(wav_data + WAV_HEADER_SIZE);
 
-    for (size_t i = 0; i < num_samples; ++i) {
-        // Clamp to [-1.0, 1.0] range
-        float sample = std::max(-1.0f, std::min(1.0f, float_samples[i]));
-        // Scale to Int16 range [-32768, 32767]
-        int16_samples[i] = static_cast<int16_t>(sample * 32767.0f);
-    }
+    rac_audio_float32_to_int16(float_samples, num_samples, int16_samples);
 
     *out_wav_data = wav_data;
     *out_wav_size = wav_size;
@@ -205,6 +205,8 @@ const char* rac_error_message(rac_result_t error_code) {
             return "Audio buffer is empty";
         case RAC_ERROR_AUDIO_SESSION_ACTIVATION_FAILED:
             return "Audio session activation failed";
+        case RAC_ERROR_AUDIO_BUFFER_OVERRUN:
+            return "Audio buffer overrun";
 
         // =================================================================
         // LANGUAGE/VOICE ERRORS (-300 to -319)
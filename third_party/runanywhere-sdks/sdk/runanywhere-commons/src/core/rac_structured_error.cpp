@@ -414,6 +414,8 @@ const char* rac_error_code_name(rac_result_t code) {
             return "emptyAudioBuffer";
         case RAC_ERROR_AUDIO_SESSION_ACTIVATION_FAILED:
             return "audioSessionActivationFailed";
+        case RAC_ERROR_AUDIO_BUFFER_OVERRUN:
+            return "audioBufferOverrun";
 
         // Language/Voice Errors (-300 to -319)
         case RAC_ERROR_LANGUAGE_NOT_SUPPORTED:
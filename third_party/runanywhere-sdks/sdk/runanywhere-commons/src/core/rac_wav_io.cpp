@@ -0,0 +1,177 @@
+/**
+ * @file rac_wav_io.cpp
+ * @brief RunAnywhere Commons - Streaming WAV Writer Implementation
+ */
+
+#include "rac/core/rac_wav_io.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+
+static const char* LOG_CAT = "WAV";
+
+// WAV format tag
+static constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+
+static constexpr size_t WAV_HEADER_SIZE = 44;
+
+// RIFF sizes are 32-bit; the RIFF size field also covers the 36 header bytes
+// that follow it
+static constexpr uint64_t WAV_MAX_DATA_SIZE = 0xFFFFFFFFull - 36;
+
+// Float32 samples converted per write
+static constexpr size_t CONVERT_SAMPLES = 4096;
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+struct rac_wav_writer {
+    FILE* file = nullptr;
+    int32_t sample_rate = 0;
+    int32_t channels = 0;
+    uint64_t data_size = 0;
+    bool failed = false;
+    std::vector<int16_t> scratch;
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static void write_uint16_le(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value & 0xFF);
+    p[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+}
+
+static void write_uint32_le(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value & 0xFF);
+    p[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    p[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
+    p[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
+}
+
+// =============================================================================
+// WRITER API
+// =============================================================================
+
+static bool write_header(rac_wav_writer* writer) {
+    const uint16_t block_align = static_cast<uint16_t>(writer->channels * 2);
+    uint8_t header[WAV_HEADER_SIZE];
+    memcpy(header, "RIFF", 4);
+    write_uint32_le(header + 4, 0);  // Filled in on close
+    memcpy(header + 8, "WAVEfmt ", 8);
+    write_uint32_le(header + 16, 16);
+    write_uint16_le(header + 20, WAVE_FORMAT_PCM);
+    write_uint16_le(header + 22, static_cast<uint16_t>(writer->channels));
+    write_uint32_le(header + 24, static_cast<uint32_t>(writer->sample_rate));
+    write_uint32_le(header + 28, static_cast<uint32_t>(writer->sample_rate) * block_align);
+    write_uint16_le(header + 32, block_align);
+    write_uint16_le(header + 34, 16);
+    memcpy(header + 36, "data", 4);
+    write_uint32_le(header + 40, 0);  // Filled in on close
+    return fwrite(header, 1, sizeof(header), writer->file) == sizeof(header);
+}
+
+extern "C" rac_result_t rac_wav_writer_open(const char* path, int32_t sample_rate,
+                                            int32_t channels, rac_handle_t* out_writer) {
+    if (!path || !out_writer || sample_rate <= 0 || channels <= 0 || channels > UINT16_MAX / 2) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto* writer = new (std::nothrow) rac_wav_writer();
+    if (!writer) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    writer->sample_rate = sample_rate;
+    writer->channels = channels;
+
+    writer->file = fopen(path, "wb");
+    if (!writer->file || !write_header(writer)) {
+        RAC_LOG_ERROR(LOG_CAT, "Cannot create %s", path);
+        if (writer->file) {
+            fclose(writer->file);
+        }
+        delete writer;
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+
+    *out_writer = reinterpret_cast<rac_handle_t>(writer);
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_wav_writer_write_int16(rac_handle_t handle, const int16_t* samples,
+                                                   size_t sample_count) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!samples && sample_count > 0)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* writer = reinterpret_cast<rac_wav_writer*>(handle);
+    if (writer->failed) {
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+
+    const uint64_t bytes = static_cast<uint64_t>(sample_count) * sizeof(int16_t);
+    if (writer->data_size + bytes > WAV_MAX_DATA_SIZE) {
+        RAC_LOG_ERROR(LOG_CAT, "WAV data would exceed the 4 GB RIFF limit");
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    if (fwrite(samples, sizeof(int16_t), sample_count, writer->file) != sample_count) {
+        writer->failed = true;
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    writer->data_size += bytes;
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_wav_writer_write_float32(rac_handle_t handle, const float* samples,
+                                                     size_t sample_count) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!samples && sample_count > 0)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* writer = reinterpret_cast<rac_wav_writer*>(handle);
+    writer->scratch.resize(CONVERT_SAMPLES);
+    for (size_t offset = 0; offset < sample_count; offset += CONVERT_SAMPLES) {
+        const size_t count = std::min(CONVERT_SAMPLES, sample_count - offset);
+        rac_audio_float32_to_int16(samples + offset, count, writer->scratch.data());
+        rac_result_t result = rac_wav_writer_write_int16(handle, writer->scratch.data(), count);
+        if (result != RAC_SUCCESS) {
+            return result;
+        }
+    }
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_wav_writer_close(rac_handle_t handle) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+
+    auto* writer = reinterpret_cast<rac_wav_writer*>(handle);
+    bool ok = !writer->failed;
+
+    if (ok) {
+        uint8_t size[4];
+        write_uint32_le(size, static_cast<uint32_t>(writer->data_size + WAV_HEADER_SIZE - 8));
+        ok = fseeko(writer->file, 4, SEEK_SET) == 0 && fwrite(size, 1, 4, writer->file) == 4;
+        write_uint32_le(size, static_cast<uint32_t>(writer->data_size));
+        ok = ok && fseeko(writer->file, 40, SEEK_SET) == 0 &&
+             fwrite(size, 1, 4, writer->file) == 4;
+    }
+    ok = fclose(writer->file) == 0 && ok;
+
+    if (!ok) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to finalize WAV file");
+    }
+    delete writer;
+    return ok ? RAC_SUCCESS : RAC_ERROR_FILE_WRITE_FAILED;
+}
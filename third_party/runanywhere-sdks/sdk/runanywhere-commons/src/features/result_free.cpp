@@ -50,10 +50,16 @@ __attribute__((weak)) void rac_stt_result_free(rac_stt_result_t* result) {
 __attribute__((weak)) void rac_tts_result_free(rac_tts_result_t* result) {
     if (result) {
         if (result->audio_data) {
-            free(result->audio_data);
+            if (result->release_audio) {
+                result->release_audio(result->audio_data, result->release_context);
+            } else {
+                free(result->audio_data);
+            }
             result->audio_data = nullptr;
         }
         result->audio_size = 0;
+        result->release_audio = nullptr;
+        result->release_context = nullptr;
     }
 }
 
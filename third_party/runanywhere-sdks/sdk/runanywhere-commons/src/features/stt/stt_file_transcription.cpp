@@ -0,0 +1,361 @@
+/**
+ * @file stt_file_transcription.cpp
+ * @brief RunAnywhere Commons - STT file transcription
+ *
+ * Streams an audio file through the component in bounded windows. Built only
+ * on the public component and audio reader APIs. A reader thread decodes,
+ * resamples and cuts windows while the calling thread transcribes them; at
+ * most WINDOW_QUEUE_DEPTH windows wait between the two.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_audio_reader.h"
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+#include "rac/features/stt/rac_stt_component.h"
+#include "rac/features/stt/rac_stt_service.h"
+
+static const char* LOG_CAT = "STT.File";
+
+// Longest window passed to a single transcription; matches Whisper's context
+static constexpr int64_t WINDOW_MS = 30000;
+
+// A window is cut at the quietest frame within this much of WINDOW_MS
+static constexpr int64_t CUT_SEARCH_MS = 3000;
+static constexpr int64_t CUT_FRAME_MS = 20;
+
+// Windows the reader thread may decode ahead of the one being transcribed
+static constexpr size_t WINDOW_QUEUE_DEPTH = 2;
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+/**
+ * Results of the windows transcribed so far
+ */
+struct file_transcript {
+    std::string text;
+    std::vector<rac_stt_word_t> words;  // Word texts are owned
+    char* detected_language = nullptr;
+    double confidence_sum = 0.0;  // Confidence weighted by window length
+    int64_t transcribed_ms = 0;
+    int64_t processing_time_ms = 0;
+
+    ~file_transcript() {
+        for (rac_stt_word_t& word : words) {
+            free(const_cast<char*>(word.text));
+        }
+        free(detected_language);
+    }
+};
+
+/**
+ * A window cut from the file, ready to transcribe
+ */
+struct pcm_window {
+    std::vector<int16_t> samples;
+    int64_t start_samples = 0;
+};
+
+/**
+ * Hand-off between the reader thread and the transcribing thread
+ */
+struct window_queue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<pcm_window> windows;
+    bool finished = false;   // Reader is done; read_result says how it ended
+    bool cancelled = false;  // Transcription failed; the reader should stop
+    rac_result_t read_result = RAC_SUCCESS;
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+/**
+ * Pick where to end a full window: the middle of the lowest-energy frame in
+ * the CUT_SEARCH_MS before WINDOW_MS, so words are not split across windows.
+ * The buffer may run past WINDOW_MS by up to a block; the cut never does.
+ */
+static size_t find_window_cut(const std::vector<int16_t>& window, int32_t sample_rate) {
+    const auto frame = static_cast<size_t>(sample_rate * CUT_FRAME_MS / 1000);
+    const auto search = static_cast<size_t>(sample_rate * CUT_SEARCH_MS / 1000);
+    const size_t limit =
+        std::min(window.size(), static_cast<size_t>(sample_rate * WINDOW_MS / 1000));
+    if (frame == 0 || limit < search + frame) {
+        return limit;
+    }
+
+    size_t best = limit;
+    int64_t best_energy = INT64_MAX;
+    for (size_t start = limit - search; start + frame <= limit; start += frame) {
+        int64_t energy = 0;
+        for (size_t i = start; i < start + frame; ++i) {
+            energy += static_cast<int32_t>(window[i]) * window[i];
+        }
+        if (energy < best_energy) {
+            best_energy = energy;
+            best = start + frame / 2;
+        }
+    }
+    return best;
+}
+
+/**
+ * Move one window's result into the transcript, shifting word times by the
+ * window's start
+ */
+static void append_window(file_transcript* transcript, rac_stt_result_t* result,
+                          int64_t offset_ms, int64_t length_ms) {
+    if (result->text) {
+        std::string text = result->text;
+        const size_t first = text.find_first_not_of(" \t\n");
+        const size_t last = text.find_last_not_of(" \t\n");
+        if (first != std::string::npos) {
+            if (!transcript->text.empty()) {
+                transcript->text += ' ';
+            }
+            transcript->text.append(text, first, last - first + 1);
+        }
+    }
+
+    if (result->words) {
+        for (size_t i = 0; i < result->num_words; ++i) {
+            rac_stt_word_t word = result->words[i];
+            word.start_ms += offset_ms;
+            word.end_ms += offset_ms;
+            transcript->words.push_back(word);
+        }
+        free(result->words);
+        result->words = nullptr;
+        result->num_words = 0;
+    }
+
+    if (!transcript->detected_language) {
+        transcript->detected_language = result->detected_language;
+        result->detected_language = nullptr;
+    }
+
+    transcript->confidence_sum += static_cast<double>(result->confidence) * length_ms;
+    transcript->transcribed_ms += length_ms;
+    transcript->processing_time_ms += result->processing_time_ms;
+
+    rac_stt_result_free(result);
+}
+
+static rac_result_t transcribe_window(rac_handle_t handle, const int16_t* samples, size_t count,
+                                      int32_t sample_rate, const rac_stt_options_t* options,
+                                      int64_t offset_ms, file_transcript* transcript) {
+    rac_stt_result_t result = {};
+    rac_result_t status = rac_stt_component_transcribe(handle, samples, count * sizeof(int16_t),
+                                                       options, &result);
+    if (status != RAC_SUCCESS) {
+        rac_stt_result_free(&result);
+        return status;
+    }
+    append_window(transcript, &result, offset_ms,
+                  static_cast<int64_t>(count) * 1000 / sample_rate);
+    return RAC_SUCCESS;
+}
+
+/**
+ * Queue a window, waiting while the transcriber is WINDOW_QUEUE_DEPTH
+ * windows behind. Returns false once transcription has been cancelled.
+ */
+static bool push_window(window_queue* queue, pcm_window window) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->cv.wait(lock, [queue] {
+        return queue->cancelled || queue->windows.size() < WINDOW_QUEUE_DEPTH;
+    });
+    if (queue->cancelled) {
+        return false;
+    }
+    queue->windows.push_back(std::move(window));
+    lock.unlock();
+    queue->cv.notify_all();
+    return true;
+}
+
+/**
+ * Reader thread: decode the file block by block, convert to 16-bit PCM and
+ * cut it into windows
+ */
+static void read_windows(rac_handle_t reader, int32_t sample_rate, size_t block_size,
+                         window_queue* queue) {
+    const auto window_samples = static_cast<size_t>(sample_rate * WINDOW_MS / 1000);
+    pcm_window window;
+    window.samples.reserve(window_samples + block_size);
+    std::vector<int16_t> block;
+    rac_result_t result = RAC_SUCCESS;
+
+    while (true) {
+        const float* samples = nullptr;
+        size_t count = 0;
+        result = rac_audio_reader_read(reader, &samples, &count);
+        if (result != RAC_SUCCESS) {
+            break;
+        }
+
+        if (count > 0) {
+            block.resize(count);
+            rac_audio_float32_to_int16(samples, count, block.data());
+            window.samples.insert(window.samples.end(), block.begin(), block.end());
+            if (window.samples.size() < window_samples) {
+                continue;
+            }
+        } else if (window.samples.empty()) {
+            break;
+        }
+
+        // The tail after the cut starts the next window
+        const size_t cut =
+            count > 0 ? find_window_cut(window.samples, sample_rate) : window.samples.size();
+        pcm_window next;
+        next.start_samples = window.start_samples + static_cast<int64_t>(cut);
+        next.samples.reserve(window_samples + block_size);
+        next.samples.assign(window.samples.begin() + static_cast<ptrdiff_t>(cut),
+                            window.samples.end());
+        window.samples.resize(cut);
+
+        if (!push_window(queue, std::move(window))) {
+            return;
+        }
+        window = std::move(next);
+
+        if (count == 0) {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->finished = true;
+        queue->read_result = result;
+    }
+    queue->cv.notify_all();
+}
+
+// =============================================================================
+// FILE TRANSCRIPTION API
+// =============================================================================
+
+extern "C" rac_result_t rac_stt_component_transcribe_file(rac_handle_t handle,
+                                                          const char* file_path,
+                                                          const rac_stt_options_t* options,
+                                                          rac_stt_result_t* out_result) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!file_path || !out_result)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    // Windows are handed over as 16-bit PCM at the rate the options announce
+    rac_stt_options_t window_options = options ? *options : RAC_STT_OPTIONS_DEFAULT;
+    window_options.audio_format = RAC_AUDIO_FORMAT_PCM;
+    if (window_options.sample_rate <= 0) {
+        window_options.sample_rate = RAC_STT_OPTIONS_DEFAULT.sample_rate;
+    }
+    const int32_t sample_rate = window_options.sample_rate;
+
+    rac_audio_reader_config_t reader_config = RAC_AUDIO_READER_CONFIG_DEFAULT;
+    reader_config.target_sample_rate = sample_rate;
+    rac_handle_t reader = nullptr;
+    rac_result_t result = rac_audio_reader_open(file_path, &reader_config, &reader);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    rac_audio_file_info_t info = {};
+    rac_audio_reader_get_info(reader, &info);
+    if (info.frame_count > 0) {
+        log_info(LOG_CAT, "Transcribing %s (%.1fs)", file_path,
+                 static_cast<double>(info.frame_count) / info.sample_rate);
+    } else {
+        log_info(LOG_CAT, "Transcribing %s", file_path);
+    }
+
+    // Without options the component applies its configured defaults; only
+    // the sample rate has to be pinned to what the reader produces
+    const rac_stt_options_t* effective_options =
+        options || sample_rate != RAC_STT_OPTIONS_DEFAULT.sample_rate ? &window_options : nullptr;
+
+    window_queue queue;
+    std::thread reader_thread(read_windows, reader, sample_rate, reader_config.block_size,
+                              &queue);
+
+    file_transcript transcript;
+    int64_t window_start_samples = 0;
+
+    while (true) {
+        pcm_window window;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.cv.wait(lock, [&queue] { return queue.finished || !queue.windows.empty(); });
+            if (queue.windows.empty()) {
+                result = queue.read_result;
+                break;
+            }
+            window = std::move(queue.windows.front());
+            queue.windows.pop_front();
+        }
+        queue.cv.notify_all();
+
+        window_start_samples = window.start_samples;
+        result = transcribe_window(handle, window.samples.data(), window.samples.size(),
+                                   sample_rate, effective_options,
+                                   window.start_samples * 1000 / sample_rate, &transcript);
+        if (result != RAC_SUCCESS) {
+            break;
+        }
+    }
+
+    if (result != RAC_SUCCESS) {
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.cancelled = true;
+        }
+        queue.cv.notify_all();
+    }
+    reader_thread.join();
+    rac_audio_reader_close(reader);
+
+    if (result != RAC_SUCCESS) {
+        log_error(LOG_CAT, "Transcription of %s failed at %.1fs", file_path,
+                  static_cast<double>(window_start_samples) / sample_rate);
+        return result;
+    }
+
+    *out_result = {};
+    out_result->text = transcript.text.empty() ? nullptr : strdup(transcript.text.c_str());
+    out_result->detected_language = transcript.detected_language;
+    transcript.detected_language = nullptr;
+    if (!transcript.words.empty()) {
+        out_result->words = static_cast<rac_stt_word_t*>(
+            malloc(transcript.words.size() * sizeof(rac_stt_word_t)));
+        if (out_result->words) {
+            memcpy(out_result->words, transcript.words.data(),
+                   transcript.words.size() * sizeof(rac_stt_word_t));
+            out_result->num_words = transcript.words.size();
+            transcript.words.clear();
+        }
+    }
+    out_result->confidence =
+        transcript.transcribed_ms > 0
+            ? static_cast<float>(transcript.confidence_sum / transcript.transcribed_ms)
+            : 0.0f;
+    out_result->processing_time_ms = transcript.processing_time_ms;
+
+    log_info(LOG_CAT, "Transcribed %s in %lldms", file_path,
+             static_cast<long long>(transcript.processing_time_ms));
+    return RAC_SUCCESS;
+}
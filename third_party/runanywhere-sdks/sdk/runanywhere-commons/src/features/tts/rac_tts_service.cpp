@@ -168,9 +168,15 @@ void rac_tts_result_free(rac_tts_result_t* result) {
     if (!result)
         return;
     if (result->audio_data) {
-        free(result->audio_data);
+        if (result->release_audio) {
+            result->release_audio(result->audio_data, result->release_context);
+        } else {
+            free(result->audio_data);
+        }
         result->audio_data = nullptr;
     }
+    result->release_audio = nullptr;
+    result->release_context = nullptr;
 }
 
 }  // extern "C"
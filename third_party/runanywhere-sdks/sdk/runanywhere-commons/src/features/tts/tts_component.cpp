@@ -9,11 +9,18 @@
  * Do NOT add features not present in the Swift code.
  */
 
+#include <cctype>
 #include <chrono>
+#include <cinttypes>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "rac/core/capabilities/rac_lifecycle.h"
 #include "rac/core/rac_analytics_events.h"
@@ -27,10 +34,48 @@
 // INTERNAL STRUCTURES
 // =============================================================================
 
+// Synthesized audio for one cache key
+struct tts_cache_entry {
+    std::string key;
+    std::shared_ptr<const std::vector<uint8_t>> audio;
+    rac_audio_format_enum_t audio_format;
+    rac_tts_sample_format_t sample_format;
+    int32_t sample_rate;
+    int64_t duration_ms;
+};
+
+// A persisted entry file, by name within the persist directory
+struct tts_disk_entry {
+    std::string name;
+    size_t bytes;
+};
+
+// LRU of synthesized phrases bounded by audio bytes, optionally mirrored to a
+// directory through the platform adapter so phrases survive restarts. The
+// directory is an LRU of its own under the same budget; the platform adapter
+// cannot list directories, so its files are tracked in an index file.
+struct tts_audio_cache {
+    size_t max_bytes = 0;  // 0 = disabled
+    size_t max_entry_bytes = 0;
+    std::string persist_directory;
+
+    std::list<tts_cache_entry> entries;  // Most recently used first
+    std::unordered_map<std::string, std::list<tts_cache_entry>::iterator> index;
+    size_t bytes = 0;
+
+    std::list<tts_disk_entry> disk_entries;  // Most recently used first
+    std::unordered_map<std::string, std::list<tts_disk_entry>::iterator> disk_index;
+    size_t disk_bytes = 0;
+    bool disk_index_loaded = false;
+
+    rac_tts_cache_stats_t stats = {};
+};
+
 struct rac_tts_component {
     rac_handle_t lifecycle;
     rac_tts_config_t config;
     rac_tts_options_t default_options;
+    tts_audio_cache cache;
     std::mutex mtx;
 
     rac_tts_component() : lifecycle(nullptr) {
@@ -59,6 +104,446 @@ static std::string generate_uuid_v4() {
     return uuid;
 }
 
+// =============================================================================
+// AUDIO CACHE
+// =============================================================================
+
+static constexpr char TTS_CACHE_MAGIC[4] = {'R', 'T', 'T', 'S'};
+static constexpr uint32_t TTS_CACHE_VERSION = 1;
+
+// Persisted entry layout: magic, version, sample_rate, audio_format,
+// sample_format, duration_ms, key length, key, audio
+static constexpr size_t TTS_CACHE_HEADER_SIZE = 4 + 4 + 4 + 4 + 4 + 8 + 4;
+
+// Trims and collapses whitespace runs so cosmetic differences still hit
+static std::string normalize_cache_text(const char* text) {
+    std::string normalized;
+    bool pending_space = false;
+    for (const char* p = text; *p; ++p) {
+        if (std::isspace(static_cast<unsigned char>(*p))) {
+            pending_space = !normalized.empty();
+            continue;
+        }
+        if (pending_space) {
+            normalized.push_back(' ');
+            pending_space = false;
+        }
+        normalized.push_back(*p);
+    }
+    return normalized;
+}
+
+// Covers every option that changes the audio; borrow_audio only changes who
+// owns the returned buffer
+static std::string make_cache_key(const char* voice_id, const rac_tts_options_t* options,
+                                  const char* text) {
+    char params[128];
+    snprintf(params, sizeof(params), "%.3f|%.3f|%.3f|%d|%d|%d|%d",
+             options->rate > 0 ? options->rate : 1.0f, options->pitch, options->volume,
+             static_cast<int>(options->audio_format), static_cast<int>(options->sample_rate),
+             static_cast<int>(options->use_ssml), static_cast<int>(options->sample_format));
+
+    std::string key = voice_id ? voice_id : "";
+    key += '|';
+    key += options->voice ? options->voice : "";
+    key += '|';
+    key += options->language ? options->language : "";
+    key += '|';
+    key += params;
+    key += '|';
+    key += normalize_cache_text(text);
+    return key;
+}
+
+// Lists the persisted entries, most recently used first, as "<name> <bytes>" lines
+static constexpr const char* TTS_CACHE_INDEX_NAME = "ttscache.index";
+
+static std::string cache_file_name(const std::string& key) {
+    // FNV-1a names the file; the stored key guards against collisions
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016" PRIx64 ".ttscache", hash);
+    return name;
+}
+
+static std::string cache_dir_path(const tts_audio_cache& cache, const std::string& name) {
+    std::string path = cache.persist_directory;
+    if (!path.empty() && path.back() != '/') {
+        path += '/';
+    }
+    return path + name;
+}
+
+static void disk_save_index(const tts_audio_cache& cache) {
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    if (cache.persist_directory.empty() || !adapter || !adapter->file_write) {
+        return;
+    }
+
+    std::string index;
+    for (const tts_disk_entry& entry : cache.disk_entries) {
+        index += entry.name;
+        index += ' ';
+        index += std::to_string(entry.bytes);
+        index += '\n';
+    }
+    const std::string path = cache_dir_path(cache, TTS_CACHE_INDEX_NAME);
+    if (adapter->file_write(path.c_str(), index.data(), index.size(), adapter->user_data) !=
+        RAC_SUCCESS) {
+        log_warning("TTS.Component", "Failed to write cache index: %s", path.c_str());
+    }
+}
+
+static void disk_forget(tts_audio_cache& cache, const std::string& name) {
+    auto it = cache.disk_index.find(name);
+    if (it != cache.disk_index.end()) {
+        cache.disk_bytes -= it->second->bytes;
+        cache.disk_entries.erase(it->second);
+        cache.disk_index.erase(it);
+    }
+}
+
+// Records a persisted file as most recently used
+static void disk_touch(tts_audio_cache& cache, const std::string& name, size_t bytes) {
+    disk_forget(cache, name);
+    cache.disk_entries.push_front({name, bytes});
+    cache.disk_index[name] = cache.disk_entries.begin();
+    cache.disk_bytes += bytes;
+}
+
+// Deletes least recently used files until the directory fits the budget;
+// returns whether anything was deleted
+static bool disk_prune(tts_audio_cache& cache, size_t budget) {
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    bool pruned = false;
+    while (cache.disk_bytes > budget && !cache.disk_entries.empty()) {
+        const tts_disk_entry& oldest = cache.disk_entries.back();
+        if (adapter && adapter->file_delete) {
+            const std::string path = cache_dir_path(cache, oldest.name);
+            adapter->file_delete(path.c_str(), adapter->user_data);
+        }
+        cache.disk_bytes -= oldest.bytes;
+        cache.disk_index.erase(oldest.name);
+        cache.disk_entries.pop_back();
+        cache.stats.disk_evictions++;
+        pruned = true;
+    }
+    return pruned;
+}
+
+// Reads the persist directory's index and prunes it to the current budget
+static void disk_load_index(tts_audio_cache& cache) {
+    cache.disk_entries.clear();
+    cache.disk_index.clear();
+    cache.disk_bytes = 0;
+    cache.disk_index_loaded = true;
+
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    if (cache.persist_directory.empty() || !adapter || !adapter->file_exists ||
+        !adapter->file_read) {
+        return;
+    }
+    const std::string path = cache_dir_path(cache, TTS_CACHE_INDEX_NAME);
+    if (adapter->file_exists(path.c_str(), adapter->user_data) != RAC_TRUE) {
+        return;
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+    if (adapter->file_read(path.c_str(), &data, &size, adapter->user_data) != RAC_SUCCESS ||
+        !data) {
+        return;
+    }
+    const std::string index(static_cast<const char*>(data), size);
+    rac_free(data);
+
+    // Lines are most recently used first; append each so the order is kept
+    size_t line_start = 0;
+    while (line_start < index.size()) {
+        size_t line_end = index.find('\n', line_start);
+        if (line_end == std::string::npos) {
+            line_end = index.size();
+        }
+        const std::string line = index.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+
+        const size_t space = line.find(' ');
+        if (space == 0 || space == std::string::npos) {
+            continue;
+        }
+        const std::string name = line.substr(0, space);
+        if (cache.disk_index.count(name) != 0) {
+            continue;
+        }
+        const size_t bytes = strtoull(line.c_str() + space + 1, nullptr, 10);
+        cache.disk_entries.push_back({name, bytes});
+        cache.disk_index[name] = std::prev(cache.disk_entries.end());
+        cache.disk_bytes += bytes;
+    }
+
+    if (disk_prune(cache, cache.max_bytes)) {
+        disk_save_index(cache);
+    }
+}
+
+static void cache_evict(tts_audio_cache& cache, size_t budget) {
+    while (cache.bytes > budget && !cache.entries.empty()) {
+        const tts_cache_entry& oldest = cache.entries.back();
+        cache.bytes -= oldest.audio->size();
+        cache.index.erase(oldest.key);
+        cache.entries.pop_back();
+        cache.stats.evictions++;
+    }
+}
+
+static void cache_clear(tts_audio_cache& cache) {
+    cache.entries.clear();
+    cache.index.clear();
+    cache.bytes = 0;
+}
+
+static void cache_insert(tts_audio_cache& cache, tts_cache_entry entry) {
+    auto existing = cache.index.find(entry.key);
+    if (existing != cache.index.end()) {
+        cache.bytes -= existing->second->audio->size();
+        cache.entries.erase(existing->second);
+        cache.index.erase(existing);
+    }
+
+    cache.bytes += entry.audio->size();
+    cache.entries.push_front(std::move(entry));
+    cache.index[cache.entries.front().key] = cache.entries.begin();
+    cache_evict(cache, cache.max_bytes);
+}
+
+static void cache_persist(tts_audio_cache& cache, const tts_cache_entry& entry) {
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    if (cache.persist_directory.empty() || !adapter || !adapter->file_write) {
+        return;
+    }
+
+    const auto key_size = static_cast<uint32_t>(entry.key.size());
+    const auto audio_format = static_cast<int32_t>(entry.audio_format);
+    const auto sample_format = static_cast<int32_t>(entry.sample_format);
+
+    std::vector<uint8_t> file(TTS_CACHE_HEADER_SIZE + key_size + entry.audio->size());
+    uint8_t* p = file.data();
+    auto put = [&p](const void* data, size_t size) {
+        memcpy(p, data, size);
+        p += size;
+    };
+    put(TTS_CACHE_MAGIC, sizeof(TTS_CACHE_MAGIC));
+    put(&TTS_CACHE_VERSION, sizeof(TTS_CACHE_VERSION));
+    put(&entry.sample_rate, sizeof(entry.sample_rate));
+    put(&audio_format, sizeof(audio_format));
+    put(&sample_format, sizeof(sample_format));
+    put(&entry.duration_ms, sizeof(entry.duration_ms));
+    put(&key_size, sizeof(key_size));
+    put(entry.key.data(), key_size);
+    put(entry.audio->data(), entry.audio->size());
+
+    const std::string name = cache_file_name(entry.key);
+    const std::string path = cache_dir_path(cache, name);
+    if (adapter->file_write(path.c_str(), file.data(), file.size(), adapter->user_data) !=
+        RAC_SUCCESS) {
+        log_warning("TTS.Component", "Failed to persist cached audio: %s", path.c_str());
+        return;
+    }
+
+    disk_touch(cache, name, file.size());
+    disk_prune(cache, cache.max_bytes);
+    disk_save_index(cache);
+}
+
+static bool cache_load(tts_audio_cache& cache, const std::string& key,
+                       tts_cache_entry* out_entry) {
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    if (cache.persist_directory.empty() || !adapter || !adapter->file_exists ||
+        !adapter->file_read) {
+        return false;
+    }
+
+    const std::string name = cache_file_name(key);
+    const std::string path = cache_dir_path(cache, name);
+    if (adapter->file_exists(path.c_str(), adapter->user_data) != RAC_TRUE) {
+        disk_forget(cache, name);
+        return false;
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+    if (adapter->file_read(path.c_str(), &data, &size, adapter->user_data) != RAC_SUCCESS ||
+        !data) {
+        return false;
+    }
+
+    const auto* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    auto get = [&p, end](void* value, size_t value_size) {
+        if (static_cast<size_t>(end - p) < value_size) {
+            return false;
+        }
+        memcpy(value, p, value_size);
+        p += value_size;
+        return true;
+    };
+
+    char magic[4];
+    uint32_t version = 0;
+    int32_t audio_format = 0;
+    int32_t sample_format = 0;
+    uint32_t key_size = 0;
+    bool ok = get(magic, sizeof(magic)) && memcmp(magic, TTS_CACHE_MAGIC, sizeof(magic)) == 0 &&
+              get(&version, sizeof(version)) && version == TTS_CACHE_VERSION &&
+              get(&out_entry->sample_rate, sizeof(out_entry->sample_rate)) &&
+              get(&audio_format, sizeof(audio_format)) &&
+              get(&sample_format, sizeof(sample_format)) &&
+              get(&out_entry->duration_ms, sizeof(out_entry->duration_ms)) &&
+              get(&key_size, sizeof(key_size)) && static_cast<size_t>(end - p) >= key_size &&
+              key.compare(0, std::string::npos, reinterpret_cast<const char*>(p), key_size) == 0;
+
+    if (ok) {
+        p += key_size;
+        out_entry->key = key;
+        out_entry->audio = std::make_shared<const std::vector<uint8_t>>(p, end);
+        out_entry->audio_format = static_cast<rac_audio_format_enum_t>(audio_format);
+        out_entry->sample_format = static_cast<rac_tts_sample_format_t>(sample_format);
+        ok = !out_entry->audio->empty();
+    }
+
+    rac_free(data);
+    if (ok) {
+        disk_touch(cache, name, size);
+        disk_save_index(cache);
+    }
+    return ok;
+}
+
+// Finds an entry in memory, falling back to the persist directory
+static const tts_cache_entry* cache_find(tts_audio_cache& cache, const std::string& key) {
+    auto it = cache.index.find(key);
+    if (it != cache.index.end()) {
+        cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+        return &cache.entries.front();
+    }
+
+    tts_cache_entry entry;
+    if (!cache_load(cache, key, &entry) || entry.audio->size() > cache.max_entry_bytes) {
+        return nullptr;
+    }
+    cache.stats.disk_hits++;
+    cache_insert(cache, std::move(entry));
+
+    it = cache.index.find(key);
+    return it != cache.index.end() ? &*it->second : nullptr;
+}
+
+static void release_cached_audio(void* /*audio_data*/, void* context) {
+    delete static_cast<std::shared_ptr<const std::vector<uint8_t>>*>(context);
+}
+
+static rac_result_t fill_from_cache(const tts_cache_entry& entry, const rac_tts_options_t* options,
+                                    rac_tts_result_t* out_result) {
+    *out_result = {};
+    if (options->borrow_audio == RAC_TRUE) {
+        // Borrowed results pin the entry, so eviction cannot pull the buffer away
+        out_result->audio_data = const_cast<uint8_t*>(entry.audio->data());
+        out_result->release_audio = release_cached_audio;
+        out_result->release_context = new std::shared_ptr<const std::vector<uint8_t>>(entry.audio);
+    } else {
+        out_result->audio_data = malloc(entry.audio->size());
+        if (!out_result->audio_data) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(out_result->audio_data, entry.audio->data(), entry.audio->size());
+    }
+    out_result->audio_size = entry.audio->size();
+    out_result->audio_format = entry.audio_format;
+    out_result->sample_format = entry.sample_format;
+    out_result->sample_rate = entry.sample_rate;
+    out_result->duration_ms = entry.duration_ms;
+    return RAC_SUCCESS;
+}
+
+static void cache_store(tts_audio_cache& cache, const std::string& key,
+                        const rac_tts_result_t* result) {
+    if (!result->audio_data || result->audio_size == 0 ||
+        result->audio_size > cache.max_entry_bytes) {
+        return;
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(result->audio_data);
+    tts_cache_entry entry;
+    entry.key = key;
+    entry.audio = std::make_shared<const std::vector<uint8_t>>(bytes, bytes + result->audio_size);
+    entry.audio_format = result->audio_format;
+    entry.sample_format = result->sample_format;
+    entry.sample_rate = result->sample_rate;
+    entry.duration_ms = result->duration_ms;
+
+    cache_persist(cache, entry);
+    cache_insert(cache, std::move(entry));
+}
+
+static void emit_synthesis_started(const std::string& synthesis_id, const char* voice_id,
+                                   const char* voice_name, const char* text, bool cache_hit) {
+    rac_analytics_event_data_t event_data;
+    event_data.data.tts_synthesis = RAC_ANALYTICS_TTS_SYNTHESIS_DEFAULT;
+    event_data.data.tts_synthesis.synthesis_id = synthesis_id.c_str();
+    event_data.data.tts_synthesis.model_id = voice_id;
+    event_data.data.tts_synthesis.model_name = voice_name;
+    event_data.data.tts_synthesis.character_count = static_cast<int32_t>(std::strlen(text));
+    event_data.data.tts_synthesis.is_cache_hit = cache_hit ? RAC_TRUE : RAC_FALSE;
+    rac_analytics_event_emit(RAC_EVENT_TTS_SYNTHESIS_STARTED, &event_data);
+}
+
+static void emit_synthesis_completed(const std::string& synthesis_id, const char* voice_id,
+                                     const char* voice_name, const char* text,
+                                     const rac_tts_result_t* result, bool cache_hit) {
+    int32_t char_count = static_cast<int32_t>(std::strlen(text));
+    double processing_ms = static_cast<double>(result->processing_time_ms);
+    double chars_per_sec = processing_ms > 0 ? (char_count * 1000.0 / processing_ms) : 0.0;
+
+    rac_analytics_event_data_t event_data;
+    event_data.data.tts_synthesis = RAC_ANALYTICS_TTS_SYNTHESIS_DEFAULT;
+    event_data.data.tts_synthesis.synthesis_id = synthesis_id.c_str();
+    event_data.data.tts_synthesis.model_id = voice_id;
+    event_data.data.tts_synthesis.model_name = voice_name;
+    event_data.data.tts_synthesis.character_count = char_count;
+    event_data.data.tts_synthesis.audio_duration_ms = static_cast<double>(result->duration_ms);
+    event_data.data.tts_synthesis.audio_size_bytes = static_cast<int32_t>(result->audio_size);
+    event_data.data.tts_synthesis.processing_duration_ms = processing_ms;
+    event_data.data.tts_synthesis.characters_per_second = chars_per_sec;
+    event_data.data.tts_synthesis.sample_rate = static_cast<int32_t>(result->sample_rate);
+    event_data.data.tts_synthesis.is_cache_hit = cache_hit ? RAC_TRUE : RAC_FALSE;
+    rac_analytics_event_emit(RAC_EVENT_TTS_SYNTHESIS_COMPLETED, &event_data);
+}
+
+// Wraps the caller's stream callback to time the first audio chunk
+struct tts_stream_context {
+    rac_tts_stream_callback_t callback;
+    void* user_data;
+    std::chrono::steady_clock::time_point start_time;
+    double time_to_first_audio_ms;
+    size_t audio_bytes;
+};
+
+static void tts_stream_forward(const void* audio_data, size_t audio_size, void* user_data) {
+    auto* ctx = static_cast<tts_stream_context*>(user_data);
+    if (ctx->audio_bytes == 0 && audio_size > 0) {
+        ctx->time_to_first_audio_ms = std::chrono::duration<double, std::milli>(
+                                          std::chrono::steady_clock::now() - ctx->start_time)
+                                          .count();
+    }
+    ctx->audio_bytes += audio_size;
+    if (ctx->callback) {
+        ctx->callback(audio_data, audio_size, ctx->user_data);
+    }
+}
+
 // =============================================================================
 // LIFECYCLE CALLBACKS
 // =============================================================================
@@ -182,6 +667,19 @@ extern "C" const char* rac_tts_component_get_voice_id(rac_handle_t handle) {
     return rac_lifecycle_get_model_id(component->lifecycle);
 }
 
+extern "C" rac_result_t rac_tts_component_get_default_options(rac_handle_t handle,
+                                                              rac_tts_options_t* out_options) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_options)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* component = reinterpret_cast<rac_tts_component*>(handle);
+    std::lock_guard<std::mutex> lock(component->mtx);
+    *out_options = component->default_options;
+    return RAC_SUCCESS;
+}
+
 extern "C" void rac_tts_component_destroy(rac_handle_t handle) {
     if (!handle)
         return;
@@ -272,6 +770,32 @@ extern "C" rac_result_t rac_tts_component_synthesize(rac_handle_t handle, const
     const char* voice_id = rac_lifecycle_get_model_id(component->lifecycle);
     const char* voice_name = rac_lifecycle_get_model_name(component->lifecycle);
 
+    const rac_tts_options_t* effective_options = options ? options : &component->default_options;
+
+    // Serve repeated prompts from the audio cache
+    tts_audio_cache& cache = component->cache;
+    std::string cache_key;
+    if (cache.max_bytes > 0 && rac_lifecycle_is_loaded(component->lifecycle)) {
+        const auto lookup_start = std::chrono::steady_clock::now();
+        cache_key = make_cache_key(voice_id, effective_options, text);
+        if (const tts_cache_entry* entry = cache_find(cache, cache_key)) {
+            cache.stats.hits++;
+            log_debug("TTS.Component", "Synthesis served from cache");
+            emit_synthesis_started(synthesis_id, voice_id, voice_name, text, true);
+            rac_result_t result = fill_from_cache(*entry, effective_options, out_result);
+            if (result == RAC_SUCCESS) {
+                out_result->processing_time_ms =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - lookup_start)
+                        .count();
+                emit_synthesis_completed(synthesis_id, voice_id, voice_name, text, out_result,
+                                         true);
+            }
+            return result;
+        }
+        cache.stats.misses++;
+    }
+
     // Debug: Log if voice_id is null
     if (!voice_id) {
         log_warning("TTS.Component",
@@ -281,15 +805,7 @@ extern "C" rac_result_t rac_tts_component_synthesize(rac_handle_t handle, const
     }
 
     // Emit SYNTHESIS_STARTED event
-    {
-        rac_analytics_event_data_t event_data;
-        event_data.data.tts_synthesis = RAC_ANALYTICS_TTS_SYNTHESIS_DEFAULT;
-        event_data.data.tts_synthesis.synthesis_id = synthesis_id.c_str();
-        event_data.data.tts_synthesis.model_id = voice_id;
-        event_data.data.tts_synthesis.model_name = voice_name;
-        event_data.data.tts_synthesis.character_count = static_cast<int32_t>(std::strlen(text));
-        rac_analytics_event_emit(RAC_EVENT_TTS_SYNTHESIS_STARTED, &event_data);
-    }
+    emit_synthesis_started(synthesis_id, voice_id, voice_name, text, false);
 
     rac_handle_t service = nullptr;
     rac_result_t result = rac_lifecycle_require_service(component->lifecycle, &service);
@@ -309,8 +825,6 @@ extern "C" rac_result_t rac_tts_component_synthesize(rac_handle_t handle, const
 
     log_info("TTS.Component", "Synthesizing text");
 
-    const rac_tts_options_t* effective_options = options ? options : &component->default_options;
-
     auto start_time = std::chrono::steady_clock::now();
 
     result = rac_tts_synthesize(service, text, effective_options, out_result);
@@ -339,28 +853,13 @@ extern "C" rac_result_t rac_tts_component_synthesize(rac_handle_t handle, const
         out_result->processing_time_ms = duration.count();
     }
 
-    // Emit SYNTHESIS_COMPLETED event
-    {
-        int32_t char_count = static_cast<int32_t>(std::strlen(text));
-        double processing_ms = static_cast<double>(out_result->processing_time_ms);
-        double chars_per_sec = processing_ms > 0 ? (char_count * 1000.0 / processing_ms) : 0.0;
-
-        rac_analytics_event_data_t event_data;
-        event_data.data.tts_synthesis = RAC_ANALYTICS_TTS_SYNTHESIS_DEFAULT;
-        event_data.data.tts_synthesis.synthesis_id = synthesis_id.c_str();
-        event_data.data.tts_synthesis.model_id = voice_id;
-        event_data.data.tts_synthesis.model_name = voice_name;
-        event_data.data.tts_synthesis.character_count = char_count;
-        event_data.data.tts_synthesis.audio_duration_ms =
-            static_cast<double>(out_result->duration_ms);
-        event_data.data.tts_synthesis.audio_size_bytes =
-            static_cast<int32_t>(out_result->audio_size);
-        event_data.data.tts_synthesis.processing_duration_ms = processing_ms;
-        event_data.data.tts_synthesis.characters_per_second = chars_per_sec;
-        event_data.data.tts_synthesis.sample_rate = static_cast<int32_t>(out_result->sample_rate);
-        rac_analytics_event_emit(RAC_EVENT_TTS_SYNTHESIS_COMPLETED, &event_data);
+    if (!cache_key.empty()) {
+        cache_store(cache, cache_key, out_result);
     }
 
+    // Emit SYNTHESIS_COMPLETED event
+    emit_synthesis_completed(synthesis_id, voice_id, voice_name, text, out_result, false);
+
     log_info("TTS.Component", "Synthesis completed");
 
     return RAC_SUCCESS;
@@ -417,7 +916,9 @@ extern "C" rac_result_t rac_tts_component_synthesize_stream(rac_handle_t handle,
 
     auto start_time = std::chrono::steady_clock::now();
 
-    result = rac_tts_synthesize_stream(service, text, effective_options, callback, user_data);
+    tts_stream_context stream_ctx = {callback, user_data, start_time, 0.0, 0};
+    result = rac_tts_synthesize_stream(service, text, effective_options, tts_stream_forward,
+                                       &stream_ctx);
 
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -447,9 +948,15 @@ extern "C" rac_result_t rac_tts_component_synthesize_stream(rac_handle_t handle,
         event_data.data.tts_synthesis.model_id = voice_id;
         event_data.data.tts_synthesis.model_name = voice_name;
         event_data.data.tts_synthesis.character_count = char_count;
+        event_data.data.tts_synthesis.audio_size_bytes =
+            static_cast<int32_t>(stream_ctx.audio_bytes);
         event_data.data.tts_synthesis.processing_duration_ms = processing_ms;
         event_data.data.tts_synthesis.characters_per_second = chars_per_sec;
+        event_data.data.tts_synthesis.time_to_first_audio_ms = stream_ctx.time_to_first_audio_ms;
         rac_analytics_event_emit(RAC_EVENT_TTS_SYNTHESIS_COMPLETED, &event_data);
+
+        log_info("TTS.Component", "Streaming synthesis completed (first audio after %.0fms)",
+                 stream_ctx.time_to_first_audio_ms);
     }
 
     return result;
@@ -467,6 +974,77 @@ extern "C" rac_lifecycle_state_t rac_tts_component_get_state(rac_handle_t handle
     return rac_lifecycle_get_state(component->lifecycle);
 }
 
+extern "C" rac_result_t rac_tts_component_configure_cache(rac_handle_t handle,
+                                                          const rac_tts_cache_config_t* config) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!config || config->max_bytes < 0 || config->max_entry_bytes < 0)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* component = reinterpret_cast<rac_tts_component*>(handle);
+    std::lock_guard<std::mutex> lock(component->mtx);
+
+    tts_audio_cache& cache = component->cache;
+    cache.max_bytes = static_cast<size_t>(config->max_bytes);
+    cache.max_entry_bytes = config->max_entry_bytes > 0
+                                ? static_cast<size_t>(config->max_entry_bytes)
+                                : cache.max_bytes / 8;
+    const std::string persist_directory =
+        config->persist_directory ? config->persist_directory : "";
+    if (cache.max_bytes == 0) {
+        cache_clear(cache);
+    } else {
+        cache_evict(cache, cache.max_bytes);
+    }
+
+    // The persisted files share the byte budget; a disabled cache leaves them alone
+    if (persist_directory != cache.persist_directory) {
+        cache.persist_directory = persist_directory;
+        cache.disk_index_loaded = false;
+    }
+    if (cache.max_bytes > 0) {
+        if (!cache.disk_index_loaded) {
+            disk_load_index(cache);
+        } else if (disk_prune(cache, cache.max_bytes)) {
+            disk_save_index(cache);
+        }
+    }
+
+    log_info("TTS.Component", "Audio cache configured: %" PRId64 " bytes%s", config->max_bytes,
+             cache.persist_directory.empty() ? "" : " (persistent)");
+
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_tts_component_get_cache_stats(rac_handle_t handle,
+                                                          rac_tts_cache_stats_t* out_stats) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_stats)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* component = reinterpret_cast<rac_tts_component*>(handle);
+    std::lock_guard<std::mutex> lock(component->mtx);
+
+    *out_stats = component->cache.stats;
+    out_stats->entry_count = static_cast<int32_t>(component->cache.entries.size());
+    out_stats->bytes = static_cast<int64_t>(component->cache.bytes);
+    out_stats->disk_entry_count = static_cast<int32_t>(component->cache.disk_entries.size());
+    out_stats->disk_bytes = static_cast<int64_t>(component->cache.disk_bytes);
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_tts_component_clear_cache(rac_handle_t handle) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+
+    auto* component = reinterpret_cast<rac_tts_component*>(handle);
+    std::lock_guard<std::mutex> lock(component->mtx);
+
+    cache_clear(component->cache);
+    return RAC_SUCCESS;
+}
+
 extern "C" rac_result_t rac_tts_component_get_metrics(rac_handle_t handle,
                                                       rac_lifecycle_metrics_t* out_metrics) {
     if (!handle)
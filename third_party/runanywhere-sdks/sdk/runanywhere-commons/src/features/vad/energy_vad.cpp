@@ -16,15 +16,33 @@
 #include <string>
 #include <vector>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #include "rac/core/rac_logger.h"
 #include "rac/core/rac_platform_adapter.h"
 #include "rac/core/rac_structured_error.h"
 #include "rac/features/vad/rac_vad_energy.h"
 
+#include "p2_quantile.h"
+#include "vad_event_dispatcher.h"
+
 // =============================================================================
 // INTERNAL STRUCTURE - Mirrors Swift's SimpleEnergyVADService properties
 // =============================================================================
 
+/** Frames per noise-floor tracking window (~10 seconds at 100ms) */
+static constexpr int32_t kNoiseWindowFrames = 100;
+
+/** Weight given to each new window when updating the ambient level */
+static constexpr float kNoiseWindowWeight = 0.3f;
+
+/** Low quantile used while tracking; speech rarely pushes it up */
+static constexpr float kNoiseFloorQuantile = 0.2f;
+
 struct rac_energy_vad {
     // Configuration
     int32_t sample_rate;
@@ -50,19 +68,26 @@ struct rac_energy_vad {
 
     // Calibration (mirrors Swift calibration properties)
     bool is_calibrating;
-    std::vector<float> calibration_samples;
+    p2_quantile calibration_p90;
+    p2_quantile calibration_floor;
     int32_t calibration_frame_count;
     int32_t calibration_frames_needed;
     float ambient_noise_level;
 
+    // Continuous noise-floor tracking after calibration
+    bool noise_tracking_enabled;
+    bool is_calibrated;             // cleared when the threshold is set manually
+    float noise_spread;             // calibrated 90th / 20th percentile ratio
+    p2_quantile noise_window;
+    int32_t noise_window_frames;
+
     // Debug statistics (mirrors Swift debug properties)
     std::vector<float> recent_energy_values;
     int32_t max_recent_values;
     int32_t debug_frame_count;
 
-    // Callbacks
-    rac_speech_activity_callback_fn speech_callback;
-    void* speech_user_data;
+    // Callbacks; speech events are delivered on the dispatcher's thread
+    vad_event_dispatcher* speech_events;
     rac_audio_buffer_callback_fn audio_callback;
     void* audio_user_data;
 
@@ -74,6 +99,102 @@ struct rac_energy_vad {
 // HELPER FUNCTIONS - Mirrors Swift's private methods
 // =============================================================================
 
+/**
+ * Sum of squares, four lanes at a time (the vDSP_rmsqv equivalent)
+ */
+static float sum_of_squares(const float* samples, size_t count) {
+    size_t i = 0;
+    float sum = 0.0f;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vld1q_f32(samples + i);
+        float32x4_t b = vld1q_f32(samples + i + 4);
+        acc0 = vmlaq_f32(acc0, a, a);
+        acc1 = vmlaq_f32(acc1, b, b);
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t half = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(half, half), 0);
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_loadu_ps(samples + i);
+        __m128 b = _mm_loadu_ps(samples + i + 4);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+    for (; i < count; ++i) {
+        sum += samples[i] * samples[i];
+    }
+    return sum;
+}
+
+/**
+ * Derive the energy threshold from the ambient noise level
+ * Mirrors the threshold math in Swift's completeCalibration()
+ * Returns true if the threshold hit the cap
+ */
+static bool apply_ambient_noise_level(rac_energy_vad* vad) {
+    // Calculate dynamic threshold (mirrors Swift logic)
+    float minimum_threshold = std::max(vad->ambient_noise_level * 2.0f, RAC_VAD_MIN_THRESHOLD);
+    float calculated_threshold = vad->ambient_noise_level * vad->calibration_multiplier;
+
+    // Apply threshold with sensible bounds
+    vad->energy_threshold = std::max(calculated_threshold, minimum_threshold);
+
+    // Cap at reasonable maximum (mirrors Swift cap)
+    bool capped = vad->energy_threshold > RAC_VAD_MAX_THRESHOLD;
+    if (capped) {
+        vad->energy_threshold = RAC_VAD_MAX_THRESHOLD;
+    }
+    vad->base_energy_threshold = vad->energy_threshold;
+    return capped;
+}
+
+static void begin_calibration(rac_energy_vad* vad) {
+    vad->is_calibrating = true;
+    p2_reset(&vad->calibration_p90, 0.90f);
+    p2_reset(&vad->calibration_floor, kNoiseFloorQuantile);
+    vad->calibration_frame_count = 0;
+}
+
+/**
+ * Follow the room's noise level after calibration. Every window of frames
+ * estimates a low quantile of the energy (pauses between words keep speech
+ * from raising it), scales it by the calibrated spread to an equivalent
+ * 90th percentile, and blends that into the ambient level.
+ */
+static void track_noise_floor(rac_energy_vad* vad, float energy) {
+    if (!vad->noise_tracking_enabled || !vad->is_calibrated) {
+        return;
+    }
+
+    p2_add(&vad->noise_window, energy);
+    if (++vad->noise_window_frames < kNoiseWindowFrames) {
+        return;
+    }
+
+    float window_ambient = p2_value(&vad->noise_window) * vad->noise_spread;
+    vad->ambient_noise_level = (1.0f - kNoiseWindowWeight) * vad->ambient_noise_level +
+                               kNoiseWindowWeight * window_ambient;
+    apply_ambient_noise_level(vad);
+
+    RAC_LOG_DEBUG("EnergyVAD", "Noise floor updated: ambient=%.5f threshold=%.5f",
+                  vad->ambient_noise_level, vad->energy_threshold);
+
+    p2_reset(&vad->noise_window, kNoiseFloorQuantile);
+    vad->noise_window_frames = 0;
+}
+
 /**
  * Update voice activity state with hysteresis
  * Mirrors Swift's updateVoiceActivityState(hasVoice:)
@@ -101,10 +222,7 @@ static void update_voice_activity_state(rac_energy_vad* vad, bool has_voice) {
             vad->is_currently_speaking = true;
             RAC_LOG_INFO("EnergyVAD", "VAD: SPEECH STARTED");
 
-            // Fire callback
-            if (vad->speech_callback) {
-                vad->speech_callback(RAC_SPEECH_ACTIVITY_STARTED, vad->speech_user_data);
-            }
+            vad_event_dispatcher_post(vad->speech_events, RAC_SPEECH_ACTIVITY_STARTED);
         }
     } else {
         vad->consecutive_silent_frames++;
@@ -115,10 +233,7 @@ static void update_voice_activity_state(rac_energy_vad* vad, bool has_voice) {
             vad->is_currently_speaking = false;
             RAC_LOG_INFO("EnergyVAD", "VAD: SPEECH ENDED");
 
-            // Fire callback
-            if (vad->speech_callback) {
-                vad->speech_callback(RAC_SPEECH_ACTIVITY_ENDED, vad->speech_user_data);
-            }
+            vad_event_dispatcher_post(vad->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
         }
     }
 }
@@ -132,37 +247,20 @@ static void handle_calibration_frame(rac_energy_vad* vad, float energy) {
         return;
     }
 
-    vad->calibration_samples.push_back(energy);
+    p2_add(&vad->calibration_p90, energy);
+    p2_add(&vad->calibration_floor, energy);
     vad->calibration_frame_count++;
 
     if (vad->calibration_frame_count >= vad->calibration_frames_needed) {
         // Complete calibration - mirrors Swift's completeCalibration()
-        if (vad->calibration_samples.empty()) {
-            vad->is_calibrating = false;
-            return;
-        }
-
-        // Calculate statistics (mirrors Swift logic)
-        std::vector<float> sorted_samples = vad->calibration_samples;
-        std::sort(sorted_samples.begin(), sorted_samples.end());
-
-        size_t count = sorted_samples.size();
-        float percentile_90 =
-            sorted_samples[std::min(count - 1, static_cast<size_t>(count * 0.90f))];
+        float percentile_90 = p2_value(&vad->calibration_p90);
+        float floor = p2_value(&vad->calibration_floor);
 
         // Use 90th percentile as ambient noise level (mirrors Swift)
         vad->ambient_noise_level = percentile_90;
+        vad->noise_spread = floor > 0.0f ? std::min(percentile_90 / floor, 10.0f) : 1.0f;
 
-        // Calculate dynamic threshold (mirrors Swift logic)
-        float minimum_threshold = std::max(vad->ambient_noise_level * 2.0f, RAC_VAD_MIN_THRESHOLD);
-        float calculated_threshold = vad->ambient_noise_level * vad->calibration_multiplier;
-
-        // Apply threshold with sensible bounds
-        vad->energy_threshold = std::max(calculated_threshold, minimum_threshold);
-
-        // Cap at reasonable maximum (mirrors Swift cap)
-        if (vad->energy_threshold > RAC_VAD_MAX_THRESHOLD) {
-            vad->energy_threshold = RAC_VAD_MAX_THRESHOLD;
+        if (apply_ambient_noise_level(vad)) {
             RAC_LOG_WARNING("EnergyVAD",
                             "Calibration detected high ambient noise. Capping threshold.");
         }
@@ -170,7 +268,9 @@ static void handle_calibration_frame(rac_energy_vad* vad, float energy) {
         RAC_LOG_INFO("EnergyVAD", "VAD Calibration Complete");
 
         vad->is_calibrating = false;
-        vad->calibration_samples.clear();
+        vad->is_calibrated = true;
+        p2_reset(&vad->noise_window, kNoiseFloorQuantile);
+        vad->noise_window_frames = 0;
     }
 }
 
@@ -224,17 +324,25 @@ rac_result_t rac_energy_vad_create(const rac_energy_vad_config_t* config,
 
     // Calibration (mirrors Swift defaults)
     vad->is_calibrating = false;
+    p2_reset(&vad->calibration_p90, 0.90f);
+    p2_reset(&vad->calibration_floor, kNoiseFloorQuantile);
     vad->calibration_frame_count = 0;
     vad->calibration_frames_needed = RAC_VAD_CALIBRATION_FRAMES_NEEDED;
     vad->ambient_noise_level = 0.0f;
 
+    // Noise-floor tracking
+    vad->noise_tracking_enabled = cfg->disable_noise_tracking == RAC_FALSE;
+    vad->is_calibrated = false;
+    vad->noise_spread = 1.0f;
+    p2_reset(&vad->noise_window, kNoiseFloorQuantile);
+    vad->noise_window_frames = 0;
+
     // Debug (mirrors Swift defaults)
     vad->max_recent_values = RAC_VAD_MAX_RECENT_VALUES;
     vad->debug_frame_count = 0;
 
     // Callbacks
-    vad->speech_callback = nullptr;
-    vad->speech_user_data = nullptr;
+    vad->speech_events = vad_event_dispatcher_create("EnergyVAD");
     vad->audio_callback = nullptr;
     vad->audio_user_data = nullptr;
 
@@ -249,6 +357,7 @@ void rac_energy_vad_destroy(rac_energy_vad_handle_t handle) {
         return;
     }
 
+    vad_event_dispatcher_destroy(handle->speech_events);
     delete handle;
     RAC_LOG_DEBUG("EnergyVAD", "SimpleEnergyVADService destroyed");
 }
@@ -269,9 +378,7 @@ rac_result_t rac_energy_vad_initialize(rac_energy_vad_handle_t handle) {
     // Start calibration (mirrors Swift's startCalibration)
     RAC_LOG_INFO("EnergyVAD", "Starting VAD calibration - measuring ambient noise");
 
-    handle->is_calibrating = true;
-    handle->calibration_samples.clear();
-    handle->calibration_frame_count = 0;
+    begin_calibration(handle);
 
     return RAC_SUCCESS;
 }
@@ -314,9 +421,7 @@ rac_result_t rac_energy_vad_stop(rac_energy_vad_handle_t handle) {
         handle->is_currently_speaking = false;
         RAC_LOG_INFO("EnergyVAD", "VAD: SPEECH ENDED (stopped)");
 
-        if (handle->speech_callback) {
-            handle->speech_callback(RAC_SPEECH_ACTIVITY_ENDED, handle->speech_user_data);
-        }
+        vad_event_dispatcher_post(handle->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
     }
 
     handle->is_active = false;
@@ -349,7 +454,7 @@ rac_result_t rac_energy_vad_process_audio(rac_energy_vad_handle_t handle, const
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
+    std::unique_lock<std::mutex> lock(handle->mutex);
 
     // Mirrors Swift's processAudioData(_:)
     if (!handle->is_active) {
@@ -385,14 +490,21 @@ rac_result_t rac_energy_vad_process_audio(rac_energy_vad_handle_t handle, const
         return RAC_SUCCESS;
     }
 
+    track_noise_floor(handle, energy);
+
     bool has_voice = energy > handle->energy_threshold;
 
     // Update state (mirrors Swift's updateVoiceActivityState)
     update_voice_activity_state(handle, has_voice);
 
-    // Call audio buffer callback if provided
-    if (handle->audio_callback) {
-        handle->audio_callback(audio_data, sample_count * sizeof(float), handle->audio_user_data);
+    // Call audio buffer callback if provided, outside the lock so a slow
+    // consumer cannot hold up the next capture buffer
+    rac_audio_buffer_callback_fn audio_callback = handle->audio_callback;
+    void* audio_user_data = handle->audio_user_data;
+    lock.unlock();
+
+    if (audio_callback) {
+        audio_callback(audio_data, sample_count * sizeof(float), audio_user_data);
     }
 
     if (out_has_voice) {
@@ -409,13 +521,85 @@ float rac_energy_vad_calculate_rms(const float* audio_data, size_t sample_count)
 
     // RMS calculation: sqrt(sum(x^2) / N)
     // Mirrors Swift's calculateAverageEnergy using vDSP_rmsqv
-    float sum_squares = 0.0f;
-    for (size_t i = 0; i < sample_count; ++i) {
-        sum_squares += audio_data[i] * audio_data[i];
-    }
+    float sum_squares = sum_of_squares(audio_data, sample_count);
     return std::sqrt(sum_squares / static_cast<float>(sample_count));
 }
 
+rac_result_t rac_energy_vad_process_frames(rac_energy_vad_handle_t handle, const float* audio_data,
+                                           size_t sample_count,
+                                           rac_energy_vad_frame_output_t* output) {
+    if (!handle || !audio_data || !output) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    output->frame_count = 0;
+    output->boundary_count = 0;
+    output->samples_consumed = 0;
+
+    std::unique_lock<std::mutex> lock(handle->mutex);
+
+    if (handle->frame_length_samples <= 0) {
+        return RAC_ERROR_INVALID_STATE;
+    }
+    const size_t frame_length = static_cast<size_t>(handle->frame_length_samples);
+
+    // Same gating as processAudioData(_:): every frame is silence
+    const bool blocked = !handle->is_active || handle->is_tts_active || handle->is_paused;
+
+    size_t offset = 0;
+    while (offset + frame_length <= sample_count) {
+        if (output->frame_decisions && output->frame_count >= output->frame_capacity) {
+            break;
+        }
+        if (output->boundaries && output->boundary_count >= output->boundary_capacity) {
+            break;
+        }
+
+        bool has_voice = false;
+        if (!blocked) {
+            float energy = std::sqrt(sum_of_squares(audio_data + offset, frame_length) /
+                                     static_cast<float>(frame_length));
+            update_debug_statistics(handle, energy);
+
+            if (handle->is_calibrating) {
+                handle_calibration_frame(handle, energy);
+            } else {
+                track_noise_floor(handle, energy);
+                has_voice = energy > handle->energy_threshold;
+
+                const bool was_speaking = handle->is_currently_speaking;
+                update_voice_activity_state(handle, has_voice);
+
+                if (handle->is_currently_speaking != was_speaking && output->boundaries) {
+                    rac_energy_vad_boundary_t& boundary =
+                        output->boundaries[output->boundary_count++];
+                    boundary.event = handle->is_currently_speaking ? RAC_SPEECH_ACTIVITY_STARTED
+                                                                   : RAC_SPEECH_ACTIVITY_ENDED;
+                    boundary.sample_offset = offset;
+                }
+            }
+        }
+
+        if (output->frame_decisions) {
+            output->frame_decisions[output->frame_count] = has_voice ? RAC_TRUE : RAC_FALSE;
+        }
+        output->frame_count++;
+        offset += frame_length;
+    }
+
+    output->samples_consumed = offset;
+
+    rac_audio_buffer_callback_fn audio_callback = handle->audio_callback;
+    void* audio_user_data = handle->audio_user_data;
+    lock.unlock();
+
+    if (!blocked && offset > 0 && audio_callback) {
+        audio_callback(audio_data, offset * sizeof(float), audio_user_data);
+    }
+
+    return RAC_SUCCESS;
+}
+
 rac_result_t rac_energy_vad_pause(rac_energy_vad_handle_t handle) {
     if (!handle) {
         return RAC_ERROR_INVALID_ARGUMENT;
@@ -434,9 +618,7 @@ rac_result_t rac_energy_vad_pause(rac_energy_vad_handle_t handle) {
     // If currently speaking, send end event
     if (handle->is_currently_speaking) {
         handle->is_currently_speaking = false;
-        if (handle->speech_callback) {
-            handle->speech_callback(RAC_SPEECH_ACTIVITY_ENDED, handle->speech_user_data);
-        }
+        vad_event_dispatcher_post(handle->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
     }
 
     // Clear recent energy values
@@ -481,9 +663,7 @@ rac_result_t rac_energy_vad_start_calibration(rac_energy_vad_handle_t handle) {
 
     RAC_LOG_INFO("EnergyVAD", "Starting VAD calibration");
 
-    handle->is_calibrating = true;
-    handle->calibration_samples.clear();
-    handle->calibration_frame_count = 0;
+    begin_calibration(handle);
 
     return RAC_SUCCESS;
 }
@@ -536,9 +716,7 @@ rac_result_t rac_energy_vad_notify_tts_start(rac_energy_vad_handle_t handle) {
     // End any current speech detection
     if (handle->is_currently_speaking) {
         handle->is_currently_speaking = false;
-        if (handle->speech_callback) {
-            handle->speech_callback(RAC_SPEECH_ACTIVITY_ENDED, handle->speech_user_data);
-        }
+        vad_event_dispatcher_post(handle->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
     }
 
     // Reset counters
@@ -620,6 +798,9 @@ rac_result_t rac_energy_vad_set_threshold(rac_energy_vad_handle_t handle, float
     handle->energy_threshold = threshold;
     handle->base_energy_threshold = threshold;
 
+    // A manual threshold holds until the next calibration
+    handle->is_calibrated = false;
+
     return RAC_SUCCESS;
 }
 
@@ -687,8 +868,7 @@ rac_result_t rac_energy_vad_set_speech_callback(rac_energy_vad_handle_t handle,
 
     std::lock_guard<std::mutex> lock(handle->mutex);
 
-    handle->speech_callback = callback;
-    handle->speech_user_data = user_data;
+    vad_event_dispatcher_set_callback(handle->speech_events, callback, user_data);
 
     return RAC_SUCCESS;
 }
@@ -0,0 +1,110 @@
+#ifndef RAC_P2_QUANTILE_H
+#define RAC_P2_QUANTILE_H
+
+/**
+ * P-square streaming quantile estimator (Jain & Chlamtac, 1985)
+ *
+ * Tracks one quantile with five markers whose heights are adjusted by
+ * piecewise-parabolic interpolation as observations arrive: O(1) work per
+ * observation and no sample storage. Used by the energy VAD for its
+ * calibration percentiles and noise-floor tracking.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+struct p2_quantile {
+    float p;
+    int32_t count;
+    float heights[5];
+    float positions[5];
+    float desired[5];
+    float increments[5];
+};
+
+inline void p2_reset(p2_quantile* q, float p) {
+    q->p = p;
+    q->count = 0;
+}
+
+inline void p2_add(p2_quantile* q, float x) {
+    if (q->count < 5) {
+        q->heights[q->count++] = x;
+        if (q->count == 5) {
+            std::sort(q->heights, q->heights + 5);
+            const float p = q->p;
+            const float desired[5] = {0.0f, 2.0f * p, 4.0f * p, 2.0f + 2.0f * p, 4.0f};
+            const float increments[5] = {0.0f, p / 2.0f, p, (1.0f + p) / 2.0f, 1.0f};
+            for (int i = 0; i < 5; ++i) {
+                q->positions[i] = static_cast<float>(i);
+                q->desired[i] = desired[i];
+                q->increments[i] = increments[i];
+            }
+        }
+        return;
+    }
+
+    // Find the cell holding x, extending the extremes if needed
+    int k;
+    if (x < q->heights[0]) {
+        q->heights[0] = x;
+        k = 0;
+    } else if (x >= q->heights[4]) {
+        q->heights[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && x >= q->heights[k + 1]) {
+            ++k;
+        }
+    }
+    q->count++;
+    for (int i = k + 1; i < 5; ++i) {
+        q->positions[i] += 1.0f;
+    }
+    for (int i = 0; i < 5; ++i) {
+        q->desired[i] += q->increments[i];
+    }
+
+    // Move the middle markers toward their desired positions
+    float* h = q->heights;
+    float* n = q->positions;
+    for (int i = 1; i < 4; ++i) {
+        float d = q->desired[i] - n[i];
+        if ((d >= 1.0f && n[i + 1] - n[i] > 1.0f) || (d <= -1.0f && n[i - 1] - n[i] < -1.0f)) {
+            float sign = d > 0.0f ? 1.0f : -1.0f;
+            float parabolic =
+                h[i] + sign / (n[i + 1] - n[i - 1]) *
+                           ((n[i] - n[i - 1] + sign) * (h[i + 1] - h[i]) / (n[i + 1] - n[i]) +
+                            (n[i + 1] - n[i] - sign) * (h[i] - h[i - 1]) / (n[i] - n[i - 1]));
+            if (h[i - 1] < parabolic && parabolic < h[i + 1]) {
+                h[i] = parabolic;
+            } else {
+                int j = i + static_cast<int>(sign);
+                h[i] += sign * (h[j] - h[i]) / (n[j] - n[i]);
+            }
+            n[i] += sign;
+        }
+    }
+}
+
+/**
+ * Current estimate; exact while fewer than five observations have been added
+ */
+inline float p2_value(const p2_quantile* q) {
+    if (q->count == 0) {
+        return 0.0f;
+    }
+    if (q->count >= 5) {
+        return q->heights[2];
+    }
+    // Too few observations for the markers; use the exact percentile
+    float sorted[5];
+    std::copy(q->heights, q->heights + q->count, sorted);
+    std::sort(sorted, sorted + q->count);
+    size_t count = static_cast<size_t>(q->count);
+    return sorted[std::min(count - 1, static_cast<size_t>(count * q->p))];
+}
+
+#endif  // RAC_P2_QUANTILE_H
@@ -0,0 +1,489 @@
+/**
+ * @file spectral_vad.cpp
+ * @brief RunAnywhere Commons - Spectral VAD Service Implementation
+ *
+ * Each frame is split into half-overlapping Hann windows, and their power
+ * spectra are averaged (Welch) before the band ratio and flatness are
+ * measured. The FFT is a radix-2 transform over split real/imaginary
+ * arrays, so the butterfly loops run over contiguous memory and vectorize.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+#include "rac/features/vad/rac_vad_spectral.h"
+
+#include "vad_event_dispatcher.h"
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+/** Analysis window length; rounded up to a power of two */
+static constexpr float kWindowSeconds = 0.025f;
+
+/** Speech band edges */
+static constexpr float kSpeechBandLowHz = 200.0f;
+static constexpr float kSpeechBandHighHz = 4000.0f;
+
+/** Below this the spectrum is mostly DC offset and rumble */
+static constexpr float kSpectrumLowHz = 80.0f;
+
+static constexpr float kPowerFloor = 1e-12f;
+static constexpr float kPi = 3.14159265358979323846f;
+
+// =============================================================================
+// INTERNAL STRUCTURE
+// =============================================================================
+
+struct rac_spectral_vad {
+    // Configuration
+    rac_spectral_vad_config_t config;
+    int32_t frame_length_samples;
+    int32_t start_frames;
+    int32_t end_frames;
+
+    // FFT tables and scratch, sized once at create
+    size_t fft_size;
+    std::vector<size_t> bit_reverse;
+    std::vector<float> twiddle_re;
+    std::vector<float> twiddle_im;
+    std::vector<float> window;
+    std::vector<float> re;
+    std::vector<float> im;
+    std::vector<float> power;
+    size_t band_low_bin;
+    size_t band_high_bin;
+    size_t spectrum_low_bin;
+
+    // Partial frame carried between calls
+    std::vector<float> pending;
+
+    // State
+    bool is_active;
+    bool is_currently_speaking;
+    int32_t consecutive_speech_frames;
+    int32_t consecutive_silent_frames;
+    rac_spectral_vad_features_t last_features;
+
+    // Speech events, delivered on the dispatcher's thread
+    vad_event_dispatcher* speech_events;
+
+    // Thread safety
+    std::mutex mutex;
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static void build_fft_tables(rac_spectral_vad* vad, size_t n) {
+    vad->fft_size = n;
+
+    size_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) < n) {
+        ++bits;
+    }
+    vad->bit_reverse.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t reversed = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        vad->bit_reverse[i] = reversed;
+    }
+
+    vad->twiddle_re.resize(n / 2);
+    vad->twiddle_im.resize(n / 2);
+    for (size_t k = 0; k < n / 2; ++k) {
+        float angle = -2.0f * kPi * static_cast<float>(k) / static_cast<float>(n);
+        vad->twiddle_re[k] = std::cos(angle);
+        vad->twiddle_im[k] = std::sin(angle);
+    }
+
+    vad->window.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        vad->window[i] =
+            0.5f - 0.5f * std::cos(2.0f * kPi * static_cast<float>(i) / static_cast<float>(n));
+    }
+
+    vad->re.resize(n);
+    vad->im.resize(n);
+    vad->power.resize(n / 2 + 1);
+}
+
+/**
+ * In-place radix-2 FFT of vad->re / vad->im (already bit-reversed)
+ */
+static void fft(rac_spectral_vad* vad) {
+    const size_t n = vad->fft_size;
+    float* re = vad->re.data();
+    float* im = vad->im.data();
+    const float* tw_re = vad->twiddle_re.data();
+    const float* tw_im = vad->twiddle_im.data();
+
+    for (size_t half = 1; half < n; half <<= 1) {
+        const size_t stride = n / (half * 2);
+        for (size_t start = 0; start < n; start += half * 2) {
+            float* a_re = re + start;
+            float* a_im = im + start;
+            float* b_re = a_re + half;
+            float* b_im = a_im + half;
+            for (size_t j = 0; j < half; ++j) {
+                const float w_re = tw_re[j * stride];
+                const float w_im = tw_im[j * stride];
+                const float t_re = b_re[j] * w_re - b_im[j] * w_im;
+                const float t_im = b_re[j] * w_im + b_im[j] * w_re;
+                b_re[j] = a_re[j] - t_re;
+                b_im[j] = a_im[j] - t_im;
+                a_re[j] += t_re;
+                a_im[j] += t_im;
+            }
+        }
+    }
+}
+
+/**
+ * Accumulate the windowed power spectrum of `count` samples (zero-padded)
+ */
+static void accumulate_power(rac_spectral_vad* vad, const float* samples, size_t count) {
+    const size_t n = vad->fft_size;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t src = vad->bit_reverse[i];
+        vad->re[i] = src < count ? samples[src] * vad->window[src] : 0.0f;
+        vad->im[i] = 0.0f;
+    }
+    fft(vad);
+    for (size_t k = 0; k <= n / 2; ++k) {
+        vad->power[k] += vad->re[k] * vad->re[k] + vad->im[k] * vad->im[k];
+    }
+}
+
+static void analyze_frame(rac_spectral_vad* vad, const float* frame, size_t length,
+                          rac_spectral_vad_features_t* out) {
+    // Time-domain features
+    float sum_squares = 0.0f;
+    size_t crossings = 0;
+    for (size_t i = 0; i < length; ++i) {
+        sum_squares += frame[i] * frame[i];
+    }
+    for (size_t i = 1; i < length; ++i) {
+        crossings += (frame[i - 1] >= 0.0f) != (frame[i] >= 0.0f) ? 1 : 0;
+    }
+    out->energy = std::sqrt(sum_squares / static_cast<float>(length));
+    out->zero_crossing_rate =
+        length > 1 ? static_cast<float>(crossings) / static_cast<float>(length - 1) : 0.0f;
+
+    // Welch-averaged power spectrum
+    std::fill(vad->power.begin(), vad->power.end(), 0.0f);
+    const size_t n = vad->fft_size;
+    const size_t hop = n / 2;
+    if (length <= n) {
+        accumulate_power(vad, frame, length);
+    } else {
+        for (size_t offset = 0; offset + n <= length; offset += hop) {
+            accumulate_power(vad, frame + offset, n);
+        }
+    }
+
+    float total = 0.0f;
+    for (size_t k = vad->spectrum_low_bin; k <= n / 2; ++k) {
+        total += vad->power[k];
+    }
+
+    float band = 0.0f;
+    float log_sum = 0.0f;
+    for (size_t k = vad->band_low_bin; k <= vad->band_high_bin; ++k) {
+        band += vad->power[k];
+        log_sum += std::log(vad->power[k] + kPowerFloor);
+    }
+    const float bins = static_cast<float>(vad->band_high_bin - vad->band_low_bin + 1);
+
+    out->band_ratio = total > kPowerFloor ? band / total : 0.0f;
+    out->flatness =
+        band > kPowerFloor ? std::exp(log_sum / bins) / (band / bins + kPowerFloor) : 1.0f;
+
+    const rac_spectral_vad_config_t& cfg = vad->config;
+    const bool is_speech = out->energy > cfg.energy_threshold &&
+                           out->band_ratio >= cfg.min_band_ratio &&
+                           out->flatness <= cfg.max_flatness &&
+                           out->zero_crossing_rate <= cfg.max_zero_crossing_rate;
+    out->is_speech_frame = is_speech ? RAC_TRUE : RAC_FALSE;
+}
+
+/**
+ * Start/end hysteresis, as in the energy VAD
+ */
+static void update_speech_state(rac_spectral_vad* vad, bool is_speech) {
+    if (is_speech) {
+        vad->consecutive_speech_frames++;
+        vad->consecutive_silent_frames = 0;
+
+        if (!vad->is_currently_speaking && vad->consecutive_speech_frames >= vad->start_frames) {
+            vad->is_currently_speaking = true;
+            RAC_LOG_INFO("SpectralVAD", "VAD: SPEECH STARTED");
+            vad_event_dispatcher_post(vad->speech_events, RAC_SPEECH_ACTIVITY_STARTED);
+        }
+    } else {
+        vad->consecutive_silent_frames++;
+        vad->consecutive_speech_frames = 0;
+
+        if (vad->is_currently_speaking && vad->consecutive_silent_frames >= vad->end_frames) {
+            vad->is_currently_speaking = false;
+            RAC_LOG_INFO("SpectralVAD", "VAD: SPEECH ENDED");
+            vad_event_dispatcher_post(vad->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
+        }
+    }
+}
+
+static void reset_state(rac_spectral_vad* vad) {
+    vad->is_currently_speaking = false;
+    vad->consecutive_speech_frames = 0;
+    vad->consecutive_silent_frames = 0;
+    vad->pending.clear();
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+rac_result_t rac_spectral_vad_create(const rac_spectral_vad_config_t* config,
+                                     rac_spectral_vad_handle_t* out_handle) {
+    if (!out_handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const rac_spectral_vad_config_t* cfg = config ? config : &RAC_SPECTRAL_VAD_CONFIG_DEFAULT;
+
+    const int32_t frame_length_samples =
+        static_cast<int32_t>(cfg->frame_length * static_cast<float>(cfg->sample_rate));
+    if (cfg->sample_rate <= 0 || frame_length_samples <= 1) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    rac_spectral_vad* vad = new (std::nothrow) rac_spectral_vad();
+    if (!vad) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    vad->config = *cfg;
+    vad->frame_length_samples = frame_length_samples;
+
+    const float frame_ms = 1000.0f * cfg->frame_length;
+    vad->start_frames =
+        std::max(1, static_cast<int32_t>(std::ceil(cfg->speech_start_ms / frame_ms)));
+    vad->end_frames = std::max(1, static_cast<int32_t>(std::ceil(cfg->speech_end_ms / frame_ms)));
+
+    size_t n = 64;
+    while (static_cast<float>(n) < kWindowSeconds * static_cast<float>(cfg->sample_rate)) {
+        n <<= 1;
+    }
+    build_fft_tables(vad, n);
+
+    const float hz_per_bin = static_cast<float>(cfg->sample_rate) / static_cast<float>(n);
+    auto bin_for = [&](float hz) {
+        return std::min(n / 2, static_cast<size_t>(std::lround(hz / hz_per_bin)));
+    };
+    vad->spectrum_low_bin = std::max<size_t>(1, bin_for(kSpectrumLowHz));
+    vad->band_low_bin = std::max<size_t>(1, bin_for(kSpeechBandLowHz));
+    vad->band_high_bin = std::max(vad->band_low_bin, bin_for(kSpeechBandHighHz));
+
+    vad->pending.reserve(static_cast<size_t>(frame_length_samples));
+
+    vad->is_active = false;
+    reset_state(vad);
+    vad->last_features = {};
+    vad->speech_events = vad_event_dispatcher_create("SpectralVAD");
+
+    RAC_LOG_INFO("SpectralVAD", "Spectral VAD initialized (fft=%zu, frame=%d samples)", n,
+                 frame_length_samples);
+
+    *out_handle = vad;
+    return RAC_SUCCESS;
+}
+
+void rac_spectral_vad_destroy(rac_spectral_vad_handle_t handle) {
+    if (!handle) {
+        return;
+    }
+
+    vad_event_dispatcher_destroy(handle->speech_events);
+    delete handle;
+    RAC_LOG_DEBUG("SpectralVAD", "Spectral VAD destroyed");
+}
+
+rac_result_t rac_spectral_vad_start(rac_spectral_vad_handle_t handle) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (handle->is_active) {
+        return RAC_SUCCESS;
+    }
+
+    handle->is_active = true;
+    reset_state(handle);
+
+    RAC_LOG_INFO("SpectralVAD", "Spectral VAD started");
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_stop(rac_spectral_vad_handle_t handle) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (!handle->is_active) {
+        return RAC_SUCCESS;
+    }
+
+    if (handle->is_currently_speaking) {
+        RAC_LOG_INFO("SpectralVAD", "VAD: SPEECH ENDED (stopped)");
+        vad_event_dispatcher_post(handle->speech_events, RAC_SPEECH_ACTIVITY_ENDED);
+    }
+
+    handle->is_active = false;
+    reset_state(handle);
+
+    RAC_LOG_INFO("SpectralVAD", "Spectral VAD stopped");
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_reset(rac_spectral_vad_handle_t handle) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    handle->is_active = false;
+    reset_state(handle);
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_process_audio(rac_spectral_vad_handle_t handle,
+                                            const float* audio_data, size_t sample_count,
+                                            rac_bool_t* out_has_voice) {
+    if (!handle || !audio_data || sample_count == 0) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (out_has_voice) {
+        *out_has_voice = RAC_FALSE;
+    }
+    if (!handle->is_active) {
+        return RAC_SUCCESS;
+    }
+
+    const size_t frame_length = static_cast<size_t>(handle->frame_length_samples);
+    size_t offset = 0;
+
+    // Complete the frame left over from the previous call
+    if (!handle->pending.empty()) {
+        size_t take = std::min(frame_length - handle->pending.size(), sample_count);
+        handle->pending.insert(handle->pending.end(), audio_data, audio_data + take);
+        offset = take;
+        if (handle->pending.size() < frame_length) {
+            return RAC_SUCCESS;
+        }
+        analyze_frame(handle, handle->pending.data(), frame_length, &handle->last_features);
+        update_speech_state(handle, handle->last_features.is_speech_frame == RAC_TRUE);
+        handle->pending.clear();
+    }
+
+    for (; offset + frame_length <= sample_count; offset += frame_length) {
+        analyze_frame(handle, audio_data + offset, frame_length, &handle->last_features);
+        update_speech_state(handle, handle->last_features.is_speech_frame == RAC_TRUE);
+    }
+
+    handle->pending.assign(audio_data + offset, audio_data + sample_count);
+
+    if (out_has_voice) {
+        *out_has_voice = handle->last_features.is_speech_frame;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_is_speech_active(rac_spectral_vad_handle_t handle,
+                                               rac_bool_t* out_is_active) {
+    if (!handle || !out_is_active) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    *out_is_active = handle->is_currently_speaking ? RAC_TRUE : RAC_FALSE;
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_get_threshold(rac_spectral_vad_handle_t handle,
+                                            float* out_threshold) {
+    if (!handle || !out_threshold) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    *out_threshold = handle->config.energy_threshold;
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_set_threshold(rac_spectral_vad_handle_t handle, float threshold) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    handle->config.energy_threshold = threshold;
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_get_features(rac_spectral_vad_handle_t handle,
+                                           rac_spectral_vad_features_t* out_features) {
+    if (!handle || !out_features) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    *out_features = handle->last_features;
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_get_frame_length_samples(rac_spectral_vad_handle_t handle,
+                                                       int32_t* out_frame_length) {
+    if (!handle || !out_frame_length) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    *out_frame_length = handle->frame_length_samples;
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_spectral_vad_set_speech_callback(rac_spectral_vad_handle_t handle,
+                                                  rac_speech_activity_callback_fn callback,
+                                                  void* user_data) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    vad_event_dispatcher_set_callback(handle->speech_events, callback, user_data);
+
+    return RAC_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include "rac/features/vad/rac_vad_component.h"
 #include "rac/features/vad/rac_vad_energy.h"
 #include "rac/features/vad/rac_vad_service.h"
+#include "rac/features/vad/rac_vad_spectral.h"
 
 // =============================================================================
 // INTERNAL STRUCTURES
@@ -31,6 +32,9 @@ struct rac_vad_component {
     /** Energy VAD service handle */
     rac_energy_vad_handle_t vad_service;
 
+    /** Spectral VAD service handle (RAC_VAD_ENGINE_SPECTRAL) */
+    rac_spectral_vad_handle_t spectral_service;
+
     /** Configuration */
     rac_vad_config_t config;
 
@@ -50,6 +54,7 @@ struct rac_vad_component {
 
     rac_vad_component()
         : vad_service(nullptr),
+          spectral_service(nullptr),
           activity_callback(nullptr),
           activity_user_data(nullptr),
           audio_callback(nullptr),
@@ -66,13 +71,22 @@ struct rac_vad_component {
 
 /**
  * Internal speech activity callback wrapper.
- * Routes events from energy VAD to the user callback.
+ * Routes events from the VAD engine to the user callback. Runs on the
+ * engine's event dispatcher thread, not the capture thread.
  */
 static void vad_speech_activity_callback(rac_speech_activity_event_t event, void* user_data) {
     auto* component = reinterpret_cast<rac_vad_component*>(user_data);
     if (!component)
         return;
 
+    rac_vad_activity_callback_fn activity_callback;
+    void* activity_user_data;
+    {
+        std::lock_guard<std::mutex> lock(component->mtx);
+        activity_callback = component->activity_callback;
+        activity_user_data = component->activity_user_data;
+    }
+
     // Emit analytics event for speech activity
     rac_analytics_event_data_t event_data;
     event_data.data.vad = RAC_ANALYTICS_VAD_DEFAULT;
@@ -86,17 +100,44 @@ static void vad_speech_activity_callback(rac_speech_activity_event_t event, void
     }
 
     // Route to user callback
-    if (component->activity_callback) {
+    if (activity_callback) {
         rac_speech_activity_t activity{};
         if (event == RAC_SPEECH_ACTIVITY_STARTED) {
             activity = RAC_SPEECH_STARTED;
         } else {
             activity = RAC_SPEECH_ENDED;
         }
-        component->activity_callback(activity, component->activity_user_data);
+        activity_callback(activity, activity_user_data);
     }
 }
 
+/**
+ * Create and start the spectral engine in place of the energy VAD.
+ */
+static rac_result_t initialize_spectral_service(rac_vad_component* component) {
+    rac_spectral_vad_config_t vad_config = RAC_SPECTRAL_VAD_CONFIG_DEFAULT;
+    vad_config.sample_rate = component->config.sample_rate;
+    vad_config.frame_length = component->config.frame_length;
+    vad_config.energy_threshold = component->config.energy_threshold;
+
+    rac_result_t result = rac_spectral_vad_create(&vad_config, &component->spectral_service);
+    if (result != RAC_SUCCESS) {
+        log_error("VAD.Component", "Failed to create spectral VAD service");
+        return result;
+    }
+
+    result = rac_spectral_vad_set_speech_callback(component->spectral_service,
+                                                  vad_speech_activity_callback, component);
+    if (result == RAC_SUCCESS) {
+        result = rac_spectral_vad_start(component->spectral_service);
+    }
+    if (result != RAC_SUCCESS) {
+        rac_spectral_vad_destroy(component->spectral_service);
+        component->spectral_service = nullptr;
+    }
+    return result;
+}
+
 // =============================================================================
 // LIFECYCLE API
 // =============================================================================
@@ -196,6 +237,16 @@ extern "C" rac_result_t rac_vad_component_initialize(rac_handle_t handle) {
         return RAC_SUCCESS;
     }
 
+    if (component->config.engine == RAC_VAD_ENGINE_SPECTRAL) {
+        rac_result_t result = initialize_spectral_service(component);
+        if (result != RAC_SUCCESS) {
+            return result;
+        }
+        component->is_initialized = true;
+        log_info("VAD.Component", "VAD component initialized (spectral engine)");
+        return RAC_SUCCESS;
+    }
+
     // Create energy VAD configuration
     rac_energy_vad_config_t vad_config = {};
     vad_config.sample_rate = component->config.sample_rate;
@@ -239,15 +290,28 @@ extern "C" rac_result_t rac_vad_component_cleanup(rac_handle_t handle) {
         return RAC_ERROR_INVALID_HANDLE;
 
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
-    std::lock_guard<std::mutex> lock(component->mtx);
-
-    if (component->vad_service) {
-        rac_energy_vad_stop(component->vad_service);
-        rac_energy_vad_destroy(component->vad_service);
+    rac_energy_vad_handle_t vad_service;
+    rac_spectral_vad_handle_t spectral_service;
+    {
+        std::lock_guard<std::mutex> lock(component->mtx);
+        vad_service = component->vad_service;
+        spectral_service = component->spectral_service;
         component->vad_service = nullptr;
+        component->spectral_service = nullptr;
+        component->is_initialized = false;
     }
 
-    component->is_initialized = false;
+    // Destroyed outside the lock: destroying a service delivers its pending
+    // speech events, and the activity callback wrapper takes the lock.
+    if (vad_service) {
+        rac_energy_vad_stop(vad_service);
+        rac_energy_vad_destroy(vad_service);
+    }
+
+    if (spectral_service) {
+        rac_spectral_vad_stop(spectral_service);
+        rac_spectral_vad_destroy(spectral_service);
+    }
 
     log_info("VAD.Component", "VAD component cleaned up");
 
@@ -313,11 +377,13 @@ extern "C" rac_result_t rac_vad_component_start(rac_handle_t handle) {
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
     std::lock_guard<std::mutex> lock(component->mtx);
 
-    if (!component->is_initialized || !component->vad_service) {
+    if (!component->is_initialized) {
         return RAC_ERROR_NOT_INITIALIZED;
     }
 
-    rac_result_t result = rac_energy_vad_start(component->vad_service);
+    rac_result_t result = component->spectral_service
+                              ? rac_spectral_vad_start(component->spectral_service)
+                              : rac_energy_vad_start(component->vad_service);
 
     if (result == RAC_SUCCESS) {
         // Emit VAD_STARTED event
@@ -336,11 +402,13 @@ extern "C" rac_result_t rac_vad_component_stop(rac_handle_t handle) {
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
     std::lock_guard<std::mutex> lock(component->mtx);
 
-    if (!component->vad_service) {
+    if (!component->vad_service && !component->spectral_service) {
         return RAC_SUCCESS;  // Already stopped
     }
 
-    rac_result_t result = rac_energy_vad_stop(component->vad_service);
+    rac_result_t result = component->spectral_service
+                              ? rac_spectral_vad_stop(component->spectral_service)
+                              : rac_energy_vad_stop(component->vad_service);
 
     if (result == RAC_SUCCESS) {
         // Emit VAD_STOPPED event
@@ -359,6 +427,9 @@ extern "C" rac_result_t rac_vad_component_reset(rac_handle_t handle) {
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
     std::lock_guard<std::mutex> lock(component->mtx);
 
+    if (component->spectral_service) {
+        return rac_spectral_vad_reset(component->spectral_service);
+    }
     if (!component->vad_service) {
         return RAC_ERROR_NOT_INITIALIZED;
     }
@@ -378,28 +449,37 @@ extern "C" rac_result_t rac_vad_component_process(rac_handle_t handle, const flo
         return RAC_ERROR_INVALID_ARGUMENT;
 
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
-    std::lock_guard<std::mutex> lock(component->mtx);
+    std::unique_lock<std::mutex> lock(component->mtx);
 
-    if (!component->is_initialized || !component->vad_service) {
+    if (!component->is_initialized || (!component->vad_service && !component->spectral_service)) {
         return RAC_ERROR_NOT_INITIALIZED;
     }
 
-    // Process audio through energy VAD
+    // Process audio through the configured engine
     rac_bool_t has_voice = RAC_FALSE;
     rac_result_t result =
-        rac_energy_vad_process_audio(component->vad_service, samples, num_samples, &has_voice);
+        component->spectral_service
+            ? rac_spectral_vad_process_audio(component->spectral_service, samples, num_samples,
+                                             &has_voice)
+            : rac_energy_vad_process_audio(component->vad_service, samples, num_samples,
+                                           &has_voice);
 
     if (result != RAC_SUCCESS) {
         return result;
     }
 
+    // Route audio to audio callback if set, after releasing the lock so the
+    // consumer cannot hold up the capture thread
+    rac_vad_audio_callback_fn audio_callback = component->audio_callback;
+    void* audio_user_data = component->audio_user_data;
+    lock.unlock();
+
     if (out_is_speech) {
         *out_is_speech = has_voice;
     }
 
-    // Route audio to audio callback if set
-    if (component->audio_callback && samples) {
-        component->audio_callback(samples, num_samples * sizeof(float), component->audio_user_data);
+    if (audio_callback) {
+        audio_callback(samples, num_samples * sizeof(float), audio_user_data);
     }
 
     return RAC_SUCCESS;
@@ -416,11 +496,15 @@ extern "C" rac_bool_t rac_vad_component_is_speech_active(rac_handle_t handle) {
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
     std::lock_guard<std::mutex> lock(component->mtx);
 
+    rac_bool_t is_active = RAC_FALSE;
+    if (component->spectral_service) {
+        rac_spectral_vad_is_speech_active(component->spectral_service, &is_active);
+        return is_active;
+    }
     if (!component->vad_service) {
         return RAC_FALSE;
     }
 
-    rac_bool_t is_active = RAC_FALSE;
     rac_energy_vad_is_speech_active(component->vad_service, &is_active);
     return is_active;
 }
@@ -432,11 +516,15 @@ extern "C" float rac_vad_component_get_energy_threshold(rac_handle_t handle) {
     auto* component = reinterpret_cast<rac_vad_component*>(handle);
     std::lock_guard<std::mutex> lock(component->mtx);
 
+    float threshold = 0.0f;
+    if (component->spectral_service) {
+        rac_spectral_vad_get_threshold(component->spectral_service, &threshold);
+        return threshold;
+    }
     if (!component->vad_service) {
         return component->config.energy_threshold;
     }
 
-    float threshold = 0.0f;
     rac_energy_vad_get_threshold(component->vad_service, &threshold);
     return threshold;
 }
@@ -466,6 +554,9 @@ extern "C" rac_result_t rac_vad_component_set_energy_threshold(rac_handle_t hand
 
     component->config.energy_threshold = threshold;
 
+    if (component->spectral_service) {
+        return rac_spectral_vad_set_threshold(component->spectral_service, threshold);
+    }
     if (component->vad_service) {
         return rac_energy_vad_set_threshold(component->vad_service, threshold);
     }
@@ -0,0 +1,202 @@
+/**
+ * @file vad_event_dispatcher.cpp
+ * @brief RunAnywhere Commons - VAD speech event dispatcher
+ *
+ * Bounded SPSC ring between a VAD's capture path and a thread that runs the
+ * speech activity callback. See vad_event_dispatcher.h.
+ */
+
+#include "vad_event_dispatcher.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rac/core/rac_logger.h"
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+// Transitions are at most a few per second; 64 pending means the consumer is
+// badly stuck, and dropping beats blocking capture.
+static constexpr size_t kRingCapacity = 64;
+static_assert((kRingCapacity & (kRingCapacity - 1)) == 0, "ring capacity must be a power of two");
+
+struct vad_event_entry {
+    rac_speech_activity_event_t event;
+    rac_speech_activity_callback_fn callback;
+    void* user_data;
+    uint64_t generation;
+};
+
+/**
+ * State shared with the dispatcher thread; outlives the dispatcher when the
+ * thread is released from inside its own callback
+ */
+struct vad_dispatch_state {
+    const char* name = nullptr;
+
+    std::array<vad_event_entry, kRingCapacity> ring{};
+    std::atomic<size_t> head{0};  // Next slot to read; written by the consumer
+    std::atomic<size_t> tail{0};  // Next slot to write; written by the producer
+
+    // Bumped by set_callback; entries from an older generation are skipped
+    std::atomic<uint64_t> generation{0};
+    std::atomic<uint64_t> dropped{0};
+
+    // Set by the consumer before it waits, so the producer knows to wake it
+    std::atomic<bool> sleeping{false};
+    std::atomic<bool> abandoned{false};
+
+    std::mutex wake_mtx;
+    std::condition_variable wake_cv;
+    bool wake = false;      // Guarded by wake_mtx
+    bool stopping = false;  // Guarded by wake_mtx
+};
+
+struct vad_event_dispatcher {
+    std::shared_ptr<vad_dispatch_state> state;
+    std::thread thread;
+
+    // Producer side, guarded by the owning VAD's lock
+    rac_speech_activity_callback_fn callback = nullptr;
+    void* user_data = nullptr;
+    uint64_t generation = 0;
+};
+
+// =============================================================================
+// DISPATCHER THREAD
+// =============================================================================
+
+static bool ring_empty(const vad_dispatch_state& s) {
+    return s.head.load(std::memory_order_relaxed) == s.tail.load(std::memory_order_seq_cst);
+}
+
+static bool ring_pop(vad_dispatch_state& s, vad_event_entry* out) {
+    const size_t head = s.head.load(std::memory_order_relaxed);
+    if (head == s.tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *out = s.ring[head & (kRingCapacity - 1)];
+    s.head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+static void dispatch_loop(std::shared_ptr<vad_dispatch_state> state) {
+    vad_dispatch_state& s = *state;
+    uint64_t reported_drops = 0;
+    vad_event_entry entry{};
+
+    while (!s.abandoned.load(std::memory_order_acquire)) {
+        if (ring_pop(s, &entry)) {
+            if (entry.generation == s.generation.load(std::memory_order_acquire)) {
+                entry.callback(entry.event, entry.user_data);
+            }
+            continue;
+        }
+
+        const uint64_t drops = s.dropped.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            RAC_LOG_WARNING(s.name, "Speech callback fell behind; %llu events dropped",
+                            static_cast<unsigned long long>(drops - reported_drops));
+            reported_drops = drops;
+        }
+
+        std::unique_lock<std::mutex> lock(s.wake_mtx);
+        if (s.stopping) {
+            if (ring_empty(s)) {
+                return;
+            }
+            continue;
+        }
+
+        // Pairs with the tail store / sleeping load in post(): either the
+        // producer sees sleeping and wakes us, or we see its entry here.
+        s.sleeping.store(true, std::memory_order_seq_cst);
+        if (!ring_empty(s)) {
+            s.sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        s.wake_cv.wait(lock, [&s] { return s.wake; });
+        s.wake = false;
+        s.sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// API
+// =============================================================================
+
+vad_event_dispatcher* vad_event_dispatcher_create(const char* name) {
+    auto* dispatcher = new vad_event_dispatcher();
+    dispatcher->state = std::make_shared<vad_dispatch_state>();
+    dispatcher->state->name = name;
+    return dispatcher;
+}
+
+void vad_event_dispatcher_destroy(vad_event_dispatcher* dispatcher) {
+    if (!dispatcher) {
+        return;
+    }
+
+    if (dispatcher->thread.joinable()) {
+        vad_dispatch_state& s = *dispatcher->state;
+        if (dispatcher->thread.get_id() == std::this_thread::get_id()) {
+            s.abandoned.store(true, std::memory_order_release);
+            dispatcher->thread.detach();
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(s.wake_mtx);
+                s.stopping = true;
+                s.wake = true;
+            }
+            s.wake_cv.notify_one();
+            dispatcher->thread.join();
+        }
+    }
+
+    delete dispatcher;
+}
+
+void vad_event_dispatcher_set_callback(vad_event_dispatcher* dispatcher,
+                                       rac_speech_activity_callback_fn callback, void* user_data) {
+    dispatcher->callback = callback;
+    dispatcher->user_data = user_data;
+    dispatcher->generation++;
+    dispatcher->state->generation.store(dispatcher->generation, std::memory_order_release);
+
+    if (callback && !dispatcher->thread.joinable()) {
+        dispatcher->thread = std::thread(dispatch_loop, dispatcher->state);
+    }
+}
+
+bool vad_event_dispatcher_post(vad_event_dispatcher* dispatcher,
+                               rac_speech_activity_event_t event) {
+    if (!dispatcher->callback) {
+        return true;
+    }
+
+    vad_dispatch_state& s = *dispatcher->state;
+    const size_t tail = s.tail.load(std::memory_order_relaxed);
+    if (tail - s.head.load(std::memory_order_acquire) >= kRingCapacity) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    s.ring[tail & (kRingCapacity - 1)] = {event, dispatcher->callback, dispatcher->user_data,
+                                          dispatcher->generation};
+    s.tail.store(tail + 1, std::memory_order_seq_cst);
+
+    if (s.sleeping.load(std::memory_order_seq_cst)) {
+        // Notify under the lock: once woken, the thread may run a callback
+        // that destroys the dispatcher and releases the state.
+        std::lock_guard<std::mutex> lock(s.wake_mtx);
+        s.wake = true;
+        s.wake_cv.notify_one();
+    }
+    return true;
+}
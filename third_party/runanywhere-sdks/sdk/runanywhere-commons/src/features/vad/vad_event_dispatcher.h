@@ -0,0 +1,58 @@
+#ifndef RAC_VAD_EVENT_DISPATCHER_H
+#define RAC_VAD_EVENT_DISPATCHER_H
+
+/**
+ * Speech activity event dispatch for the VAD services
+ *
+ * The VADs detect speech start/end on the capture thread while holding their
+ * handle lock. Calling the application from there lets a slow consumer (a
+ * JNI or Swift bridge) stall capture, so events are instead pushed onto a
+ * bounded single-producer/single-consumer ring and a dispatcher thread
+ * invokes the callback.
+ *
+ * Producers are serialized by the owning VAD's lock, which is all the ring
+ * needs from them. Posting is a slot write and an atomic store; the
+ * producer only touches a mutex to wake a dispatcher that has gone to sleep
+ * on an empty ring, and that mutex is never held while a callback runs. A
+ * full ring drops the event (counted and logged) rather than waiting.
+ *
+ * The dispatcher thread is started by the first non-NULL callback, so a VAD
+ * nobody listens to costs no thread.
+ */
+
+#include "rac/features/vad/rac_vad_energy.h"
+
+struct vad_event_dispatcher;
+
+/**
+ * Create a dispatcher; `name` is used in log messages and must outlive it
+ */
+vad_event_dispatcher* vad_event_dispatcher_create(const char* name);
+
+/**
+ * Deliver events already posted, then stop the dispatcher thread
+ *
+ * Called from the dispatcher's own callback, the thread is released instead
+ * and undelivered events are dropped. Must not be called with a lock the
+ * callback takes.
+ */
+void vad_event_dispatcher_destroy(vad_event_dispatcher* dispatcher);
+
+/**
+ * Replace the callback; events posted before the change are discarded
+ *
+ * Called under the owning VAD's lock.
+ */
+void vad_event_dispatcher_set_callback(vad_event_dispatcher* dispatcher,
+                                       rac_speech_activity_callback_fn callback, void* user_data);
+
+/**
+ * Queue an event for the current callback; never blocks
+ *
+ * Called under the owning VAD's lock. Returns false if the ring was full
+ * and the event was dropped.
+ */
+bool vad_event_dispatcher_post(vad_event_dispatcher* dispatcher,
+                               rac_speech_activity_event_t event);
+
+#endif  // RAC_VAD_EVENT_DISPATCHER_H
@@ -0,0 +1,511 @@
+/**
+ * @file vad_segmenter.cpp
+ * @brief RunAnywhere Commons - VAD-driven utterance segmenter
+ *
+ * The capture side (process/flush) and the transcription side (worker
+ * thread) share only the job queue and a fixed pool of PCM buffers, all
+ * allocated at create. The capture thread never allocates: when the pool
+ * runs dry it takes the buffer of a superseded queued job instead.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+#include "rac/features/stt/rac_stt_component.h"
+#include "rac/features/stt/rac_stt_service.h"
+#include "rac/features/vad/rac_vad_component.h"
+#include "rac/features/vad/rac_vad_segmenter.h"
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+using segmenter_clock = std::chrono::steady_clock;
+
+/**
+ * Buffers per segmenter: one being transcribed, one queued final, one queued
+ * partial and one spare. Queued partials are coalesced per utterance, so
+ * more only helps when the worker is whole utterances behind.
+ */
+static constexpr size_t kBufferPoolSize = 4;
+
+/**
+ * Captured audio is converted to Int16 through a scratch buffer of this many
+ * milliseconds, sized at create; longer calls are converted in slices.
+ */
+static constexpr int32_t kScratchMs = 100;
+
+struct segmenter_job {
+    std::vector<int16_t> audio;
+    bool is_final = true;
+    int64_t utterance_id = 0;
+    segmenter_clock::time_point endpoint_at;
+};
+
+struct rac_vad_segmenter {
+    rac_handle_t vad_component = nullptr;
+    rac_handle_t stt_component = nullptr;
+    rac_vad_segmenter_callback_fn callback = nullptr;
+    void* user_data = nullptr;
+
+    size_t max_utterance_samples = 0;
+    size_t partial_window_samples = 0;
+    int32_t sample_rate = 0;
+
+    // Capture side, guarded by capture_mtx
+    std::mutex capture_mtx;
+    std::vector<int16_t> pre_roll;  // ring buffer
+    size_t pre_roll_start = 0;
+    size_t pre_roll_count = 0;
+    std::vector<int16_t> utterance;  // capacity max_utterance_samples
+    size_t partial_sent = 0;         // utterance length at the last partial
+    bool in_speech = false;
+    int64_t next_utterance_id = 1;
+    std::vector<int16_t> scratch;
+
+    // Worker side, guarded by queue_mtx
+    std::mutex queue_mtx;
+    std::condition_variable queue_cv;
+    std::deque<segmenter_job> jobs;
+    std::vector<std::vector<int16_t>> free_buffers;
+    bool stopping = false;
+    rac_vad_segmenter_metrics_t metrics = {};
+    std::thread worker;
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static int64_t samples_to_ms(const rac_vad_segmenter* seg, size_t samples) {
+    return static_cast<int64_t>(samples) * 1000 / seg->sample_rate;
+}
+
+/**
+ * Take a pooled buffer, or the buffer of a queued job when the pool is dry.
+ * Queued partials are given up first; a final only yields to a newer final
+ * once the worker is a whole pool of utterances behind. Returns false, with
+ * nothing taken, when only a partial asked and no partial could be dropped.
+ * Call with queue_mtx held.
+ */
+static bool take_buffer_locked(rac_vad_segmenter* seg, bool for_final,
+                               std::vector<int16_t>* out_buffer) {
+    if (!seg->free_buffers.empty()) {
+        *out_buffer = std::move(seg->free_buffers.back());
+        seg->free_buffers.pop_back();
+        return true;
+    }
+
+    auto victim = std::find_if(seg->jobs.begin(), seg->jobs.end(),
+                               [](const segmenter_job& job) { return !job.is_final; });
+    if (victim != seg->jobs.end()) {
+        seg->metrics.dropped_partials++;
+    } else if (for_final && !seg->jobs.empty()) {
+        victim = seg->jobs.begin();
+        seg->metrics.dropped_utterances++;
+        RAC_LOG_WARNING("VAD.Segmenter", "Transcription backlog full; dropping utterance %lld",
+                        static_cast<long long>(victim->utterance_id));
+    } else {
+        if (!for_final) {
+            seg->metrics.dropped_partials++;
+        }
+        return false;
+    }
+
+    *out_buffer = std::move(victim->audio);
+    seg->jobs.erase(victim);
+    return true;
+}
+
+/**
+ * Queue a job. A newer job for the same utterance supersedes its queued
+ * partials: a partial covers everything before it, and once the final is
+ * queued no partial is worth transcribing.
+ */
+static void submit_locked(rac_vad_segmenter* seg, segmenter_job job) {
+    for (auto it = seg->jobs.begin(); it != seg->jobs.end();) {
+        if (!it->is_final && it->utterance_id == job.utterance_id) {
+            it->audio.clear();
+            seg->free_buffers.push_back(std::move(it->audio));
+            it = seg->jobs.erase(it);
+            seg->metrics.dropped_partials++;
+        } else {
+            ++it;
+        }
+    }
+    seg->jobs.push_back(std::move(job));
+    seg->queue_cv.notify_one();
+}
+
+static void push_pre_roll(rac_vad_segmenter* seg, const int16_t* pcm, size_t count) {
+    const size_t capacity = seg->pre_roll.size();
+    if (capacity == 0) {
+        return;
+    }
+    if (count >= capacity) {
+        pcm += count - capacity;
+        count = capacity;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        size_t slot = (seg->pre_roll_start + seg->pre_roll_count) % capacity;
+        seg->pre_roll[slot] = pcm[i];
+        if (seg->pre_roll_count < capacity) {
+            seg->pre_roll_count++;
+        } else {
+            seg->pre_roll_start = (seg->pre_roll_start + 1) % capacity;
+        }
+    }
+}
+
+static void begin_utterance(rac_vad_segmenter* seg) {
+    seg->in_speech = true;
+    seg->partial_sent = 0;
+    seg->utterance.clear();
+
+    const size_t capacity = seg->pre_roll.size();
+    for (size_t i = 0; i < seg->pre_roll_count; ++i) {
+        seg->utterance.push_back(seg->pre_roll[(seg->pre_roll_start + i) % capacity]);
+    }
+    seg->pre_roll_start = 0;
+    seg->pre_roll_count = 0;
+}
+
+/**
+ * Hand the accumulated utterance to the worker, swapping in a recycled buffer
+ */
+static void end_utterance(rac_vad_segmenter* seg, segmenter_clock::time_point endpoint_at) {
+    seg->in_speech = false;
+    if (seg->utterance.empty()) {
+        return;
+    }
+
+    segmenter_job job;
+    job.is_final = true;
+    job.utterance_id = seg->next_utterance_id++;
+    job.endpoint_at = endpoint_at;
+
+    std::lock_guard<std::mutex> lock(seg->queue_mtx);
+    std::vector<int16_t> replacement;
+    take_buffer_locked(seg, true, &replacement);
+    replacement.clear();
+    job.audio = std::move(seg->utterance);
+    seg->utterance = std::move(replacement);
+    submit_locked(seg, std::move(job));
+}
+
+/**
+ * Queue the whole utterance so far for a partial result; each partial
+ * replaces the previous one rather than adding a disjoint slice to it
+ */
+static void send_partial(rac_vad_segmenter* seg) {
+    seg->partial_sent = seg->utterance.size();
+
+    std::lock_guard<std::mutex> lock(seg->queue_mtx);
+    segmenter_job job;
+    if (!take_buffer_locked(seg, false, &job.audio)) {
+        return;
+    }
+    job.audio.assign(seg->utterance.begin(), seg->utterance.end());
+    job.is_final = false;
+    job.utterance_id = seg->next_utterance_id;
+    submit_locked(seg, std::move(job));
+}
+
+/**
+ * Append speech, splitting the utterance when the buffer is full
+ */
+static void append_speech(rac_vad_segmenter* seg, const int16_t* pcm, size_t count) {
+    while (count > 0) {
+        size_t room = seg->max_utterance_samples - seg->utterance.size();
+        size_t take = std::min(room, count);
+        seg->utterance.insert(seg->utterance.end(), pcm, pcm + take);
+        pcm += take;
+        count -= take;
+
+        if (seg->utterance.size() >= seg->max_utterance_samples) {
+            {
+                std::lock_guard<std::mutex> lock(seg->queue_mtx);
+                seg->metrics.split_utterances++;
+            }
+            end_utterance(seg, segmenter_clock::now());
+            seg->in_speech = true;
+            seg->partial_sent = 0;
+        }
+    }
+
+    if (seg->partial_window_samples > 0 &&
+        seg->utterance.size() - seg->partial_sent >= seg->partial_window_samples) {
+        send_partial(seg);
+    }
+}
+
+struct partial_context {
+    rac_vad_segmenter* seg;
+    rac_vad_segment_result_t result;
+};
+
+static void on_partial_text(const char* text, rac_bool_t /*is_final*/, void* user_data) {
+    auto* ctx = static_cast<partial_context*>(user_data);
+    if (!text || !ctx->seg->callback) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ctx->seg->queue_mtx);
+        ctx->seg->metrics.partial_results++;
+    }
+    ctx->result.text = text;
+    ctx->seg->callback(&ctx->result, ctx->seg->user_data);
+}
+
+static void run_job(rac_vad_segmenter* seg, segmenter_job& job) {
+    const size_t audio_size = job.audio.size() * sizeof(int16_t);
+
+    rac_vad_segment_result_t result = {};
+    result.is_final = job.is_final ? RAC_TRUE : RAC_FALSE;
+    result.utterance_id = job.utterance_id;
+    result.audio_duration_ms = samples_to_ms(seg, job.audio.size());
+
+    if (!job.is_final) {
+        partial_context ctx{seg, result};
+        rac_result_t status = rac_stt_component_transcribe_stream(
+            seg->stt_component, job.audio.data(), audio_size, nullptr, on_partial_text, &ctx);
+        if (status != RAC_SUCCESS && status != RAC_ERROR_NOT_SUPPORTED) {
+            std::lock_guard<std::mutex> lock(seg->queue_mtx);
+            seg->metrics.failed_transcriptions++;
+        }
+        return;
+    }
+
+    rac_stt_result_t stt_result = {};
+    rac_result_t status = rac_stt_component_transcribe(seg->stt_component, job.audio.data(),
+                                                       audio_size, nullptr, &stt_result);
+    if (status != RAC_SUCCESS) {
+        RAC_LOG_ERROR("VAD.Segmenter", "Transcription of utterance %lld failed: %d",
+                      static_cast<long long>(job.utterance_id), status);
+        {
+            std::lock_guard<std::mutex> lock(seg->queue_mtx);
+            seg->metrics.failed_transcriptions++;
+        }
+        result.text = "";
+        result.error_code = status;
+        if (seg->callback) {
+            seg->callback(&result, seg->user_data);
+        }
+        return;
+    }
+
+    result.endpoint_latency_ms =
+        std::chrono::duration<double, std::milli>(segmenter_clock::now() - job.endpoint_at)
+            .count();
+    {
+        // Counted before delivery, so the callback already sees its result
+        std::lock_guard<std::mutex> lock(seg->queue_mtx);
+        rac_vad_segmenter_metrics_t& m = seg->metrics;
+        m.utterances++;
+        m.last_endpoint_latency_ms = result.endpoint_latency_ms;
+        m.max_endpoint_latency_ms =
+            std::max(m.max_endpoint_latency_ms, result.endpoint_latency_ms);
+        const double delta = result.endpoint_latency_ms - m.avg_endpoint_latency_ms;
+        m.avg_endpoint_latency_ms += delta / static_cast<double>(m.utterances);
+    }
+
+    result.text = stt_result.text ? stt_result.text : "";
+    if (seg->callback) {
+        seg->callback(&result, seg->user_data);
+    }
+    rac_stt_result_free(&stt_result);
+}
+
+static void worker_loop(rac_vad_segmenter* seg) {
+    std::unique_lock<std::mutex> lock(seg->queue_mtx);
+    while (true) {
+        seg->queue_cv.wait(lock, [seg] { return seg->stopping || !seg->jobs.empty(); });
+        if (seg->jobs.empty()) {
+            return;  // Stopping, and every queued final has been delivered
+        }
+
+        segmenter_job job = std::move(seg->jobs.front());
+        seg->jobs.pop_front();
+        lock.unlock();
+
+        run_job(seg, job);
+
+        lock.lock();
+        job.audio.clear();
+        seg->free_buffers.push_back(std::move(job.audio));
+    }
+}
+
+// =============================================================================
+// SEGMENTER API
+// =============================================================================
+
+extern "C" rac_result_t rac_vad_segmenter_create(rac_handle_t vad_component,
+                                                 rac_handle_t stt_component,
+                                                 const rac_vad_segmenter_config_t* config,
+                                                 rac_vad_segmenter_callback_fn callback,
+                                                 void* user_data, rac_handle_t* out_handle) {
+    if (!vad_component || !stt_component)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_handle)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    const rac_vad_segmenter_config_t* cfg = config ? config : &RAC_VAD_SEGMENTER_CONFIG_DEFAULT;
+    if (cfg->sample_rate <= 0 || cfg->max_utterance_ms <= 0 || cfg->pre_roll_ms < 0 ||
+        cfg->partial_window_ms < 0) {
+        return RAC_ERROR_INVALID_PARAMETER;
+    }
+
+    auto* seg = new (std::nothrow) rac_vad_segmenter();
+    if (!seg) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    auto ms_to_samples = [cfg](int32_t ms) {
+        return static_cast<size_t>(static_cast<int64_t>(ms) * cfg->sample_rate / 1000);
+    };
+
+    seg->vad_component = vad_component;
+    seg->stt_component = stt_component;
+    seg->callback = callback;
+    seg->user_data = user_data;
+    seg->sample_rate = cfg->sample_rate;
+    seg->max_utterance_samples = std::max<size_t>(1, ms_to_samples(cfg->max_utterance_ms));
+    seg->partial_window_samples = ms_to_samples(cfg->partial_window_ms);
+    if (seg->partial_window_samples > 0 &&
+        rac_stt_component_supports_streaming(stt_component) != RAC_TRUE) {
+        RAC_LOG_WARNING("VAD.Segmenter",
+                        "STT model does not support streaming; partial results disabled");
+        seg->partial_window_samples = 0;
+    }
+
+    // Preallocate so the capture path never allocates
+    try {
+        seg->pre_roll.resize(ms_to_samples(cfg->pre_roll_ms));
+        seg->scratch.resize(std::max<size_t>(1, ms_to_samples(kScratchMs)));
+        seg->utterance.reserve(seg->max_utterance_samples);
+        const size_t pool_size = seg->partial_window_samples > 0 ? kBufferPoolSize
+                                                                  : kBufferPoolSize - 1;
+        seg->free_buffers.resize(pool_size);
+        for (std::vector<int16_t>& buffer : seg->free_buffers) {
+            buffer.reserve(seg->max_utterance_samples);
+        }
+    } catch (const std::bad_alloc&) {
+        delete seg;
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    seg->worker = std::thread(worker_loop, seg);
+
+    *out_handle = reinterpret_cast<rac_handle_t>(seg);
+
+    RAC_LOG_INFO("VAD.Segmenter", "Segmenter created (pre-roll %dms, max utterance %dms)",
+                 cfg->pre_roll_ms, cfg->max_utterance_ms);
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_vad_segmenter_process(rac_handle_t handle, const float* samples,
+                                                  size_t num_samples) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!samples || num_samples == 0)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* seg = reinterpret_cast<rac_vad_segmenter*>(handle);
+    std::lock_guard<std::mutex> lock(seg->capture_mtx);
+
+    rac_result_t result = rac_vad_component_process(seg->vad_component, samples, num_samples,
+                                                    nullptr);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    const bool speech_active = rac_vad_component_is_speech_active(seg->vad_component) == RAC_TRUE;
+
+    if (!seg->in_speech && speech_active) {
+        begin_utterance(seg);
+    }
+
+    // Convert through the preallocated scratch buffer, a slice at a time
+    for (size_t offset = 0; offset < num_samples; offset += seg->scratch.size()) {
+        const size_t count = std::min(seg->scratch.size(), num_samples - offset);
+        rac_audio_float32_to_int16(samples + offset, count, seg->scratch.data());
+        if (seg->in_speech) {
+            append_speech(seg, seg->scratch.data(), count);
+        } else {
+            push_pre_roll(seg, seg->scratch.data(), count);
+        }
+    }
+
+    if (seg->in_speech && !speech_active) {
+        end_utterance(seg, segmenter_clock::now());
+    }
+
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_vad_segmenter_flush(rac_handle_t handle) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+
+    auto* seg = reinterpret_cast<rac_vad_segmenter*>(handle);
+    std::lock_guard<std::mutex> lock(seg->capture_mtx);
+
+    if (seg->in_speech) {
+        end_utterance(seg, segmenter_clock::now());
+    }
+    return RAC_SUCCESS;
+}
+
+extern "C" rac_result_t rac_vad_segmenter_get_metrics(rac_handle_t handle,
+                                                      rac_vad_segmenter_metrics_t* out_metrics) {
+    if (!handle)
+        return RAC_ERROR_INVALID_HANDLE;
+    if (!out_metrics)
+        return RAC_ERROR_INVALID_ARGUMENT;
+
+    auto* seg = reinterpret_cast<rac_vad_segmenter*>(handle);
+    std::lock_guard<std::mutex> lock(seg->queue_mtx);
+    *out_metrics = seg->metrics;
+
+    return RAC_SUCCESS;
+}
+
+extern "C" void rac_vad_segmenter_destroy(rac_handle_t handle) {
+    if (!handle)
+        return;
+
+    auto* seg = reinterpret_cast<rac_vad_segmenter*>(handle);
+    size_t dropped_partials = 0;
+    size_t pending_finals = 0;
+    {
+        // Queued partials are stale once capture has stopped, but finals are
+        // transcribed and delivered before the worker exits
+        std::lock_guard<std::mutex> lock(seg->queue_mtx);
+        seg->stopping = true;
+        const auto partials =
+            std::remove_if(seg->jobs.begin(), seg->jobs.end(),
+                           [](const segmenter_job& job) { return !job.is_final; });
+        dropped_partials = static_cast<size_t>(seg->jobs.end() - partials);
+        seg->jobs.erase(partials, seg->jobs.end());
+        pending_finals = seg->jobs.size();
+    }
+    seg->queue_cv.notify_all();
+    if (pending_finals > 0 || dropped_partials > 0) {
+        RAC_LOG_INFO("VAD.Segmenter", "Draining %zu queued utterances (%zu partials dropped)",
+                     pending_finals, dropped_partials);
+    }
+    if (seg->worker.joinable()) {
+        seg->worker.join();
+    }
+
+    RAC_LOG_DEBUG("VAD.Segmenter", "Segmenter destroyed");
+    delete seg;
+}
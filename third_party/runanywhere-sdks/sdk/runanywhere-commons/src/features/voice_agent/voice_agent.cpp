@@ -8,9 +8,13 @@
  * CRITICAL: This is a direct port of Swift implementation - do NOT add custom logic!
  */
 
+#include <atomic>
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "rac/core/rac_analytics_events.h"
 #include "rac/core/rac_audio_utils.h"
@@ -55,6 +59,13 @@ struct rac_voice_agent {
     rac_handle_t tts_handle;
     rac_handle_t vad_handle;
 
+    // Synthesized audio output format
+    bool raw_pcm_output;
+    rac_tts_sample_format_t pcm_sample_format;
+
+    // A voice session (voice_session.cpp) is driving the STT and VAD components
+    bool session_active;
+
     // Thread safety
     std::mutex mutex;
 
@@ -64,7 +75,10 @@ struct rac_voice_agent {
           llm_handle(nullptr),
           stt_handle(nullptr),
           tts_handle(nullptr),
-          vad_handle(nullptr) {}
+          vad_handle(nullptr),
+          raw_pcm_output(false),
+          pcm_sample_format(RAC_TTS_SAMPLE_FORMAT_FLOAT32),
+          session_active(false) {}
 };
 
 // Note: rac_strdup is declared in rac_types.h and implemented in rac_memory.cpp
@@ -455,6 +469,9 @@ rac_result_t rac_voice_agent_initialize(rac_voice_agent_handle_t handle,
         }
     }
 
+    handle->raw_pcm_output = cfg->tts_config.raw_pcm_output == RAC_TRUE;
+    handle->pcm_sample_format = cfg->tts_config.pcm_sample_format;
+
     // Step 5: Verify all components ready (mirrors Swift's verifyAllComponentsReady)
     // Note: In the C API, we trust initialization succeeded
 
@@ -522,6 +539,88 @@ rac_result_t rac_voice_agent_is_ready(rac_voice_agent_handle_t handle, rac_bool_
     return RAC_SUCCESS;
 }
 
+// =============================================================================
+// AUDIO OUTPUT
+// =============================================================================
+
+/**
+ * @brief Synthesize text into the agent's configured output format
+ *
+ * Raw PCM output takes over the TTS buffer as is (narrowing to Int16 in place),
+ * so nothing is copied; otherwise the samples are wrapped in a WAV file for
+ * players that need a container.
+ */
+static rac_result_t synthesize_output(rac_voice_agent* handle, const char* text, void** out_audio,
+                                      size_t* out_audio_size) {
+    rac_tts_options_t options = RAC_TTS_OPTIONS_DEFAULT;
+    rac_tts_component_get_default_options(handle->tts_handle, &options);
+    if (handle->raw_pcm_output) {
+        // Produced in the encoding the caller wants; an owned buffer is handed over as is
+        options.sample_format = handle->pcm_sample_format;
+    } else {
+        // WAV output is 16-bit either way, and the buffer is freed right after encoding
+        options.sample_format = RAC_TTS_SAMPLE_FORMAT_INT16;
+        options.borrow_audio = RAC_TRUE;
+    }
+
+    rac_tts_result_t tts_result = {};
+    rac_result_t result =
+        rac_tts_component_synthesize(handle->tts_handle, text, &options, &tts_result);
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR("VoiceAgent", "TTS synthesis failed");
+        return result;
+    }
+
+    const bool is_int16 = tts_result.sample_format == RAC_TTS_SAMPLE_FORMAT_INT16;
+
+    if (!handle->raw_pcm_output) {
+        // TTS returns raw PCM samples, but audio players need WAV format
+        const int32_t sample_rate =
+            tts_result.sample_rate > 0 ? tts_result.sample_rate : RAC_TTS_DEFAULT_SAMPLE_RATE;
+        result = is_int16 ? rac_audio_int16_to_wav(tts_result.audio_data, tts_result.audio_size,
+                                                   sample_rate, out_audio, out_audio_size)
+                          : rac_audio_float32_to_wav(tts_result.audio_data,
+                                                     tts_result.audio_size, sample_rate,
+                                                     out_audio, out_audio_size);
+        rac_tts_result_free(&tts_result);
+        if (result != RAC_SUCCESS) {
+            RAC_LOG_ERROR("VoiceAgent", "Failed to convert audio to WAV format");
+        }
+        return result;
+    }
+
+    void* pcm = tts_result.audio_data;
+    size_t pcm_size = tts_result.audio_size;
+
+    if (tts_result.release_audio) {
+        // A borrowed buffer has to be copied before it can be handed to the caller
+        pcm = malloc(pcm_size);
+        if (!pcm) {
+            rac_tts_result_free(&tts_result);
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(pcm, tts_result.audio_data, pcm_size);
+        rac_tts_result_free(&tts_result);
+    } else {
+        tts_result.audio_data = nullptr;
+    }
+
+    if (handle->pcm_sample_format == RAC_TTS_SAMPLE_FORMAT_INT16 && !is_int16) {
+        const size_t sample_count = pcm_size / sizeof(float);
+        rac_audio_float32_to_int16(static_cast<const float*>(pcm), sample_count,
+                                   static_cast<int16_t*>(pcm));
+        pcm_size = sample_count * sizeof(int16_t);
+    } else if (handle->pcm_sample_format == RAC_TTS_SAMPLE_FORMAT_FLOAT32 && is_int16) {
+        free(pcm);
+        RAC_LOG_ERROR("VoiceAgent", "TTS returned Int16 audio but Float32 output is configured");
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    *out_audio = pcm;
+    *out_audio_size = pcm_size;
+    return RAC_SUCCESS;
+}
+
 // =============================================================================
 // VOICE PROCESSING API
 // =============================================================================
@@ -595,48 +694,27 @@ rac_result_t rac_voice_agent_process_voice_turn(rac_voice_agent_handle_t handle,
     // Step 3: Synthesize speech (mirrors Swift's Step 3)
     RAC_LOG_DEBUG("VoiceAgent", "Step 3: Synthesizing speech");
 
-    rac_tts_result_t tts_result = {};
-    result = rac_tts_component_synthesize(handle->tts_handle, llm_result.text,
-                                          nullptr,  // default options
-                                          &tts_result);
+    // Step 4: Deliver as WAV for playback, or as raw PCM if configured
+    void* speech = nullptr;
+    size_t speech_size = 0;
+    result = synthesize_output(handle, llm_result.text, &speech, &speech_size);
 
     if (result != RAC_SUCCESS) {
-        RAC_LOG_ERROR("VoiceAgent", "TTS synthesis failed");
-        rac_stt_result_free(&stt_result);
-        rac_llm_result_free(&llm_result);
-        return result;
-    }
-
-    // Step 4: Convert Float32 PCM to WAV format for playback
-    // TTS returns raw Float32 samples, but audio players need WAV format
-    void* wav_data = nullptr;
-    size_t wav_size = 0;
-    result = rac_audio_float32_to_wav(tts_result.audio_data, tts_result.audio_size,
-                                      tts_result.sample_rate > 0 ? tts_result.sample_rate
-                                                                 : RAC_TTS_DEFAULT_SAMPLE_RATE,
-                                      &wav_data, &wav_size);
-
-    if (result != RAC_SUCCESS) {
-        RAC_LOG_ERROR("VoiceAgent", "Failed to convert audio to WAV format");
         rac_stt_result_free(&stt_result);
         rac_llm_result_free(&llm_result);
-        rac_tts_result_free(&tts_result);
         return result;
     }
 
-    RAC_LOG_DEBUG("VoiceAgent", "Converted PCM to WAV format");
-
     // Build result (mirrors Swift's VoiceAgentResult)
     out_result->speech_detected = RAC_TRUE;
     out_result->transcription = rac_strdup(stt_result.text);
     out_result->response = rac_strdup(llm_result.text);
-    out_result->synthesized_audio = wav_data;
-    out_result->synthesized_audio_size = wav_size;
+    out_result->synthesized_audio = speech;
+    out_result->synthesized_audio_size = speech_size;
 
-    // Free intermediate results (tts_result audio data is no longer needed since we have WAV)
+    // Free intermediate results
     rac_stt_result_free(&stt_result);
     rac_llm_result_free(&llm_result);
-    rac_tts_result_free(&tts_result);
 
     RAC_LOG_INFO("VoiceAgent", "Voice turn completed");
 
@@ -710,33 +788,14 @@ rac_result_t rac_voice_agent_process_stream(rac_voice_agent_handle_t handle, con
     response_event.data.response = llm_result.text;
     callback(&response_event, user_data);
 
-    // Step 3: Synthesize
-    rac_tts_result_t tts_result = {};
-    result =
-        rac_tts_component_synthesize(handle->tts_handle, llm_result.text, nullptr, &tts_result);
-
-    if (result != RAC_SUCCESS) {
-        rac_stt_result_free(&stt_result);
-        rac_llm_result_free(&llm_result);
-        rac_voice_agent_event_t error_event = {};
-        error_event.type = RAC_VOICE_AGENT_EVENT_ERROR;
-        error_event.data.error_code = result;
-        callback(&error_event, user_data);
-        return result;
-    }
-
-    // Step 4: Convert Float32 PCM to WAV format for playback
-    void* wav_data = nullptr;
-    size_t wav_size = 0;
-    result = rac_audio_float32_to_wav(tts_result.audio_data, tts_result.audio_size,
-                                      tts_result.sample_rate > 0 ? tts_result.sample_rate
-                                                                 : RAC_TTS_DEFAULT_SAMPLE_RATE,
-                                      &wav_data, &wav_size);
+    // Step 3: Synthesize, as WAV for playback or as raw PCM if configured
+    void* speech = nullptr;
+    size_t speech_size = 0;
+    result = synthesize_output(handle, llm_result.text, &speech, &speech_size);
 
     if (result != RAC_SUCCESS) {
         rac_stt_result_free(&stt_result);
         rac_llm_result_free(&llm_result);
-        rac_tts_result_free(&tts_result);
         rac_voice_agent_event_t error_event = {};
         error_event.type = RAC_VOICE_AGENT_EVENT_ERROR;
         error_event.data.error_code = result;
@@ -744,11 +803,11 @@ rac_result_t rac_voice_agent_process_stream(rac_voice_agent_handle_t handle, con
         return result;
     }
 
-    // Emit audio synthesized event (with WAV data)
+    // Emit audio synthesized event
     rac_voice_agent_event_t audio_event = {};
     audio_event.type = RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED;
-    audio_event.data.audio.audio_data = wav_data;
-    audio_event.data.audio.audio_size = wav_size;
+    audio_event.data.audio.audio_data = speech;
+    audio_event.data.audio.audio_size = speech_size;
     callback(&audio_event, user_data);
 
     // Emit final processed event
@@ -757,18 +816,298 @@ rac_result_t rac_voice_agent_process_stream(rac_voice_agent_handle_t handle, con
     processed_event.data.result.speech_detected = RAC_TRUE;
     processed_event.data.result.transcription = rac_strdup(stt_result.text);
     processed_event.data.result.response = rac_strdup(llm_result.text);
-    processed_event.data.result.synthesized_audio = wav_data;
-    processed_event.data.result.synthesized_audio_size = wav_size;
+    processed_event.data.result.synthesized_audio = speech;
+    processed_event.data.result.synthesized_audio_size = speech_size;
     callback(&processed_event, user_data);
 
-    // Free intermediate results (WAV data ownership transferred to processed_event)
+    // Free intermediate results (audio ownership transferred to processed_event)
     rac_stt_result_free(&stt_result);
     rac_llm_result_free(&llm_result);
+
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// VOICE SESSION SUPPORT (used by voice_session.cpp)
+// =============================================================================
+
+namespace rac::voice_agent {
+
+/**
+ * @brief Reserve the agent for a voice session
+ *
+ * Checks that the agent is initialized and its components are loaded, and
+ * hands out the STT and VAD components the session drives directly.
+ */
+rac_result_t acquire_session(rac_voice_agent_handle_t handle, rac_handle_t* out_stt_handle,
+                             rac_handle_t* out_vad_handle) {
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (!handle->is_configured) {
+        RAC_LOG_ERROR("VoiceAgent", "Voice Agent is not initialized");
+        return RAC_ERROR_NOT_INITIALIZED;
+    }
+    if (handle->session_active) {
+        RAC_LOG_ERROR("VoiceAgent", "A voice session is already running");
+        return RAC_ERROR_SERVICE_BUSY;
+    }
+    rac_result_t result = validate_all_components_ready(handle);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    if (!handle->vad_handle) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    handle->session_active = true;
+    *out_stt_handle = handle->stt_handle;
+    *out_vad_handle = handle->vad_handle;
+    return RAC_SUCCESS;
+}
+
+void release_session(rac_voice_agent_handle_t handle) {
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    handle->session_active = false;
+}
+
+struct session_generation {
+    const std::atomic<bool>* cancelled;
+    std::string text;
+    rac_result_t error;
+};
+
+static rac_bool_t session_generation_token(const char* /*token*/, void* user_data) {
+    auto* generation = static_cast<session_generation*>(user_data);
+    return generation->cancelled->load() ? RAC_FALSE : RAC_TRUE;
+}
+
+static void session_generation_complete(const rac_llm_result_t* result, void* user_data) {
+    auto* generation = static_cast<session_generation*>(user_data);
+    generation->text = result->text ? result->text : "";
+}
+
+static void session_generation_error(rac_result_t error_code, const char* /*error_message*/,
+                                     void* user_data) {
+    static_cast<session_generation*>(user_data)->error = error_code;
+}
+
+/**
+ * @brief Generate a session turn's response, stopping early once cancelled
+ *
+ * Streams tokens when the model supports it so that cancellation takes
+ * effect at the next token; rac_llm_component_cancel would wait for the
+ * generation to finish.
+ *
+ * @return RAC_SUCCESS, RAC_ERROR_CANCELLED, or the generation error
+ */
+rac_result_t generate_session_response(rac_voice_agent_handle_t handle, const char* prompt,
+                                       const std::atomic<bool>& cancelled, char** out_response) {
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (!handle->is_configured) {
+        return RAC_ERROR_NOT_INITIALIZED;
+    }
+
+    if (rac_llm_component_supports_streaming(handle->llm_handle) != RAC_TRUE) {
+        rac_llm_result_t llm_result = {};
+        rac_result_t result =
+            rac_llm_component_generate(handle->llm_handle, prompt, nullptr, &llm_result);
+        if (result == RAC_SUCCESS && cancelled.load()) {
+            result = RAC_ERROR_CANCELLED;
+        } else if (result == RAC_SUCCESS) {
+            *out_response = rac_strdup(llm_result.text);
+        }
+        rac_llm_result_free(&llm_result);
+        return result;
+    }
+
+    session_generation generation{&cancelled, std::string(), RAC_SUCCESS};
+    rac_result_t result = rac_llm_component_generate_stream(
+        handle->llm_handle, prompt, nullptr, session_generation_token,
+        session_generation_complete, session_generation_error, &generation);
+    if (cancelled.load()) {
+        return RAC_ERROR_CANCELLED;
+    }
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    if (generation.error != RAC_SUCCESS) {
+        return generation.error;
+    }
+
+    *out_response = rac_strdup(generation.text.c_str());
+    return *out_response ? RAC_SUCCESS : RAC_ERROR_OUT_OF_MEMORY;
+}
+
+/**
+ * @brief Split a reply at sentence ends, so a cancelled turn stops at the next one
+ *
+ * A sentence ends at '.', '!', '?' or a newline followed by whitespace or the
+ * end of the text. Fragments shorter than kMinSentenceChars are merged into
+ * the next sentence.
+ */
+static std::vector<std::string> split_session_sentences(const char* text) {
+    constexpr size_t kMinSentenceChars = 20;
+
+    std::vector<std::string> sentences;
+    std::string current;
+    for (const char* p = text; *p != '\0'; ++p) {
+        if (current.empty() && std::isspace(static_cast<unsigned char>(*p)) != 0) {
+            continue;
+        }
+        current += *p;
+        const bool terminator = *p == '.' || *p == '!' || *p == '?' || *p == '\n';
+        const bool boundary =
+            terminator && (p[1] == '\0' || std::isspace(static_cast<unsigned char>(p[1])) != 0);
+        if (boundary && current.size() >= kMinSentenceChars) {
+            sentences.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        if (current.size() < kMinSentenceChars && !sentences.empty()) {
+            sentences.back() += " " + current;
+        } else {
+            sentences.push_back(std::move(current));
+        }
+    }
+    return sentences;
+}
+
+struct session_synthesis {
+    rac_tts_stream_callback_t on_chunk;
+    void* user_data;
+    std::vector<uint8_t> audio;
+    int32_t sample_rate;
+};
+
+static void append_session_audio(session_synthesis* synthesis, const void* audio_data,
+                                 size_t audio_size) {
+    const auto* bytes = static_cast<const uint8_t*>(audio_data);
+    synthesis->audio.insert(synthesis->audio.end(), bytes, bytes + audio_size);
+    synthesis->on_chunk(audio_data, audio_size, synthesis->user_data);
+}
+
+static void session_synthesis_chunk(const void* audio_data, size_t audio_size, void* user_data) {
+    append_session_audio(static_cast<session_synthesis*>(user_data), audio_data, audio_size);
+}
+
+/**
+ * @brief Synthesize one sentence of a session reply in one piece
+ *
+ * Used for WAV output, which needs the sample rate that only whole-sentence
+ * synthesis reports, and for TTS models that do not stream.
+ */
+static rac_result_t synthesize_session_sentence(rac_voice_agent* handle, const char* sentence,
+                                                const rac_tts_options_t& options,
+                                                session_synthesis* synthesis) {
+    rac_tts_options_t borrowed = options;
+    borrowed.borrow_audio = RAC_TRUE;  // Copied into the reply right away
+    rac_tts_result_t tts_result = {};
+    rac_result_t result =
+        rac_tts_component_synthesize(handle->tts_handle, sentence, &borrowed, &tts_result);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    if (tts_result.sample_rate > 0) {
+        synthesis->sample_rate = tts_result.sample_rate;
+    }
+
+    const bool is_int16 = tts_result.sample_format == RAC_TTS_SAMPLE_FORMAT_INT16;
+    if (options.sample_format == RAC_TTS_SAMPLE_FORMAT_INT16 && !is_int16) {
+        std::vector<int16_t> narrowed(tts_result.audio_size / sizeof(float));
+        rac_audio_float32_to_int16(static_cast<const float*>(tts_result.audio_data),
+                                   narrowed.size(), narrowed.data());
+        append_session_audio(synthesis, narrowed.data(), narrowed.size() * sizeof(int16_t));
+    } else if (options.sample_format == RAC_TTS_SAMPLE_FORMAT_FLOAT32 && is_int16) {
+        RAC_LOG_ERROR("VoiceAgent", "TTS returned Int16 audio but Float32 output is configured");
+        result = RAC_ERROR_NOT_SUPPORTED;
+    } else {
+        append_session_audio(synthesis, tts_result.audio_data, tts_result.audio_size);
+    }
     rac_tts_result_free(&tts_result);
+    return result;
+}
+
+/**
+ * @brief Synthesize a session turn's reply, handing out audio as it is produced
+ *
+ * The reply is synthesized sentence by sentence, and on_chunk receives each
+ * piece as soon as it exists: streamed chunks in the configured sample format
+ * for raw PCM output, or one Int16 PCM piece per sentence for WAV output,
+ * which is wrapped in its header once at the end. Cancellation is checked
+ * before each sentence.
+ *
+ * @return RAC_SUCCESS, RAC_ERROR_CANCELLED, or the synthesis error
+ */
+rac_result_t synthesize_session_speech(rac_voice_agent_handle_t handle, const char* text,
+                                       const std::atomic<bool>& cancelled,
+                                       rac_tts_stream_callback_t on_chunk, void* user_data,
+                                       void** out_audio, size_t* out_audio_size) {
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    if (!handle->is_configured) {
+        return RAC_ERROR_NOT_INITIALIZED;
+    }
 
+    rac_tts_options_t options = RAC_TTS_OPTIONS_DEFAULT;
+    rac_tts_component_get_default_options(handle->tts_handle, &options);
+    options.sample_format =
+        handle->raw_pcm_output ? handle->pcm_sample_format : RAC_TTS_SAMPLE_FORMAT_INT16;
+
+    session_synthesis synthesis{on_chunk, user_data, std::vector<uint8_t>(),
+                                RAC_TTS_DEFAULT_SAMPLE_RATE};
+    bool streaming = handle->raw_pcm_output;
+    for (const std::string& sentence : split_session_sentences(text)) {
+        if (cancelled.load()) {
+            return RAC_ERROR_CANCELLED;
+        }
+        rac_result_t result = RAC_ERROR_NOT_SUPPORTED;
+        if (streaming) {
+            result = rac_tts_component_synthesize_stream(
+                handle->tts_handle, sentence.c_str(), &options, session_synthesis_chunk,
+                &synthesis);
+            streaming = result != RAC_ERROR_NOT_SUPPORTED;
+        }
+        if (!streaming) {
+            result = synthesize_session_sentence(handle, sentence.c_str(), options, &synthesis);
+        }
+        if (result != RAC_SUCCESS) {
+            RAC_LOG_ERROR("VoiceAgent", "TTS synthesis failed");
+            return result;
+        }
+    }
+    if (cancelled.load()) {
+        return RAC_ERROR_CANCELLED;
+    }
+
+    if (!handle->raw_pcm_output) {
+        if (synthesis.audio.empty()) {
+            return RAC_ERROR_INVALID_ARGUMENT;  // Nothing to speak
+        }
+        rac_result_t result =
+            rac_audio_int16_to_wav(synthesis.audio.data(), synthesis.audio.size(),
+                                   synthesis.sample_rate, out_audio, out_audio_size);
+        if (result != RAC_SUCCESS) {
+            RAC_LOG_ERROR("VoiceAgent", "Failed to convert audio to WAV format");
+        }
+        return result;
+    }
+
+    void* pcm = malloc(synthesis.audio.empty() ? 1 : synthesis.audio.size());
+    if (!pcm) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    if (!synthesis.audio.empty()) {
+        memcpy(pcm, synthesis.audio.data(), synthesis.audio.size());
+    }
+    *out_audio = pcm;
+    *out_audio_size = synthesis.audio.size();
     return RAC_SUCCESS;
 }
 
+}  // namespace rac::voice_agent
+
 // =============================================================================
 // INDIVIDUAL COMPONENT ACCESS API
 // =============================================================================
@@ -837,34 +1176,7 @@ rac_result_t rac_voice_agent_synthesize_speech(rac_voice_agent_handle_t handle,
         return RAC_ERROR_NOT_INITIALIZED;
     }
 
-    rac_tts_result_t tts_result = {};
-    rac_result_t result =
-        rac_tts_component_synthesize(handle->tts_handle, text, nullptr, &tts_result);
-
-    if (result != RAC_SUCCESS) {
-        return result;
-    }
-
-    // Convert Float32 PCM to WAV format for playback
-    void* wav_data = nullptr;
-    size_t wav_size = 0;
-    result = rac_audio_float32_to_wav(tts_result.audio_data, tts_result.audio_size,
-                                      tts_result.sample_rate > 0 ? tts_result.sample_rate
-                                                                 : RAC_TTS_DEFAULT_SAMPLE_RATE,
-                                      &wav_data, &wav_size);
-
-    if (result != RAC_SUCCESS) {
-        rac_tts_result_free(&tts_result);
-        return result;
-    }
-
-    *out_audio = wav_data;
-    *out_audio_size = wav_size;
-
-    // Free the original PCM data
-    rac_tts_result_free(&tts_result);
-
-    return RAC_SUCCESS;
+    return synthesize_output(handle, text, out_audio, out_audio_size);
 }
 
 rac_result_t rac_voice_agent_detect_speech(rac_voice_agent_handle_t handle, const float* samples,
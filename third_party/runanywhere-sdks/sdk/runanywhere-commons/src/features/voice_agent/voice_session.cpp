@@ -0,0 +1,562 @@
+/**
+ * @file voice_session.cpp
+ * @brief RunAnywhere Commons - Continuous voice session
+ *
+ * Three threads share the work so that none of them waits on a slower stage:
+ *   - capture: drains the lock-free ring buffer the microphone writes into
+ *     and feeds the VAD segmenter, which detects speech start and end
+ *   - segmenter worker: transcribes partial windows and finished utterances
+ *   - turn: answers each utterance with LLM and TTS through the voice agent
+ * Events from all three are serialized through one callback mutex.
+ *
+ * A turn can be cancelled at any point (barge-in): the turn thread checks a
+ * flag between tokens, before every event, and for each synthesized chunk.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+#include "rac/features/tts/rac_tts_types.h"
+#include "rac/features/vad/rac_vad_component.h"
+#include "rac/features/vad/rac_vad_segmenter.h"
+#include "rac/features/voice_agent/rac_voice_agent.h"
+
+// Forward declare session support from voice_agent.cpp
+namespace rac::voice_agent {
+rac_result_t acquire_session(rac_voice_agent_handle_t handle, rac_handle_t* out_stt_handle,
+                             rac_handle_t* out_vad_handle);
+void release_session(rac_voice_agent_handle_t handle);
+rac_result_t generate_session_response(rac_voice_agent_handle_t handle, const char* prompt,
+                                       const std::atomic<bool>& cancelled, char** out_response);
+rac_result_t synthesize_session_speech(rac_voice_agent_handle_t handle, const char* text,
+                                       const std::atomic<bool>& cancelled,
+                                       rac_tts_stream_callback_t on_chunk, void* user_data,
+                                       void** out_audio, size_t* out_audio_size);
+}  // namespace rac::voice_agent
+
+static const char* LOG_CAT = "VoiceAgent.Session";
+
+// Audio handed to the VAD per step, and how long the capture thread sleeps
+// when a wakeup from push_audio is missed
+static constexpr int32_t CAPTURE_CHUNK_MS = 20;
+static constexpr auto CAPTURE_POLL_INTERVAL = std::chrono::milliseconds(10);
+
+// =============================================================================
+// INTERNAL STRUCTURES
+// =============================================================================
+
+using session_clock = std::chrono::steady_clock;
+
+/**
+ * A finished utterance waiting for its response
+ */
+struct session_turn {
+    std::string transcription;
+    session_clock::time_point endpoint_at;
+};
+
+struct rac_voice_agent_session {
+    rac_voice_agent_handle_t agent = nullptr;
+    rac_handle_t stt_handle = nullptr;
+    rac_handle_t vad_handle = nullptr;
+
+    rac_voice_agent_event_callback_fn callback = nullptr;
+    void* user_data = nullptr;
+    std::mutex callback_mtx;
+
+    // Capture: push_audio writes the ring, the capture thread reads it
+    rac_handle_t ring = nullptr;
+    int32_t ring_reader = -1;
+    size_t chunk_samples = 0;
+    rac_handle_t segmenter = nullptr;
+    std::thread capture_thread;
+    std::mutex capture_mtx;  // Only for sleeping on capture_cv
+    std::condition_variable capture_cv;
+    std::atomic<bool> capture_stopping{false};
+    std::atomic<bool> flush_requested{false};
+    bool speech_active = false;  // Capture thread only
+    bool barge_in = false;
+
+    // Turns, guarded by turn_mtx
+    std::thread turn_thread;
+    std::mutex turn_mtx;
+    std::condition_variable turn_cv;
+    std::deque<session_turn> turns;
+    bool turns_stopping = false;
+    bool turn_in_progress = false;
+    // Set by cancel_turn and stop, cleared when the next turn starts
+    std::atomic<bool> turn_cancelled{false};
+
+    std::mutex metrics_mtx;
+    rac_voice_agent_session_metrics_t metrics = {};
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static double elapsed_ms(session_clock::time_point since, session_clock::time_point until) {
+    return std::chrono::duration<double, std::milli>(until - since).count();
+}
+
+static void emit(rac_voice_agent_session* session, const rac_voice_agent_event_t& event) {
+    std::lock_guard<std::mutex> lock(session->callback_mtx);
+    session->callback(&event, session->user_data);
+}
+
+/**
+ * Emit an event of the turn in progress, unless the turn has been cancelled.
+ * Checked under the callback mutex, so a cancel from inside a callback or
+ * returned before this one started is never followed by the turn's events.
+ */
+static bool emit_turn_event(rac_voice_agent_session* session,
+                            const rac_voice_agent_event_t& event) {
+    std::lock_guard<std::mutex> lock(session->callback_mtx);
+    if (session->turn_cancelled.load()) {
+        return false;
+    }
+    session->callback(&event, session->user_data);
+    return true;
+}
+
+static void emit_error(rac_voice_agent_session* session, rac_result_t error_code) {
+    rac_voice_agent_event_t event = {};
+    event.type = RAC_VOICE_AGENT_EVENT_ERROR;
+    event.data.error_code = error_code;
+    emit(session, event);
+}
+
+static void record_failed_turn(rac_voice_agent_session* session) {
+    std::lock_guard<std::mutex> lock(session->metrics_mtx);
+    session->metrics.failed_turns++;
+}
+
+// =============================================================================
+// SEGMENTER RESULTS (segmenter worker thread)
+// =============================================================================
+
+static void on_segment(const rac_vad_segment_result_t* result, void* user_data) {
+    auto* session = static_cast<rac_voice_agent_session*>(user_data);
+    if (result->error_code != RAC_SUCCESS) {
+        // The segmenter only reports failed final transcriptions
+        RAC_LOG_ERROR(LOG_CAT, "Transcription failed: %d", result->error_code);
+        record_failed_turn(session);
+        emit_error(session, result->error_code);
+        return;
+    }
+    if (!result->text || result->text[0] == '\0') {
+        return;
+    }
+
+    rac_voice_agent_event_t event = {};
+    event.data.transcription = result->text;
+
+    if (result->is_final != RAC_TRUE) {
+        event.type = RAC_VOICE_AGENT_EVENT_PARTIAL_TRANSCRIPTION;
+        emit(session, event);
+        std::lock_guard<std::mutex> lock(session->metrics_mtx);
+        session->metrics.partial_transcriptions++;
+        return;
+    }
+
+    event.type = RAC_VOICE_AGENT_EVENT_TRANSCRIPTION;
+    emit(session, event);
+
+    const auto latency = std::chrono::duration_cast<session_clock::duration>(
+        std::chrono::duration<double, std::milli>(result->endpoint_latency_ms));
+    session_turn turn;
+    turn.transcription = result->text;
+    turn.endpoint_at = session_clock::now() - latency;
+    {
+        std::lock_guard<std::mutex> lock(session->metrics_mtx);
+        session->metrics.last_stt_latency_ms = result->endpoint_latency_ms;
+    }
+    {
+        std::lock_guard<std::mutex> lock(session->turn_mtx);
+        session->turns.push_back(std::move(turn));
+    }
+    session->turn_cv.notify_one();
+}
+
+// =============================================================================
+// TURN THREAD
+// =============================================================================
+
+/**
+ * Audio chunks of the turn in progress, forwarded from the TTS stream
+ */
+struct turn_audio {
+    rac_voice_agent_session* session;
+    bool first_chunk_seen;
+    session_clock::time_point first_chunk_at;
+};
+
+static void on_audio_chunk(const void* audio_data, size_t audio_size, void* user_data) {
+    auto* audio = static_cast<turn_audio*>(user_data);
+    if (!audio->first_chunk_seen) {
+        audio->first_chunk_seen = true;
+        audio->first_chunk_at = session_clock::now();
+    }
+    rac_voice_agent_event_t event = {};
+    event.type = RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK;
+    event.data.audio.audio_data = const_cast<void*>(audio_data);
+    event.data.audio.audio_size = audio_size;
+    emit_turn_event(audio->session, event);
+}
+
+static void run_turn(rac_voice_agent_session* session, session_turn& turn) {
+    const session_clock::time_point llm_start = session_clock::now();
+    char* response = nullptr;
+    rac_result_t result = rac::voice_agent::generate_session_response(
+        session->agent, turn.transcription.c_str(), session->turn_cancelled, &response);
+    if (result == RAC_ERROR_CANCELLED) {
+        RAC_LOG_INFO(LOG_CAT, "Turn cancelled during generation");
+        return;
+    }
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "LLM generation failed: %d", result);
+        record_failed_turn(session);
+        emit_error(session, result);
+        return;
+    }
+
+    rac_voice_agent_event_t response_event = {};
+    response_event.type = RAC_VOICE_AGENT_EVENT_RESPONSE;
+    response_event.data.response = response;
+    if (!emit_turn_event(session, response_event)) {
+        rac_free(response);
+        return;
+    }
+
+    const session_clock::time_point tts_start = session_clock::now();
+    turn_audio audio = {session, false, {}};
+    void* speech = nullptr;
+    size_t speech_size = 0;
+    result = rac::voice_agent::synthesize_session_speech(session->agent, response,
+                                                         session->turn_cancelled, on_audio_chunk,
+                                                         &audio, &speech, &speech_size);
+    const session_clock::time_point audio_ready = session_clock::now();
+    if (session->turn_cancelled.load()) {
+        rac_free(response);
+        rac_free(speech);
+        return;
+    }
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "TTS synthesis failed: %d", result);
+        rac_free(response);
+        record_failed_turn(session);
+        emit_error(session, result);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(session->metrics_mtx);
+        rac_voice_agent_session_metrics_t& m = session->metrics;
+        m.turns++;
+        m.last_llm_duration_ms = elapsed_ms(llm_start, tts_start);
+        m.last_tts_duration_ms = elapsed_ms(tts_start, audio_ready);
+        m.last_first_audio_latency_ms = elapsed_ms(
+            turn.endpoint_at, audio.first_chunk_seen ? audio.first_chunk_at : audio_ready);
+        m.max_first_audio_latency_ms =
+            std::max(m.max_first_audio_latency_ms, m.last_first_audio_latency_ms);
+        const double delta = m.last_first_audio_latency_ms - m.avg_first_audio_latency_ms;
+        m.avg_first_audio_latency_ms += delta / static_cast<double>(m.turns);
+        RAC_LOG_INFO(LOG_CAT, "Turn %lld: first audio %.0fms after end of speech",
+                     static_cast<long long>(m.turns), m.last_first_audio_latency_ms);
+    }
+
+    rac_voice_agent_event_t audio_event = {};
+    audio_event.type = RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED;
+    audio_event.data.audio.audio_data = speech;
+    audio_event.data.audio.audio_size = speech_size;
+    emit_turn_event(session, audio_event);
+
+    rac_voice_agent_event_t processed_event = {};
+    processed_event.type = RAC_VOICE_AGENT_EVENT_PROCESSED;
+    processed_event.data.result.speech_detected = RAC_TRUE;
+    processed_event.data.result.transcription = &turn.transcription[0];
+    processed_event.data.result.response = response;
+    processed_event.data.result.synthesized_audio = speech;
+    processed_event.data.result.synthesized_audio_size = speech_size;
+    emit_turn_event(session, processed_event);
+
+    rac_free(response);
+    rac_free(speech);
+}
+
+static void turn_loop(rac_voice_agent_session* session) {
+    std::unique_lock<std::mutex> lock(session->turn_mtx);
+    while (true) {
+        session->turn_cv.wait(
+            lock, [session] { return session->turns_stopping || !session->turns.empty(); });
+        if (session->turns_stopping) {
+            return;
+        }
+
+        session_turn turn = std::move(session->turns.front());
+        session->turns.pop_front();
+        session->turn_in_progress = true;
+        session->turn_cancelled.store(false);
+        lock.unlock();
+
+        run_turn(session, turn);
+
+        lock.lock();
+        session->turn_in_progress = false;
+    }
+}
+
+// =============================================================================
+// CAPTURE THREAD
+// =============================================================================
+
+/**
+ * Run one view of captured audio through the segmenter and report VAD edges
+ */
+static void process_capture(rac_voice_agent_session* session, const rac_audio_ring_view_t& view) {
+    rac_result_t result = rac_vad_segmenter_process(session->segmenter, view.samples, view.count);
+    if (rac_audio_ring_buffer_consume(session->ring, session->ring_reader, view.count) ==
+        RAC_ERROR_AUDIO_BUFFER_OVERRUN) {
+        RAC_LOG_WARNING(LOG_CAT, "Capture audio was overwritten while being processed");
+    }
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "VAD processing failed: %d", result);
+        emit_error(session, result);
+        return;
+    }
+
+    const bool speech_active = rac_vad_component_is_speech_active(session->vad_handle) == RAC_TRUE;
+    if (speech_active != session->speech_active) {
+        session->speech_active = speech_active;
+        if (speech_active && session->barge_in) {
+            rac_voice_agent_session_cancel_turn(session);
+        }
+        rac_voice_agent_event_t event = {};
+        event.type = RAC_VOICE_AGENT_EVENT_VAD_TRIGGERED;
+        event.data.vad_speech_active = speech_active ? RAC_TRUE : RAC_FALSE;
+        emit(session, event);
+    }
+}
+
+static void capture_loop(rac_voice_agent_session* session) {
+    while (true) {
+        rac_audio_ring_view_t view = {};
+        rac_audio_ring_buffer_peek(session->ring, session->ring_reader, session->chunk_samples,
+                                   &view);
+        if (view.dropped > 0) {
+            RAC_LOG_WARNING(LOG_CAT, "Capture fell behind, dropped %llu samples",
+                            static_cast<unsigned long long>(view.dropped));
+            std::lock_guard<std::mutex> lock(session->metrics_mtx);
+            session->metrics.dropped_samples += view.dropped;
+        }
+        if (view.count > 0) {
+            process_capture(session, view);
+            continue;
+        }
+
+        // Drained: everything pushed before a flush has been processed
+        if (session->flush_requested.exchange(false)) {
+            rac_vad_segmenter_flush(session->segmenter);
+        }
+        if (session->capture_stopping.load()) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(session->capture_mtx);
+        session->capture_cv.wait_for(lock, CAPTURE_POLL_INTERVAL, [session] {
+            return session->capture_stopping.load() || session->flush_requested.load() ||
+                   rac_audio_ring_buffer_available(session->ring, session->ring_reader) > 0;
+        });
+    }
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/**
+ * Release everything the session has set up; threads must be stopped
+ */
+static void destroy_session(rac_voice_agent_session* session) {
+    if (session->segmenter) {
+        rac_vad_segmenter_destroy(session->segmenter);
+    }
+    if (session->ring) {
+        rac_audio_ring_buffer_destroy(session->ring);
+    }
+    if (session->vad_handle) {
+        rac_vad_component_stop(session->vad_handle);
+        rac_vad_component_reset(session->vad_handle);
+    }
+    rac::voice_agent::release_session(session->agent);
+    delete session;
+}
+
+// =============================================================================
+// VOICE SESSION API
+// =============================================================================
+
+rac_result_t rac_voice_agent_session_start(rac_voice_agent_handle_t handle,
+                                           const rac_voice_agent_session_config_t* config,
+                                           rac_voice_agent_event_callback_fn callback,
+                                           void* user_data,
+                                           rac_voice_agent_session_handle_t* out_session) {
+    if (!handle || !callback || !out_session) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const rac_voice_agent_session_config_t* cfg =
+        config ? config : &RAC_VOICE_AGENT_SESSION_CONFIG_DEFAULT;
+    if (cfg->sample_rate <= 0 || cfg->capture_buffer_ms <= 0) {
+        return RAC_ERROR_INVALID_PARAMETER;
+    }
+
+    rac_handle_t stt_handle = nullptr;
+    rac_handle_t vad_handle = nullptr;
+    rac_result_t result = rac::voice_agent::acquire_session(handle, &stt_handle, &vad_handle);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    auto* session = new (std::nothrow) rac_voice_agent_session();
+    if (!session) {
+        rac::voice_agent::release_session(handle);
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    session->agent = handle;
+    session->stt_handle = stt_handle;
+    session->callback = callback;
+    session->user_data = user_data;
+    session->chunk_samples =
+        std::max<size_t>(1, static_cast<size_t>(cfg->sample_rate * CAPTURE_CHUNK_MS / 1000));
+    session->barge_in = cfg->barge_in == RAC_TRUE;
+
+    result = rac_vad_component_start(vad_handle);
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to start VAD: %d", result);
+        destroy_session(session);
+        return result;
+    }
+    session->vad_handle = vad_handle;
+
+    rac_audio_ring_buffer_config_t ring_config = RAC_AUDIO_RING_BUFFER_CONFIG_DEFAULT;
+    ring_config.capacity =
+        static_cast<size_t>(static_cast<int64_t>(cfg->capture_buffer_ms) * cfg->sample_rate / 1000);
+    ring_config.max_read_size = session->chunk_samples;
+    ring_config.max_readers = 1;
+    result = rac_audio_ring_buffer_create(&ring_config, &session->ring);
+    if (result == RAC_SUCCESS) {
+        result = rac_audio_ring_buffer_add_reader(session->ring, &session->ring_reader);
+    }
+    if (result != RAC_SUCCESS) {
+        destroy_session(session);
+        return result;
+    }
+
+    rac_vad_segmenter_config_t segmenter_config = RAC_VAD_SEGMENTER_CONFIG_DEFAULT;
+    segmenter_config.sample_rate = cfg->sample_rate;
+    segmenter_config.pre_roll_ms = cfg->pre_roll_ms;
+    segmenter_config.max_utterance_ms = cfg->max_utterance_ms;
+    segmenter_config.partial_window_ms = cfg->partial_window_ms;
+    result = rac_vad_segmenter_create(vad_handle, stt_handle, &segmenter_config, on_segment,
+                                      session, &session->segmenter);
+    if (result != RAC_SUCCESS) {
+        destroy_session(session);
+        return result;
+    }
+
+    session->turn_thread = std::thread(turn_loop, session);
+    session->capture_thread = std::thread(capture_loop, session);
+
+    *out_session = session;
+    RAC_LOG_INFO(LOG_CAT, "Voice session started (%dHz, partial windows %dms)", cfg->sample_rate,
+                 cfg->partial_window_ms);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_voice_agent_session_push_audio(rac_voice_agent_session_handle_t session,
+                                                const float* samples, size_t sample_count) {
+    if (!session || !samples) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    rac_result_t result = rac_audio_ring_buffer_write(session->ring, samples, sample_count);
+    session->capture_cv.notify_one();
+    return result;
+}
+
+rac_result_t rac_voice_agent_session_flush(rac_voice_agent_session_handle_t session) {
+    if (!session) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    session->flush_requested.store(true);
+    session->capture_cv.notify_one();
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_voice_agent_session_cancel_turn(rac_voice_agent_session_handle_t session) {
+    if (!session) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    int64_t cancelled = 0;
+    {
+        std::lock_guard<std::mutex> lock(session->turn_mtx);
+        cancelled = static_cast<int64_t>(session->turns.size());
+        session->turns.clear();
+        if (session->turn_in_progress && !session->turn_cancelled.load()) {
+            cancelled++;
+        }
+        session->turn_cancelled.store(true);
+    }
+    if (cancelled > 0) {
+        RAC_LOG_INFO(LOG_CAT, "Cancelled %lld turn(s)", static_cast<long long>(cancelled));
+        std::lock_guard<std::mutex> lock(session->metrics_mtx);
+        session->metrics.cancelled_turns += cancelled;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_voice_agent_session_get_metrics(rac_voice_agent_session_handle_t session,
+                                                 rac_voice_agent_session_metrics_t* out_metrics) {
+    if (!session || !out_metrics) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> lock(session->metrics_mtx);
+    *out_metrics = session->metrics;
+    return RAC_SUCCESS;
+}
+
+void rac_voice_agent_session_stop(rac_voice_agent_session_handle_t session) {
+    if (!session) {
+        return;
+    }
+
+    session->capture_stopping.store(true);
+    session->capture_cv.notify_one();
+    session->capture_thread.join();
+
+    // Delivers the queued transcriptions, which may still queue turns
+    rac_vad_segmenter_destroy(session->segmenter);
+    session->segmenter = nullptr;
+
+    {
+        // The turn in progress stops at its next token or sentence
+        std::lock_guard<std::mutex> lock(session->turn_mtx);
+        session->turns_stopping = true;
+        session->turns.clear();
+        session->turn_cancelled.store(true);
+    }
+    session->turn_cv.notify_all();
+    session->turn_thread.join();
+
+    RAC_LOG_INFO(LOG_CAT, "Voice session stopped");
+    destroy_session(session);
+}
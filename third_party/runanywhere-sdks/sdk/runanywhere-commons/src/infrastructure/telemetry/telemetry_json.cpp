@@ -264,6 +264,8 @@ rac_result_t rac_telemetry_manager_payload_to_json(const rac_telemetry_payload_t
     json.add_int("sample_rate", payload->sample_rate);
     json.add_string("voice", payload->voice);
     json.add_double("output_duration_ms", payload->output_duration_ms);
+    json.add_double("time_to_first_audio_ms", payload->time_to_first_audio_ms);
+    json.add_bool("is_cache_hit", payload->is_cache_hit, payload->has_is_cache_hit);
 
     // Model lifecycle
     json.add_int("model_size_bytes", payload->model_size_bytes);
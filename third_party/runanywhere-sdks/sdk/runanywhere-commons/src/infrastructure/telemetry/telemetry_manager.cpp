@@ -595,6 +595,9 @@ rac_result_t rac_telemetry_manager_track_analytics(rac_telemetry_manager_t* mana
                 payload.audio_size_bytes = tts.audio_size_bytes;
                 payload.processing_time_ms = tts.processing_duration_ms;
                 payload.characters_per_second = tts.characters_per_second;
+                payload.time_to_first_audio_ms = tts.time_to_first_audio_ms;
+                payload.is_cache_hit = tts.is_cache_hit;
+                payload.has_is_cache_hit = RAC_TRUE;
                 payload.sample_rate = tts.sample_rate;
                 payload.framework = framework_to_string(tts.framework);
                 if (tts.error_code != RAC_SUCCESS) {
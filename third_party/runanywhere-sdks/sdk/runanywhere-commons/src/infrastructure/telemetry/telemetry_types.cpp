@@ -15,6 +15,8 @@ rac_telemetry_payload_t rac_telemetry_payload_default(void) {
     payload.has_success = RAC_FALSE;
     payload.is_streaming = RAC_FALSE;
     payload.has_is_streaming = RAC_FALSE;
+    payload.is_cache_hit = RAC_FALSE;
+    payload.has_is_cache_hit = RAC_FALSE;
     payload.is_online = RAC_FALSE;
     payload.has_is_online = RAC_FALSE;
     return payload;
@@ -0,0 +1,32 @@
+/**
+ * @file rac_test.h
+ * @brief Minimal check macros for the commons unit tests
+ *
+ * Checks keep running after a failure so one run reports every broken
+ * expectation; RAC_TEST_RESULT() turns the count into the exit code.
+ */
+
+#ifndef RAC_TEST_H
+#define RAC_TEST_H
+
+#include <cstdio>
+
+static int rac_test_failures = 0;
+
+#define RAC_CHECK(cond)                                                                  \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++rac_test_failures;                                                         \
+        }                                                                                \
+    } while (0)
+
+#define RAC_CHECK_EQ(a, b) RAC_CHECK((a) == (b))
+
+#define RAC_TEST_RESULT()                                                          \
+    (rac_test_failures == 0 ? (std::printf("All checks passed\n"), 0)              \
+                            : (std::fprintf(stderr, "%d check(s) failed\n",        \
+                                            rac_test_failures),                    \
+                               1))
+
+#endif  // RAC_TEST_H
@@ -0,0 +1,220 @@
+/**
+ * @file rac_test_fakes.h
+ * @brief Configurable fake STT, LLM and TTS providers for the commons unit tests
+ *
+ * register_fake_provider() registers a provider whose services forward each
+ * operation to a hook in fake_stt(), fake_llm() or fake_tts(). Tests set the
+ * hooks they need; an unset hook makes the operation RAC_ERROR_NOT_SUPPORTED,
+ * and get_info reports streaming support when the streaming hook is set.
+ */
+
+#ifndef RAC_TEST_FAKES_H
+#define RAC_TEST_FAKES_H
+
+#include <cstdlib>
+#include <functional>
+
+#include "rac/core/rac_core.h"
+#include "rac/features/llm/rac_llm_service.h"
+#include "rac/features/stt/rac_stt_service.h"
+#include "rac/features/tts/rac_tts_service.h"
+#include "rac_test.h"
+
+namespace rac::test {
+
+// =============================================================================
+// HOOKS
+// =============================================================================
+
+struct fake_stt_hooks {
+    std::function<rac_result_t(const void* audio_data, size_t audio_size,
+                               const rac_stt_options_t* options, rac_stt_result_t* out_result)>
+        transcribe;
+    std::function<rac_result_t(const void* audio_data, size_t audio_size,
+                               const rac_stt_options_t* options,
+                               rac_stt_stream_callback_t callback, void* user_data)>
+        transcribe_stream;
+};
+
+struct fake_llm_hooks {
+    std::function<rac_result_t(const char* prompt, const rac_llm_options_t* options,
+                               rac_llm_result_t* out_result)>
+        generate;
+    std::function<rac_result_t(const char* prompt, const rac_llm_options_t* options,
+                               rac_llm_stream_callback_fn callback, void* user_data)>
+        generate_stream;
+};
+
+struct fake_tts_hooks {
+    std::function<rac_result_t(const char* text, const rac_tts_options_t* options,
+                               rac_tts_result_t* out_result)>
+        synthesize;
+    std::function<rac_result_t(const char* text, const rac_tts_options_t* options,
+                               rac_tts_stream_callback_t callback, void* user_data)>
+        synthesize_stream;
+};
+
+inline fake_stt_hooks& fake_stt() {
+    static fake_stt_hooks hooks;
+    return hooks;
+}
+
+inline fake_llm_hooks& fake_llm() {
+    static fake_llm_hooks hooks;
+    return hooks;
+}
+
+inline fake_tts_hooks& fake_tts() {
+    static fake_tts_hooks hooks;
+    return hooks;
+}
+
+// =============================================================================
+// SERVICE OPS
+// =============================================================================
+
+namespace detail {
+
+inline rac_result_t initialize_model(void* /*impl*/, const char* /*model_path*/) {
+    return RAC_SUCCESS;
+}
+
+inline rac_result_t initialize_voice(void* /*impl*/) {
+    return RAC_SUCCESS;
+}
+
+inline void destroy(void* /*impl*/) {}
+
+inline rac_result_t stt_transcribe(void* /*impl*/, const void* audio_data, size_t audio_size,
+                                   const rac_stt_options_t* options,
+                                   rac_stt_result_t* out_result) {
+    const auto& hook = fake_stt().transcribe;
+    return hook ? hook(audio_data, audio_size, options, out_result) : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline rac_result_t stt_transcribe_stream(void* /*impl*/, const void* audio_data,
+                                          size_t audio_size, const rac_stt_options_t* options,
+                                          rac_stt_stream_callback_t callback, void* user_data) {
+    const auto& hook = fake_stt().transcribe_stream;
+    return hook ? hook(audio_data, audio_size, options, callback, user_data)
+                : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline rac_result_t stt_get_info(void* /*impl*/, rac_stt_info_t* out_info) {
+    out_info->is_ready = RAC_TRUE;
+    out_info->current_model = "fake-stt";
+    out_info->supports_streaming = fake_stt().transcribe_stream ? RAC_TRUE : RAC_FALSE;
+    return RAC_SUCCESS;
+}
+
+inline rac_result_t llm_generate(void* /*impl*/, const char* prompt,
+                                 const rac_llm_options_t* options,
+                                 rac_llm_result_t* out_result) {
+    const auto& hook = fake_llm().generate;
+    return hook ? hook(prompt, options, out_result) : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline rac_result_t llm_generate_stream(void* /*impl*/, const char* prompt,
+                                        const rac_llm_options_t* options,
+                                        rac_llm_stream_callback_fn callback, void* user_data) {
+    const auto& hook = fake_llm().generate_stream;
+    return hook ? hook(prompt, options, callback, user_data) : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline rac_result_t llm_get_info(void* /*impl*/, rac_llm_info_t* out_info) {
+    out_info->is_ready = RAC_TRUE;
+    out_info->current_model = "fake-llm";
+    out_info->supports_streaming = fake_llm().generate_stream ? RAC_TRUE : RAC_FALSE;
+    return RAC_SUCCESS;
+}
+
+inline rac_result_t tts_synthesize(void* /*impl*/, const char* text,
+                                   const rac_tts_options_t* options,
+                                   rac_tts_result_t* out_result) {
+    const auto& hook = fake_tts().synthesize;
+    return hook ? hook(text, options, out_result) : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline rac_result_t tts_synthesize_stream(void* /*impl*/, const char* text,
+                                          const rac_tts_options_t* options,
+                                          rac_tts_stream_callback_t callback, void* user_data) {
+    const auto& hook = fake_tts().synthesize_stream;
+    return hook ? hook(text, options, callback, user_data) : RAC_ERROR_NOT_SUPPORTED;
+}
+
+inline const rac_stt_service_ops_t kSttOps = {.initialize = initialize_model,
+                                              .transcribe = stt_transcribe,
+                                              .transcribe_stream = stt_transcribe_stream,
+                                              .get_info = stt_get_info,
+                                              .cleanup = nullptr,
+                                              .destroy = destroy};
+
+inline const rac_llm_service_ops_t kLlmOps = {.initialize = initialize_model,
+                                              .generate = llm_generate,
+                                              .generate_stream = llm_generate_stream,
+                                              .get_info = llm_get_info,
+                                              .cancel = nullptr,
+                                              .cleanup = nullptr,
+                                              .destroy = destroy};
+
+inline const rac_tts_service_ops_t kTtsOps = {.initialize = initialize_voice,
+                                              .synthesize = tts_synthesize,
+                                              .synthesize_stream = tts_synthesize_stream,
+                                              .stop = nullptr,
+                                              .get_info = nullptr,
+                                              .cleanup = nullptr,
+                                              .destroy = destroy};
+
+inline rac_bool_t can_handle(const rac_service_request_t* /*request*/, void* /*user_data*/) {
+    return RAC_TRUE;
+}
+
+inline rac_handle_t create_stt(const rac_service_request_t* /*request*/, void* /*user_data*/) {
+    auto* service = static_cast<rac_stt_service_t*>(calloc(1, sizeof(rac_stt_service_t)));
+    service->ops = &kSttOps;
+    return service;
+}
+
+inline rac_handle_t create_llm(const rac_service_request_t* /*request*/, void* /*user_data*/) {
+    auto* service = static_cast<rac_llm_service_t*>(calloc(1, sizeof(rac_llm_service_t)));
+    service->ops = &kLlmOps;
+    return service;
+}
+
+inline rac_handle_t create_tts(const rac_service_request_t* /*request*/, void* /*user_data*/) {
+    auto* service = static_cast<rac_tts_service_t*>(calloc(1, sizeof(rac_tts_service_t)));
+    service->ops = &kTtsOps;
+    return service;
+}
+
+}  // namespace detail
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+/**
+ * Register the fake provider for RAC_CAPABILITY_STT, RAC_CAPABILITY_TEXT_GENERATION
+ * or RAC_CAPABILITY_TTS, ahead of any real one
+ */
+inline void register_fake_provider(rac_capability_t capability) {
+    rac_service_provider_t provider = {};
+    provider.capability = capability;
+    provider.priority = 100;
+    provider.can_handle = detail::can_handle;
+    if (capability == RAC_CAPABILITY_STT) {
+        provider.name = "FakeSTT";
+        provider.create = detail::create_stt;
+    } else if (capability == RAC_CAPABILITY_TEXT_GENERATION) {
+        provider.name = "FakeLLM";
+        provider.create = detail::create_llm;
+    } else {
+        provider.name = "FakeTTS";
+        provider.create = detail::create_tts;
+    }
+    RAC_CHECK_EQ(rac_service_register_provider(&provider), RAC_SUCCESS);
+}
+
+}  // namespace rac::test
+
+#endif  // RAC_TEST_FAKES_H
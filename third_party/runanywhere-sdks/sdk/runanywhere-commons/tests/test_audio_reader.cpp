@@ -0,0 +1,329 @@
+/**
+ * @file test_audio_reader.cpp
+ * @brief Audio reader: WAV parsing, downmixing and resampling
+ *
+ * Writes small WAV files to the temp directory and reads them back through
+ * both the mapped and the buffered path.
+ */
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "rac/core/rac_audio_reader.h"
+#include "rac_test.h"
+
+namespace {
+
+// =============================================================================
+// WAV WRITER
+// =============================================================================
+
+struct wav_spec {
+    uint16_t format = 0x0001;
+    uint16_t channels = 1;
+    uint32_t sample_rate = 16000;
+    uint16_t bits = 16;
+    bool extensible = false;
+    bool odd_chunk_before_data = false;  // A LIST chunk of odd length, padded
+    bool zero_data_size = false;         // Header of a recording never finalized
+};
+
+void put_u16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    put_u16(out, static_cast<uint16_t>(value));
+    put_u16(out, static_cast<uint16_t>(value >> 16));
+}
+
+void put_tag(std::vector<uint8_t>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+std::string temp_path(const char* name) {
+    const char* dir = getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/rac_test_" + std::to_string(getpid()) + "_" +
+           name + ".wav";
+}
+
+std::string write_wav(const char* name, const wav_spec& spec, const std::vector<uint8_t>& data) {
+    const uint16_t block_align = static_cast<uint16_t>(spec.channels * spec.bits / 8);
+    std::vector<uint8_t> file;
+    put_tag(file, "RIFF");
+    put_u32(file, 0);  // Patched below
+    put_tag(file, "WAVE");
+
+    put_tag(file, "fmt ");
+    put_u32(file, spec.extensible ? 40 : 16);
+    put_u16(file, spec.extensible ? 0xFFFE : spec.format);
+    put_u16(file, spec.channels);
+    put_u32(file, spec.sample_rate);
+    put_u32(file, spec.sample_rate * block_align);
+    put_u16(file, block_align);
+    put_u16(file, spec.bits);
+    if (spec.extensible) {
+        static const uint8_t kGuidTail[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80,
+                                              0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+        put_u16(file, 22);
+        put_u16(file, spec.bits);
+        put_u32(file, spec.channels == 1 ? 0x4 : 0x3);
+        put_u16(file, spec.format);
+        file.insert(file.end(), kGuidTail, kGuidTail + sizeof(kGuidTail));
+    }
+
+    if (spec.odd_chunk_before_data) {
+        put_tag(file, "LIST");
+        put_u32(file, 5);
+        file.insert(file.end(), {'I', 'N', 'F', 'O', 'x', 0});
+    }
+
+    put_tag(file, "data");
+    put_u32(file, spec.zero_data_size ? 0 : static_cast<uint32_t>(data.size()));
+    file.insert(file.end(), data.begin(), data.end());
+
+    const uint32_t riff_size = static_cast<uint32_t>(file.size() - 8);
+    for (int i = 0; i < 4; ++i) {
+        file[4 + i] = static_cast<uint8_t>(riff_size >> (8 * i));
+    }
+
+    const std::string path = temp_path(name);
+    FILE* f = fopen(path.c_str(), "wb");
+    RAC_CHECK(f != nullptr);
+    if (f) {
+        fwrite(file.data(), 1, file.size(), f);
+        fclose(f);
+    }
+    return path;
+}
+
+std::vector<uint8_t> pcm16_bytes(const std::vector<int16_t>& samples) {
+    std::vector<uint8_t> bytes;
+    for (int16_t sample : samples) {
+        put_u16(bytes, static_cast<uint16_t>(sample));
+    }
+    return bytes;
+}
+
+std::vector<float> read_all(const std::string& path, const rac_audio_reader_config_t& config,
+                            rac_audio_file_info_t* out_info = nullptr) {
+    std::vector<float> samples;
+    rac_handle_t reader = nullptr;
+    RAC_CHECK_EQ(rac_audio_reader_open(path.c_str(), &config, &reader), RAC_SUCCESS);
+    if (!reader) {
+        return samples;
+    }
+    if (out_info) {
+        RAC_CHECK_EQ(rac_audio_reader_get_info(reader, out_info), RAC_SUCCESS);
+    }
+    while (true) {
+        const float* block = nullptr;
+        size_t count = 0;
+        RAC_CHECK_EQ(rac_audio_reader_read(reader, &block, &count), RAC_SUCCESS);
+        if (count == 0) {
+            break;
+        }
+        RAC_CHECK(count <= config.block_size);
+        samples.insert(samples.end(), block, block + count);
+    }
+    rac_audio_reader_close(reader);
+    return samples;
+}
+
+bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-4f;
+}
+
+float rms(const std::vector<float>& samples, size_t from, size_t to) {
+    double sum = 0.0;
+    for (size_t i = from; i < to; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return static_cast<float>(std::sqrt(sum / static_cast<double>(to - from)));
+}
+
+std::vector<int16_t> sine(uint32_t rate, double hz, size_t count, double amplitude) {
+    std::vector<int16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<int16_t>(
+            std::lround(amplitude * 32767.0 * std::sin(2.0 * M_PI * hz * i / rate)));
+    }
+    return samples;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_pcm16_stereo_both_paths() {
+    wav_spec spec;
+    spec.channels = 2;
+    spec.odd_chunk_before_data = true;
+    std::vector<int16_t> interleaved;
+    for (int i = 0; i < 10000; ++i) {
+        interleaved.push_back(static_cast<int16_t>(i % 2000));
+        interleaved.push_back(static_cast<int16_t>(-(i % 1000)));
+    }
+    const std::string path = write_wav("stereo", spec, pcm16_bytes(interleaved));
+
+    for (rac_bool_t disable_mmap : {RAC_FALSE, RAC_TRUE}) {
+        rac_audio_reader_config_t config = RAC_AUDIO_READER_CONFIG_DEFAULT;
+        config.block_size = 1000;
+        config.disable_mmap = disable_mmap;
+        rac_audio_file_info_t info = {};
+        const std::vector<float> samples = read_all(path, config, &info);
+
+        RAC_CHECK_EQ(info.format, RAC_AUDIO_FORMAT_WAV);
+        RAC_CHECK_EQ(info.channels, 2);
+        RAC_CHECK_EQ(info.sample_rate, 16000);
+        RAC_CHECK_EQ(info.bits_per_sample, 16);
+        RAC_CHECK_EQ(info.frame_count, 10000u);
+        RAC_CHECK_EQ(info.is_mapped, disable_mmap == RAC_TRUE ? RAC_FALSE : RAC_TRUE);
+        RAC_CHECK_EQ(samples.size(), 10000u);
+        if (samples.size() == 10000) {
+            for (size_t i = 0; i < samples.size(); i += 997) {
+                const float expected =
+                    (static_cast<float>(i % 2000) - static_cast<float>(i % 1000)) / 2.0f /
+                    32768.0f;
+                RAC_CHECK(near(samples[i], expected));
+            }
+        }
+    }
+    remove(path.c_str());
+}
+
+void test_encodings() {
+    // 24-bit PCM in a WAVE_FORMAT_EXTENSIBLE header
+    wav_spec pcm24;
+    pcm24.bits = 24;
+    pcm24.extensible = true;
+    const std::vector<uint8_t> pcm24_data = {0x00, 0x00, 0x40, 0x00, 0x00, 0xC0, 0xFF, 0xFF, 0x7F};
+    std::string path = write_wav("pcm24", pcm24, pcm24_data);
+    std::vector<float> samples = read_all(path, RAC_AUDIO_READER_CONFIG_DEFAULT);
+    RAC_CHECK_EQ(samples.size(), 3u);
+    if (samples.size() == 3) {
+        RAC_CHECK(near(samples[0], 0.5f));
+        RAC_CHECK(near(samples[1], -0.5f));
+        RAC_CHECK(near(samples[2], 1.0f));
+    }
+    remove(path.c_str());
+
+    // IEEE float with a data size of zero, read to the end of the file
+    wav_spec float32;
+    float32.format = 0x0003;
+    float32.bits = 32;
+    float32.zero_data_size = true;
+    const float values[] = {0.25f, -0.75f, 1.0f, 0.0f};
+    std::vector<uint8_t> float_data(reinterpret_cast<const uint8_t*>(values),
+                                    reinterpret_cast<const uint8_t*>(values) + sizeof(values));
+    path = write_wav("float32", float32, float_data);
+    rac_audio_file_info_t info = {};
+    samples = read_all(path, RAC_AUDIO_READER_CONFIG_DEFAULT, &info);
+    RAC_CHECK_EQ(info.is_float, RAC_TRUE);
+    RAC_CHECK_EQ(samples.size(), 4u);
+    if (samples.size() == 4) {
+        for (size_t i = 0; i < 4; ++i) {
+            RAC_CHECK(near(samples[i], values[i]));
+        }
+    }
+    remove(path.c_str());
+}
+
+void test_rejects_malformed_files() {
+    rac_handle_t reader = nullptr;
+    RAC_CHECK_EQ(rac_audio_reader_open("/nonexistent/file.wav", nullptr, &reader),
+                 RAC_ERROR_FILE_NOT_FOUND);
+
+    // Not a known container
+    std::string path = temp_path("garbage");
+    FILE* f = fopen(path.c_str(), "wb");
+    fputs("this is not audio at all, just text padding", f);
+    fclose(f);
+    RAC_CHECK_EQ(rac_audio_reader_open(path.c_str(), nullptr, &reader), RAC_ERROR_INVALID_FORMAT);
+    remove(path.c_str());
+
+    // Half-precision float is not an encoding the reader decodes
+    wav_spec odd_width;
+    odd_width.format = 0x0003;
+    odd_width.bits = 16;
+    path = write_wav("float16", odd_width, {0, 0, 0, 0});
+    RAC_CHECK_EQ(rac_audio_reader_open(path.c_str(), nullptr, &reader),
+                 RAC_ERROR_AUDIO_FORMAT_NOT_SUPPORTED);
+    remove(path.c_str());
+    RAC_CHECK(reader == nullptr);
+}
+
+void test_resampling_lengths() {
+    // Every output position inside the input is produced, including the ones
+    // after the last input sample
+    struct rates {
+        uint32_t in;
+        int32_t out;
+        size_t in_count;
+        size_t out_count;
+    };
+    const rates cases[] = {{8000, 16000, 8000, 16000},
+                           {48000, 16000, 48000, 16000},
+                           {44100, 16000, 44100, 16000},
+                           {22050, 16000, 1001, 727}};
+    for (const rates& c : cases) {
+        wav_spec spec;
+        spec.sample_rate = c.in;
+        const std::string path =
+            write_wav("resample", spec, pcm16_bytes(sine(c.in, 440.0, c.in_count, 0.5)));
+        rac_audio_reader_config_t config = RAC_AUDIO_READER_CONFIG_DEFAULT;
+        config.target_sample_rate = c.out;
+        const std::vector<float> samples = read_all(path, config);
+        RAC_CHECK_EQ(samples.size(), c.out_count);
+        remove(path.c_str());
+    }
+}
+
+void test_downsampling_filters_aliases() {
+    wav_spec spec;
+    spec.sample_rate = 48000;
+    rac_audio_reader_config_t config = RAC_AUDIO_READER_CONFIG_DEFAULT;
+    config.target_sample_rate = 16000;
+
+    // 12 kHz is above the 8 kHz output Nyquist rate; decimating it without a
+    // low-pass folds it to a full-strength 4 kHz tone
+    std::string path = write_wav("alias", spec, pcm16_bytes(sine(48000, 12000.0, 48000, 0.5)));
+    std::vector<float> samples = read_all(path, config);
+    RAC_CHECK_EQ(samples.size(), 16000u);
+    if (samples.size() == 16000) {
+        RAC_CHECK(rms(samples, 1000, 15000) < 0.005f);
+    }
+    remove(path.c_str());
+
+    // Speech-band content passes, in phase with the input
+    path = write_wav("passband", spec, pcm16_bytes(sine(48000, 1000.0, 48000, 0.5)));
+    samples = read_all(path, config);
+    RAC_CHECK_EQ(samples.size(), 16000u);
+    if (samples.size() == 16000) {
+        RAC_CHECK(std::fabs(rms(samples, 1000, 15000) - 0.5f / std::sqrt(2.0f)) < 0.01f);
+        for (size_t i = 1000; i < 15000; i += 1111) {
+            const float expected = 0.5f * static_cast<float>(std::sin(2.0 * M_PI * 1000.0 * i /
+                                                                       16000.0));
+            RAC_CHECK(std::fabs(samples[i] - expected) < 0.02f);
+        }
+    }
+    remove(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    test_pcm16_stereo_both_paths();
+    test_encodings();
+    test_rejects_malformed_files();
+    test_resampling_lengths();
+    test_downsampling_filters_aliases();
+    return RAC_TEST_RESULT();
+}
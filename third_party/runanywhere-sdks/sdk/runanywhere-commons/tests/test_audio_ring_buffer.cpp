@@ -0,0 +1,236 @@
+/**
+ * @file test_audio_ring_buffer.cpp
+ * @brief Multi-reader audio ring buffer: views, wrap-around, lagging readers, overruns
+ *
+ * Samples written are a ramp (sample value = stream position), so any view
+ * can be checked against the position it claims to start at.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_error.h"
+#include "rac_test.h"
+
+namespace {
+
+// Ramp values are exact in Float32 up to 2^24
+std::vector<float> ramp(uint64_t from, size_t count) {
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<float>(from + i);
+    }
+    return samples;
+}
+
+bool view_matches_ramp(const rac_audio_ring_view_t& view) {
+    for (size_t i = 0; i < view.count; ++i) {
+        if (view.samples[i] != static_cast<float>(view.position + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+rac_handle_t create_ring(size_t capacity, size_t max_read_size, int32_t max_readers) {
+    rac_audio_ring_buffer_config_t config = RAC_AUDIO_RING_BUFFER_CONFIG_DEFAULT;
+    config.capacity = capacity;
+    config.max_read_size = max_read_size;
+    config.max_readers = max_readers;
+    rac_handle_t ring = nullptr;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_create(&config, &ring), RAC_SUCCESS);
+    return ring;
+}
+
+void write_ramp(rac_handle_t ring, size_t count) {
+    const uint64_t from = rac_audio_ring_buffer_write_position(ring);
+    const std::vector<float> samples = ramp(from, count);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_write(ring, samples.data(), samples.size()), RAC_SUCCESS);
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_views_across_the_wrap() {
+    // Capacity rounds up to 1024
+    rac_handle_t ring = create_ring(1000, 256, 2);
+    int32_t reader = -1;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &reader), RAC_SUCCESS);
+
+    // Walk the reader around the ring several times in odd-sized steps, so
+    // views start at every offset relative to the wrap point
+    uint64_t expected = 0;
+    for (int round = 0; round < 40; ++round) {
+        write_ramp(ring, 200);
+        while (rac_audio_ring_buffer_available(ring, reader) > 0) {
+            rac_audio_ring_view_t view = {};
+            RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 177, &view), RAC_SUCCESS);
+            RAC_CHECK(view.count > 0 && view.count <= 177);
+            RAC_CHECK_EQ(view.position, expected);
+            RAC_CHECK_EQ(view.dropped, 0u);
+            RAC_CHECK(view_matches_ramp(view));
+            RAC_CHECK_EQ(rac_audio_ring_buffer_consume(ring, reader, view.count), RAC_SUCCESS);
+            expected += view.count;
+        }
+    }
+    RAC_CHECK_EQ(expected, rac_audio_ring_buffer_write_position(ring));
+
+    // Views are capped at max_read_size
+    write_ramp(ring, 600);
+    rac_audio_ring_view_t view = {};
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 10000, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.count, 256u);
+    rac_audio_ring_buffer_destroy(ring);
+}
+
+void test_lagging_reader_skips_to_oldest() {
+    rac_handle_t ring = create_ring(1024, 256, 2);
+    int32_t slow = -1;
+    int32_t fast = -1;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &slow), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &fast), RAC_SUCCESS);
+
+    write_ramp(ring, 3000);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_available(ring, slow), 3000u);
+
+    rac_audio_ring_view_t view = {};
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, slow, 100, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.dropped, 3000u - 1024u);
+    RAC_CHECK_EQ(view.position, 3000u - 1024u);
+    RAC_CHECK_EQ(view.count, 100u);
+    RAC_CHECK(view_matches_ramp(view));
+    RAC_CHECK_EQ(rac_audio_ring_buffer_consume(ring, slow, view.count), RAC_SUCCESS);
+
+    // The loss is reported once
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, slow, 100, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.dropped, 0u);
+    RAC_CHECK_EQ(view.position, 3000u - 1024u + 100u);
+
+    // Readers are independent: the other one lost the same amount, no more
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, fast, 1, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.dropped, 3000u - 1024u);
+    rac_audio_ring_buffer_destroy(ring);
+}
+
+void test_overrun_while_view_in_use() {
+    rac_handle_t ring = create_ring(1024, 256, 1);
+    int32_t reader = -1;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &reader), RAC_SUCCESS);
+
+    // Writing up to exactly one lap past the view leaves it intact
+    write_ramp(ring, 100);
+    rac_audio_ring_view_t view = {};
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 100, &view), RAC_SUCCESS);
+    write_ramp(ring, 1024 - 100);
+    RAC_CHECK(view_matches_ramp(view));
+    RAC_CHECK_EQ(rac_audio_ring_buffer_consume(ring, reader, view.count), RAC_SUCCESS);
+
+    // One sample more and the start of the view has been overwritten
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 100, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.position, 100u);
+    write_ramp(ring, 101);
+    RAC_CHECK(!view_matches_ramp(view));
+    RAC_CHECK_EQ(rac_audio_ring_buffer_consume(ring, reader, view.count),
+                 RAC_ERROR_AUDIO_BUFFER_OVERRUN);
+
+    // The cursor still advanced past the damaged view
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 256, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.position, 200u);
+    RAC_CHECK_EQ(view.dropped, 0u);
+    RAC_CHECK(view_matches_ramp(view));
+    RAC_CHECK_EQ(rac_audio_ring_buffer_consume(ring, reader, view.count), RAC_SUCCESS);
+
+    // A single write longer than the ring keeps only its tail
+    write_ramp(ring, 5000);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 256, &view), RAC_SUCCESS);
+    RAC_CHECK_EQ(view.position, rac_audio_ring_buffer_write_position(ring) - 1024u);
+    RAC_CHECK(view_matches_ramp(view));
+    rac_audio_ring_buffer_destroy(ring);
+}
+
+void test_reader_slots() {
+    rac_handle_t ring = create_ring(1024, 256, 2);
+    int32_t a = -1;
+    int32_t b = -1;
+    int32_t c = -1;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &a), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &b), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &c), RAC_ERROR_SERVICE_BUSY);
+
+    // A reader attached later starts at the current write position
+    write_ramp(ring, 500);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_remove_reader(ring, a), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_available(ring, a), 0u);
+    rac_audio_ring_view_t view = {};
+    RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, a, 1, &view), RAC_ERROR_INVALID_ARGUMENT);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &c), RAC_SUCCESS);
+    RAC_CHECK_EQ(c, a);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_available(ring, c), 0u);
+    RAC_CHECK_EQ(rac_audio_ring_buffer_available(ring, b), 500u);
+    rac_audio_ring_buffer_destroy(ring);
+}
+
+void test_concurrent_writer_detects_every_overrun() {
+    // A small ring and a writer that outpaces the reader, so overruns are
+    // common. Every view that consume accepts must hold intact samples.
+    rac_handle_t ring = create_ring(4096, 512, 1);
+    int32_t reader = -1;
+    RAC_CHECK_EQ(rac_audio_ring_buffer_add_reader(ring, &reader), RAC_SUCCESS);
+
+    constexpr uint64_t kTotal = 160 * 50000;
+    std::atomic<bool> done{false};
+    std::thread writer([ring, &done] {
+        std::vector<float> block;
+        for (uint64_t written = 0; written < kTotal; written += block.size()) {
+            block = ramp(written, 160);
+            rac_audio_ring_buffer_write(ring, block.data(), block.size());
+        }
+        done.store(true);
+    });
+
+    int64_t accepted = 0;
+    int64_t corrupt_accepted = 0;
+    uint64_t next = 0;
+    uint64_t dropped = 0;
+    while (!done.load() || rac_audio_ring_buffer_available(ring, reader) > 0) {
+        rac_audio_ring_view_t view = {};
+        RAC_CHECK_EQ(rac_audio_ring_buffer_peek(ring, reader, 512, &view), RAC_SUCCESS);
+        if (view.count == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        dropped += view.dropped;
+        RAC_CHECK_EQ(view.position, next + view.dropped);
+        const bool intact = view_matches_ramp(view);
+        const rac_result_t status = rac_audio_ring_buffer_consume(ring, reader, view.count);
+        if (status == RAC_SUCCESS) {
+            ++accepted;
+            corrupt_accepted += intact ? 0 : 1;
+        } else {
+            RAC_CHECK_EQ(status, RAC_ERROR_AUDIO_BUFFER_OVERRUN);
+        }
+        next = view.position + view.count;
+    }
+    writer.join();
+
+    RAC_CHECK(accepted > 0);
+    RAC_CHECK_EQ(corrupt_accepted, 0);
+    // Every sample was either read (accepted or overrun) or reported dropped
+    RAC_CHECK_EQ(next, kTotal);
+    RAC_CHECK(dropped < kTotal);
+    rac_audio_ring_buffer_destroy(ring);
+}
+
+}  // namespace
+
+int main() {
+    test_views_across_the_wrap();
+    test_lagging_reader_skips_to_oldest();
+    test_overrun_while_view_in_use();
+    test_reader_slots();
+    test_concurrent_writer_detects_every_overrun();
+    return RAC_TEST_RESULT();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_p2_quantile.cpp
+ * @brief P-square quantile estimator accuracy and the energy VAD percentiles built on it
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "features/vad/p2_quantile.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac_test.h"
+
+namespace {
+
+float exact_quantile(std::vector<float> values, float p) {
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(values.size() * p));
+    return values[index];
+}
+
+float estimate(const std::vector<float>& values, float p) {
+    p2_quantile q;
+    p2_reset(&q, p);
+    for (float value : values) {
+        p2_add(&q, value);
+    }
+    return p2_value(&q);
+}
+
+void test_small_counts_are_exact() {
+    p2_quantile q;
+    p2_reset(&q, 0.9f);
+    RAC_CHECK_EQ(p2_value(&q), 0.0f);
+
+    const float values[] = {4.0f, 1.0f, 3.0f, 2.0f};
+    for (float value : values) {
+        p2_add(&q, value);
+    }
+    RAC_CHECK_EQ(p2_value(&q), 4.0f);
+
+    p2_reset(&q, 0.2f);
+    for (float value : values) {
+        p2_add(&q, value);
+    }
+    RAC_CHECK_EQ(p2_value(&q), 1.0f);
+}
+
+void test_matches_exact_quantiles() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::exponential_distribution<float> exponential(1.0f);
+    std::lognormal_distribution<float> lognormal(-5.0f, 0.8f);  // Energy-like levels
+
+    std::vector<float> uniform_values(20000);
+    std::vector<float> exponential_values(20000);
+    std::vector<float> lognormal_values(20000);
+    for (size_t i = 0; i < uniform_values.size(); ++i) {
+        uniform_values[i] = uniform(rng);
+        exponential_values[i] = exponential(rng);
+        lognormal_values[i] = lognormal(rng);
+    }
+
+    for (float p : {0.2f, 0.5f, 0.9f}) {
+        RAC_CHECK(std::fabs(estimate(uniform_values, p) - p) < 0.01f);
+
+        const float exact_exp = exact_quantile(exponential_values, p);
+        RAC_CHECK(std::fabs(estimate(exponential_values, p) - exact_exp) < 0.03f * exact_exp);
+
+        const float exact_log = exact_quantile(lognormal_values, p);
+        RAC_CHECK(std::fabs(estimate(lognormal_values, p) - exact_log) < 0.03f * exact_log);
+    }
+}
+
+void test_sorted_input() {
+    std::vector<float> ascending(10000);
+    for (size_t i = 0; i < ascending.size(); ++i) {
+        ascending[i] = static_cast<float>(i + 1);
+    }
+    std::vector<float> descending(ascending.rbegin(), ascending.rend());
+
+    RAC_CHECK(std::fabs(estimate(ascending, 0.9f) - 9000.0f) < 100.0f);
+    RAC_CHECK(std::fabs(estimate(descending, 0.9f) - 9000.0f) < 100.0f);
+    RAC_CHECK(std::fabs(estimate(ascending, 0.2f) - 2000.0f) < 100.0f);
+}
+
+// Frames of constant amplitude have that amplitude as their RMS energy
+void feed_frame(rac_energy_vad_handle_t vad, float level) {
+    std::vector<float> frame(1600, level);
+    rac_bool_t has_voice = RAC_FALSE;
+    RAC_CHECK_EQ(rac_energy_vad_process_audio(vad, frame.data(), frame.size(), &has_voice),
+                 RAC_SUCCESS);
+}
+
+void test_energy_vad_calibration_and_tracking() {
+    rac_energy_vad_handle_t vad = nullptr;
+    RAC_CHECK_EQ(rac_energy_vad_create(nullptr, &vad), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_energy_vad_initialize(vad), RAC_SUCCESS);
+
+    // Calibration levels 0.0005 .. 0.0100 in a scrambled order
+    std::vector<float> levels;
+    for (int i = 1; i <= RAC_VAD_CALIBRATION_FRAMES_NEEDED; ++i) {
+        levels.push_back(0.0005f * static_cast<float>(i));
+    }
+    std::shuffle(levels.begin(), levels.end(), std::mt19937(7));
+    for (float level : levels) {
+        feed_frame(vad, level);
+    }
+
+    rac_bool_t calibrating = RAC_TRUE;
+    RAC_CHECK_EQ(rac_energy_vad_is_calibrating(vad, &calibrating), RAC_SUCCESS);
+    RAC_CHECK_EQ(calibrating, RAC_FALSE);
+
+    rac_energy_vad_stats_t stats = {};
+    RAC_CHECK_EQ(rac_energy_vad_get_statistics(vad, &stats), RAC_SUCCESS);
+    const float calibrated_ambient = stats.ambient;
+    RAC_CHECK(calibrated_ambient > 0.0080f && calibrated_ambient <= 0.0100f);
+    RAC_CHECK(std::fabs(stats.threshold - std::max(calibrated_ambient * 2.0f,
+                                                   RAC_VAD_MIN_THRESHOLD)) < 1e-6f);
+
+    // A quieter room pulls the ambient level down after one tracking window
+    for (int i = 0; i < 100; ++i) {
+        feed_frame(vad, 0.001f);
+    }
+    RAC_CHECK_EQ(rac_energy_vad_get_statistics(vad, &stats), RAC_SUCCESS);
+    RAC_CHECK(stats.ambient < calibrated_ambient);
+    RAC_CHECK(stats.ambient > 0.001f);
+    RAC_CHECK(std::fabs(stats.threshold -
+                        std::max(stats.ambient * 2.0f, RAC_VAD_MIN_THRESHOLD)) < 1e-6f);
+
+    rac_energy_vad_destroy(vad);
+}
+
+}  // namespace
+
+int main() {
+    test_small_counts_are_exact();
+    test_matches_exact_quantiles();
+    test_sorted_input();
+    test_energy_vad_calibration_and_tracking();
+    return RAC_TEST_RESULT();
+}
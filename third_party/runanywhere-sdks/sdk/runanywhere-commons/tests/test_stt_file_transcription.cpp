@@ -0,0 +1,117 @@
+/**
+ * @file test_stt_file_transcription.cpp
+ * @brief File transcription: window lengths and where windows are cut
+ *
+ * Writes a WAV file with rac_wav_writer and transcribes it through a fake
+ * STT provider that records the length of every window it is given.
+ */
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "rac/core/rac_core.h"
+#include "rac/core/rac_wav_io.h"
+#include "rac/features/stt/rac_stt_component.h"
+#include "rac_test.h"
+#include "rac_test_fakes.h"
+
+namespace {
+
+constexpr int32_t kSampleRate = 16000;
+constexpr size_t kWindowSamples = 30 * kSampleRate;
+
+std::vector<size_t> g_windows;
+
+// =============================================================================
+// FAKE STT SERVICE
+// =============================================================================
+
+rac_result_t fake_transcribe(const void* /*audio_data*/, size_t audio_size,
+                             const rac_stt_options_t* /*options*/, rac_stt_result_t* out_result) {
+    g_windows.push_back(audio_size / sizeof(int16_t));
+    *out_result = {};
+    out_result->text = strdup("window");
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+/**
+ * A steady tone with a quiet stretch at 28.0 s and a silent one at 30.1 s.
+ * The silent stretch lies past the 30 s window but inside the last decoded
+ * block, so a search over the whole buffer would cut there.
+ */
+std::string write_test_file(size_t total_samples) {
+    std::vector<int16_t> samples(total_samples);
+    for (size_t i = 0; i < total_samples; ++i) {
+        double amplitude = 0.3;
+        if (i >= 28000 * kSampleRate / 1000 && i < 28100 * kSampleRate / 1000) {
+            amplitude = 0.05;
+        } else if (i >= 30100 * kSampleRate / 1000 && i < 30140 * kSampleRate / 1000) {
+            amplitude = 0.0;
+        }
+        samples[i] = static_cast<int16_t>(
+            std::lround(amplitude * 32767.0 * std::sin(2.0 * M_PI * 300.0 * i / kSampleRate)));
+    }
+
+    const char* dir = getenv("TMPDIR");
+    const std::string path = std::string(dir ? dir : "/tmp") + "/rac_test_" +
+                             std::to_string(getpid()) + "_transcribe.wav";
+    rac_handle_t writer = nullptr;
+    RAC_CHECK_EQ(rac_wav_writer_open(path.c_str(), kSampleRate, 1, &writer), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_wav_writer_write_int16(writer, samples.data(), samples.size()),
+                 RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_wav_writer_close(writer), RAC_SUCCESS);
+    return path;
+}
+
+void test_windows_are_cut_within_bounds() {
+    const size_t total_samples = 65 * static_cast<size_t>(kSampleRate);
+    const std::string path = write_test_file(total_samples);
+
+    rac_handle_t stt = nullptr;
+    RAC_CHECK_EQ(rac_stt_component_create(&stt), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_stt_component_load_model(stt, "fake-stt", "fake-stt", "Fake STT"),
+                 RAC_SUCCESS);
+
+    rac_stt_result_t result = {};
+    RAC_CHECK_EQ(rac_stt_component_transcribe_file(stt, path.c_str(), nullptr, &result),
+                 RAC_SUCCESS);
+    RAC_CHECK(result.text != nullptr && strcmp(result.text, "window window window") == 0);
+    rac_stt_result_free(&result);
+
+    RAC_CHECK_EQ(g_windows.size(), 3u);
+    size_t covered = 0;
+    for (size_t window : g_windows) {
+        RAC_CHECK(window <= kWindowSamples);
+        covered += window;
+    }
+    RAC_CHECK_EQ(covered, total_samples);
+
+    // The first cut lands in the quiet stretch, not the silence past 30 s
+    if (!g_windows.empty()) {
+        RAC_CHECK(g_windows[0] >= 28000 * kSampleRate / 1000);
+        RAC_CHECK(g_windows[0] < 28100 * kSampleRate / 1000);
+    }
+
+    rac_stt_component_destroy(stt);
+    remove(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    rac::test::fake_stt().transcribe = fake_transcribe;
+    rac::test::register_fake_provider(RAC_CAPABILITY_STT);
+
+    test_windows_are_cut_within_bounds();
+
+    return RAC_TEST_RESULT();
+}
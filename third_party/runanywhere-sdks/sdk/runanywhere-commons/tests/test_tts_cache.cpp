@@ -0,0 +1,274 @@
+/**
+ * @file test_tts_cache.cpp
+ * @brief Synthesized-audio cache: key coverage, events, memory and disk budgets
+ *
+ * Drives rac_tts_component through a fake TTS provider that counts syntheses,
+ * with a platform adapter backed by an in-memory file system.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rac/core/rac_analytics_events.h"
+#include "rac/core/rac_core.h"
+#include "rac/core/rac_platform_adapter.h"
+#include "rac/features/tts/rac_tts_component.h"
+#include "rac_test.h"
+#include "rac_test_fakes.h"
+
+namespace {
+
+constexpr size_t kAudioBytes = 1000;
+constexpr const char* kCacheDir = "/tts-cache";
+
+int g_syntheses = 0;
+std::map<std::string, std::vector<uint8_t>> g_files;
+
+// =============================================================================
+// FAKE PLATFORM FILE SYSTEM
+// =============================================================================
+
+rac_bool_t fake_file_exists(const char* path, void* /*user_data*/) {
+    return g_files.count(path) != 0 ? RAC_TRUE : RAC_FALSE;
+}
+
+rac_result_t fake_file_read(const char* path, void** out_data, size_t* out_size,
+                            void* /*user_data*/) {
+    auto it = g_files.find(path);
+    if (it == g_files.end()) {
+        return RAC_ERROR_FILE_NOT_FOUND;
+    }
+    *out_data = rac_alloc(it->second.size());
+    memcpy(*out_data, it->second.data(), it->second.size());
+    *out_size = it->second.size();
+    return RAC_SUCCESS;
+}
+
+rac_result_t fake_file_write(const char* path, const void* data, size_t size,
+                             void* /*user_data*/) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    g_files[path].assign(bytes, bytes + size);
+    return RAC_SUCCESS;
+}
+
+rac_result_t fake_file_delete(const char* path, void* /*user_data*/) {
+    g_files.erase(path);
+    return RAC_SUCCESS;
+}
+
+// Entry files in the cache directory, excluding the index
+void count_entry_files(size_t* out_count, size_t* out_bytes) {
+    *out_count = 0;
+    *out_bytes = 0;
+    for (const auto& file : g_files) {
+        const std::string& path = file.first;
+        if (path.size() > 9 && path.compare(path.size() - 9, 9, ".ttscache") == 0) {
+            ++*out_count;
+            *out_bytes += file.second.size();
+        }
+    }
+}
+
+// =============================================================================
+// FAKE TTS SERVICE
+// =============================================================================
+
+rac_result_t fake_synthesize(const char* /*text*/, const rac_tts_options_t* options,
+                             rac_tts_result_t* out_result) {
+    ++g_syntheses;
+    *out_result = {};
+    out_result->audio_data = malloc(kAudioBytes);
+    memset(out_result->audio_data, g_syntheses & 0xff, kAudioBytes);
+    out_result->audio_size = kAudioBytes;
+    out_result->audio_format = options->audio_format;
+    out_result->sample_format = options->sample_format;
+    out_result->sample_rate = options->sample_rate;
+    out_result->duration_ms = 100;
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// EVENTS
+// =============================================================================
+
+struct synthesis_events {
+    int started = 0;
+    int completed = 0;
+    int cache_hits = 0;
+};
+
+synthesis_events g_events;
+
+void on_event(rac_event_type_t type, const rac_analytics_event_data_t* data, void* /*user*/) {
+    if (type == RAC_EVENT_TTS_SYNTHESIS_STARTED) {
+        ++g_events.started;
+    } else if (type == RAC_EVENT_TTS_SYNTHESIS_COMPLETED) {
+        ++g_events.completed;
+    } else {
+        return;
+    }
+    if (data->data.tts_synthesis.is_cache_hit == RAC_TRUE) {
+        ++g_events.cache_hits;
+    }
+}
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+rac_handle_t create_component(int64_t max_bytes) {
+    rac_handle_t tts = nullptr;
+    RAC_CHECK_EQ(rac_tts_component_create(&tts), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_tts_component_load_voice(tts, "fake-voice", "fake-voice", "Fake Voice"),
+                 RAC_SUCCESS);
+
+    rac_tts_cache_config_t cache_config = RAC_TTS_CACHE_CONFIG_DEFAULT;
+    cache_config.max_bytes = max_bytes;
+    cache_config.max_entry_bytes = static_cast<int64_t>(kAudioBytes);
+    cache_config.persist_directory = kCacheDir;
+    RAC_CHECK_EQ(rac_tts_component_configure_cache(tts, &cache_config), RAC_SUCCESS);
+    return tts;
+}
+
+// Returns whether the synthesis went to the service
+bool synthesize(rac_handle_t tts, const char* text, const rac_tts_options_t& options) {
+    const int before = g_syntheses;
+    rac_tts_result_t result = {};
+    RAC_CHECK_EQ(rac_tts_component_synthesize(tts, text, &options, &result), RAC_SUCCESS);
+    RAC_CHECK_EQ(result.audio_size, kAudioBytes);
+    rac_tts_result_free(&result);
+    return g_syntheses != before;
+}
+
+rac_tts_cache_stats_t cache_stats(rac_handle_t tts) {
+    rac_tts_cache_stats_t stats = {};
+    RAC_CHECK_EQ(rac_tts_component_get_cache_stats(tts, &stats), RAC_SUCCESS);
+    return stats;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_key_covers_output_options() {
+    rac_handle_t tts = create_component(64 * static_cast<int64_t>(kAudioBytes));
+    const rac_tts_options_t base = RAC_TTS_OPTIONS_DEFAULT;
+
+    RAC_CHECK(synthesize(tts, "Hello there", base));
+    RAC_CHECK(!synthesize(tts, "  Hello   there ", base));
+
+    // Each output-affecting option is a separate entry
+    rac_tts_options_t options = base;
+    options.pitch = 1.25f;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.volume = 0.5f;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.language = "de-DE";
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.sample_rate = 16000;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.audio_format = RAC_AUDIO_FORMAT_WAV;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.rate = 1.5f;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+    options = base;
+    options.sample_format = RAC_TTS_SAMPLE_FORMAT_INT16;
+    RAC_CHECK(synthesize(tts, "Hello there", options));
+
+    // Ownership of the returned buffer does not change the audio
+    options = base;
+    options.borrow_audio = RAC_TRUE;
+    RAC_CHECK(!synthesize(tts, "Hello there", options));
+
+    const rac_tts_cache_stats_t stats = cache_stats(tts);
+    RAC_CHECK_EQ(stats.hits, 2);
+    RAC_CHECK_EQ(stats.misses, 8);
+    rac_tts_component_destroy(tts);
+}
+
+void test_hits_emit_events() {
+    g_files.clear();
+    rac_handle_t tts = create_component(8 * static_cast<int64_t>(kAudioBytes));
+    const rac_tts_options_t options = RAC_TTS_OPTIONS_DEFAULT;
+
+    g_events = synthesis_events();
+    RAC_CHECK(synthesize(tts, "Event check", options));
+    RAC_CHECK(!synthesize(tts, "Event check", options));
+
+    RAC_CHECK_EQ(g_events.started, 2);
+    RAC_CHECK_EQ(g_events.completed, 2);
+    RAC_CHECK_EQ(g_events.cache_hits, 2);
+    rac_tts_component_destroy(tts);
+}
+
+void test_memory_and_disk_share_budget() {
+    g_files.clear();
+    const int64_t budget = 3 * static_cast<int64_t>(kAudioBytes) + 500;
+    rac_handle_t tts = create_component(budget);
+    const rac_tts_options_t options = RAC_TTS_OPTIONS_DEFAULT;
+
+    const char* phrases[] = {"one", "two", "three", "four", "five", "six"};
+    for (const char* phrase : phrases) {
+        RAC_CHECK(synthesize(tts, phrase, options));
+    }
+
+    rac_tts_cache_stats_t stats = cache_stats(tts);
+    RAC_CHECK(stats.bytes <= budget);
+    RAC_CHECK_EQ(stats.entry_count, 3);
+    RAC_CHECK_EQ(stats.evictions, 3);
+    RAC_CHECK(stats.disk_bytes <= budget);
+    RAC_CHECK(stats.disk_evictions >= 3);
+
+    size_t files = 0;
+    size_t file_bytes = 0;
+    count_entry_files(&files, &file_bytes);
+    RAC_CHECK_EQ(files, static_cast<size_t>(stats.disk_entry_count));
+    RAC_CHECK_EQ(file_bytes, static_cast<size_t>(stats.disk_bytes));
+    RAC_CHECK(file_bytes <= static_cast<size_t>(budget));
+
+    // Evicted from both tiers, so synthesized again
+    RAC_CHECK(synthesize(tts, "one", options));
+    // Still in memory
+    RAC_CHECK(!synthesize(tts, "six", options));
+    rac_tts_component_destroy(tts);
+
+    // A new component finds the persisted entries through the index and
+    // prunes them to a smaller budget, least recently used first
+    rac_handle_t reopened = create_component(static_cast<int64_t>(kAudioBytes) + 500);
+    stats = cache_stats(reopened);
+    RAC_CHECK_EQ(stats.disk_entry_count, 1);
+    count_entry_files(&files, &file_bytes);
+    RAC_CHECK_EQ(files, 1u);
+    RAC_CHECK(!synthesize(reopened, "one", options));
+    RAC_CHECK_EQ(cache_stats(reopened).disk_hits, 1);
+    rac_tts_component_destroy(reopened);
+}
+
+}  // namespace
+
+int main() {
+    static rac_platform_adapter_t adapter = {};
+    adapter.file_exists = fake_file_exists;
+    adapter.file_read = fake_file_read;
+    adapter.file_write = fake_file_write;
+    adapter.file_delete = fake_file_delete;
+    rac_set_platform_adapter(&adapter);
+    rac_analytics_events_set_callback(on_event, nullptr);
+
+    rac::test::fake_tts().synthesize = fake_synthesize;
+    rac::test::register_fake_provider(RAC_CAPABILITY_TTS);
+
+    test_key_covers_output_options();
+    test_hits_emit_events();
+    test_memory_and_disk_share_budget();
+
+    return RAC_TEST_RESULT();
+}
@@ -0,0 +1,338 @@
+/**
+ * @file test_vad_segmenter.cpp
+ * @brief VAD segmenter: cumulative partials, partial/final ordering, backlog drops,
+ *        queued finals drained on destroy
+ *
+ * Drives the segmenter with the built-in energy VAD and a fake streaming STT
+ * provider whose transcriptions can be held at a gate, so jobs pile up in the
+ * queue the way they do when the model is slower than real time.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_core.h"
+#include "rac/features/stt/rac_stt_component.h"
+#include "rac/features/vad/rac_vad_component.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac/features/vad/rac_vad_segmenter.h"
+#include "rac_test.h"
+#include "rac_test_fakes.h"
+
+namespace {
+
+constexpr int32_t kSampleRate = 16000;
+constexpr size_t kFrameSamples = 1600;  // One energy VAD frame (100 ms)
+
+// =============================================================================
+// FAKE STT SERVICE
+// =============================================================================
+
+struct fake_stt_state {
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool gate_open = true;
+    int calls_entered = 0;
+    std::vector<size_t> stream_samples;  // Audio length of each partial transcription
+};
+
+fake_stt_state g_stt;
+
+void pass_gate() {
+    std::unique_lock<std::mutex> lock(g_stt.mtx);
+    g_stt.calls_entered++;
+    g_stt.cv.notify_all();
+    g_stt.cv.wait(lock, [] { return g_stt.gate_open; });
+}
+
+void set_gate(bool open) {
+    std::lock_guard<std::mutex> lock(g_stt.mtx);
+    g_stt.gate_open = open;
+    g_stt.cv.notify_all();
+}
+
+// Waits until the worker has entered the fake service `count` times in total
+bool wait_for_calls(int count) {
+    std::unique_lock<std::mutex> lock(g_stt.mtx);
+    return g_stt.cv.wait_for(lock, std::chrono::seconds(5),
+                             [count] { return g_stt.calls_entered >= count; });
+}
+
+rac_result_t fake_transcribe(const void* /*audio_data*/, size_t /*audio_size*/,
+                             const rac_stt_options_t* /*options*/, rac_stt_result_t* out_result) {
+    pass_gate();
+    *out_result = {};
+    out_result->text = strdup("final");
+    return RAC_SUCCESS;
+}
+
+rac_result_t fake_transcribe_stream(const void* /*audio_data*/, size_t audio_size,
+                                    const rac_stt_options_t* /*options*/,
+                                    rac_stt_stream_callback_t callback, void* user_data) {
+    pass_gate();
+    {
+        std::lock_guard<std::mutex> lock(g_stt.mtx);
+        g_stt.stream_samples.push_back(audio_size / sizeof(int16_t));
+    }
+    callback("partial", RAC_FALSE, user_data);
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// SEGMENTER HARNESS
+// =============================================================================
+
+struct delivered_result {
+    int64_t utterance_id;
+    bool is_final;
+    int64_t audio_duration_ms;
+};
+
+struct harness {
+    rac_handle_t vad = nullptr;
+    rac_handle_t stt = nullptr;
+    rac_handle_t segmenter = nullptr;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<delivered_result> results;
+};
+
+void on_result(const rac_vad_segment_result_t* result, void* user_data) {
+    auto* h = static_cast<harness*>(user_data);
+    std::lock_guard<std::mutex> lock(h->mtx);
+    h->results.push_back({result->utterance_id, result->is_final == RAC_TRUE,
+                          result->audio_duration_ms});
+    h->cv.notify_all();
+}
+
+void open_harness(harness* h, int32_t partial_window_ms) {
+    RAC_CHECK_EQ(rac_vad_component_create(&h->vad), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_vad_component_initialize(h->vad), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_vad_component_start(h->vad), RAC_SUCCESS);
+
+    RAC_CHECK_EQ(rac_stt_component_create(&h->stt), RAC_SUCCESS);
+    RAC_CHECK_EQ(rac_stt_component_load_model(h->stt, "fake-stt", "fake-stt", "Fake STT"),
+                 RAC_SUCCESS);
+
+    rac_vad_segmenter_config_t config = RAC_VAD_SEGMENTER_CONFIG_DEFAULT;
+    config.sample_rate = kSampleRate;
+    config.partial_window_ms = partial_window_ms;
+    RAC_CHECK_EQ(rac_vad_segmenter_create(h->vad, h->stt, &config, on_result, h, &h->segmenter),
+                 RAC_SUCCESS);
+}
+
+void close_harness(harness* h) {
+    rac_vad_segmenter_destroy(h->segmenter);
+    rac_stt_component_destroy(h->stt);
+    rac_vad_component_destroy(h->vad);
+}
+
+void feed(harness* h, float level, int frames) {
+    std::vector<float> frame(kFrameSamples, level);
+    for (int i = 0; i < frames; ++i) {
+        RAC_CHECK_EQ(rac_vad_segmenter_process(h->segmenter, frame.data(), frame.size()),
+                     RAC_SUCCESS);
+    }
+}
+
+// Quiet calibration frames, so the energy VAD settles on its minimum threshold
+void calibrate(harness* h) {
+    feed(h, 0.0005f, RAC_VAD_CALIBRATION_FRAMES_NEEDED + 5);
+}
+
+// Enough quiet frames to end speech
+void end_speech(harness* h) {
+    feed(h, 0.0005f, RAC_VAD_VOICE_END_THRESHOLD + 2);
+}
+
+bool wait_for_finals(harness* h, size_t count) {
+    std::unique_lock<std::mutex> lock(h->mtx);
+    return h->cv.wait_for(lock, std::chrono::seconds(5), [h, count] {
+        size_t finals = 0;
+        for (const delivered_result& result : h->results) {
+            finals += result.is_final ? 1 : 0;
+        }
+        return finals >= count;
+    });
+}
+
+rac_vad_segmenter_metrics_t metrics(harness* h) {
+    rac_vad_segmenter_metrics_t m = {};
+    RAC_CHECK_EQ(rac_vad_segmenter_get_metrics(h->segmenter, &m), RAC_SUCCESS);
+    return m;
+}
+
+void reset_fake_stt() {
+    std::lock_guard<std::mutex> lock(g_stt.mtx);
+    g_stt.gate_open = true;
+    g_stt.calls_entered = 0;
+    g_stt.stream_samples.clear();
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_partials_are_cumulative() {
+    reset_fake_stt();
+    harness h;
+    open_harness(&h, 1000);
+    calibrate(&h);
+
+    // Let each partial finish before the next one is due, so none is superseded
+    feed(&h, 0.3f, 10);
+    RAC_CHECK(wait_for_calls(1));
+    feed(&h, 0.3f, 10);
+    RAC_CHECK(wait_for_calls(2));
+    end_speech(&h);
+    RAC_CHECK(wait_for_finals(&h, 1));
+
+    std::vector<size_t> streamed;
+    {
+        std::lock_guard<std::mutex> lock(g_stt.mtx);
+        streamed = g_stt.stream_samples;
+    }
+    RAC_CHECK(streamed.size() >= 2);
+    if (streamed.size() >= 2) {
+        // Each partial is the utterance so far, not the latest window alone
+        RAC_CHECK(streamed[0] >= static_cast<size_t>(kSampleRate));
+        RAC_CHECK(streamed[1] >= streamed[0] + static_cast<size_t>(kSampleRate));
+    }
+
+    std::lock_guard<std::mutex> lock(h.mtx);
+    const delivered_result& last = h.results.back();
+    RAC_CHECK(last.is_final);
+    for (const delivered_result& result : h.results) {
+        RAC_CHECK(result.audio_duration_ms <= last.audio_duration_ms);
+    }
+    RAC_CHECK_EQ(metrics(&h).dropped_partials, 0);
+    close_harness(&h);
+}
+
+void test_partials_never_follow_their_final() {
+    reset_fake_stt();
+    harness h;
+    open_harness(&h, 1000);
+    calibrate(&h);
+
+    // Hold the worker in the first partial while the rest of the speech arrives
+    set_gate(false);
+    feed(&h, 0.3f, 10);
+    RAC_CHECK(wait_for_calls(1));
+    feed(&h, 0.3f, 30);
+    end_speech(&h);
+    set_gate(true);
+    RAC_CHECK(wait_for_finals(&h, 1));
+
+    {
+        std::lock_guard<std::mutex> lock(h.mtx);
+        bool final_seen = false;
+        int64_t previous_ms = 0;
+        for (const delivered_result& result : h.results) {
+            RAC_CHECK_EQ(result.utterance_id, 1);
+            RAC_CHECK(!final_seen);
+            RAC_CHECK(result.audio_duration_ms >= previous_ms);
+            final_seen = result.is_final;
+            previous_ms = result.audio_duration_ms;
+        }
+        RAC_CHECK(final_seen);
+        // Only the partial already in flight when the final was queued
+        RAC_CHECK_EQ(h.results.size(), 2u);
+    }
+
+    const rac_vad_segmenter_metrics_t m = metrics(&h);
+    RAC_CHECK(m.dropped_partials >= 2);
+    RAC_CHECK_EQ(m.partial_results, 1);
+    RAC_CHECK_EQ(m.utterances, 1);
+    close_harness(&h);
+}
+
+void test_backlog_drops_oldest_queued_utterance() {
+    reset_fake_stt();
+    harness h;
+    open_harness(&h, 0);
+    calibrate(&h);
+
+    // Utterance 1 is held in transcription; 2 and 3 fill the pool, then 4
+    // and 5 each take the buffer of the oldest queued utterance
+    set_gate(false);
+    feed(&h, 0.3f, 5);
+    end_speech(&h);
+    RAC_CHECK(wait_for_calls(1));
+    for (int i = 0; i < 4; ++i) {
+        feed(&h, 0.3f, 5);
+        end_speech(&h);
+    }
+    set_gate(true);
+    RAC_CHECK(wait_for_finals(&h, 3));
+
+    {
+        std::lock_guard<std::mutex> lock(h.mtx);
+        RAC_CHECK_EQ(h.results.size(), 3u);
+        if (h.results.size() == 3) {
+            RAC_CHECK_EQ(h.results[0].utterance_id, 1);
+            RAC_CHECK_EQ(h.results[1].utterance_id, 4);
+            RAC_CHECK_EQ(h.results[2].utterance_id, 5);
+        }
+    }
+    const rac_vad_segmenter_metrics_t m = metrics(&h);
+    RAC_CHECK_EQ(m.dropped_utterances, 2);
+    RAC_CHECK_EQ(m.utterances, 3);
+    close_harness(&h);
+}
+
+void test_destroy_delivers_queued_finals() {
+    reset_fake_stt();
+    harness h;
+    open_harness(&h, 0);
+    calibrate(&h);
+
+    // Utterance 1 is held in transcription while utterance 2 is queued
+    set_gate(false);
+    feed(&h, 0.3f, 5);
+    end_speech(&h);
+    RAC_CHECK(wait_for_calls(1));
+    feed(&h, 0.3f, 5);
+    end_speech(&h);
+
+    // Release the worker only once destroy has begun stopping it
+    std::thread opener([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        set_gate(true);
+    });
+    rac_vad_segmenter_destroy(h.segmenter);
+    opener.join();
+
+    {
+        std::lock_guard<std::mutex> lock(h.mtx);
+        RAC_CHECK_EQ(h.results.size(), 2u);
+        if (h.results.size() == 2) {
+            RAC_CHECK_EQ(h.results[0].utterance_id, 1);
+            RAC_CHECK_EQ(h.results[1].utterance_id, 2);
+            RAC_CHECK(h.results[1].is_final);
+        }
+    }
+    rac_stt_component_destroy(h.stt);
+    rac_vad_component_destroy(h.vad);
+}
+
+}  // namespace
+
+int main() {
+    rac::test::fake_stt().transcribe = fake_transcribe;
+    rac::test::fake_stt().transcribe_stream = fake_transcribe_stream;
+    rac::test::register_fake_provider(RAC_CAPABILITY_STT);
+
+    test_partials_are_cumulative();
+    test_partials_never_follow_their_final();
+    test_backlog_drops_oldest_queued_utterance();
+    test_destroy_delivers_queued_finals();
+
+    return RAC_TEST_RESULT();
+}
@@ -0,0 +1,429 @@
+/**
+ * @file test_voice_session.cpp
+ * @brief Voice session: failed transcriptions, streamed replies, cancelled turns
+ *
+ * Runs a session on a voice agent whose STT, LLM and TTS come from fake
+ * providers, with the built-in energy VAD finding the end of speech. The fake
+ * LLM streams tokens until told to stop; the fake TTS streams two chunks per
+ * sentence with a pause between them, so first-chunk and full-reply timings
+ * differ, and synthesizes one chunk per sentence for WAV output.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_core.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac/features/voice_agent/rac_voice_agent.h"
+#include "rac_test.h"
+#include "rac_test_fakes.h"
+
+namespace {
+
+constexpr int32_t kSampleRate = 16000;
+constexpr size_t kFrameSamples = 1600;  // One energy VAD frame (100 ms)
+constexpr size_t kChunkBytes = 3200;
+constexpr auto kChunkGap = std::chrono::milliseconds(200);
+
+// =============================================================================
+// FAKE SERVICES
+// =============================================================================
+
+struct fake_state {
+    std::mutex mtx;
+    std::condition_variable cv;
+    rac_result_t stt_status = RAC_SUCCESS;
+    int llm_max_tokens = 5;
+    const char* llm_token = "word ";
+    int llm_tokens = 0;  // Tokens accepted by the most recent generation
+    bool llm_running = false;
+    int llm_calls = 0;
+    int tts_calls = 0;  // Sentences synthesized
+};
+
+fake_state g_fake;
+
+rac_result_t fake_stt_transcribe(const void* /*audio_data*/, size_t /*audio_size*/,
+                                 const rac_stt_options_t* /*options*/,
+                                 rac_stt_result_t* out_result) {
+    std::lock_guard<std::mutex> lock(g_fake.mtx);
+    if (g_fake.stt_status != RAC_SUCCESS) {
+        return g_fake.stt_status;
+    }
+    *out_result = {};
+    out_result->text = strdup("hello");
+    return RAC_SUCCESS;
+}
+
+rac_result_t fake_llm_generate_stream(const char* /*prompt*/,
+                                      const rac_llm_options_t* /*options*/,
+                                      rac_llm_stream_callback_fn callback, void* user_data) {
+    int max_tokens = 0;
+    const char* token = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_fake.mtx);
+        g_fake.llm_running = true;
+        g_fake.llm_calls++;
+        max_tokens = g_fake.llm_max_tokens;
+        token = g_fake.llm_token;
+        g_fake.cv.notify_all();
+    }
+    int tokens = 0;
+    while (tokens < max_tokens) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (callback(token, user_data) != RAC_TRUE) {
+            break;
+        }
+        tokens++;
+    }
+    std::lock_guard<std::mutex> lock(g_fake.mtx);
+    g_fake.llm_running = false;
+    g_fake.llm_tokens = tokens;
+    g_fake.cv.notify_all();
+    return RAC_SUCCESS;
+}
+
+void count_tts_call() {
+    std::lock_guard<std::mutex> lock(g_fake.mtx);
+    g_fake.tts_calls++;
+}
+
+rac_result_t fake_tts_synthesize(const char* /*text*/, const rac_tts_options_t* /*options*/,
+                                 rac_tts_result_t* out_result) {
+    count_tts_call();
+    *out_result = {};
+    out_result->audio_data = calloc(1, kChunkBytes);
+    out_result->audio_size = kChunkBytes;
+    out_result->audio_format = RAC_AUDIO_FORMAT_PCM;
+    out_result->sample_rate = kSampleRate;
+    out_result->sample_format = RAC_TTS_SAMPLE_FORMAT_INT16;
+    return RAC_SUCCESS;
+}
+
+rac_result_t fake_tts_synthesize_stream(const char* /*text*/,
+                                        const rac_tts_options_t* /*options*/,
+                                        rac_tts_stream_callback_t callback, void* user_data) {
+    count_tts_call();
+    std::vector<uint8_t> chunk(kChunkBytes, 0);
+    callback(chunk.data(), chunk.size(), user_data);
+    std::this_thread::sleep_for(kChunkGap);
+    callback(chunk.data(), chunk.size(), user_data);
+    return RAC_SUCCESS;
+}
+
+void install_fakes() {
+    rac::test::fake_stt().transcribe = fake_stt_transcribe;
+    rac::test::fake_llm().generate_stream = fake_llm_generate_stream;
+    rac::test::fake_tts().synthesize = fake_tts_synthesize;
+    rac::test::fake_tts().synthesize_stream = fake_tts_synthesize_stream;
+    rac::test::register_fake_provider(RAC_CAPABILITY_STT);
+    rac::test::register_fake_provider(RAC_CAPABILITY_TEXT_GENERATION);
+    rac::test::register_fake_provider(RAC_CAPABILITY_TTS);
+}
+
+// =============================================================================
+// SESSION HARNESS
+// =============================================================================
+
+struct recorder {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<rac_voice_agent_event_type_t> types;  // Without VAD_TRIGGERED
+    std::vector<rac_result_t> errors;
+    size_t chunk_bytes = 0;
+    size_t synthesized_bytes = 0;
+};
+
+void on_event(const rac_voice_agent_event_t* event, void* user_data) {
+    auto* r = static_cast<recorder*>(user_data);
+    std::lock_guard<std::mutex> lock(r->mtx);
+    if (event->type == RAC_VOICE_AGENT_EVENT_VAD_TRIGGERED) {
+        return;
+    }
+    r->types.push_back(event->type);
+    if (event->type == RAC_VOICE_AGENT_EVENT_ERROR) {
+        r->errors.push_back(event->data.error_code);
+    } else if (event->type == RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK) {
+        r->chunk_bytes += event->data.audio.audio_size;
+    } else if (event->type == RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED) {
+        r->synthesized_bytes += event->data.audio.audio_size;
+    }
+    r->cv.notify_all();
+}
+
+size_t count_events(recorder* r, rac_voice_agent_event_type_t type) {
+    size_t count = 0;
+    for (rac_voice_agent_event_type_t t : r->types) {
+        count += t == type ? 1 : 0;
+    }
+    return count;
+}
+
+bool wait_for_event(recorder* r, rac_voice_agent_event_type_t type, size_t count) {
+    std::unique_lock<std::mutex> lock(r->mtx);
+    return r->cv.wait_for(lock, std::chrono::seconds(5),
+                          [r, type, count] { return count_events(r, type) >= count; });
+}
+
+bool wait_for_llm(const std::function<bool()>& done) {
+    std::unique_lock<std::mutex> lock(g_fake.mtx);
+    return g_fake.cv.wait_for(lock, std::chrono::seconds(5), done);
+}
+
+void push(rac_voice_agent_session_handle_t session, float level, int frames) {
+    std::vector<float> frame(kFrameSamples, level);
+    for (int i = 0; i < frames; ++i) {
+        RAC_CHECK_EQ(rac_voice_agent_session_push_audio(session, frame.data(), frame.size()),
+                     RAC_SUCCESS);
+    }
+}
+
+// Quiet calibration frames, so the energy VAD settles on its minimum threshold
+void calibrate(rac_voice_agent_session_handle_t session) {
+    push(session, 0.0005f, RAC_VAD_CALIBRATION_FRAMES_NEEDED + 5);
+}
+
+// Speech followed by enough quiet frames to end it
+void speak(rac_voice_agent_session_handle_t session) {
+    push(session, 0.3f, 5);
+    push(session, 0.0005f, RAC_VAD_VOICE_END_THRESHOLD + 2);
+}
+
+rac_voice_agent_session_handle_t start_session(rac_voice_agent_handle_t agent, recorder* r,
+                                               bool barge_in) {
+    rac_voice_agent_session_config_t config = RAC_VOICE_AGENT_SESSION_CONFIG_DEFAULT;
+    config.sample_rate = kSampleRate;
+    config.barge_in = barge_in ? RAC_TRUE : RAC_FALSE;
+    rac_voice_agent_session_handle_t session = nullptr;
+    RAC_CHECK_EQ(rac_voice_agent_session_start(agent, &config, on_event, r, &session),
+                 RAC_SUCCESS);
+    return session;
+}
+
+rac_voice_agent_session_metrics_t metrics(rac_voice_agent_session_handle_t session) {
+    rac_voice_agent_session_metrics_t m = {};
+    RAC_CHECK_EQ(rac_voice_agent_session_get_metrics(session, &m), RAC_SUCCESS);
+    return m;
+}
+
+void reset_fakes(rac_result_t stt_status, int llm_max_tokens) {
+    std::lock_guard<std::mutex> lock(g_fake.mtx);
+    g_fake.stt_status = stt_status;
+    g_fake.llm_max_tokens = llm_max_tokens;
+    g_fake.llm_token = "word ";
+    g_fake.llm_tokens = 0;
+    g_fake.llm_calls = 0;
+    g_fake.tts_calls = 0;
+}
+
+void set_llm_max_tokens(int max_tokens) {
+    std::lock_guard<std::mutex> lock(g_fake.mtx);
+    g_fake.llm_max_tokens = max_tokens;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void test_failed_transcription_is_reported(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_ERROR_INFERENCE_FAILED, 5);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_ERROR, 1));
+
+    const rac_voice_agent_session_metrics_t m = metrics(session);
+    RAC_CHECK_EQ(m.failed_turns, 1);
+    RAC_CHECK_EQ(m.turns, 0);
+    rac_voice_agent_session_stop(session);
+
+    RAC_CHECK_EQ(r.errors.size(), 1u);
+    if (!r.errors.empty()) {
+        RAC_CHECK_EQ(r.errors[0], RAC_ERROR_INFERENCE_FAILED);
+    }
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_TRANSCRIPTION), 0u);
+    RAC_CHECK_EQ(g_fake.llm_calls, 0);
+}
+
+void test_reply_is_streamed(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 5);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_PROCESSED, 1));
+
+    const rac_voice_agent_session_metrics_t m = metrics(session);
+    rac_voice_agent_session_stop(session);
+
+    const std::vector<rac_voice_agent_event_type_t> expected = {
+        RAC_VOICE_AGENT_EVENT_TRANSCRIPTION,     RAC_VOICE_AGENT_EVENT_RESPONSE,
+        RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK,       RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK,
+        RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED, RAC_VOICE_AGENT_EVENT_PROCESSED};
+    RAC_CHECK(r.types == expected);
+    RAC_CHECK_EQ(r.chunk_bytes, 2 * kChunkBytes);
+    RAC_CHECK_EQ(r.synthesized_bytes, 2 * kChunkBytes);
+
+    // First audio is the first chunk, not the end of synthesis
+    RAC_CHECK_EQ(m.turns, 1);
+    RAC_CHECK(m.last_tts_duration_ms >= 150.0);
+    RAC_CHECK(m.last_first_audio_latency_ms + 150.0 <
+              m.last_stt_latency_ms + m.last_llm_duration_ms + m.last_tts_duration_ms);
+}
+
+void test_cancel_stops_turn(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 100000);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_llm([] { return g_fake.llm_running; }));
+
+    RAC_CHECK_EQ(rac_voice_agent_session_cancel_turn(session), RAC_SUCCESS);
+    RAC_CHECK(wait_for_llm([] { return !g_fake.llm_running; }));
+    RAC_CHECK(g_fake.llm_tokens < 100000);
+
+    // The next utterance is answered as usual
+    set_llm_max_tokens(5);
+    speak(session);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_PROCESSED, 1));
+
+    const rac_voice_agent_session_metrics_t m = metrics(session);
+    rac_voice_agent_session_stop(session);
+
+    RAC_CHECK_EQ(m.cancelled_turns, 1);
+    RAC_CHECK_EQ(m.failed_turns, 0);
+    RAC_CHECK_EQ(m.turns, 1);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_TRANSCRIPTION), 2u);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_RESPONSE), 1u);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_ERROR), 0u);
+}
+
+void test_barge_in_cancels_on_speech(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 100000);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, true);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_llm([] { return g_fake.llm_running; }));
+
+    // Speaking over the reply cancels it
+    push(session, 0.3f, 5);
+    RAC_CHECK(wait_for_llm([] { return !g_fake.llm_running; }));
+    set_llm_max_tokens(5);
+    push(session, 0.0005f, RAC_VAD_VOICE_END_THRESHOLD + 2);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_PROCESSED, 1));
+
+    const rac_voice_agent_session_metrics_t m = metrics(session);
+    rac_voice_agent_session_stop(session);
+
+    RAC_CHECK_EQ(m.cancelled_turns, 1);
+    RAC_CHECK_EQ(m.turns, 1);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_RESPONSE), 1u);
+}
+
+void test_cancel_stops_synthesis_between_sentences(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 3);
+    {
+        std::lock_guard<std::mutex> lock(g_fake.mtx);
+        g_fake.llm_token = "This is one whole sentence. ";
+    }
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+
+    // Cancelled while the first of three sentences is being synthesized
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK, 1));
+    RAC_CHECK_EQ(rac_voice_agent_session_cancel_turn(session), RAC_SUCCESS);
+
+    // The next one-sentence reply is the only other synthesis
+    {
+        std::lock_guard<std::mutex> lock(g_fake.mtx);
+        g_fake.llm_token = "word ";
+    }
+    speak(session);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_PROCESSED, 1));
+    rac_voice_agent_session_stop(session);
+
+    RAC_CHECK_EQ(g_fake.tts_calls, 2);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED), 1u);
+}
+
+void test_stop_cancels_turn(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 100000);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_llm([] { return g_fake.llm_running; }));
+
+    // Returns once generation stops, not after all of its tokens
+    rac_voice_agent_session_stop(session);
+    RAC_CHECK(!g_fake.llm_running);
+    RAC_CHECK(g_fake.llm_tokens < 100000);
+    RAC_CHECK_EQ(count_events(&r, RAC_VOICE_AGENT_EVENT_RESPONSE), 0u);
+}
+
+void test_wav_reply_is_streamed(rac_voice_agent_handle_t agent) {
+    reset_fakes(RAC_SUCCESS, 5);
+    recorder r;
+    rac_voice_agent_session_handle_t session = start_session(agent, &r, false);
+    calibrate(session);
+    speak(session);
+    RAC_CHECK(wait_for_event(&r, RAC_VOICE_AGENT_EVENT_PROCESSED, 1));
+    rac_voice_agent_session_stop(session);
+
+    // Int16 PCM as it is synthesized, then the WAV file with its header
+    const std::vector<rac_voice_agent_event_type_t> expected = {
+        RAC_VOICE_AGENT_EVENT_TRANSCRIPTION, RAC_VOICE_AGENT_EVENT_RESPONSE,
+        RAC_VOICE_AGENT_EVENT_AUDIO_CHUNK, RAC_VOICE_AGENT_EVENT_AUDIO_SYNTHESIZED,
+        RAC_VOICE_AGENT_EVENT_PROCESSED};
+    RAC_CHECK(r.types == expected);
+    RAC_CHECK_EQ(r.chunk_bytes, kChunkBytes);
+    RAC_CHECK_EQ(r.synthesized_bytes, kChunkBytes + rac_audio_wav_header_size());
+}
+
+rac_voice_agent_handle_t create_agent(bool raw_pcm_output) {
+    rac_voice_agent_handle_t agent = nullptr;
+    RAC_CHECK_EQ(rac_voice_agent_create_standalone(&agent), RAC_SUCCESS);
+    rac_voice_agent_config_t config = RAC_VOICE_AGENT_CONFIG_DEFAULT;
+    config.stt_config = {.model_path = "fake-stt", .model_id = "fake-stt", .model_name = "STT"};
+    config.llm_config = {.model_path = "fake-llm", .model_id = "fake-llm", .model_name = "LLM"};
+    config.tts_config.voice_path = "fake-tts";
+    config.tts_config.voice_id = "fake-tts";
+    config.tts_config.voice_name = "TTS";
+    config.tts_config.raw_pcm_output = raw_pcm_output ? RAC_TRUE : RAC_FALSE;
+    config.tts_config.pcm_sample_format = RAC_TTS_SAMPLE_FORMAT_INT16;
+    RAC_CHECK_EQ(rac_voice_agent_initialize(agent, &config), RAC_SUCCESS);
+    return agent;
+}
+
+}  // namespace
+
+int main() {
+    install_fakes();
+
+    rac_voice_agent_handle_t agent = create_agent(true);
+    test_failed_transcription_is_reported(agent);
+    test_reply_is_streamed(agent);
+    test_cancel_stops_turn(agent);
+    test_barge_in_cancels_on_speech(agent);
+    test_cancel_stops_synthesis_between_sentences(agent);
+    test_stop_cancels_turn(agent);
+    rac_voice_agent_destroy(agent);
+
+    rac_voice_agent_handle_t wav_agent = create_agent(false);
+    test_wav_reply_is_streamed(wav_agent);
+    rac_voice_agent_destroy(wav_agent);
+
+    return RAC_TEST_RESULT();
+}